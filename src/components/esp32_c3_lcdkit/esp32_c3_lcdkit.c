@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+#include <inttypes.h>
 #include "esp_timer.h"
 #include "driver/gpio.h"
 #include "driver/ledc.h"
@@ -219,6 +221,13 @@ static lv_disp_t *bsp_display_lcd_init(const bsp_display_cfg_t *cfg)
         .panel_handle = panel_handle,
         .buffer_size = cfg->buffer_size,
         .double_buffer = cfg->double_buffer,
+        .strip = cfg->strip,
+#if CONFIG_BSP_LCD_FRAME_PACING
+        .pacing = {
+            .scan_period_us = CONFIG_BSP_LCD_SCAN_PERIOD_US,
+            .te_gpio = CONFIG_BSP_LCD_TE_GPIO,
+        },
+#endif
         .hres = BSP_LCD_H_RES,
         .vres = BSP_LCD_V_RES,
         .monochrome = false,
@@ -231,6 +240,24 @@ static lv_disp_t *bsp_display_lcd_init(const bsp_display_cfg_t *cfg)
         .flags = {
             .buff_dma = cfg->flags.buff_dma,
             .buff_spiram = cfg->flags.buff_spiram,
+            .buff_strip = cfg->flags.buff_strip,
+#if CONFIG_BSP_LCD_ROUND_CLIP
+            .round = true,
+#endif
+#if BSP_LCD_BIGENDIAN && !LV_COLOR_16_SWAP
+            /* LVGL renders native RGB565, bytes are swapped by the flush */
+            .swap_bytes = true,
+#endif
+#if CONFIG_BSP_LCD_MERGE_AREAS
+            .merge_areas = true,
+#endif
+#if CONFIG_BSP_LCD_DIFF
+            .diff = true,
+#endif
+#if CONFIG_BSP_LCD_FRAME_PACING
+            .pacing = true,
+            .pacing_te = (CONFIG_BSP_LCD_TE_GPIO >= 0),
+#endif
         }
     };
 
@@ -254,6 +281,18 @@ static lv_indev_t *bsp_display_indev_init(lv_disp_t *disp)
 #define LCD_LEDC_DUTY_RES      (LEDC_TIMER_10_BIT)
 #define LCD_LEDC_CH            CONFIG_BSP_DISPLAY_BRIGHTNESS_LEDC_CH
 
+#define LCD_LEDC_DUTY_MAX      (BIT(LCD_LEDC_DUTY_RES))
+
+static struct {
+    bool fade_installed;
+    int percent;            /* Last requested brightness */
+    uint32_t duty;          /* Target duty of the last request */
+    int64_t since_us;       /* Start of the current level */
+    bsp_display_brightness_stats_t stats;
+} bsp_brightness;
+
+static portMUX_TYPE bsp_brightness_lock = portMUX_INITIALIZER_UNLOCKED;
+
 static esp_err_t bsp_display_brightness_init(void)
 {
     // Setup LEDC peripheral for PWM backlight control
@@ -276,12 +315,51 @@ static esp_err_t bsp_display_brightness_init(void)
 
     BSP_ERROR_CHECK_RETURN_ERR(ledc_timer_config(&LCD_backlight_timer));
     BSP_ERROR_CHECK_RETURN_ERR(ledc_channel_config(&LCD_backlight_channel));
+    if (!bsp_brightness.fade_installed) {
+        /* Fades run in hardware, the only interrupt is at the end of a ramp */
+        BSP_ERROR_CHECK_RETURN_ERR(ledc_fade_func_install(0));
+        bsp_brightness.fade_installed = true;
+    }
+
+    taskENTER_CRITICAL(&bsp_brightness_lock);
+    memset(&bsp_brightness.stats, 0, sizeof(bsp_brightness.stats));
+    bsp_brightness.percent = 0;
+    bsp_brightness.duty = 0;
+    bsp_brightness.since_us = esp_timer_get_time();
+    taskEXIT_CRITICAL(&bsp_brightness_lock);
 
     return ESP_OK;
 }
 
-esp_err_t bsp_display_brightness_set(int brightness_percent)
+static uint32_t bsp_display_brightness_to_duty(int brightness_percent)
 {
+#if CONFIG_BSP_DISPLAY_BRIGHTNESS_PERCEPTUAL
+    /* CIE 1931 lightness L* = brightness_percent to relative luminance */
+    const uint32_t l = brightness_percent;
+    if (l <= 8) {
+        return (l * LCD_LEDC_DUTY_MAX * 10 + 9033 / 2) / 9033;
+    }
+    return ((l + 16) * (l + 16) * (l + 16) * LCD_LEDC_DUTY_MAX + 1560896 / 2) / 1560896;   /* 116^3 */
+#else
+    return (LCD_LEDC_DUTY_MAX * brightness_percent) / 100;
+#endif
+}
+
+/* Close the time spent at the current level, call with bsp_brightness_lock taken */
+static void bsp_display_brightness_account(int64_t now_us)
+{
+    const uint64_t elapsed = now_us - bsp_brightness.since_us;
+
+    bsp_brightness.stats.level_us[(bsp_brightness.percent + 5) / 10] += elapsed;
+    bsp_brightness.stats.total_us += elapsed;
+    bsp_brightness.stats.duty_us += elapsed * bsp_brightness.duty / LCD_LEDC_DUTY_MAX;
+    bsp_brightness.since_us = now_us;
+}
+
+esp_err_t bsp_display_brightness_fade(int brightness_percent, uint32_t fade_ms)
+{
+    ESP_RETURN_ON_FALSE(bsp_brightness.fade_installed, ESP_ERR_INVALID_STATE, TAG, "Brightness not initialized");
+
     if (brightness_percent > 100) {
         brightness_percent = 100;
     }
@@ -289,14 +367,56 @@ esp_err_t bsp_display_brightness_set(int brightness_percent)
         brightness_percent = 0;
     }
 
-    ESP_LOGD(TAG, "Setting LCD backlight: %d%%", brightness_percent);
-    uint32_t duty_cycle = (BIT(LCD_LEDC_DUTY_RES) * (brightness_percent)) / 100;
-    BSP_ERROR_CHECK_RETURN_ERR(ledc_set_duty(LEDC_LOW_SPEED_MODE, LCD_LEDC_CH, duty_cycle));
-    BSP_ERROR_CHECK_RETURN_ERR(ledc_update_duty(LEDC_LOW_SPEED_MODE, LCD_LEDC_CH));
+    ESP_LOGD(TAG, "Fading LCD backlight: %d%% in %"PRIu32" ms", brightness_percent, fade_ms);
+    const uint32_t duty_cycle = bsp_display_brightness_to_duty(brightness_percent);
+
+    taskENTER_CRITICAL(&bsp_brightness_lock);
+    bsp_display_brightness_account(esp_timer_get_time());
+    bsp_brightness.percent = brightness_percent;
+    bsp_brightness.duty = duty_cycle;
+    taskEXIT_CRITICAL(&bsp_brightness_lock);
+
+    /* A new fade would wait for the running one, stop it at the current duty instead */
+    BSP_ERROR_CHECK_RETURN_ERR(ledc_fade_stop(LEDC_LOW_SPEED_MODE, LCD_LEDC_CH));
+    if (fade_ms == 0) {
+        BSP_ERROR_CHECK_RETURN_ERR(ledc_set_duty_and_update(LEDC_LOW_SPEED_MODE, LCD_LEDC_CH, duty_cycle, 0));
+    } else {
+        BSP_ERROR_CHECK_RETURN_ERR(ledc_set_fade_time_and_start(LEDC_LOW_SPEED_MODE, LCD_LEDC_CH, duty_cycle, fade_ms, LEDC_FADE_NO_WAIT));
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t bsp_display_brightness_set(int brightness_percent)
+{
+    return bsp_display_brightness_fade(brightness_percent, 0);
+}
+
+int bsp_display_brightness_get(void)
+{
+    return bsp_brightness.percent;
+}
+
+esp_err_t bsp_display_brightness_get_stats(bsp_display_brightness_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+
+    taskENTER_CRITICAL(&bsp_brightness_lock);
+    bsp_display_brightness_account(esp_timer_get_time());
+    *stats = bsp_brightness.stats;
+    taskEXIT_CRITICAL(&bsp_brightness_lock);
 
     return ESP_OK;
 }
 
+void bsp_display_brightness_reset_stats(void)
+{
+    taskENTER_CRITICAL(&bsp_brightness_lock);
+    memset(&bsp_brightness.stats, 0, sizeof(bsp_brightness.stats));
+    bsp_brightness.since_us = esp_timer_get_time();
+    taskEXIT_CRITICAL(&bsp_brightness_lock);
+}
+
 esp_err_t bsp_display_backlight_off(void)
 {
     return bsp_display_brightness_set(0);
@@ -372,17 +492,31 @@ lv_disp_t *bsp_display_start(void)
 {
     bsp_display_cfg_t cfg = {
         .lvgl_port_cfg = ESP_LVGL_PORT_INIT_CONFIG(),
+#if CONFIG_BSP_LCD_DRAW_BUF_AUTO
+        .strip = {
+            .min_lines = CONFIG_BSP_LCD_DRAW_BUF_MIN_LINES,
+            .max_lines = CONFIG_BSP_LCD_DRAW_BUF_MAX_LINES,
+            .heap_reserve = CONFIG_BSP_LCD_DRAW_BUF_HEAP_RESERVE,
+        },
+#else
         .buffer_size = BSP_LCD_H_RES * CONFIG_BSP_LCD_DRAW_BUF_HEIGHT,
 #if CONFIG_BSP_LCD_DRAW_BUF_DOUBLE
         .double_buffer = 1,
 #else
         .double_buffer = 0,
+#endif
 #endif
         .flags = {
             .buff_dma = true,
             .buff_spiram = false,
+#if CONFIG_BSP_LCD_DRAW_BUF_AUTO
+            .buff_strip = true,
+#endif
         }
     };
+#if CONFIG_BSP_LVGL_WAKE_ON_EVENT
+    cfg.lvgl_port_cfg.task_wake_on_event = true;
+#endif
     return bsp_display_start_with_config(&cfg);
 }
 
@@ -390,9 +524,25 @@ lv_disp_t *bsp_display_start_with_config(const bsp_display_cfg_t *cfg)
 {
     lv_disp_t *disp;
     BSP_ERROR_CHECK_RETURN_NULL(lvgl_port_init(&cfg->lvgl_port_cfg));
+    BSP_ERROR_CHECK_RETURN_NULL(lvgl_port_add_rle_decoder(CONFIG_BSP_LVGL_RLE_CACHE_SIZE));
     BSP_ERROR_CHECK_RETURN_NULL(bsp_display_brightness_init());
     BSP_NULL_CHECK(disp = bsp_display_lcd_init(cfg), NULL);
+#if CONFIG_BSP_LVGL_IMG_CACHE_SIZE > 0
+    BSP_ERROR_CHECK_RETURN_NULL(lvgl_port_add_img_cache(disp, CONFIG_BSP_LVGL_IMG_CACHE_SIZE));
+#endif
+#if CONFIG_BSP_LVGL_FONT_CACHE_SIZE > 0
+    BSP_ERROR_CHECK_RETURN_NULL(lvgl_port_add_font_cache(CONFIG_BSP_LVGL_FONT_CACHE_SIZE));
+#endif
+#if CONFIG_BSP_LVGL_GLYPH_CACHE_SIZE > 0
+    BSP_ERROR_CHECK_RETURN_NULL(lvgl_port_add_glyph_cache(disp, CONFIG_BSP_LVGL_GLYPH_CACHE_SIZE));
+#endif
+#if CONFIG_BSP_LVGL_TTF_CACHE_SIZE > 0
+    BSP_ERROR_CHECK_RETURN_NULL(lvgl_port_add_ttf_cache(CONFIG_BSP_LVGL_TTF_CACHE_SIZE));
+#endif
     BSP_NULL_CHECK(disp_indev = bsp_display_indev_init(disp), NULL);
+#if CONFIG_BSP_LVGL_STATS_OVERLAY
+    BSP_ERROR_CHECK_RETURN_NULL(lvgl_port_stats_overlay(disp, true));
+#endif
 
     return disp;
 }
@@ -409,7 +559,8 @@ void bsp_display_rotate(lv_disp_t *disp, lv_disp_rot_t rotation)
 
 bool bsp_display_lock(uint32_t timeout_ms)
 {
-    return lvgl_port_lock(timeout_ms);
+    /* Lock statistics are accounted to the caller of the BSP */
+    return lvgl_port_lock_from(timeout_ms, __builtin_return_address(0));
 }
 
 void bsp_display_unlock(void)
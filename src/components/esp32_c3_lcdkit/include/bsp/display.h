@@ -33,6 +33,9 @@
 #define BSP_LCD_H_RES              (240)
 #define BSP_LCD_V_RES              (240)
 
+/* Brightness levels of the statistics: 0, 10, ..., 100 % */
+#define BSP_DISPLAY_BRIGHTNESS_LEVELS   (11)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -45,6 +48,17 @@ typedef struct {
     int max_transfer_sz;    /*!< Maximum transfer size, in bytes. */
 } bsp_display_config_t;
 
+/**
+ * @brief Time spent by the backlight at each brightness level
+ *
+ * A fade is accounted to its target level from the moment it is requested.
+ */
+typedef struct {
+    uint64_t level_us[BSP_DISPLAY_BRIGHTNESS_LEVELS];  /*!< Time at brightness 0, 10, ..., 100 %, rounded to the nearest level */
+    uint64_t total_us;      /*!< Time since the brightness init or the last reset */
+    uint64_t duty_us;       /*!< Time weighted by the PWM duty, duty_us / total_us is the backlight power relative to full brightness */
+} bsp_display_brightness_stats_t;
+
 /**
  * @brief Create new display panel
  *
@@ -83,6 +97,44 @@ esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_hand
  */
 esp_err_t bsp_display_brightness_set(int brightness_percent);
 
+/**
+ * @brief Fade display's brightness
+ *
+ * The ramp runs in the LEDC fade hardware and the function returns immediately. A fade in
+ * progress is stopped at its current duty and the new one starts from there.
+ * With CONFIG_BSP_DISPLAY_BRIGHTNESS_PERCEPTUAL, the target is perceived lightness (CIE 1931).
+ * The ramp is linear in duty, so a fade looks faster at its dark end.
+ *
+ * @param[in] brightness_percent Brightness in [%]
+ * @param[in] fade_ms            Ramp time, 0 to set the brightness at once
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_STATE Display brightness is not initialized
+ */
+esp_err_t bsp_display_brightness_fade(int brightness_percent, uint32_t fade_ms);
+
+/**
+ * @brief Get the last requested display's brightness
+ *
+ * @return Brightness in [%]
+ */
+int bsp_display_brightness_get(void);
+
+/**
+ * @brief Get time spent at each brightness level
+ *
+ * @param[out] stats Statistics since the brightness init or the last reset
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_ARG   Parameter error
+ */
+esp_err_t bsp_display_brightness_get_stats(bsp_display_brightness_stats_t *stats);
+
+/**
+ * @brief Reset brightness statistics
+ */
+void bsp_display_brightness_reset_stats(void);
+
 /**
  * @brief Turn on display backlight
  *
@@ -63,9 +63,11 @@ typedef struct {
     lvgl_port_cfg_t lvgl_port_cfg;  /*!< LVGL port configuration */
     uint32_t        buffer_size;    /*!< Size of the buffer for the screen in pixels */
     bool            double_buffer;  /*!< True, if should be allocated two buffers */
+    lvgl_port_strip_cfg_t strip;    /*!< Strip sizing, used only with flags.buff_strip */
     struct {
         unsigned int buff_dma: 1;    /*!< Allocated LVGL buffer will be DMA capable */
         unsigned int buff_spiram: 1; /*!< Allocated LVGL buffer will be in PSRAM */
+        unsigned int buff_strip: 1;  /*!< Size two DMA strips from free memory, buffer_size and double_buffer are ignored */
     } flags;
 } bsp_display_cfg_t;
 
@@ -0,0 +1,2758 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "esp_system.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_lcd_panel_io.h"
+#include "esp_lcd_panel_ops.h"
+#include "esp_lcd_panel_commands.h"
+#include "driver/gpio.h"
+#include "esp_partition.h"
+#include "esp_lvgl_port.h"
+#include "lvgl_port_round.h"
+#include "lvgl_port_area.h"
+#include "lvgl_port_pacing.h"
+#include "lvgl_port_stats.h"
+#include "lvgl_port_queue.h"
+#include "lvgl_port_swap.h"
+#include "lvgl_port_diff.h"
+#include "lvgl_port_img.h"
+#include "lvgl_port_font.h"
+#include "lvgl_port_ttf.h"
+#include "lvgl_port_sprite_obj.h"
+#include "lvgl_port_clip_obj.h"
+#include "lvgl_port_scroll_obj.h"
+#include "lvgl_port_roller_obj.h"
+#include "lvgl_port_assets.h"
+
+#include "lvgl.h"
+
+
+#ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
+#include "esp_lcd_touch.h"
+#endif
+
+#ifdef ESP_LVGL_PORT_USB_HOST_HID_COMPONENT
+#include "usb/hid_host.h"
+#include "usb/hid_usage_keyboard.h"
+#include "usb/hid_usage_mouse.h"
+/* LVGL image of cursor */
+LV_IMG_DECLARE(img_cursor)
+#endif
+
+#if (ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(4, 4, 4)) || (ESP_IDF_VERSION == ESP_IDF_VERSION_VAL(5, 0, 0))
+#define LVGL_PORT_HANDLE_FLUSH_READY 0
+#else
+#define LVGL_PORT_HANDLE_FLUSH_READY 1
+#endif
+
+/* Longest time the rendering blocks in one wait for a free draw buffer */
+#define LVGL_PORT_FLUSH_WAIT_MS     (20)
+
+/* Default overhead of one more window (CASET, RASET and RAMWR commands) expressed in pixel bytes at the SPI clock */
+#define LVGL_PORT_TRANS_COST        (128)
+/* Pixels of one row covered by one signature of the diff */
+#define LVGL_PORT_DIFF_TILE_W       (32)
+/* Swapped pixels are sent in bands of this size, the next band is swapped while the previous one is transferred */
+#define LVGL_PORT_SWAP_BAND_BYTES   (8 * 1024)
+
+/* Default scan period of the LCD (60 Hz) */
+#define LVGL_PORT_SCAN_PERIOD_US    (16667)
+
+/* Notification bits of the LVGL task */
+#define LVGL_PORT_EVENT_WAKE        (1 << 0)
+#define LVGL_PORT_EVENT_INPUT       (1 << 1)
+
+/* Input devices, which wake up the LVGL task, are not read anymore after this time without input (task_wake_on_event only) */
+#define LVGL_PORT_INPUT_IDLE_MS     (500)
+
+/* Parts of the frame, its statistics are added, when both of them are finished */
+#define LVGL_PORT_FRAME_RENDERED    (1 << 0)
+#define LVGL_PORT_FRAME_FLUSHED     (1 << 1)
+
+/* Update period of the performance overlay */
+#define LVGL_PORT_OVERLAY_PERIOD_MS (1000)
+
+#if LV_FONT_MONTSERRAT_12
+#define LVGL_PORT_OVERLAY_FONT      (&lv_font_montserrat_12)
+#else
+#define LVGL_PORT_OVERLAY_FONT      (LV_FONT_DEFAULT)
+#endif
+
+static const char *TAG = "LVGL";
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+#ifdef ESP_LVGL_PORT_USB_HOST_HID_COMPONENT
+typedef struct {
+    QueueHandle_t   queue;      /* USB HID queue */
+    TaskHandle_t    task;       /* USB HID task */
+    bool            running;    /* USB HID task running */
+    struct {
+        lv_indev_drv_t  drv;    /* LVGL mouse input device driver */
+        uint8_t sensitivity;    /* Mouse sensitivity (cannot be zero) */
+        int16_t x;              /* Mouse X coordinate */
+        int16_t y;              /* Mouse Y coordinate */
+        bool left_button;       /* Mouse left button state */
+    } mouse;
+    struct {
+        lv_indev_drv_t  drv;    /* LVGL keyboard input device driver */
+        uint32_t last_key;
+        bool     pressed;
+    } kb;
+} lvgl_port_usb_hid_ctx_t;
+
+typedef struct {
+    hid_host_device_handle_t hid_device_handle;
+    hid_host_driver_event_t event;
+    void *arg;
+} lvgl_port_usb_hid_event_t;
+
+#endif
+
+typedef struct lvgl_port_ctx_s {
+    SemaphoreHandle_t   lvgl_mux;
+    esp_timer_handle_t  tick_timer;
+    TaskHandle_t        lvgl_task;
+    bool                running;
+    int                 task_max_sleep_ms;
+    bool                wake_on_event;      /* LVGL task sleeps until the next timer or an event */
+    uint32_t            input_last_ms;      /* LVGL tick of the last input event */
+    int64_t             input_time;         /* First input event not followed by a flush yet [us], 0 when none */
+    portMUX_TYPE        input_lock;         /* Protects input_time against the input callbacks */
+    lvgl_port_task_stats_t task_stats;      /* LVGL task statistics */
+    int64_t             task_wake;          /* Start of a paced refresh the LVGL task sleeps until [us], 0 when none */
+    uint64_t            input_latency_sum;  /* Sum of input latencies since the reset [us] */
+    int64_t             stats_start;        /* Reset of the statistics [us] */
+    lvgl_port_stats_t   frame_stats;        /* Metrics of the last frames */
+    lvgl_port_stats_sample_t frame;         /* Metrics of the running frame */
+    uint32_t            frame_parts;        /* Finished parts of the running frame */
+    bool                frame_rendered;     /* Frame was rendered in the running lv_timer_handler() */
+    portMUX_TYPE        frame_lock;         /* Protects frame_stats and frame_parts against the transfer done ISR */
+    lv_timer_t          *overlay_timer;     /* Update timer of the performance overlay */
+    uint32_t            overlay_frames;     /* Frames at the last update of the overlay */
+    lvgl_port_queue_t   cmd_queue;          /* Commands posted to the LVGL task */
+    uint32_t            cmd_dropped_base;   /* Dropped commands at the reset of the task statistics */
+    lvgl_port_lock_stats_t lock_stats;      /* LVGL mutex statistics per call site */
+    portMUX_TYPE        lock_stats_lock;    /* Protects lock_stats */
+    const void          *lock_caller;       /* Call site of the outermost lock of the mutex holder */
+    uint32_t            lock_depth;         /* Recursive locks of the mutex holder */
+    int64_t             lock_start;         /* Outermost lock of the mutex holder [us] */
+    bool                assets_mapped;      /* Asset partition is mapped */
+    esp_partition_mmap_handle_t assets_mmap; /* Mapping of the asset partition */
+#ifdef ESP_LVGL_PORT_USB_HOST_HID_COMPONENT
+    lvgl_port_usb_hid_ctx_t hid_ctx;
+#endif
+} lvgl_port_ctx_t;
+
+typedef struct {
+    esp_lcd_panel_io_handle_t io_handle;    /* LCD panel IO handle */
+    esp_lcd_panel_handle_t    panel_handle; /* LCD panel handle */
+    lvgl_port_rotation_cfg_t  rotation;     /* Default values of the screen rotation */
+    lv_disp_drv_t             disp_drv;     /* LVGL display driver */
+    SemaphoreHandle_t         flush_done;   /* Given when the transfer of the draw buffer is finished */
+    int64_t                   flush_start;  /* Start time of the running transfer [us] */
+    lvgl_port_buffer_stats_t  buf_stats;    /* Draw buffers statistics */
+    uint32_t                  frame_saved;  /* Pixel bytes not sent in the running frame */
+    uint32_t                  frame_trans;  /* Windows sent in the running frame */
+    uint32_t                  frame_bytes;  /* Pixel bytes sent in the running frame */
+    uint32_t                  trans_cost;   /* Overhead of one window in pixel bytes */
+    bool                      merge_areas;  /* Optimize invalidated areas before refresh */
+    lvgl_port_pacing_t        pacing;       /* Frame pacing state */
+    portMUX_TYPE              pacing_lock;  /* Protects pacing against the TE ISR */
+    bool                      pacing_en;    /* Pace the refresh by the LCD scan */
+    int                       te_gpio;      /* GPIO of the TE output, -1 when the vertical sync is estimated */
+    uint32_t                  fast_period_ms; /* Refresh period while animations run */
+    uint32_t                  slow_period_ms; /* Refresh period of static screen */
+    uint32_t                  frame_scans;  /* Scans between frames of running animations, 0 for static screen */
+    int64_t                   frame_start;  /* Start of the running refresh [us] */
+    int64_t                   pacing_due;   /* Start the postponed refresh waits for [us], 0 when none */
+    int64_t                   frame_flush;  /* First flush of the running refresh [us] */
+    int64_t                   frame_last_flush; /* Last flush of the running refresh [us] */
+    uint32_t                  frame_wait_us;/* Time the running refresh waited for a free draw buffer */
+    bool                      trans_last;   /* Flushed area is the last one of the frame */
+    lvgl_port_round_t         round;        /* Visible spans of round display */
+    bool                      round_en;     /* Display is round */
+    bool                      swap_bytes;   /* Swap bytes of RGB565 pixels before they are sent */
+    lvgl_port_diff_t          diff;         /* Signatures of the LCD content */
+    bool                      diff_en;      /* Send only the changed spans of rows */
+    uint32_t                  frame_diff_saved; /* Bytes not sent by the diff in the running frame */
+    uint32_t                  trans_pending;/* Windows of the flushed area, which are not transferred yet */
+    portMUX_TYPE              trans_lock;   /* Protects trans_pending against the transfer done ISR */
+} lvgl_port_display_ctx_t;
+
+#ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
+typedef struct {
+    esp_lcd_touch_handle_t   handle;     /* LCD touch IO handle */
+    lv_indev_drv_t           indev_drv;  /* LVGL input device driver */
+} lvgl_port_touch_ctx_t;
+#endif
+
+#ifdef ESP_LVGL_PORT_KNOB_COMPONENT
+typedef struct {
+    knob_handle_t   knob_handle; /* Encoder knob handlers */
+    button_handle_t btn_handle; /* Encoder button handlers */
+    lv_indev_drv_t  indev_drv;  /* LVGL input device driver */
+    bool btn_enter; /* Encoder button enter state */
+} lvgl_port_encoder_ctx_t;
+#endif
+
+#ifdef ESP_LVGL_PORT_BUTTON_COMPONENT
+
+typedef enum {
+    LVGL_PORT_NAV_BTN_PREV,
+    LVGL_PORT_NAV_BTN_NEXT,
+    LVGL_PORT_NAV_BTN_ENTER,
+    LVGL_PORT_NAV_BTN_CNT,
+} lvgl_port_nav_btns_t;
+
+typedef struct {
+    button_handle_t btn[LVGL_PORT_NAV_BTN_CNT];     /* Button handlers */
+    lv_indev_drv_t  indev_drv;  /* LVGL input device driver */
+    bool btn_prev; /* Button prev state */
+    bool btn_next; /* Button next state */
+    bool btn_enter; /* Button enter state */
+} lvgl_port_nav_btns_ctx_t;
+#endif
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+static lvgl_port_ctx_t lvgl_port_ctx;
+static int lvgl_port_timer_period_ms = 5;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static void lvgl_port_task(void *arg);
+static esp_err_t lvgl_port_tick_init(void);
+static void lvgl_port_task_deinit(void);
+static void lvgl_port_task_notify(uint32_t events, BaseType_t *need_yield);
+static void lvgl_port_task_input(bool pending);
+static void lvgl_port_task_commands(void);
+static uint32_t lvgl_port_task_wake_ms(uint32_t delay_ms);
+static void lvgl_port_input_flushed(int64_t now);
+static void lvgl_port_frame_done(uint32_t part);
+static void lvgl_port_overlay_update(lv_timer_t *timer);
+
+// LVGL callbacks
+#if LVGL_PORT_HANDLE_FLUSH_READY
+static bool lvgl_port_flush_ready_callback(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx);
+#endif
+static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map);
+static void lvgl_port_update_callback(lv_disp_drv_t *drv);
+static void lvgl_port_wait_callback(lv_disp_drv_t *drv);
+static void lvgl_port_rounder_callback(lv_disp_drv_t *drv, lv_area_t *area);
+static void lvgl_port_window_send(void *user_ctx, int x1, int y1, int x2, int y2, const void *data);
+static bool lvgl_port_trans_done(lvgl_port_display_ctx_t *disp_ctx);
+static void lvgl_port_refr_timer_callback(lv_timer_t *timer);
+static void lvgl_port_pacing_setup(lvgl_port_display_ctx_t *disp_ctx, const lvgl_port_display_cfg_t *disp_cfg);
+static bool lvgl_port_pacing_wait(lvgl_port_display_ctx_t *disp_ctx, lv_timer_t *timer);
+static void lvgl_port_pacing_postpone(lvgl_port_display_ctx_t *disp_ctx, lv_timer_t *timer, int64_t start);
+static void lvgl_port_te_isr(void *arg);
+static esp_err_t lvgl_port_alloc_strips(const lvgl_port_display_cfg_t *disp_cfg, lv_color_t **buf1, lv_color_t **buf2, uint32_t *buffer_size);
+#ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
+static void lvgl_port_touchpad_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data);
+#endif
+#ifdef ESP_LVGL_PORT_KNOB_COMPONENT
+static void lvgl_port_encoder_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data);
+static void lvgl_port_encoder_btn_down_handler(void *arg, void *arg2);
+static void lvgl_port_encoder_btn_up_handler(void *arg, void *arg2);
+static void lvgl_port_encoder_knob_handler(void *arg, void *arg2);
+#endif
+#ifdef ESP_LVGL_PORT_BUTTON_COMPONENT
+static void lvgl_port_navigation_buttons_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data);
+static void lvgl_port_btn_down_handler(void *arg, void *arg2);
+static void lvgl_port_btn_up_handler(void *arg, void *arg2);
+#endif
+#ifdef ESP_LVGL_PORT_USB_HOST_HID_COMPONENT
+static lvgl_port_usb_hid_ctx_t *lvgl_port_hid_init(void);
+static void lvgl_port_usb_hid_task(void *arg);
+static void lvgl_port_usb_hid_read_mouse(lv_indev_drv_t *indev_drv, lv_indev_data_t *data);
+static void lvgl_port_usb_hid_read_kb(lv_indev_drv_t *indev_drv, lv_indev_data_t *data);
+static void lvgl_port_usb_hid_callback(hid_host_device_handle_t hid_device_handle, const hid_host_driver_event_t event, void *arg);
+#endif
+static void lvgl_port_pix_monochrome_callback(lv_disp_drv_t *drv, uint8_t *buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y, lv_color_t color, lv_opa_t opa);
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_init(const lvgl_port_cfg_t *cfg)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_GOTO_ON_FALSE(cfg, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+    ESP_GOTO_ON_FALSE(cfg->task_affinity < (configNUM_CORES), ESP_ERR_INVALID_ARG, err, TAG, "Bad core number for task! Maximum core number is %d", (configNUM_CORES - 1));
+
+    memset(&lvgl_port_ctx, 0, sizeof(lvgl_port_ctx));
+
+
+    /* LVGL init */
+    lv_init();
+    /* Tick init */
+    lvgl_port_timer_period_ms = cfg->timer_period_ms;
+    ESP_RETURN_ON_ERROR(lvgl_port_tick_init(), TAG, "");
+    /* Create task */
+    lvgl_port_ctx.task_max_sleep_ms = cfg->task_max_sleep_ms;
+    if (lvgl_port_ctx.task_max_sleep_ms == 0) {
+        lvgl_port_ctx.task_max_sleep_ms = 500;
+    }
+    lvgl_port_ctx.wake_on_event = cfg->task_wake_on_event;
+    portMUX_INITIALIZE(&lvgl_port_ctx.input_lock);
+    portMUX_INITIALIZE(&lvgl_port_ctx.frame_lock);
+    portMUX_INITIALIZE(&lvgl_port_ctx.lock_stats_lock);
+    lvgl_port_queue_init(&lvgl_port_ctx.cmd_queue);
+    lvgl_port_ctx.stats_start = esp_timer_get_time();
+    lvgl_port_ctx.lvgl_mux = xSemaphoreCreateRecursiveMutex();
+    ESP_GOTO_ON_FALSE(lvgl_port_ctx.lvgl_mux, ESP_ERR_NO_MEM, err, TAG, "Create LVGL mutex fail!");
+
+    BaseType_t res;
+    if (cfg->task_affinity < 0) {
+        res = xTaskCreate(lvgl_port_task, "LVGL task", cfg->task_stack, NULL, cfg->task_priority, &lvgl_port_ctx.lvgl_task);
+    } else {
+        res = xTaskCreatePinnedToCore(lvgl_port_task, "LVGL task", cfg->task_stack, NULL, cfg->task_priority, &lvgl_port_ctx.lvgl_task, cfg->task_affinity);
+    }
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_FAIL, err, TAG, "Create LVGL task fail!");
+
+err:
+    if (ret != ESP_OK) {
+        lvgl_port_deinit();
+    }
+
+    return ret;
+}
+
+esp_err_t lvgl_port_resume(void)
+{
+    esp_err_t ret = ESP_ERR_INVALID_STATE;
+
+    if (lvgl_port_ctx.tick_timer != NULL) {
+        lv_timer_enable(true);
+        ret = esp_timer_start_periodic(lvgl_port_ctx.tick_timer, lvgl_port_timer_period_ms * 1000);
+    }
+
+    return ret;
+}
+
+esp_err_t lvgl_port_stop(void)
+{
+    esp_err_t ret = ESP_ERR_INVALID_STATE;
+
+    if (lvgl_port_ctx.tick_timer != NULL) {
+        lv_timer_enable(false);
+        ret = esp_timer_stop(lvgl_port_ctx.tick_timer);
+    }
+
+    return ret;
+}
+
+esp_err_t lvgl_port_deinit(void)
+{
+    /* Stop and delete timer */
+    if (lvgl_port_ctx.tick_timer != NULL) {
+        esp_timer_stop(lvgl_port_ctx.tick_timer);
+        esp_timer_delete(lvgl_port_ctx.tick_timer);
+        lvgl_port_ctx.tick_timer = NULL;
+    }
+
+    /* Stop running task */
+    if (!lvgl_port_ctx.running) {
+        lvgl_port_ctx.running = false;
+    } else {
+        lvgl_port_task_deinit();
+    }
+    lvgl_port_img_cache_deinit();
+    lvgl_port_font_cache_deinit();
+    lvgl_port_font_glyph_deinit();
+    lvgl_port_ttf_deinit();
+    lvgl_port_img_rle_deinit();
+    lvgl_port_img_assets_deinit();
+    if (lvgl_port_ctx.assets_mapped) {
+        esp_partition_munmap(lvgl_port_ctx.assets_mmap);
+        lvgl_port_ctx.assets_mapped = false;
+    }
+
+    return ESP_OK;
+}
+
+lv_disp_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg)
+{
+    esp_err_t ret = ESP_OK;
+    lv_disp_t *disp = NULL;
+    lv_color_t *buf1 = NULL;
+    lv_color_t *buf2 = NULL;
+    lv_disp_draw_buf_t *disp_buf = NULL;
+    uint32_t buffer_size = disp_cfg->buffer_size;
+    assert(disp_cfg != NULL);
+    assert(disp_cfg->io_handle != NULL);
+    assert(disp_cfg->panel_handle != NULL);
+    assert(disp_cfg->buffer_size > 0 || disp_cfg->flags.buff_strip);
+    assert(disp_cfg->hres > 0);
+    assert(disp_cfg->vres > 0);
+
+    /* Display context */
+    lvgl_port_display_ctx_t *disp_ctx = calloc(1, sizeof(lvgl_port_display_ctx_t));
+    ESP_GOTO_ON_FALSE(disp_ctx, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for display context allocation!");
+    disp_ctx->flush_done = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(disp_ctx->flush_done, ESP_ERR_NO_MEM, err, TAG, "Create flush semaphore fail!");
+    disp_ctx->io_handle = disp_cfg->io_handle;
+    disp_ctx->panel_handle = disp_cfg->panel_handle;
+    disp_ctx->rotation.swap_xy = disp_cfg->rotation.swap_xy;
+    disp_ctx->rotation.mirror_x = disp_cfg->rotation.mirror_x;
+    disp_ctx->rotation.mirror_y = disp_cfg->rotation.mirror_y;
+    portMUX_INITIALIZE(&disp_ctx->trans_lock);
+    disp_ctx->trans_cost = disp_cfg->trans_cost ? disp_cfg->trans_cost : LVGL_PORT_TRANS_COST;
+    disp_ctx->te_gpio = -1;
+
+    uint32_t buff_caps = MALLOC_CAP_DEFAULT;
+    if (disp_cfg->flags.buff_dma && disp_cfg->flags.buff_spiram) {
+        ESP_GOTO_ON_FALSE(false, ESP_ERR_NOT_SUPPORTED, err, TAG, "Alloc DMA capable buffer in SPIRAM is not supported!");
+    } else if (disp_cfg->flags.buff_dma) {
+        buff_caps = MALLOC_CAP_DMA;
+    } else if (disp_cfg->flags.buff_spiram) {
+        buff_caps = MALLOC_CAP_SPIRAM;
+    }
+
+    /* alloc draw buffers used by LVGL */
+    if (disp_cfg->flags.buff_strip) {
+        ESP_GOTO_ON_FALSE(!disp_cfg->flags.buff_spiram && !disp_cfg->monochrome, ESP_ERR_NOT_SUPPORTED, err, TAG, "Strip buffers must be in internal DMA capable memory!");
+        ESP_GOTO_ON_ERROR(lvgl_port_alloc_strips(disp_cfg, &buf1, &buf2, &buffer_size), err, TAG, "Not enough memory for LVGL strip buffers allocation!");
+    } else {
+        /* it's recommended to choose the size of the draw buffer(s) to be at least 1/10 screen sized */
+        buf1 = heap_caps_malloc(buffer_size * sizeof(lv_color_t), buff_caps);
+        ESP_GOTO_ON_FALSE(buf1, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (buf1) allocation!");
+        if (disp_cfg->double_buffer) {
+            buf2 = heap_caps_malloc(buffer_size * sizeof(lv_color_t), buff_caps);
+            ESP_GOTO_ON_FALSE(buf2, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (buf2) allocation!");
+        }
+    }
+    disp_ctx->buf_stats.buffer_lines = buffer_size / disp_cfg->hres;
+    disp_ctx->buf_stats.buffer_bytes = buffer_size * sizeof(lv_color_t) * (buf2 ? 2 : 1);
+
+    disp_buf = malloc(sizeof(lv_disp_draw_buf_t));
+    ESP_GOTO_ON_FALSE(disp_buf, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL display buffer allocation!");
+
+    /* initialize LVGL draw buffers */
+    lv_disp_draw_buf_init(disp_buf, buf1, buf2, buffer_size);
+
+    ESP_LOGD(TAG, "Register display driver to LVGL");
+    lv_disp_drv_init(&disp_ctx->disp_drv);
+    disp_ctx->disp_drv.hor_res = disp_cfg->hres;
+    disp_ctx->disp_drv.ver_res = disp_cfg->vres;
+    disp_ctx->disp_drv.flush_cb = lvgl_port_flush_callback;
+    disp_ctx->disp_drv.drv_update_cb = lvgl_port_update_callback;
+    disp_ctx->disp_drv.wait_cb = lvgl_port_wait_callback;
+    disp_ctx->disp_drv.draw_buf = disp_buf;
+    disp_ctx->disp_drv.user_data = disp_ctx;
+
+    /* Round display settings */
+    if (disp_cfg->flags.round) {
+        ESP_GOTO_ON_FALSE(!disp_cfg->monochrome, ESP_ERR_NOT_SUPPORTED, err, TAG, "Round monochromatic display is not supported!");
+        ESP_GOTO_ON_FALSE(lvgl_port_round_init(&disp_ctx->round, disp_cfg->hres, disp_cfg->vres, disp_ctx->trans_cost), ESP_ERR_NO_MEM, err, TAG, "Not enough memory for round display spans allocation!");
+        disp_ctx->round_en = true;
+        disp_ctx->disp_drv.rounder_cb = lvgl_port_rounder_callback;
+    }
+
+    if (disp_cfg->flags.swap_bytes) {
+        ESP_GOTO_ON_FALSE(LV_COLOR_DEPTH == 16 && !LV_COLOR_16_SWAP, ESP_ERR_NOT_SUPPORTED, err, TAG, "Byte swap needs native RGB565 colors (LV_COLOR_16_SWAP disabled)!");
+        disp_ctx->swap_bytes = true;
+    }
+
+    /* Changed spans settings */
+    if (disp_cfg->flags.diff) {
+        ESP_GOTO_ON_FALSE(!disp_cfg->monochrome && LV_COLOR_DEPTH == 16, ESP_ERR_NOT_SUPPORTED, err, TAG, "Diff needs RGB565 colors!");
+        ESP_GOTO_ON_FALSE(lvgl_port_diff_init(&disp_ctx->diff, disp_cfg->hres, disp_cfg->vres, LVGL_PORT_DIFF_TILE_W), ESP_ERR_NO_MEM, err, TAG, "Not enough memory for diff signatures!");
+        disp_ctx->buf_stats.diff_mem = lvgl_port_diff_mem(&disp_ctx->diff);
+        disp_ctx->diff_en = true;
+        disp_ctx->disp_drv.rounder_cb = lvgl_port_rounder_callback;
+    }
+
+#if LVGL_PORT_HANDLE_FLUSH_READY
+    /* Register done callback */
+    const esp_lcd_panel_io_callbacks_t cbs = {
+        .on_color_trans_done = lvgl_port_flush_ready_callback,
+    };
+    esp_lcd_panel_io_register_event_callbacks(disp_ctx->io_handle, &cbs, &disp_ctx->disp_drv);
+#endif
+
+    /* Monochrome display settings */
+    if (disp_cfg->monochrome) {
+        /* When using monochromatic display, there must be used full bufer! */
+        ESP_GOTO_ON_FALSE((disp_cfg->hres * disp_cfg->vres == disp_cfg->buffer_size), ESP_ERR_INVALID_ARG, err, TAG, "Monochromatic display must using full buffer!");
+
+        disp_ctx->disp_drv.full_refresh = 1;
+        disp_ctx->disp_drv.set_px_cb = lvgl_port_pix_monochrome_callback;
+    }
+
+    disp = lv_disp_drv_register(&disp_ctx->disp_drv);
+    ESP_GOTO_ON_FALSE(disp, ESP_ERR_NO_MEM, err, TAG, "Register LVGL display driver fail!");
+
+    /* Optimize the invalidated areas and pace the refresh by the LCD scan */
+    if (!disp_ctx->disp_drv.full_refresh) {
+        disp_ctx->merge_areas = disp_cfg->flags.merge_areas;
+        if (disp_cfg->flags.pacing) {
+            lvgl_port_pacing_setup(disp_ctx, disp_cfg);
+        }
+        if (disp_ctx->merge_areas || disp_ctx->pacing_en) {
+            lv_timer_set_cb(disp->refr_timer, lvgl_port_refr_timer_callback);
+        }
+    }
+
+err:
+    if (ret != ESP_OK) {
+        if (buf1) {
+            free(buf1);
+        }
+        if (buf2) {
+            free(buf2);
+        }
+        if (disp_buf) {
+            free(disp_buf);
+        }
+        if (disp_ctx) {
+            if (disp_ctx->flush_done) {
+                vSemaphoreDelete(disp_ctx->flush_done);
+            }
+            lvgl_port_round_deinit(&disp_ctx->round);
+            lvgl_port_diff_deinit(&disp_ctx->diff);
+            free(disp_ctx);
+        }
+    }
+
+    return disp;
+}
+
+esp_err_t lvgl_port_remove_disp(lv_disp_t *disp)
+{
+    assert(disp);
+    lv_disp_drv_t *disp_drv = disp->driver;
+    assert(disp_drv);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp_drv->user_data;
+
+    if (disp_ctx->te_gpio >= 0) {
+        gpio_isr_handler_remove(disp_ctx->te_gpio);
+    }
+
+    lv_disp_remove(disp);
+
+    if (disp_drv) {
+        if (disp_drv->draw_buf && disp_drv->draw_buf->buf1) {
+            free(disp_drv->draw_buf->buf1);
+            disp_drv->draw_buf->buf1 = NULL;
+        }
+        if (disp_drv->draw_buf && disp_drv->draw_buf->buf2) {
+            free(disp_drv->draw_buf->buf2);
+            disp_drv->draw_buf->buf2 = NULL;
+        }
+        if (disp_drv->draw_buf) {
+            free(disp_drv->draw_buf);
+            disp_drv->draw_buf = NULL;
+        }
+    }
+
+    if (disp_ctx->flush_done) {
+        vSemaphoreDelete(disp_ctx->flush_done);
+    }
+    lvgl_port_round_deinit(&disp_ctx->round);
+    lvgl_port_diff_deinit(&disp_ctx->diff);
+    free(disp_ctx);
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_set_diff(lv_disp_t *disp, bool enable)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(disp && disp->driver, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp->driver->user_data;
+    assert(disp_ctx != NULL);
+    ESP_RETURN_ON_FALSE(LV_COLOR_DEPTH == 16 && !disp_ctx->disp_drv.set_px_cb, ESP_ERR_NOT_SUPPORTED, TAG, "Diff needs RGB565 colors!");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_set_diff);
+    if (enable) {
+        if (disp_ctx->diff.hash == NULL) {
+            ESP_GOTO_ON_FALSE(lvgl_port_diff_init(&disp_ctx->diff, disp_ctx->disp_drv.hor_res, disp_ctx->disp_drv.ver_res, LVGL_PORT_DIFF_TILE_W),
+                              ESP_ERR_NO_MEM, err, TAG, "Not enough memory for diff signatures!");
+            disp_ctx->buf_stats.diff_mem = lvgl_port_diff_mem(&disp_ctx->diff);
+        }
+        /* Content of the LCD is unknown after the diff was disabled */
+        lvgl_port_diff_reset(&disp_ctx->diff);
+        disp_ctx->disp_drv.rounder_cb = lvgl_port_rounder_callback;
+    }
+    disp_ctx->diff_en = enable;
+
+err:
+    lvgl_port_unlock();
+    return ret;
+}
+
+esp_err_t lvgl_port_get_buffer_stats(lv_disp_t *disp, lvgl_port_buffer_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(disp && disp->driver && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp->driver->user_data;
+    assert(disp_ctx != NULL);
+
+    *stats = disp_ctx->buf_stats;
+    if (stats->transfer_us > stats->wait_us) {
+        stats->overlap_pct = (stats->transfer_us - stats->wait_us) * 100 / stats->transfer_us;
+    } else {
+        stats->overlap_pct = 0;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_get_pacing_stats(lv_disp_t *disp, lvgl_port_pacing_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(disp && disp->driver && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp->driver->user_data;
+    assert(disp_ctx != NULL);
+    ESP_RETURN_ON_FALSE(disp_ctx->pacing_en, ESP_ERR_INVALID_STATE, TAG, "Frame pacing is not enabled!");
+
+    portENTER_CRITICAL(&disp_ctx->pacing_lock);
+    stats->frames = disp_ctx->pacing.frames;
+    stats->dropped = disp_ctx->pacing.dropped;
+    stats->wasted = disp_ctx->pacing.wasted;
+    stats->te_count = disp_ctx->pacing.te_count;
+    stats->scan_period_us = disp_ctx->pacing.scan_us;
+    stats->lead_us = disp_ctx->pacing.lead_us;
+    portEXIT_CRITICAL(&disp_ctx->pacing_lock);
+    stats->refr_period_ms = disp->refr_timer ? disp->refr_timer->period : 0;
+
+    return ESP_OK;
+}
+
+void lvgl_port_reset_buffer_stats(lv_disp_t *disp)
+{
+    assert(disp && disp->driver);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp->driver->user_data;
+    assert(disp_ctx != NULL);
+
+    disp_ctx->buf_stats.flush_count = 0;
+    disp_ctx->buf_stats.transfer_us = 0;
+    disp_ctx->buf_stats.wait_us = 0;
+    disp_ctx->buf_stats.frame_count = 0;
+    disp_ctx->buf_stats.trans_count = 0;
+    disp_ctx->buf_stats.bytes_sent = 0;
+    disp_ctx->buf_stats.bytes_saved = 0;
+    disp_ctx->buf_stats.frame_saved = 0;
+    disp_ctx->buf_stats.frame_trans = 0;
+    disp_ctx->buf_stats.frame_bytes = 0;
+    disp_ctx->buf_stats.areas_invalidated = 0;
+    disp_ctx->buf_stats.areas_refreshed = 0;
+    disp_ctx->buf_stats.diff_saved = 0;
+    disp_ctx->buf_stats.frame_diff_saved = 0;
+}
+
+esp_err_t lvgl_port_get_task_stats(lvgl_port_task_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    *stats = lvgl_port_ctx.task_stats;
+    const int64_t elapsed = esp_timer_get_time() - lvgl_port_ctx.stats_start;
+    stats->wakeups_per_sec = (elapsed > 0) ? (uint64_t)stats->wakeups * 1000000 / elapsed : 0;
+    stats->input_latency_avg_us = stats->input_events ? lvgl_port_ctx.input_latency_sum / stats->input_events : 0;
+    stats->commands_dropped = lvgl_port_ctx.cmd_queue.dropped - lvgl_port_ctx.cmd_dropped_base;
+
+    return ESP_OK;
+}
+
+void lvgl_port_reset_task_stats(void)
+{
+    memset(&lvgl_port_ctx.task_stats, 0, sizeof(lvgl_port_task_stats_t));
+    lvgl_port_ctx.input_latency_sum = 0;
+    lvgl_port_ctx.cmd_dropped_base = lvgl_port_ctx.cmd_queue.dropped;
+    lvgl_port_ctx.stats_start = esp_timer_get_time();
+}
+
+esp_err_t lvgl_port_get_lock_stats(lvgl_port_lock_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    portENTER_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+    *stats = lvgl_port_ctx.lock_stats;
+    portEXIT_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+
+    return ESP_OK;
+}
+
+void lvgl_port_reset_lock_stats(void)
+{
+    portENTER_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+    memset(&lvgl_port_ctx.lock_stats, 0, sizeof(lvgl_port_lock_stats_t));
+    portEXIT_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+}
+
+esp_err_t lvgl_port_add_rle_decoder(size_t cache_size)
+{
+    esp_err_t ret = ESP_OK;
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_add_rle_decoder);
+    ESP_GOTO_ON_FALSE(lvgl_port_img_rle_init(cache_size), ESP_ERR_NO_MEM, err, TAG, "Not enough memory for RLE decoder!");
+
+err:
+    lvgl_port_unlock();
+    return ret;
+}
+
+esp_err_t lvgl_port_add_assets(const char *partition_label)
+{
+    esp_err_t ret = ESP_OK;
+    uint32_t header[LVGL_PORT_ASSETS_HEADER_SIZE / sizeof(uint32_t)];
+    const void *data = NULL;
+    esp_partition_mmap_handle_t mmap_handle;
+    ESP_RETURN_ON_FALSE(partition_label, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!lvgl_port_ctx.assets_mapped, ESP_ERR_INVALID_STATE, TAG, "Assets are added already!");
+
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, partition_label);
+    ESP_RETURN_ON_FALSE(part, ESP_ERR_NOT_FOUND, TAG, "Partition %s not found!", partition_label);
+
+    /* Only the bundle is mapped, the rest of the partition may be empty */
+    ESP_RETURN_ON_ERROR(esp_partition_read(part, 0, header, sizeof(header)), TAG, "Reading partition %s failed!", partition_label);
+    const uint32_t size = header[2];
+    ESP_RETURN_ON_FALSE(header[0] == LVGL_PORT_ASSETS_MAGIC && size >= sizeof(header) && size <= part->size, ESP_ERR_INVALID_STATE, TAG,
+                        "No assets in partition %s, flash them with 'idf.py %s-flash'!", partition_label, partition_label);
+    ESP_RETURN_ON_ERROR(esp_partition_mmap(part, 0, size, ESP_PARTITION_MMAP_DATA, &data, &mmap_handle), TAG, "Mapping partition %s failed!", partition_label);
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_add_assets);
+    ESP_GOTO_ON_FALSE(lvgl_port_img_assets_init(data, size), ESP_ERR_INVALID_STATE, err, TAG, "Invalid asset table in partition %s!", partition_label);
+    lvgl_port_ctx.assets_mmap = mmap_handle;
+    lvgl_port_ctx.assets_mapped = true;
+    ESP_LOGI(TAG, "%"PRIu32" assets mapped from partition %s (%"PRIu32" bytes)", lvgl_port_img_assets_count(), partition_label, size);
+
+err:
+    lvgl_port_unlock();
+    if (ret != ESP_OK) {
+        esp_partition_munmap(mmap_handle);
+    }
+    return ret;
+}
+
+esp_err_t lvgl_port_get_rle_stats(lvgl_port_rle_stats_t *stats)
+{
+    lvgl_port_img_rle_stats_t rle;
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_img_rle_get_stats(&rle);
+    stats->opened = rle.opened;
+    stats->lines = rle.lines;
+    stats->px_decoded = rle.px_decoded;
+    stats->cache_hits = rle.cache_hits;
+    stats->cache_misses = rle.cache_misses;
+    stats->cache_size = rle.cache_size;
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_add_img_cache(lv_disp_t *disp, size_t budget)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_add_img_cache);
+    ESP_GOTO_ON_FALSE(lvgl_port_img_cache_init(disp, budget), ESP_ERR_NOT_SUPPORTED, err, TAG, "Image cache needs the software renderer in native RGB565!");
+
+err:
+    lvgl_port_unlock();
+    return ret;
+}
+
+esp_err_t lvgl_port_set_img_cache_layer(const char *layer)
+{
+    lvgl_port_lock_from(0, (const void *)lvgl_port_set_img_cache_layer);
+    lvgl_port_img_cache_set_layer(layer);
+    lvgl_port_unlock();
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_pin_img(const void *src, bool pin)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(src, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_pin_img);
+    ESP_GOTO_ON_FALSE(lvgl_port_img_cache_pin(src, pin), ESP_ERR_NO_MEM, err, TAG, "Too many pinned images!");
+
+err:
+    lvgl_port_unlock();
+    return ret;
+}
+
+esp_err_t lvgl_port_get_img_cache_stats(const char *layer, lvgl_port_img_cache_stats_t *stats)
+{
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    lvgl_port_cache_layer_t counters;
+    const char *name;
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_get_img_cache_stats);
+    for (uint8_t i = 0; lvgl_port_img_cache_get_stats(i, &name, &counters); i++) {
+        if ((layer == NULL && name == NULL) || (layer && name && strcmp(layer, name) == 0)) {
+            stats->hits = counters.hits;
+            stats->misses = counters.misses;
+            stats->evictions = counters.evictions;
+            stats->entries = counters.entries;
+            stats->bytes = counters.bytes;
+            ret = ESP_OK;
+            break;
+        }
+    }
+    lvgl_port_unlock();
+
+    return ret;
+}
+
+esp_err_t lvgl_port_create_img_steps(const void *src, uint16_t zoom_min, uint16_t zoom_max, bool mask, lv_img_dsc_t *steps, uint8_t count)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(src && steps && count && zoom_min && zoom_min <= zoom_max, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_create_img_steps);
+    ESP_GOTO_ON_FALSE(lvgl_port_img_steps_create(src, zoom_min, zoom_max, mask, steps, count), ESP_ERR_NO_MEM, err, TAG, "Image steps can't be rendered!");
+
+err:
+    lvgl_port_unlock();
+    return ret;
+}
+
+void lvgl_port_delete_img_steps(lv_img_dsc_t *steps, uint8_t count)
+{
+    if (steps) {
+        lvgl_port_lock_from(0, (const void *)lvgl_port_delete_img_steps);
+        lvgl_port_img_steps_delete(steps, count);
+        lvgl_port_unlock();
+    }
+}
+
+esp_err_t lvgl_port_add_font_cache(size_t budget)
+{
+    lvgl_port_lock_from(0, (const void *)lvgl_port_add_font_cache);
+    lvgl_port_font_cache_init(budget);
+    lvgl_port_unlock();
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_get_font_cache_stats(lvgl_port_font_cache_stats_t *stats)
+{
+    lvgl_port_cache_layer_t counters;
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_get_font_cache_stats);
+    lvgl_port_font_cache_get_stats(&counters);
+    lvgl_port_unlock();
+    stats->hits = counters.hits;
+    stats->misses = counters.misses;
+    stats->evictions = counters.evictions;
+    stats->glyphs = counters.entries;
+    stats->bytes = counters.bytes;
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_add_glyph_cache(lv_disp_t *disp, size_t budget)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_add_glyph_cache);
+    ESP_GOTO_ON_FALSE(lvgl_port_font_glyph_init(disp, budget), ESP_ERR_NOT_SUPPORTED, err, TAG, "Glyph cache needs the software renderer!");
+
+err:
+    lvgl_port_unlock();
+    return ret;
+}
+
+esp_err_t lvgl_port_get_glyph_cache_stats(lvgl_port_font_cache_stats_t *stats)
+{
+    lvgl_port_cache_layer_t counters;
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_get_glyph_cache_stats);
+    lvgl_port_font_glyph_get_stats(&counters);
+    lvgl_port_unlock();
+    stats->hits = counters.hits;
+    stats->misses = counters.misses;
+    stats->evictions = counters.evictions;
+    stats->glyphs = counters.entries;
+    stats->bytes = counters.bytes;
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_add_ttf_cache(size_t budget)
+{
+    lvgl_port_lock_from(0, (const void *)lvgl_port_add_ttf_cache);
+    lvgl_port_ttf_init(budget);
+    lvgl_port_unlock();
+
+    return ESP_OK;
+}
+
+const lv_font_t *lvgl_port_get_ttf_font(const char *family, uint16_t px)
+{
+    const lv_font_t *font = NULL;
+    ESP_RETURN_ON_FALSE(family && px, NULL, TAG, "invalid argument");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_get_ttf_font);
+    font = lvgl_port_ttf_get(family, px);
+    lvgl_port_unlock();
+    ESP_RETURN_ON_FALSE(font, NULL, TAG, "No font %s in the assets or no TTF cache added!", family);
+
+    return font;
+}
+
+esp_err_t lvgl_port_prewarm_ttf_font(const lv_font_t *font, const char *text)
+{
+    int count;
+    ESP_RETURN_ON_FALSE(font && text, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_prewarm_ttf_font);
+    count = lvgl_port_ttf_prewarm(font, text);
+    lvgl_port_unlock();
+    ESP_RETURN_ON_FALSE(count >= 0, ESP_ERR_INVALID_ARG, TAG, "Not a font of lvgl_port_get_ttf_font()!");
+    ESP_LOGD(TAG, "%d glyphs rasterized ahead", count);
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_get_ttf_cache_stats(lvgl_port_font_cache_stats_t *stats)
+{
+    lvgl_port_cache_layer_t counters;
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_get_ttf_cache_stats);
+    lvgl_port_ttf_get_stats(&counters);
+    lvgl_port_unlock();
+    stats->hits = counters.hits;
+    stats->misses = counters.misses;
+    stats->evictions = counters.evictions;
+    stats->glyphs = counters.entries;
+    stats->bytes = counters.bytes;
+
+    return ESP_OK;
+}
+
+lv_obj_t *lvgl_port_create_sprite(lv_obj_t *parent, const lvgl_port_sprite_t *sprite)
+{
+    lv_obj_t *obj = NULL;
+    ESP_RETURN_ON_FALSE(parent && sprite, NULL, TAG, "invalid argument");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_create_sprite);
+    obj = lvgl_port_sprite_obj_create(parent, sprite);
+    lvgl_port_unlock();
+    ESP_RETURN_ON_FALSE(obj, NULL, TAG, "Invalid sprite!");
+
+    return obj;
+}
+
+esp_err_t lvgl_port_play_sprite(lv_obj_t *sprite, const char *anim)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(sprite && anim, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_play_sprite);
+    ESP_GOTO_ON_FALSE(lvgl_port_sprite_obj_play(sprite, anim), ESP_ERR_NOT_FOUND, err, TAG, "No animation %s!", anim);
+
+err:
+    lvgl_port_unlock();
+    return ret;
+}
+
+esp_err_t lvgl_port_set_sprite_frame(lv_obj_t *sprite, const char *frame)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(sprite && frame, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_set_sprite_frame);
+    ESP_GOTO_ON_FALSE(lvgl_port_sprite_obj_set_frame(sprite, frame), ESP_ERR_NOT_FOUND, err, TAG, "No frame %s!", frame);
+
+err:
+    lvgl_port_unlock();
+    return ret;
+}
+
+const char *lvgl_port_get_sprite_frame(lv_obj_t *sprite)
+{
+    const char *frame;
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_get_sprite_frame);
+    frame = lvgl_port_sprite_obj_get_frame(sprite);
+    lvgl_port_unlock();
+
+    return frame;
+}
+
+lv_obj_t *lvgl_port_create_scroll(lv_obj_t *parent, const void *src)
+{
+    lv_obj_t *obj = NULL;
+    ESP_RETURN_ON_FALSE(parent && src, NULL, TAG, "invalid argument");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_create_scroll);
+    obj = lvgl_port_scroll_obj_create(parent, src);
+    lvgl_port_unlock();
+    ESP_RETURN_ON_FALSE(obj, NULL, TAG, "Invalid texture!");
+
+    return obj;
+}
+
+esp_err_t lvgl_port_set_scroll_offset(lv_obj_t *scroll, lv_coord_t x)
+{
+    esp_err_t ret = ESP_OK;
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_set_scroll_offset);
+    ESP_GOTO_ON_FALSE(lvgl_port_scroll_obj_set_offset(scroll, x), ESP_ERR_INVALID_ARG, err, TAG, "No scroll object!");
+
+err:
+    lvgl_port_unlock();
+    return ret;
+}
+
+esp_err_t lvgl_port_add_clip_radius(lv_obj_t *obj, const lv_obj_t *box, lv_coord_t radius)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(obj && radius >= 0, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_add_clip_radius);
+    ESP_GOTO_ON_FALSE(lvgl_port_clip_obj_add_radius(obj, box, radius), ESP_ERR_NO_MEM, err, TAG, "Not enough memory for the clip!");
+
+err:
+    lvgl_port_unlock();
+    return ret;
+}
+
+esp_err_t lvgl_port_add_clip_fade(lv_obj_t *obj, lv_coord_t top, lv_coord_t bottom)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(obj && top >= 0 && bottom >= 0, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_add_clip_fade);
+    ESP_GOTO_ON_FALSE(lvgl_port_clip_obj_add_fade(obj, top, bottom), ESP_ERR_NO_MEM, err, TAG, "Not enough memory for the clip!");
+
+err:
+    lvgl_port_unlock();
+    return ret;
+}
+
+esp_err_t lvgl_port_add_roller_band(lv_obj_t *roller)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(roller, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_add_roller_band);
+    ESP_GOTO_ON_FALSE(lv_obj_check_type(roller, &lv_roller_class), ESP_ERR_INVALID_ARG, err, TAG, "No roller object!");
+    ESP_GOTO_ON_FALSE(lvgl_port_roller_obj_add_band(roller), ESP_ERR_NO_MEM, err, TAG, "Not enough memory for the roller bands!");
+
+err:
+    lvgl_port_unlock();
+    return ret;
+}
+
+esp_err_t lvgl_port_get_frame_stats(lvgl_port_frame_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_percentiles_t *pct[LVGL_PORT_STATS_METRICS] = {
+        [LVGL_PORT_STATS_RENDER_US] = &stats->render_us,
+        [LVGL_PORT_STATS_FLUSH_US] = &stats->flush_us,
+        [LVGL_PORT_STATS_BYTES] = &stats->bytes,
+        [LVGL_PORT_STATS_AREAS] = &stats->areas,
+        [LVGL_PORT_STATS_LOCK_WAIT_US] = &stats->lock_wait_us,
+        [LVGL_PORT_STATS_HANDLER_US] = &stats->handler_us,
+    };
+    uint32_t values[LVGL_PORT_STATS_WINDOW];
+    lvgl_port_stats_pct_t res;
+
+    /* Copy one metric at a time, the percentiles are computed outside of the critical section */
+    for (int m = 0; m < LVGL_PORT_STATS_METRICS; m++) {
+        portENTER_CRITICAL(&lvgl_port_ctx.frame_lock);
+        const size_t count = lvgl_port_stats_copy(&lvgl_port_ctx.frame_stats, (lvgl_port_stats_metric_t)m, values);
+        stats->frames = lvgl_port_ctx.frame_stats.frames;
+        portEXIT_CRITICAL(&lvgl_port_ctx.frame_lock);
+
+        lvgl_port_stats_percentiles(values, count, &res);
+        stats->samples = count;
+        pct[m]->p50 = res.p50;
+        pct[m]->p95 = res.p95;
+        pct[m]->p99 = res.p99;
+        pct[m]->max = res.max;
+    }
+
+    return ESP_OK;
+}
+
+void lvgl_port_reset_frame_stats(void)
+{
+    portENTER_CRITICAL(&lvgl_port_ctx.frame_lock);
+    lvgl_port_stats_init(&lvgl_port_ctx.frame_stats);
+    portEXIT_CRITICAL(&lvgl_port_ctx.frame_lock);
+    lvgl_port_ctx.overlay_frames = 0;
+}
+
+esp_err_t lvgl_port_stats_overlay(lv_disp_t *disp, bool enable)
+{
+    esp_err_t ret = ESP_OK;
+    lv_obj_t *label = NULL;
+    ESP_RETURN_ON_FALSE(disp && disp->driver, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp->driver->user_data;
+    assert(disp_ctx != NULL);
+
+    lvgl_port_lock_from(0, (const void *)lvgl_port_stats_overlay);
+    if (!enable) {
+        if (lvgl_port_ctx.overlay_timer) {
+            lv_obj_del(lvgl_port_ctx.overlay_timer->user_data);
+            lv_timer_del(lvgl_port_ctx.overlay_timer);
+            lvgl_port_ctx.overlay_timer = NULL;
+        }
+    } else if (lvgl_port_ctx.overlay_timer == NULL) {
+        label = lv_label_create(lv_disp_get_layer_sys(disp));
+        ESP_GOTO_ON_FALSE(label, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for overlay!");
+        lv_obj_set_style_text_font(label, LVGL_PORT_OVERLAY_FONT, 0);
+        lv_obj_set_style_text_color(label, lv_color_white(), 0);
+        lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
+        lv_obj_set_style_bg_color(label, lv_color_black(), 0);
+        lv_obj_set_style_bg_opa(label, LV_OPA_60, 0);
+        lv_obj_set_style_radius(label, 6, 0);
+        lv_obj_set_style_pad_hor(label, 6, 0);
+        lv_obj_set_style_pad_ver(label, 2, 0);
+        /* Corners of the overlay must stay inside of the circle on round display */
+        lv_obj_align(label, LV_ALIGN_BOTTOM_MID, 0, disp_ctx->round_en ? -(lv_disp_get_ver_res(disp) / 8) : -2);
+
+        lvgl_port_ctx.overlay_timer = lv_timer_create(lvgl_port_overlay_update, LVGL_PORT_OVERLAY_PERIOD_MS, label);
+        ESP_GOTO_ON_FALSE(lvgl_port_ctx.overlay_timer, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for overlay timer!");
+        lvgl_port_overlay_update(lvgl_port_ctx.overlay_timer);
+    }
+
+err:
+    if (ret != ESP_OK && label) {
+        lv_obj_del(label);
+    }
+    lvgl_port_unlock();
+    return ret;
+}
+
+#ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
+lv_indev_t *lvgl_port_add_touch(const lvgl_port_touch_cfg_t *touch_cfg)
+{
+    assert(touch_cfg != NULL);
+    assert(touch_cfg->disp != NULL);
+    assert(touch_cfg->handle != NULL);
+
+    /* Touch context */
+    lvgl_port_touch_ctx_t *touch_ctx = malloc(sizeof(lvgl_port_touch_ctx_t));
+    if (touch_ctx == NULL) {
+        ESP_LOGE(TAG, "Not enough memory for touch context allocation!");
+        return NULL;
+    }
+    touch_ctx->handle = touch_cfg->handle;
+
+    /* Register a touchpad input device */
+    lv_indev_drv_init(&touch_ctx->indev_drv);
+    touch_ctx->indev_drv.type = LV_INDEV_TYPE_POINTER;
+    touch_ctx->indev_drv.disp = touch_cfg->disp;
+    touch_ctx->indev_drv.read_cb = lvgl_port_touchpad_read;
+    touch_ctx->indev_drv.user_data = touch_ctx;
+    return lv_indev_drv_register(&touch_ctx->indev_drv);
+}
+
+esp_err_t lvgl_port_remove_touch(lv_indev_t *touch)
+{
+    assert(touch);
+    lv_indev_drv_t *indev_drv = touch->driver;
+    assert(indev_drv);
+    lvgl_port_touch_ctx_t *touch_ctx = (lvgl_port_touch_ctx_t *)indev_drv->user_data;
+
+    /* Remove input device driver */
+    lv_indev_delete(touch);
+
+    if (touch_ctx) {
+        free(touch_ctx);
+    }
+
+    return ESP_OK;
+}
+#endif
+
+#ifdef ESP_LVGL_PORT_KNOB_COMPONENT
+lv_indev_t *lvgl_port_add_encoder(const lvgl_port_encoder_cfg_t *encoder_cfg)
+{
+    esp_err_t ret = ESP_OK;
+    lv_indev_t *indev = NULL;
+    assert(encoder_cfg != NULL);
+    assert(encoder_cfg->disp != NULL);
+
+    /* Encoder context */
+    lvgl_port_encoder_ctx_t *encoder_ctx = malloc(sizeof(lvgl_port_encoder_ctx_t));
+    if (encoder_ctx == NULL) {
+        ESP_LOGE(TAG, "Not enough memory for encoder context allocation!");
+        return NULL;
+    }
+
+    /* Encoder_a/b */
+    if (encoder_cfg->encoder_a_b != NULL) {
+        encoder_ctx->knob_handle = iot_knob_create(encoder_cfg->encoder_a_b);
+        ESP_GOTO_ON_FALSE(encoder_ctx->knob_handle, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for knob create!");
+    }
+
+    /* Encoder Enter */
+    if (encoder_cfg->encoder_enter != NULL) {
+        encoder_ctx->btn_handle = iot_button_create(encoder_cfg->encoder_enter);
+        ESP_GOTO_ON_FALSE(encoder_ctx->btn_handle, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for button create!");
+    }
+
+    ESP_ERROR_CHECK(iot_button_register_cb(encoder_ctx->btn_handle, BUTTON_PRESS_DOWN, lvgl_port_encoder_btn_down_handler, encoder_ctx));
+    ESP_ERROR_CHECK(iot_button_register_cb(encoder_ctx->btn_handle, BUTTON_PRESS_UP, lvgl_port_encoder_btn_up_handler, encoder_ctx));
+    if (encoder_ctx->knob_handle != NULL) {
+        ESP_ERROR_CHECK(iot_knob_register_cb(encoder_ctx->knob_handle, KNOB_LEFT, lvgl_port_encoder_knob_handler, encoder_ctx));
+        ESP_ERROR_CHECK(iot_knob_register_cb(encoder_ctx->knob_handle, KNOB_RIGHT, lvgl_port_encoder_knob_handler, encoder_ctx));
+    }
+
+    encoder_ctx->btn_enter = false;
+
+    /* Register a encoder input device */
+    lv_indev_drv_init(&encoder_ctx->indev_drv);
+    encoder_ctx->indev_drv.type = LV_INDEV_TYPE_ENCODER;
+    encoder_ctx->indev_drv.disp = encoder_cfg->disp;
+    encoder_ctx->indev_drv.read_cb = lvgl_port_encoder_read;
+    encoder_ctx->indev_drv.user_data = encoder_ctx;
+    indev = lv_indev_drv_register(&encoder_ctx->indev_drv);
+
+err:
+    if (ret != ESP_OK) {
+        if (encoder_ctx->knob_handle != NULL) {
+            iot_knob_delete(encoder_ctx->knob_handle);
+        }
+
+        if (encoder_ctx->btn_handle != NULL) {
+            iot_button_delete(encoder_ctx->btn_handle);
+        }
+
+        if (encoder_ctx != NULL) {
+            free(encoder_ctx);
+        }
+    }
+    return indev;
+}
+
+esp_err_t lvgl_port_remove_encoder(lv_indev_t *encoder)
+{
+    assert(encoder);
+    lv_indev_drv_t *indev_drv = encoder->driver;
+    assert(indev_drv);
+    lvgl_port_encoder_ctx_t *encoder_ctx = (lvgl_port_encoder_ctx_t *)indev_drv->user_data;
+
+    if (encoder_ctx->knob_handle != NULL) {
+        iot_knob_delete(encoder_ctx->knob_handle);
+    }
+
+    if (encoder_ctx->btn_handle != NULL) {
+        iot_button_delete(encoder_ctx->btn_handle);
+    }
+
+    if (encoder_ctx != NULL) {
+        free(encoder_ctx);
+    }
+
+    return ESP_OK;
+}
+#endif
+
+#ifdef ESP_LVGL_PORT_BUTTON_COMPONENT
+lv_indev_t *lvgl_port_add_navigation_buttons(const lvgl_port_nav_btns_cfg_t *buttons_cfg)
+{
+    esp_err_t ret = ESP_OK;
+    lv_indev_t *indev = NULL;
+    assert(buttons_cfg != NULL);
+    assert(buttons_cfg->disp != NULL);
+
+    /* Touch context */
+    lvgl_port_nav_btns_ctx_t *buttons_ctx = malloc(sizeof(lvgl_port_nav_btns_ctx_t));
+    if (buttons_ctx == NULL) {
+        ESP_LOGE(TAG, "Not enough memory for buttons context allocation!");
+        return NULL;
+    }
+
+    /* Previous button */
+    if (buttons_cfg->button_prev != NULL) {
+        buttons_ctx->btn[LVGL_PORT_NAV_BTN_PREV] = iot_button_create(buttons_cfg->button_prev);
+        ESP_GOTO_ON_FALSE(buttons_ctx->btn[LVGL_PORT_NAV_BTN_PREV], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for button create!");
+    }
+
+    /* Next button */
+    if (buttons_cfg->button_next != NULL) {
+        buttons_ctx->btn[LVGL_PORT_NAV_BTN_NEXT] = iot_button_create(buttons_cfg->button_next);
+        ESP_GOTO_ON_FALSE(buttons_ctx->btn[LVGL_PORT_NAV_BTN_NEXT], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for button create!");
+    }
+
+    /* Enter button */
+    if (buttons_cfg->button_enter != NULL) {
+        buttons_ctx->btn[LVGL_PORT_NAV_BTN_ENTER] = iot_button_create(buttons_cfg->button_enter);
+        ESP_GOTO_ON_FALSE(buttons_ctx->btn[LVGL_PORT_NAV_BTN_ENTER], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for button create!");
+    }
+
+    /* Button handlers */
+    for (int i = 0; i < LVGL_PORT_NAV_BTN_CNT; i++) {
+        ESP_ERROR_CHECK(iot_button_register_cb(buttons_ctx->btn[i], BUTTON_PRESS_DOWN, lvgl_port_btn_down_handler, buttons_ctx));
+        ESP_ERROR_CHECK(iot_button_register_cb(buttons_ctx->btn[i], BUTTON_PRESS_UP, lvgl_port_btn_up_handler, buttons_ctx));
+    }
+
+    buttons_ctx->btn_prev = false;
+    buttons_ctx->btn_next = false;
+    buttons_ctx->btn_enter = false;
+
+    /* Register a touchpad input device */
+    lv_indev_drv_init(&buttons_ctx->indev_drv);
+    buttons_ctx->indev_drv.type = LV_INDEV_TYPE_ENCODER;
+    buttons_ctx->indev_drv.disp = buttons_cfg->disp;
+    buttons_ctx->indev_drv.read_cb = lvgl_port_navigation_buttons_read;
+    buttons_ctx->indev_drv.user_data = buttons_ctx;
+    buttons_ctx->indev_drv.long_press_repeat_time = 300;
+    indev = lv_indev_drv_register(&buttons_ctx->indev_drv);
+
+err:
+    if (ret != ESP_OK) {
+        for (int i = 0; i < LVGL_PORT_NAV_BTN_CNT; i++) {
+            if (buttons_ctx->btn[i] != NULL) {
+                iot_button_delete(buttons_ctx->btn[i]);
+            }
+        }
+
+        if (buttons_ctx != NULL) {
+            free(buttons_ctx);
+        }
+    }
+
+    return indev;
+}
+
+esp_err_t lvgl_port_remove_navigation_buttons(lv_indev_t *buttons)
+{
+    assert(buttons);
+    lv_indev_drv_t *indev_drv = buttons->driver;
+    assert(indev_drv);
+    lvgl_port_nav_btns_ctx_t *buttons_ctx = (lvgl_port_nav_btns_ctx_t *)indev_drv->user_data;
+
+    /* Remove input device driver */
+    lv_indev_delete(buttons);
+
+    if (buttons_ctx) {
+        free(buttons_ctx);
+    }
+
+    return ESP_OK;
+}
+#endif
+
+#ifdef ESP_LVGL_PORT_USB_HOST_HID_COMPONENT
+lv_indev_t *lvgl_port_add_usb_hid_mouse_input(const lvgl_port_hid_mouse_cfg_t *mouse_cfg)
+{
+    lv_indev_t *indev;
+    assert(mouse_cfg);
+    assert(mouse_cfg->disp);
+    assert(mouse_cfg->disp->driver);
+
+    /* Initialize USB HID */
+    lvgl_port_usb_hid_ctx_t *hid_ctx = lvgl_port_hid_init();
+    if (hid_ctx == NULL) {
+        return NULL;
+    }
+
+    /* Mouse sensitivity cannot be zero */
+    hid_ctx->mouse.sensitivity = (mouse_cfg->sensitivity == 0 ? 1 : mouse_cfg->sensitivity);
+    /* Default coordinates to screen center */
+    hid_ctx->mouse.x = (mouse_cfg->disp->driver->hor_res * hid_ctx->mouse.sensitivity) / 2;
+    hid_ctx->mouse.y = (mouse_cfg->disp->driver->ver_res * hid_ctx->mouse.sensitivity) / 2;
+
+    /* Register a mouse input device */
+    lv_indev_drv_init(&hid_ctx->mouse.drv);
+    hid_ctx->mouse.drv.type = LV_INDEV_TYPE_POINTER;
+    hid_ctx->mouse.drv.disp = mouse_cfg->disp;
+    hid_ctx->mouse.drv.read_cb = lvgl_port_usb_hid_read_mouse;
+    hid_ctx->mouse.drv.user_data = hid_ctx;
+    indev = lv_indev_drv_register(&hid_ctx->mouse.drv);
+
+    /* Set image of cursor */
+    lv_obj_t *cursor = mouse_cfg->cursor_img;
+    if (cursor == NULL) {
+        cursor = lv_img_create(lv_scr_act());
+        lv_img_set_src(cursor, &img_cursor);
+    }
+    lv_indev_set_cursor(indev, cursor);
+
+    return indev;
+}
+
+lv_indev_t *lvgl_port_add_usb_hid_keyboard_input(const lvgl_port_hid_keyboard_cfg_t *keyboard_cfg)
+{
+    lv_indev_t *indev;
+    assert(keyboard_cfg);
+    assert(keyboard_cfg->disp);
+
+    /* Initialize USB HID */
+    lvgl_port_usb_hid_ctx_t *hid_ctx = lvgl_port_hid_init();
+    if (hid_ctx == NULL) {
+        return NULL;
+    }
+
+    /* Register a keyboard input device */
+    lv_indev_drv_init(&hid_ctx->kb.drv);
+    hid_ctx->kb.drv.type = LV_INDEV_TYPE_KEYPAD;
+    hid_ctx->kb.drv.disp = keyboard_cfg->disp;
+    hid_ctx->kb.drv.read_cb = lvgl_port_usb_hid_read_kb;
+    hid_ctx->kb.drv.user_data = hid_ctx;
+    indev = lv_indev_drv_register(&hid_ctx->kb.drv);
+
+    return indev;
+}
+
+esp_err_t lvgl_port_remove_usb_hid_input(lv_indev_t *hid)
+{
+    assert(hid);
+    lv_indev_drv_t *indev_drv = hid->driver;
+    assert(indev_drv);
+    lvgl_port_usb_hid_ctx_t *hid_ctx = (lvgl_port_usb_hid_ctx_t *)indev_drv->user_data;
+
+    /* Remove input device driver */
+    lv_indev_delete(hid);
+
+    /* If all hid input devices are removed, stop task and clean all */
+    if (lvgl_port_ctx.hid_ctx.mouse.drv.disp == NULL && lvgl_port_ctx.hid_ctx.kb.drv.disp) {
+        hid_ctx->running = false;
+    }
+
+    return ESP_OK;
+}
+#endif
+
+/* Entry of the call site in the lock statistics, called in the lock_stats_lock critical section */
+static lvgl_port_lock_site_stats_t *lvgl_port_lock_site(const void *caller, bool add)
+{
+    lvgl_port_lock_stats_t *stats = &lvgl_port_ctx.lock_stats;
+
+    for (uint32_t i = 0; i < stats->sites; i++) {
+        if (stats->site[i].caller == caller) {
+            return &stats->site[i];
+        }
+    }
+    if (!add) {
+        return NULL;
+    }
+    if (stats->sites == LVGL_PORT_LOCK_SITES) {
+        stats->untracked++;
+        return NULL;
+    }
+
+    lvgl_port_lock_site_stats_t *site = &stats->site[stats->sites++];
+    memset(site, 0, sizeof(lvgl_port_lock_site_stats_t));
+    site->caller = caller;
+    return site;
+}
+
+bool lvgl_port_lock(uint32_t timeout_ms)
+{
+    return lvgl_port_lock_from(timeout_ms, __builtin_return_address(0));
+}
+
+bool lvgl_port_lock_from(uint32_t timeout_ms, const void *caller)
+{
+    assert(lvgl_port_ctx.lvgl_mux && "lvgl_port_init must be called first");
+
+    const TickType_t timeout_ticks = (timeout_ms == 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    const TaskHandle_t holder = xSemaphoreGetMutexHolder(lvgl_port_ctx.lvgl_mux);
+
+    /* Recursive lock never waits, it is accounted to the outermost one */
+    if (holder == xTaskGetCurrentTaskHandle()) {
+        const bool taken = (xSemaphoreTakeRecursive(lvgl_port_ctx.lvgl_mux, timeout_ticks) == pdTRUE);
+        lvgl_port_ctx.lock_depth += taken ? 1 : 0;
+        return taken;
+    }
+
+    /* Call site of the holder may change meanwhile, it is a hint only */
+    const void *blocked_by = holder ? lvgl_port_ctx.lock_caller : NULL;
+    const char *task = pcTaskGetName(NULL);
+    const int64_t start = esp_timer_get_time();
+    const bool taken = (xSemaphoreTakeRecursive(lvgl_port_ctx.lvgl_mux, timeout_ticks) == pdTRUE);
+    const int64_t now = esp_timer_get_time();
+    const uint32_t wait_us = now - start;
+
+    if (taken) {
+        lvgl_port_ctx.lock_caller = caller;
+        lvgl_port_ctx.lock_depth = 1;
+        lvgl_port_ctx.lock_start = now;
+    }
+
+    portENTER_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+    lvgl_port_lock_site_stats_t *site = lvgl_port_lock_site(caller, true);
+    if (site) {
+        strlcpy(site->task, task, sizeof(site->task));
+        site->locks += taken ? 1 : 0;
+        site->timeouts += taken ? 0 : 1;
+        site->wait_us += wait_us;
+        site->wait_max_us = LV_MAX(site->wait_max_us, wait_us);
+        if (holder != NULL) {
+            site->contended++;
+            site->blocked_by = blocked_by;
+        }
+    }
+    portEXIT_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+
+    return taken;
+}
+
+void lvgl_port_unlock(void)
+{
+    assert(lvgl_port_ctx.lvgl_mux && "lvgl_port_init must be called first");
+
+    if (xSemaphoreGetMutexHolder(lvgl_port_ctx.lvgl_mux) == xTaskGetCurrentTaskHandle() && --lvgl_port_ctx.lock_depth == 0) {
+        const uint32_t hold_us = esp_timer_get_time() - lvgl_port_ctx.lock_start;
+        const void *caller = lvgl_port_ctx.lock_caller;
+        lvgl_port_ctx.lock_caller = NULL;
+
+        portENTER_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+        lvgl_port_lock_site_stats_t *site = lvgl_port_lock_site(caller, false);
+        if (site) {
+            site->hold_us += hold_us;
+            site->hold_max_us = LV_MAX(site->hold_max_us, hold_us);
+        }
+        portEXIT_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+    }
+    xSemaphoreGiveRecursive(lvgl_port_ctx.lvgl_mux);
+
+    /* Other task could change the UI, let the LVGL task handle it now instead of at its next timer */
+    if (lvgl_port_ctx.wake_on_event && xTaskGetCurrentTaskHandle() != lvgl_port_ctx.lvgl_task &&
+            xSemaphoreGetMutexHolder(lvgl_port_ctx.lvgl_mux) == NULL) {
+        lvgl_port_task_notify(LVGL_PORT_EVENT_WAKE, NULL);
+    }
+}
+
+void lvgl_port_task_wake(bool input)
+{
+    BaseType_t need_yield = pdFALSE;
+
+    if (input) {
+        portENTER_CRITICAL_SAFE(&lvgl_port_ctx.input_lock);
+        if (lvgl_port_ctx.input_time == 0) {
+            lvgl_port_ctx.input_time = esp_timer_get_time();
+        }
+        portEXIT_CRITICAL_SAFE(&lvgl_port_ctx.input_lock);
+    }
+
+    lvgl_port_task_notify(input ? LVGL_PORT_EVENT_INPUT : LVGL_PORT_EVENT_WAKE, &need_yield);
+    if (need_yield == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+esp_err_t lvgl_port_post(lvgl_port_cmd_cb_t cb, void *arg)
+{
+    ESP_RETURN_ON_FALSE_ISR(cb, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE_ISR(lvgl_port_ctx.lvgl_task, ESP_ERR_INVALID_STATE, TAG, "lvgl_port_init must be called first");
+
+    /* No log when full, it could be called from an interrupt */
+    const lvgl_port_queue_cmd_t cmd = {
+        .cb = cb,
+        .arg = arg,
+    };
+    if (!lvgl_port_queue_push(&lvgl_port_ctx.cmd_queue, &cmd)) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    BaseType_t need_yield = pdFALSE;
+    lvgl_port_task_notify(LVGL_PORT_EVENT_WAKE, &need_yield);
+    if (need_yield == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+
+    return ESP_OK;
+}
+
+void lvgl_port_flush_ready(lv_disp_t *disp)
+{
+    assert(disp);
+    assert(disp->driver);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp->driver->user_data;
+    assert(disp_ctx != NULL);
+
+    if (lvgl_port_trans_done(disp_ctx)) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void lvgl_port_task(void *arg)
+{
+    uint32_t task_delay_ms = lvgl_port_ctx.task_max_sleep_ms;
+    uint32_t events = 0;
+
+    ESP_LOGI(TAG, "Starting LVGL task");
+    lvgl_port_ctx.running = true;
+    while (lvgl_port_ctx.running) {
+        const int64_t lock_start = esp_timer_get_time();
+        if (lvgl_port_lock_from(0, (const void *)lvgl_port_task)) {
+            const int64_t handler_start = esp_timer_get_time();
+            if (lvgl_port_ctx.wake_on_event) {
+                lvgl_port_task_input(events & LVGL_PORT_EVENT_INPUT);
+            }
+            lvgl_port_task_commands();
+            task_delay_ms = lv_timer_handler();
+            if (lvgl_port_ctx.frame_rendered) {
+                const int64_t handler_us = esp_timer_get_time() - handler_start - lvgl_port_ctx.frame.value[LVGL_PORT_STATS_RENDER_US];
+                lvgl_port_ctx.frame.value[LVGL_PORT_STATS_LOCK_WAIT_US] = handler_start - lock_start;
+                lvgl_port_ctx.frame.value[LVGL_PORT_STATS_HANDLER_US] = LV_MAX(handler_us, 0);
+                lvgl_port_ctx.frame_rendered = false;
+                lvgl_port_frame_done(LVGL_PORT_FRAME_RENDERED);
+            }
+            lvgl_port_unlock();
+        }
+
+        if (!lvgl_port_ctx.wake_on_event) {
+            if ((task_delay_ms > lvgl_port_ctx.task_max_sleep_ms) || (1 == task_delay_ms)) {
+                task_delay_ms = lvgl_port_ctx.task_max_sleep_ms;
+            } else if (task_delay_ms < 1) {
+                task_delay_ms = 1;
+            }
+            task_delay_ms = lvgl_port_task_wake_ms(task_delay_ms);
+            vTaskDelay(pdMS_TO_TICKS(task_delay_ms));
+            lvgl_port_ctx.task_stats.wakeups++;
+            continue;
+        }
+
+        /* Sleep until the next LVGL timer is due, LVGL time advances by whole tick periods only */
+        if (task_delay_ms > lvgl_port_ctx.task_max_sleep_ms) {
+            task_delay_ms = lvgl_port_ctx.task_max_sleep_ms;
+        }
+        task_delay_ms = ((task_delay_ms + lvgl_port_timer_period_ms - 1) / lvgl_port_timer_period_ms) * lvgl_port_timer_period_ms;
+        if (task_delay_ms < 1) {
+            task_delay_ms = 1;
+        }
+        task_delay_ms = lvgl_port_task_wake_ms(task_delay_ms);
+        events = 0;
+        if (xTaskNotifyWait(0, LVGL_PORT_EVENT_WAKE | LVGL_PORT_EVENT_INPUT, &events, pdMS_TO_TICKS(task_delay_ms)) == pdTRUE) {
+            lvgl_port_ctx.task_stats.notified++;
+        }
+        lvgl_port_ctx.task_stats.wakeups++;
+    }
+
+    lvgl_port_task_deinit();
+
+    /* Close task */
+    vTaskDelete( NULL );
+}
+
+/* Notify the LVGL task, need_yield is used only in an interrupt */
+static void lvgl_port_task_notify(uint32_t events, BaseType_t *need_yield)
+{
+    TaskHandle_t task = lvgl_port_ctx.lvgl_task;
+    if (!lvgl_port_ctx.wake_on_event || task == NULL) {
+        return;
+    }
+
+    if (xPortInIsrContext()) {
+        xTaskNotifyFromISR(task, events, eSetBits, need_yield);
+    } else {
+        xTaskNotify(task, events, eSetBits);
+    }
+}
+
+/* Input devices of the port wake up the task themselves */
+static bool lvgl_port_indev_wakes(lv_indev_t *indev)
+{
+    const void *read_cb = (const void *)indev->driver->read_cb;
+#ifdef ESP_LVGL_PORT_KNOB_COMPONENT
+    if (read_cb == (const void *)lvgl_port_encoder_read) {
+        return true;
+    }
+#endif
+#ifdef ESP_LVGL_PORT_BUTTON_COMPONENT
+    if (read_cb == (const void *)lvgl_port_navigation_buttons_read) {
+        return true;
+    }
+#endif
+#ifdef ESP_LVGL_PORT_USB_HOST_HID_COMPONENT
+    if (read_cb == (const void *)lvgl_port_usb_hid_read_mouse || read_cb == (const void *)lvgl_port_usb_hid_read_kb) {
+        return true;
+    }
+#endif
+    (void)read_cb;
+    return false;
+}
+
+/* Read input devices, which have new data, now. Stop reading the released ones after a while without input. */
+static void lvgl_port_task_input(bool pending)
+{
+    const uint32_t now = lv_tick_get();
+    if (pending) {
+        lvgl_port_ctx.input_last_ms = now;
+    }
+    const bool idle = (lv_tick_elaps(lvgl_port_ctx.input_last_ms) > LVGL_PORT_INPUT_IDLE_MS);
+
+    for (lv_indev_t *indev = lv_indev_get_next(NULL); indev != NULL; indev = lv_indev_get_next(indev)) {
+        lv_timer_t *read_timer = indev->driver->read_timer;
+        if (read_timer == NULL || !lvgl_port_indev_wakes(indev)) {
+            continue;
+        }
+        if (pending) {
+            lv_timer_resume(read_timer);
+            lv_timer_ready(read_timer);
+        } else if (idle && !read_timer->paused && indev->proc.state == LV_INDEV_STATE_RELEASED) {
+            lv_timer_pause(read_timer);
+        }
+    }
+}
+
+/* A paced refresh starts between two LVGL ticks, the task sleeps until then instead of the delay */
+static uint32_t lvgl_port_task_wake_ms(uint32_t delay_ms)
+{
+    if (lvgl_port_ctx.task_wake == 0) {
+        return delay_ms;
+    }
+    const int64_t wait_us = lvgl_port_ctx.task_wake - esp_timer_get_time();
+    lvgl_port_ctx.task_wake = 0;
+    return (wait_us > 0) ? (wait_us + 999) / 1000 : 0;
+}
+
+/* Run the posted commands, at most one queue of them per frame, so the posting tasks can not hold off the refresh */
+static void lvgl_port_task_commands(void)
+{
+    lvgl_port_queue_cmd_t cmd;
+    uint32_t count = 0;
+
+    while (count < LVGL_PORT_QUEUE_LEN && lvgl_port_queue_pop(&lvgl_port_ctx.cmd_queue, &cmd)) {
+        cmd.cb(cmd.arg);
+        count++;
+    }
+    lvgl_port_ctx.task_stats.commands += count;
+
+    /* Rest is run in the next frame, do not wait for a timer with it */
+    if (count == LVGL_PORT_QUEUE_LEN) {
+        lvgl_port_task_notify(LVGL_PORT_EVENT_WAKE, NULL);
+    }
+}
+
+/* Add the statistics of the frame, when both its rendering and its transfer are finished */
+static void lvgl_port_frame_done(uint32_t part)
+{
+    portENTER_CRITICAL_SAFE(&lvgl_port_ctx.frame_lock);
+    lvgl_port_ctx.frame_parts |= part;
+    if (lvgl_port_ctx.frame_parts == (LVGL_PORT_FRAME_RENDERED | LVGL_PORT_FRAME_FLUSHED)) {
+        lvgl_port_stats_add(&lvgl_port_ctx.frame_stats, &lvgl_port_ctx.frame);
+        lvgl_port_ctx.frame_parts = 0;
+    }
+    portEXIT_CRITICAL_SAFE(&lvgl_port_ctx.frame_lock);
+}
+
+static void lvgl_port_overlay_ms(char *buf, size_t size, uint32_t us)
+{
+    snprintf(buf, size, "%"PRIu32".%"PRIu32, us / 1000, (us % 1000) / 100);
+}
+
+static void lvgl_port_overlay_update(lv_timer_t *timer)
+{
+    lvgl_port_frame_stats_t stats;
+    char render[3][12];
+    char flush[3][12];
+    char text[96];
+
+    lvgl_port_get_frame_stats(&stats);
+    const uint32_t frames = (stats.frames >= lvgl_port_ctx.overlay_frames) ? stats.frames - lvgl_port_ctx.overlay_frames : stats.frames;
+    lvgl_port_ctx.overlay_frames = stats.frames;
+
+    lvgl_port_overlay_ms(render[0], sizeof(render[0]), stats.render_us.p50);
+    lvgl_port_overlay_ms(render[1], sizeof(render[1]), stats.render_us.p95);
+    lvgl_port_overlay_ms(render[2], sizeof(render[2]), stats.render_us.p99);
+    lvgl_port_overlay_ms(flush[0], sizeof(flush[0]), stats.flush_us.p50);
+    lvgl_port_overlay_ms(flush[1], sizeof(flush[1]), stats.flush_us.p95);
+    lvgl_port_overlay_ms(flush[2], sizeof(flush[2]), stats.flush_us.p99);
+    snprintf(text, sizeof(text), "R %s/%s/%s\nF %s/%s/%s\nH %"PRIu32" L %"PRIu32" %"PRIu32" fps",
+             render[0], render[1], render[2], flush[0], flush[1], flush[2],
+             stats.handler_us.p95 / 1000, stats.lock_wait_us.p95 / 1000, frames * 1000 / timer->period);
+    lv_label_set_text(timer->user_data, text);
+}
+
+/* First flush after an input event ends its latency */
+static void lvgl_port_input_flushed(int64_t now)
+{
+    portENTER_CRITICAL(&lvgl_port_ctx.input_lock);
+    const int64_t input_time = lvgl_port_ctx.input_time;
+    lvgl_port_ctx.input_time = 0;
+    portEXIT_CRITICAL(&lvgl_port_ctx.input_lock);
+
+    /* Input, which did not change the screen, is flushed by some later refresh, do not count it */
+    const int64_t latency = now - input_time;
+    if (input_time == 0 || latency > (int64_t)lvgl_port_ctx.task_max_sleep_ms * 1000) {
+        return;
+    }
+
+    lvgl_port_ctx.task_stats.input_events++;
+    lvgl_port_ctx.input_latency_sum += latency;
+    if (latency > lvgl_port_ctx.task_stats.input_latency_max_us) {
+        lvgl_port_ctx.task_stats.input_latency_max_us = latency;
+    }
+}
+
+static void lvgl_port_task_deinit(void)
+{
+    if (lvgl_port_ctx.lvgl_mux) {
+        vSemaphoreDelete(lvgl_port_ctx.lvgl_mux);
+    }
+    memset(&lvgl_port_ctx, 0, sizeof(lvgl_port_ctx));
+#if LV_ENABLE_GC || !LV_MEM_CUSTOM
+    /* Deinitialize LVGL */
+    lv_deinit();
+#endif
+}
+
+#if LVGL_PORT_HANDLE_FLUSH_READY
+static bool lvgl_port_flush_ready_callback(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx)
+{
+    lv_disp_drv_t *disp_drv = (lv_disp_drv_t *)user_ctx;
+    assert(disp_drv != NULL);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp_drv->user_data;
+
+    return lvgl_port_trans_done(disp_ctx);
+}
+#endif
+
+/* Called after every transferred window, LVGL is notified after the last window of the area */
+static bool lvgl_port_trans_done(lvgl_port_display_ctx_t *disp_ctx)
+{
+    BaseType_t need_yield = pdFALSE;
+
+    portENTER_CRITICAL_SAFE(&disp_ctx->trans_lock);
+    const bool last = (disp_ctx->trans_pending <= 1);
+    if (disp_ctx->trans_pending > 0) {
+        disp_ctx->trans_pending--;
+    }
+    portEXIT_CRITICAL_SAFE(&disp_ctx->trans_lock);
+    if (!last) {
+        return false;
+    }
+
+    const int64_t now = esp_timer_get_time();
+    disp_ctx->buf_stats.transfer_us += now - disp_ctx->flush_start;
+    if (disp_ctx->trans_last) {
+        lvgl_port_ctx.frame.value[LVGL_PORT_STATS_FLUSH_US] = now - disp_ctx->frame_flush;
+        lvgl_port_frame_done(LVGL_PORT_FRAME_FLUSHED);
+    }
+    lv_disp_flush_ready(&disp_ctx->disp_drv);
+    if (xPortInIsrContext()) {
+        xSemaphoreGiveFromISR(disp_ctx->flush_done, &need_yield);
+    } else {
+        xSemaphoreGive(disp_ctx->flush_done);
+    }
+    return (need_yield == pdTRUE);
+}
+
+static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    assert(drv != NULL);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
+    assert(disp_ctx != NULL);
+
+    const int offsetx1 = area->x1;
+    const int offsetx2 = area->x2;
+    const int offsety1 = area->y1;
+    const int offsety2 = area->y2;
+
+    /* Drop the completion of a transfer nobody waited for */
+    xSemaphoreTake(disp_ctx->flush_done, 0);
+    disp_ctx->buf_stats.flush_count++;
+    disp_ctx->flush_start = esp_timer_get_time();
+    if (disp_ctx->frame_flush == 0) {
+        disp_ctx->frame_flush = disp_ctx->flush_start;
+    }
+    disp_ctx->frame_last_flush = disp_ctx->flush_start;
+    disp_ctx->trans_last = lv_disp_flush_is_last(drv);
+    lvgl_port_input_flushed(disp_ctx->flush_start);
+
+    if (disp_ctx->round_en || disp_ctx->diff_en) {
+        lvgl_port_round_result_t res;
+
+        /* Hold the area until all windows are queued, even if some of them are transferred meanwhile */
+        disp_ctx->trans_pending = 1;
+        if (disp_ctx->diff_en) {
+            const uint32_t visible = lvgl_port_diff_area(&disp_ctx->diff, offsetx1, offsety1, offsetx2, offsety2, (const uint16_t *)color_map,
+                                     disp_ctx->round_en ? disp_ctx->round.span_x1 : NULL,
+                                     disp_ctx->round_en ? disp_ctx->round.span_x2 : NULL);
+            lvgl_port_round_flush_spans(disp_ctx->diff.span_x1, disp_ctx->diff.span_x2, disp_ctx->trans_cost,
+                                        offsetx1, offsety1, offsetx2, offsety2, color_map, sizeof(lv_color_t),
+                                        lvgl_port_window_send, disp_ctx, &res);
+            const uint32_t visible_bytes = visible * sizeof(lv_color_t);
+            if (visible_bytes > res.bytes_sent) {
+                disp_ctx->buf_stats.diff_saved += visible_bytes - res.bytes_sent;
+                disp_ctx->frame_diff_saved += visible_bytes - res.bytes_sent;
+            }
+        } else {
+            lvgl_port_round_flush(&disp_ctx->round, offsetx1, offsety1, offsetx2, offsety2, color_map, sizeof(lv_color_t),
+                                  lvgl_port_window_send, disp_ctx, &res);
+        }
+        disp_ctx->buf_stats.trans_count += res.trans_count;
+        disp_ctx->buf_stats.bytes_sent += res.bytes_sent;
+        disp_ctx->buf_stats.bytes_saved += res.bytes_saved;
+        disp_ctx->frame_saved += res.bytes_saved;
+        disp_ctx->frame_trans += res.trans_count;
+        disp_ctx->frame_bytes += res.bytes_sent;
+    } else {
+        disp_ctx->buf_stats.trans_count++;
+        disp_ctx->buf_stats.bytes_sent += lv_area_get_size(area) * sizeof(lv_color_t);
+        disp_ctx->frame_trans++;
+        disp_ctx->frame_bytes += lv_area_get_size(area) * sizeof(lv_color_t);
+
+        if (disp_ctx->swap_bytes) {
+            disp_ctx->trans_pending = 1;
+            lvgl_port_window_send(disp_ctx, offsetx1, offsety1, offsetx2, offsety2, color_map);
+        } else {
+            // copy a buffer's content to a specific area of the display
+            esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, color_map);
+        }
+    }
+
+    if (lv_disp_flush_is_last(drv)) {
+        disp_ctx->buf_stats.frame_count++;
+        disp_ctx->buf_stats.frame_saved = disp_ctx->frame_saved;
+        disp_ctx->buf_stats.frame_trans = disp_ctx->frame_trans;
+        disp_ctx->buf_stats.frame_bytes = disp_ctx->frame_bytes;
+        disp_ctx->buf_stats.frame_diff_saved = disp_ctx->frame_diff_saved;
+        disp_ctx->frame_diff_saved = 0;
+        disp_ctx->frame_saved = 0;
+        disp_ctx->frame_trans = 0;
+        disp_ctx->frame_bytes = 0;
+    }
+
+    if (disp_ctx->round_en || disp_ctx->diff_en || disp_ctx->swap_bytes) {
+        /* Release the area, LVGL is notified here when nothing was visible or all windows are already transferred */
+        lvgl_port_trans_done(disp_ctx);
+    }
+}
+
+static void lvgl_port_window_send(void *user_ctx, int x1, int y1, int x2, int y2, const void *data)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)user_ctx;
+    const int w = x2 - x1 + 1;
+    int band_lines = y2 - y1 + 1;
+
+    if (disp_ctx->swap_bytes) {
+        band_lines = LVGL_PORT_SWAP_BAND_BYTES / (w * sizeof(lv_color_t));
+        if (band_lines < 1) {
+            band_lines = 1;
+        }
+    }
+
+    /*
+     * Sending a window waits for the transfer of the previous one, so the swap of a band overlaps
+     * the transfer of the band before it
+     */
+    for (int y = y1; y <= y2; y += band_lines) {
+        const int y_end = (y + band_lines - 1 < y2) ? (y + band_lines - 1) : y2;
+        lv_color_t *band = (lv_color_t *)data + (y - y1) * w;
+
+        if (disp_ctx->swap_bytes) {
+            lvgl_port_swap_rgb565(band, (size_t)w * (y_end - y + 1));
+            if (y != y1) {
+                disp_ctx->buf_stats.trans_count++;
+                disp_ctx->frame_trans++;
+            }
+        }
+        portENTER_CRITICAL(&disp_ctx->trans_lock);
+        disp_ctx->trans_pending++;
+        portEXIT_CRITICAL(&disp_ctx->trans_lock);
+        esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, x1, y, x2 + 1, y_end + 1, band);
+    }
+}
+
+static void lvgl_port_refr_timer_callback(lv_timer_t *timer)
+{
+    lv_disp_t *disp = (lv_disp_t *)timer->user_data;
+    assert(disp != NULL);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp->driver->user_data;
+    assert(disp_ctx != NULL);
+
+    /* Layout changes invalidate areas too, update it first (LVGL refresh skips it then) */
+    if (disp->act_scr) {
+        lv_obj_update_layout(disp->act_scr);
+        if (disp->prev_scr) {
+            lv_obj_update_layout(disp->prev_scr);
+        }
+        lv_obj_update_layout(disp->top_layer);
+        lv_obj_update_layout(disp->sys_layer);
+    }
+
+    const bool paced = (disp_ctx->pacing_en && disp->inv_p > 0);
+    if (paced && !lvgl_port_pacing_wait(disp_ctx, timer)) {
+        return;
+    }
+
+    const size_t count = disp->inv_p;
+    size_t res = count;
+    if (disp_ctx->merge_areas && count > 1) {
+        lvgl_port_area_t areas[LV_INV_BUF_SIZE];
+        for (size_t i = 0; i < count; i++) {
+            areas[i] = (lvgl_port_area_t) {
+                disp->inv_areas[i].x1, disp->inv_areas[i].y1, disp->inv_areas[i].x2, disp->inv_areas[i].y2
+            };
+        }
+        res = lvgl_port_area_optimize(areas, count, LV_INV_BUF_SIZE, sizeof(lv_color_t), disp_ctx->trans_cost);
+        for (size_t i = 0; i < res; i++) {
+            disp->inv_areas[i].x1 = areas[i].x1;
+            disp->inv_areas[i].y1 = areas[i].y1;
+            disp->inv_areas[i].x2 = areas[i].x2;
+            disp->inv_areas[i].y2 = areas[i].y2;
+        }
+        disp->inv_p = res;
+    }
+    disp_ctx->buf_stats.areas_invalidated += count;
+    disp_ctx->buf_stats.areas_refreshed += res;
+
+    disp_ctx->frame_start = esp_timer_get_time();
+    disp_ctx->frame_flush = 0;
+    disp_ctx->frame_wait_us = 0;
+    _lv_disp_refr_timer(timer);
+    const int64_t frame_end = esp_timer_get_time();
+
+    if (paced) {
+        portENTER_CRITICAL(&disp_ctx->pacing_lock);
+        lvgl_port_pacing_frame(&disp_ctx->pacing, disp_ctx->frame_start, disp_ctx->frame_flush,
+                               disp_ctx->frame_flush ? disp_ctx->frame_last_flush : frame_end, disp_ctx->frame_scans);
+        portEXIT_CRITICAL(&disp_ctx->pacing_lock);
+    }
+
+    /* Lock wait and handler time are added by the LVGL task, flush time by the transfer done */
+    if (disp_ctx->frame_flush != 0) {
+        const int64_t render_us = frame_end - disp_ctx->frame_start - disp_ctx->frame_wait_us;
+        lvgl_port_ctx.frame.value[LVGL_PORT_STATS_RENDER_US] = LV_MAX(render_us, 0);
+        lvgl_port_ctx.frame.value[LVGL_PORT_STATS_BYTES] = disp_ctx->buf_stats.frame_bytes;
+        lvgl_port_ctx.frame.value[LVGL_PORT_STATS_AREAS] = res;
+        lvgl_port_ctx.frame_rendered = true;
+    }
+}
+
+static void lvgl_port_pacing_setup(lvgl_port_display_ctx_t *disp_ctx, const lvgl_port_display_cfg_t *disp_cfg)
+{
+    const lvgl_port_pacing_cfg_t *cfg = &disp_cfg->pacing;
+    esp_err_t ret;
+
+    portMUX_INITIALIZE(&disp_ctx->pacing_lock);
+    lvgl_port_pacing_init(&disp_ctx->pacing, cfg->scan_period_us ? cfg->scan_period_us : LVGL_PORT_SCAN_PERIOD_US, esp_timer_get_time());
+    disp_ctx->fast_period_ms = cfg->fast_period_ms;
+    disp_ctx->slow_period_ms = cfg->slow_period_ms ? cfg->slow_period_ms : LV_DISP_DEF_REFR_PERIOD;
+    disp_ctx->pacing_en = true;
+
+    if (!disp_cfg->flags.pacing_te) {
+        return;
+    }
+
+    /* Vertical sync from the TE output, the estimated one is used when anything fails */
+    const gpio_config_t te_cfg = {
+        .pin_bit_mask = 1ULL << cfg->te_gpio,
+        .mode = GPIO_MODE_INPUT,
+        .intr_type = GPIO_INTR_POSEDGE,
+    };
+    ESP_GOTO_ON_ERROR(gpio_config(&te_cfg), err, TAG, "TE GPIO config fail");
+    ret = gpio_install_isr_service(0);
+    ESP_GOTO_ON_FALSE(ret == ESP_OK || ret == ESP_ERR_INVALID_STATE, ret, err, TAG, "GPIO ISR service install fail");
+    ESP_GOTO_ON_ERROR(gpio_isr_handler_add(cfg->te_gpio, lvgl_port_te_isr, disp_ctx), err, TAG, "TE ISR add fail");
+    disp_ctx->te_gpio = cfg->te_gpio;
+
+    /* TE output on V-blanking only */
+    const uint8_t te_mode = 0;
+    ESP_GOTO_ON_ERROR(esp_lcd_panel_io_tx_param(disp_ctx->io_handle, LCD_CMD_TEON, &te_mode, 1), err, TAG, "TE enable fail");
+    return;
+
+err:
+    if (disp_ctx->te_gpio >= 0) {
+        gpio_isr_handler_remove(disp_ctx->te_gpio);
+        disp_ctx->te_gpio = -1;
+    }
+    ESP_LOGW(TAG, "TE not available, vertical sync is estimated");
+}
+
+/* Wait for the start of the frame, false when the refresh is postponed to the next run of the timer */
+static bool lvgl_port_pacing_wait(lvgl_port_display_ctx_t *disp_ctx, lv_timer_t *timer)
+{
+    const bool animating = (lv_anim_count_running() > 0);
+    const int64_t now = esp_timer_get_time();
+
+    /* Back for a start found before, once passed the pacing would give the one of the next frame */
+    if (disp_ctx->pacing_due != 0) {
+        if (now < disp_ctx->pacing_due) {
+            lvgl_port_pacing_postpone(disp_ctx, timer, disp_ctx->pacing_due);
+            return false;
+        }
+        disp_ctx->pacing_due = 0;
+        return true;
+    }
+
+    portENTER_CRITICAL(&disp_ctx->pacing_lock);
+    const uint32_t period = lvgl_port_pacing_period(&disp_ctx->pacing, animating ? disp_ctx->fast_period_ms : disp_ctx->slow_period_ms);
+    const uint32_t scans = ((uint64_t)period * 1000 + disp_ctx->pacing.scan_us / 2) / disp_ctx->pacing.scan_us;
+    const int64_t start = lvgl_port_pacing_start(&disp_ctx->pacing, now);
+    portEXIT_CRITICAL(&disp_ctx->pacing_lock);
+
+    lv_timer_set_period(timer, period);
+    disp_ctx->frame_scans = animating ? scans : 0;
+
+    /* Far from the start, let the LVGL task sleep and come back one tick before */
+    const uint32_t wait_ms = (start - now + 999) / 1000;
+    if (wait_ms > lvgl_port_timer_period_ms) {
+        const uint32_t back_ms = LV_MIN(wait_ms - lvgl_port_timer_period_ms, period - 1);
+        timer->last_run = lv_tick_get() + back_ms - period;
+        return false;
+    }
+    if (start > now) {
+        lvgl_port_pacing_postpone(disp_ctx, timer, start);
+        return false;
+    }
+
+    return true;
+}
+
+/* Close to the start, the LVGL task sleeps until then without the LVGL mutex and runs the timer again */
+static void lvgl_port_pacing_postpone(lvgl_port_display_ctx_t *disp_ctx, lv_timer_t *timer, int64_t start)
+{
+    disp_ctx->pacing_due = start;
+    timer->last_run = lv_tick_get() - timer->period;
+    if (lvgl_port_ctx.task_wake == 0 || start < lvgl_port_ctx.task_wake) {
+        lvgl_port_ctx.task_wake = start;
+    }
+}
+
+static void lvgl_port_te_isr(void *arg)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)arg;
+    const int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL_ISR(&disp_ctx->pacing_lock);
+    lvgl_port_pacing_vsync(&disp_ctx->pacing, now);
+    portEXIT_CRITICAL_ISR(&disp_ctx->pacing_lock);
+}
+
+static void lvgl_port_rounder_callback(lv_disp_drv_t *drv, lv_area_t *area)
+{
+    assert(drv != NULL);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
+    assert(disp_ctx != NULL);
+
+    int x1 = area->x1;
+    int x2 = area->x2;
+    if (disp_ctx->round_en) {
+        /* Corners outside of the circle are never rendered */
+        lvgl_port_round_clip(&disp_ctx->round, &x1, area->y1, &x2, area->y2);
+    }
+    if (disp_ctx->diff_en) {
+        /* Whole tiles can be compared with their signatures */
+        lvgl_port_diff_align(&disp_ctx->diff, &x1, &x2);
+    }
+    area->x1 = x1;
+    area->x2 = x2;
+}
+
+static void lvgl_port_wait_callback(lv_disp_drv_t *drv)
+{
+    assert(drv != NULL);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
+    assert(disp_ctx != NULL);
+
+    /* Block instead of spinning, so the other tasks can run while the draw buffer is transferred */
+    const int64_t start = esp_timer_get_time();
+    xSemaphoreTake(disp_ctx->flush_done, pdMS_TO_TICKS(LVGL_PORT_FLUSH_WAIT_MS));
+    const int64_t wait_us = esp_timer_get_time() - start;
+    disp_ctx->buf_stats.wait_us += wait_us;
+    disp_ctx->frame_wait_us += wait_us;
+}
+
+static esp_err_t lvgl_port_alloc_strips(const lvgl_port_display_cfg_t *disp_cfg, lv_color_t **buf1, lv_color_t **buf2, uint32_t *buffer_size)
+{
+    const uint32_t caps = MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL;
+    const uint32_t line_bytes = disp_cfg->hres * sizeof(lv_color_t);
+    const uint32_t min_lines = LV_MAX(disp_cfg->strip.min_lines, 1);
+    const uint32_t max_lines = LV_MIN(disp_cfg->strip.max_lines ? disp_cfg->strip.max_lines : disp_cfg->vres / 4, disp_cfg->vres);
+    ESP_RETURN_ON_FALSE(min_lines <= max_lines, ESP_ERR_INVALID_ARG, TAG, "Strip min lines (%"PRIu32") bigger than max lines (%"PRIu32")", min_lines, max_lines);
+
+    /* Split the free memory above the reserve between both strips, each of them must fit into one block */
+    const size_t free_size = heap_caps_get_free_size(caps);
+    const size_t avail = (free_size > disp_cfg->strip.heap_reserve) ? (free_size - disp_cfg->strip.heap_reserve) : 0;
+    uint32_t lines = LV_MIN(avail / 2, heap_caps_get_largest_free_block(caps)) / line_bytes;
+    lines = LV_MIN(lines, max_lines);
+
+    /* Heap can be fragmented, shrink the strips until both of them are allocated */
+    while (lines >= min_lines) {
+        *buf1 = heap_caps_malloc(lines * line_bytes, caps);
+        *buf2 = heap_caps_malloc(lines * line_bytes, caps);
+        if (*buf1 && *buf2) {
+            *buffer_size = lines * disp_cfg->hres;
+            ESP_LOGI(TAG, "Strip buffers: 2 x %"PRIu32" lines (%"PRIu32" bytes), %u bytes DMA memory left", lines, 2 * lines * line_bytes, (unsigned)heap_caps_get_free_size(caps));
+            return ESP_OK;
+        }
+        free(*buf1);
+        free(*buf2);
+        *buf1 = NULL;
+        *buf2 = NULL;
+        lines = (lines > 1) ? (lines * 3 / 4) : 0;
+    }
+
+    return ESP_ERR_NO_MEM;
+}
+
+static void lvgl_port_update_callback(lv_disp_drv_t *drv)
+{
+    assert(drv);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
+    assert(disp_ctx != NULL);
+    esp_lcd_panel_handle_t panel_handle = disp_ctx->panel_handle;
+
+    /* Signatures were taken in the previous orientation */
+    lvgl_port_diff_reset(&disp_ctx->diff);
+
+    /* Solve rotation screen and touch */
+    switch (drv->rotated) {
+    case LV_DISP_ROT_NONE:
+        /* Rotate LCD display */
+        esp_lcd_panel_swap_xy(panel_handle, disp_ctx->rotation.swap_xy);
+        esp_lcd_panel_mirror(panel_handle, disp_ctx->rotation.mirror_x, disp_ctx->rotation.mirror_y);
+        break;
+    case LV_DISP_ROT_90:
+        /* Rotate LCD display */
+        esp_lcd_panel_swap_xy(panel_handle, !disp_ctx->rotation.swap_xy);
+        if (disp_ctx->rotation.swap_xy) {
+            esp_lcd_panel_mirror(panel_handle, !disp_ctx->rotation.mirror_x, disp_ctx->rotation.mirror_y);
+        } else {
+            esp_lcd_panel_mirror(panel_handle, disp_ctx->rotation.mirror_x, !disp_ctx->rotation.mirror_y);
+        }
+        break;
+    case LV_DISP_ROT_180:
+        /* Rotate LCD display */
+        esp_lcd_panel_swap_xy(panel_handle, disp_ctx->rotation.swap_xy);
+        esp_lcd_panel_mirror(panel_handle, !disp_ctx->rotation.mirror_x, !disp_ctx->rotation.mirror_y);
+        break;
+    case LV_DISP_ROT_270:
+        /* Rotate LCD display */
+        esp_lcd_panel_swap_xy(panel_handle, !disp_ctx->rotation.swap_xy);
+        if (disp_ctx->rotation.swap_xy) {
+            esp_lcd_panel_mirror(panel_handle, disp_ctx->rotation.mirror_x, !disp_ctx->rotation.mirror_y);
+        } else {
+            esp_lcd_panel_mirror(panel_handle, !disp_ctx->rotation.mirror_x, disp_ctx->rotation.mirror_y);
+        }
+        break;
+    }
+}
+
+static void lvgl_port_pix_monochrome_callback(lv_disp_drv_t *drv, uint8_t *buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y, lv_color_t color, lv_opa_t opa)
+{
+    if (drv->rotated == LV_DISP_ROT_90 || drv->rotated == LV_DISP_ROT_270) {
+        lv_coord_t tmp_x = x;
+        x = y;
+        y = tmp_x;
+    }
+
+    /* Write to the buffer as required for the display.
+    * It writes only 1-bit for monochrome displays mapped vertically.*/
+    buf += drv->hor_res * (y >> 3) + x;
+    if (lv_color_to1(color)) {
+        (*buf) &= ~(1 << (y % 8));
+    } else {
+        (*buf) |= (1 << (y % 8));
+    }
+}
+
+#ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
+static void lvgl_port_touchpad_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data)
+{
+    assert(indev_drv);
+    lvgl_port_touch_ctx_t *touch_ctx = (lvgl_port_touch_ctx_t *)indev_drv->user_data;
+    assert(touch_ctx->handle);
+
+    uint16_t touchpad_x[1] = {0};
+    uint16_t touchpad_y[1] = {0};
+    uint8_t touchpad_cnt = 0;
+
+    /* Read data from touch controller into memory */
+    esp_lcd_touch_read_data(touch_ctx->handle);
+
+    /* Read data from touch controller */
+    bool touchpad_pressed = esp_lcd_touch_get_coordinates(touch_ctx->handle, touchpad_x, touchpad_y, NULL, &touchpad_cnt, 1);
+
+    if (touchpad_pressed && touchpad_cnt > 0) {
+        data->point.x = touchpad_x[0];
+        data->point.y = touchpad_y[0];
+        data->state = LV_INDEV_STATE_PRESSED;
+    } else {
+        data->state = LV_INDEV_STATE_RELEASED;
+    }
+}
+#endif
+
+#ifdef ESP_LVGL_PORT_KNOB_COMPONENT
+static void lvgl_port_encoder_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data)
+{
+    static int32_t last_v = 0;
+
+    assert(indev_drv);
+    lvgl_port_encoder_ctx_t *ctx = (lvgl_port_encoder_ctx_t *)indev_drv->user_data;
+    assert(ctx);
+
+    int32_t invd = iot_knob_get_count_value(ctx->knob_handle);
+    knob_event_t event = iot_knob_get_event(ctx->knob_handle);
+
+    if (last_v ^ invd) {
+        last_v = invd;
+        data->enc_diff = (KNOB_LEFT == event) ? (-1) : ((KNOB_RIGHT == event) ? (1) : (0));
+    } else {
+        data->enc_diff = 0;
+    }
+    data->state = (true == ctx->btn_enter) ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+static void lvgl_port_encoder_btn_down_handler(void *arg, void *arg2)
+{
+    lvgl_port_encoder_ctx_t *ctx = (lvgl_port_encoder_ctx_t *) arg2;
+    button_handle_t button = (button_handle_t)arg;
+    if (ctx && button) {
+        /* ENTER */
+        if (button == ctx->btn_handle) {
+            ctx->btn_enter = true;
+        }
+    }
+    lvgl_port_task_wake(true);
+}
+
+static void lvgl_port_encoder_btn_up_handler(void *arg, void *arg2)
+{
+    lvgl_port_encoder_ctx_t *ctx = (lvgl_port_encoder_ctx_t *) arg2;
+    button_handle_t button = (button_handle_t)arg;
+    if (ctx && button) {
+        /* ENTER */
+        if (button == ctx->btn_handle) {
+            ctx->btn_enter = false;
+        }
+    }
+    lvgl_port_task_wake(true);
+}
+
+static void lvgl_port_encoder_knob_handler(void *arg, void *arg2)
+{
+    lvgl_port_task_wake(true);
+}
+#endif
+
+#ifdef ESP_LVGL_PORT_BUTTON_COMPONENT
+static uint32_t last_key = 0;
+static void lvgl_port_navigation_buttons_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data)
+{
+    assert(indev_drv);
+    lvgl_port_nav_btns_ctx_t *ctx = (lvgl_port_nav_btns_ctx_t *)indev_drv->user_data;
+    assert(ctx);
+
+    /* Buttons */
+    if (ctx->btn_prev) {
+        data->key = LV_KEY_LEFT;
+        last_key = LV_KEY_LEFT;
+        data->state = LV_INDEV_STATE_PRESSED;
+    } else if (ctx->btn_next) {
+        data->key = LV_KEY_RIGHT;
+        last_key = LV_KEY_RIGHT;
+        data->state = LV_INDEV_STATE_PRESSED;
+    } else if (ctx->btn_enter) {
+        data->key = LV_KEY_ENTER;
+        last_key = LV_KEY_ENTER;
+        data->state = LV_INDEV_STATE_PRESSED;
+    } else {
+        data->key = last_key;
+        data->state = LV_INDEV_STATE_RELEASED;
+    }
+}
+
+static void lvgl_port_btn_down_handler(void *arg, void *arg2)
+{
+    lvgl_port_nav_btns_ctx_t *ctx = (lvgl_port_nav_btns_ctx_t *) arg2;
+    button_handle_t button = (button_handle_t)arg;
+    if (ctx && button) {
+        /* PREV */
+        if (button == ctx->btn[LVGL_PORT_NAV_BTN_PREV]) {
+            ctx->btn_prev = true;
+        }
+        /* NEXT */
+        if (button == ctx->btn[LVGL_PORT_NAV_BTN_NEXT]) {
+            ctx->btn_next = true;
+        }
+        /* ENTER */
+        if (button == ctx->btn[LVGL_PORT_NAV_BTN_ENTER]) {
+            ctx->btn_enter = true;
+        }
+    }
+    lvgl_port_task_wake(true);
+}
+
+static void lvgl_port_btn_up_handler(void *arg, void *arg2)
+{
+    lvgl_port_nav_btns_ctx_t *ctx = (lvgl_port_nav_btns_ctx_t *) arg2;
+    button_handle_t button = (button_handle_t)arg;
+    if (ctx && button) {
+        /* PREV */
+        if (button == ctx->btn[LVGL_PORT_NAV_BTN_PREV]) {
+            ctx->btn_prev = false;
+        }
+        /* NEXT */
+        if (button == ctx->btn[LVGL_PORT_NAV_BTN_NEXT]) {
+            ctx->btn_next = false;
+        }
+        /* ENTER */
+        if (button == ctx->btn[LVGL_PORT_NAV_BTN_ENTER]) {
+            ctx->btn_enter = false;
+        }
+    }
+    lvgl_port_task_wake(true);
+}
+#endif
+
+#ifdef ESP_LVGL_PORT_USB_HOST_HID_COMPONENT
+static lvgl_port_usb_hid_ctx_t *lvgl_port_hid_init(void)
+{
+    esp_err_t ret;
+
+    /* USB HID is already initialized */
+    if (lvgl_port_ctx.hid_ctx.task) {
+        return &lvgl_port_ctx.hid_ctx;
+    }
+
+    /* USB HID host driver config */
+    const hid_host_driver_config_t hid_host_driver_config = {
+        .create_background_task = true,
+        .task_priority = 5,
+        .stack_size = 4096,
+        .core_id = 0,
+        .callback = lvgl_port_usb_hid_callback,
+        .callback_arg = &lvgl_port_ctx.hid_ctx,
+    };
+
+    ret = hid_host_install(&hid_host_driver_config);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "USB HID install failed!");
+        return NULL;
+    }
+
+    lvgl_port_ctx.hid_ctx.queue = xQueueCreate(10, sizeof(lvgl_port_usb_hid_event_t));
+    xTaskCreate(&lvgl_port_usb_hid_task, "hid_task", 4 * 1024, &lvgl_port_ctx.hid_ctx, 2, &lvgl_port_ctx.hid_ctx.task);
+
+    return &lvgl_port_ctx.hid_ctx;
+}
+
+static char usb_hid_get_keyboard_char(uint8_t key, uint8_t shift)
+{
+    char ret_key = 0;
+
+    const uint8_t keycode2ascii [57][2] = {
+        {0, 0}, /* HID_KEY_NO_PRESS        */
+        {0, 0}, /* HID_KEY_ROLLOVER        */
+        {0, 0}, /* HID_KEY_POST_FAIL       */
+        {0, 0}, /* HID_KEY_ERROR_UNDEFINED */
+        {'a', 'A'}, /* HID_KEY_A               */
+        {'b', 'B'}, /* HID_KEY_B               */
+        {'c', 'C'}, /* HID_KEY_C               */
+        {'d', 'D'}, /* HID_KEY_D               */
+        {'e', 'E'}, /* HID_KEY_E               */
+        {'f', 'F'}, /* HID_KEY_F               */
+        {'g', 'G'}, /* HID_KEY_G               */
+        {'h', 'H'}, /* HID_KEY_H               */
+        {'i', 'I'}, /* HID_KEY_I               */
+        {'j', 'J'}, /* HID_KEY_J               */
+        {'k', 'K'}, /* HID_KEY_K               */
+        {'l', 'L'}, /* HID_KEY_L               */
+        {'m', 'M'}, /* HID_KEY_M               */
+        {'n', 'N'}, /* HID_KEY_N               */
+        {'o', 'O'}, /* HID_KEY_O               */
+        {'p', 'P'}, /* HID_KEY_P               */
+        {'q', 'Q'}, /* HID_KEY_Q               */
+        {'r', 'R'}, /* HID_KEY_R               */
+        {'s', 'S'}, /* HID_KEY_S               */
+        {'t', 'T'}, /* HID_KEY_T               */
+        {'u', 'U'}, /* HID_KEY_U               */
+        {'v', 'V'}, /* HID_KEY_V               */
+        {'w', 'W'}, /* HID_KEY_W               */
+        {'x', 'X'}, /* HID_KEY_X               */
+        {'y', 'Y'}, /* HID_KEY_Y               */
+        {'z', 'Z'}, /* HID_KEY_Z               */
+        {'1', '!'}, /* HID_KEY_1               */
+        {'2', '@'}, /* HID_KEY_2               */
+        {'3', '#'}, /* HID_KEY_3               */
+        {'4', '$'}, /* HID_KEY_4               */
+        {'5', '%'}, /* HID_KEY_5               */
+        {'6', '^'}, /* HID_KEY_6               */
+        {'7', '&'}, /* HID_KEY_7               */
+        {'8', '*'}, /* HID_KEY_8               */
+        {'9', '('}, /* HID_KEY_9               */
+        {'0', ')'}, /* HID_KEY_0               */
+        {'\r', '\r'}, /* HID_KEY_ENTER           */
+        {0, 0}, /* HID_KEY_ESC             */
+        {'\b', 0}, /* HID_KEY_DEL             */
+        {0, 0}, /* HID_KEY_TAB             */
+        {' ', ' '}, /* HID_KEY_SPACE           */
+        {'-', '_'}, /* HID_KEY_MINUS           */
+        {'=', '+'}, /* HID_KEY_EQUAL           */
+        {'[', '{'}, /* HID_KEY_OPEN_BRACKET    */
+        {']', '}'}, /* HID_KEY_CLOSE_BRACKET   */
+        {'\\', '|'}, /* HID_KEY_BACK_SLASH      */
+        {'\\', '|'}, /* HID_KEY_SHARP           */  // HOTFIX: for NonUS Keyboards repeat HID_KEY_BACK_SLASH
+        {';', ':'}, /* HID_KEY_COLON           */
+        {'\'', '"'}, /* HID_KEY_QUOTE           */
+        {'`', '~'}, /* HID_KEY_TILDE           */
+        {',', '<'}, /* HID_KEY_LESS            */
+        {'.', '>'}, /* HID_KEY_GREATER         */
+        {'/', '?'} /* HID_KEY_SLASH           */
+    };
+
+    if (shift > 1) {
+        shift = 1;
+    }
+
+    if ((key >= HID_KEY_A) && (key <= HID_KEY_SLASH)) {
+        ret_key = keycode2ascii[key][shift];
+    }
+
+    return ret_key;
+}
+
+static void lvgl_port_usb_hid_host_interface_callback(hid_host_device_handle_t hid_device_handle, const hid_host_interface_event_t event, void *arg)
+{
+    hid_host_dev_params_t dev;
+    hid_host_device_get_params(hid_device_handle, &dev);
+    lvgl_port_usb_hid_ctx_t *hid_ctx = (lvgl_port_usb_hid_ctx_t *)arg;
+    uint8_t data[10];
+    unsigned int data_length = 0;
+
+    assert(hid_ctx != NULL);
+
+    switch (event) {
+    case HID_HOST_INTERFACE_EVENT_INPUT_REPORT:
+        hid_host_device_get_raw_input_report_data(hid_device_handle, data, sizeof(data), &data_length);
+        if (dev.proto == HID_PROTOCOL_KEYBOARD) {
+            hid_keyboard_input_report_boot_t *keyboard = (hid_keyboard_input_report_boot_t *)data;
+            if (data_length < sizeof(hid_keyboard_input_report_boot_t)) {
+                return;
+            }
+            for (int i = 0; i < HID_KEYBOARD_KEY_MAX; i++) {
+                if (keyboard->key[i] > HID_KEY_ERROR_UNDEFINED) {
+                    char key = 0;
+
+                    /* LVGL special keys */
+                    if (keyboard->key[i] == HID_KEY_TAB) {
+                        if ((keyboard->modifier.left_shift || keyboard->modifier.right_shift)) {
+                            key = LV_KEY_PREV;
+                        } else {
+                            key = LV_KEY_NEXT;
+                        }
+                    } else if (keyboard->key[i] == HID_KEY_RIGHT) {
+                        key = LV_KEY_RIGHT;
+                    } else if (keyboard->key[i] == HID_KEY_LEFT) {
+                        key = LV_KEY_LEFT;
+                    } else if (keyboard->key[i] == HID_KEY_DOWN) {
+                        key = LV_KEY_DOWN;
+                    } else if (keyboard->key[i] == HID_KEY_UP) {
+                        key = LV_KEY_UP;
+                    } else if (keyboard->key[i] == HID_KEY_ENTER || keyboard->key[i] == HID_KEY_KEYPAD_ENTER) {
+                        key = LV_KEY_ENTER;
+                    } else if (keyboard->key[i] == HID_KEY_DELETE) {
+                        key = LV_KEY_DEL;
+                    } else if (keyboard->key[i] == HID_KEY_HOME) {
+                        key = LV_KEY_HOME;
+                    } else if (keyboard->key[i] == HID_KEY_END) {
+                        key = LV_KEY_END;
+                    } else {
+                        /* Get ASCII char */
+                        key = usb_hid_get_keyboard_char(keyboard->key[i], (keyboard->modifier.left_shift || keyboard->modifier.right_shift));
+                    }
+
+                    if (key == 0) {
+                        ESP_LOGI(TAG, "Not recognized key: %c (%d)", keyboard->key[i], keyboard->key[i]);
+                    }
+                    hid_ctx->kb.last_key = key;
+                    hid_ctx->kb.pressed = true;
+                }
+            }
+
+        } else if (dev.proto == HID_PROTOCOL_MOUSE) {
+            hid_mouse_input_report_boot_t *mouse = (hid_mouse_input_report_boot_t *)data;
+            if (data_length < sizeof(hid_mouse_input_report_boot_t)) {
+                break;
+            }
+            hid_ctx->mouse.left_button = mouse->buttons.button1;
+            hid_ctx->mouse.x += mouse->x_displacement;
+            hid_ctx->mouse.y += mouse->y_displacement;
+        }
+        lvgl_port_task_wake(true);
+        break;
+    case HID_HOST_INTERFACE_EVENT_TRANSFER_ERROR:
+        break;
+    case HID_HOST_INTERFACE_EVENT_DISCONNECTED:
+        hid_host_device_close(hid_device_handle);
+        break;
+    default:
+        break;
+    }
+}
+
+static void lvgl_port_usb_hid_task(void *arg)
+{
+    hid_host_dev_params_t dev;
+    lvgl_port_usb_hid_ctx_t *ctx = (lvgl_port_usb_hid_ctx_t *)arg;
+    hid_host_device_handle_t hid_device_handle = NULL;
+    lvgl_port_usb_hid_event_t msg;
+
+    assert(ctx);
+
+    ctx->running = true;
+
+    while (ctx->running) {
+        if (xQueueReceive(ctx->queue, &msg, pdMS_TO_TICKS(50))) {
+            hid_device_handle = msg.hid_device_handle;
+            hid_host_device_get_params(hid_device_handle, &dev);
+
+            switch (msg.event) {
+            case HID_HOST_DRIVER_EVENT_CONNECTED:
+                /* Handle mouse or keyboard */
+                if (dev.proto == HID_PROTOCOL_KEYBOARD || dev.proto == HID_PROTOCOL_MOUSE) {
+                    const hid_host_device_config_t dev_config = {
+                        .callback = lvgl_port_usb_hid_host_interface_callback,
+                        .callback_arg = ctx
+                    };
+
+                    ESP_ERROR_CHECK( hid_host_device_open(hid_device_handle, &dev_config) );
+                    ESP_ERROR_CHECK( hid_class_request_set_idle(hid_device_handle, 0, 0) );
+                    ESP_ERROR_CHECK( hid_class_request_set_protocol(hid_device_handle, HID_REPORT_PROTOCOL_BOOT) );
+                    ESP_ERROR_CHECK( hid_host_device_start(hid_device_handle) );
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    xQueueReset(ctx->queue);
+    vQueueDelete(ctx->queue);
+
+    hid_host_uninstall();
+
+    memset(&lvgl_port_ctx.hid_ctx, 0, sizeof(lvgl_port_usb_hid_ctx_t));
+
+    vTaskDelete(NULL);
+}
+
+static void lvgl_port_usb_hid_read_mouse(lv_indev_drv_t *indev_drv, lv_indev_data_t *data)
+{
+    int16_t width = 0;
+    int16_t height = 0;
+    assert(indev_drv);
+    lvgl_port_usb_hid_ctx_t *ctx = (lvgl_port_usb_hid_ctx_t *)indev_drv->user_data;
+    assert(ctx);
+
+    if (indev_drv->disp->driver->rotated == LV_DISP_ROT_NONE || indev_drv->disp->driver->rotated == LV_DISP_ROT_180) {
+        width = indev_drv->disp->driver->hor_res;
+        height = indev_drv->disp->driver->ver_res;
+    } else {
+        width = indev_drv->disp->driver->ver_res;
+        height = indev_drv->disp->driver->hor_res;
+    }
+
+    /* Screen borders */
+    if (ctx->mouse.x < 0) {
+        ctx->mouse.x = 0;
+    } else if (ctx->mouse.x > width * ctx->mouse.sensitivity) {
+        ctx->mouse.x = width * ctx->mouse.sensitivity;
+    }
+    if (ctx->mouse.y < 0) {
+        ctx->mouse.y = 0;
+    } else if (ctx->mouse.y > height * ctx->mouse.sensitivity) {
+        ctx->mouse.y = height * ctx->mouse.sensitivity;
+    }
+
+    /* Get coordinates by rotation with sensitivity */
+    switch (indev_drv->disp->driver->rotated) {
+    case LV_DISP_ROT_NONE:
+        data->point.x = ctx->mouse.x / ctx->mouse.sensitivity;
+        data->point.y = ctx->mouse.y / ctx->mouse.sensitivity;
+        break;
+    case LV_DISP_ROT_90:
+        data->point.y = width - ctx->mouse.x / ctx->mouse.sensitivity;
+        data->point.x = ctx->mouse.y / ctx->mouse.sensitivity;
+        break;
+    case LV_DISP_ROT_180:
+        data->point.x = width - ctx->mouse.x / ctx->mouse.sensitivity;
+        data->point.y = height - ctx->mouse.y / ctx->mouse.sensitivity;
+        break;
+    case LV_DISP_ROT_270:
+        data->point.y = ctx->mouse.x / ctx->mouse.sensitivity;
+        data->point.x = height - ctx->mouse.y / ctx->mouse.sensitivity;
+        break;
+    }
+
+    if (ctx->mouse.left_button) {
+        data->state = LV_INDEV_STATE_PRESSED;
+    } else {
+        data->state = LV_INDEV_STATE_RELEASED;
+    }
+}
+
+static void lvgl_port_usb_hid_read_kb(lv_indev_drv_t *indev_drv, lv_indev_data_t *data)
+{
+    assert(indev_drv);
+    lvgl_port_usb_hid_ctx_t *ctx = (lvgl_port_usb_hid_ctx_t *)indev_drv->user_data;
+    assert(ctx);
+
+    data->key = ctx->kb.last_key;
+    if (ctx->kb.pressed) {
+        data->state = LV_INDEV_STATE_PRESSED;
+        ctx->kb.pressed = false;
+    } else {
+        data->state = LV_INDEV_STATE_RELEASED;
+        ctx->kb.last_key = 0;
+    }
+}
+
+static void lvgl_port_usb_hid_callback(hid_host_device_handle_t hid_device_handle, const hid_host_driver_event_t event, void *arg)
+{
+    lvgl_port_usb_hid_ctx_t *hid_ctx = (lvgl_port_usb_hid_ctx_t *)arg;
+
+    const lvgl_port_usb_hid_event_t msg = {
+        .hid_device_handle = hid_device_handle,
+        .event = event,
+        .arg = arg
+    };
+
+    xQueueSend(hid_ctx->queue, &msg, 0);
+}
+#endif
+
+static void lvgl_port_tick_increment(void *arg)
+{
+    /* Tell LVGL how many milliseconds have elapsed */
+    lv_tick_inc(lvgl_port_timer_period_ms);
+}
+
+static esp_err_t lvgl_port_tick_init(void)
+{
+    // Tick interface for LVGL (using esp_timer to generate 2ms periodic event)
+    const esp_timer_create_args_t lvgl_tick_timer_args = {
+        .callback = &lvgl_port_tick_increment,
+        .name = "LVGL tick",
+    };
+    ESP_RETURN_ON_ERROR(esp_timer_create(&lvgl_tick_timer_args, &lvgl_port_ctx.tick_timer), TAG, "Creating LVGL timer filed!");
+    return esp_timer_start_periodic(lvgl_port_ctx.tick_timer, lvgl_port_timer_period_ms * 1000);
+}
@@ -0,0 +1,174 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Optimization of invalidated areas, every invalidated pixel must stay covered and the cost must not grow.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "lvgl_port_area.h"
+#include "test_common.h"
+
+#define HRES            (240)
+#define VRES            (240)
+#define PX_SIZE         (2)
+#define TRANS_COST      (128)
+#define MAX_AREAS       (32)
+
+static uint8_t covered_in[VRES][HRES];
+static uint8_t covered_out[VRES][HRES];
+
+static void cover(uint8_t map[VRES][HRES], const lvgl_port_area_t *areas, size_t count)
+{
+    memset(map, 0, VRES * HRES);
+    for (size_t i = 0; i < count; i++) {
+        for (int y = areas[i].y1; y <= areas[i].y2; y++) {
+            for (int x = areas[i].x1; x <= areas[i].x2; x++) {
+                map[y][x] = 1;
+            }
+        }
+    }
+}
+
+/* Optimize the areas and check the result against the input */
+static size_t optimize_and_check(lvgl_port_area_t *areas, size_t count)
+{
+    const uint64_t cost_in = lvgl_port_area_cost(areas, count, PX_SIZE, TRANS_COST);
+    cover(covered_in, areas, count);
+
+    const size_t res = lvgl_port_area_optimize(areas, count, MAX_AREAS, PX_SIZE, TRANS_COST);
+
+    TEST_ASSERT(res <= MAX_AREAS);
+    TEST_ASSERT(res > 0 || count == 0);
+    TEST_ASSERT(lvgl_port_area_cost(areas, res, PX_SIZE, TRANS_COST) <= cost_in);
+    cover(covered_out, areas, res);
+    for (int y = 0; y < VRES; y++) {
+        for (int x = 0; x < HRES; x++) {
+            TEST_ASSERT(!covered_in[y][x] || covered_out[y][x]);
+        }
+    }
+    for (size_t i = 0; i < res; i++) {
+        TEST_ASSERT(areas[i].x1 <= areas[i].x2 && areas[i].y1 <= areas[i].y2);
+        TEST_ASSERT(areas[i].x1 >= 0 && areas[i].y1 >= 0 && areas[i].x2 < HRES && areas[i].y2 < VRES);
+    }
+
+    return res;
+}
+
+static void test_covered(void)
+{
+    lvgl_port_area_t areas[MAX_AREAS] = {
+        {10, 10, 100, 100},
+        {20, 20, 30, 30},
+        {10, 10, 100, 100},
+        {50, 60, 100, 100},
+    };
+    TEST_ASSERT(optimize_and_check(areas, 4) == 1);
+    TEST_ASSERT(areas[0].x1 == 10 && areas[0].y1 == 10 && areas[0].x2 == 100 && areas[0].y2 == 100);
+}
+
+static void test_merge(void)
+{
+    /* Neighbours, nothing redundant in the bounding box */
+    lvgl_port_area_t areas[MAX_AREAS] = {
+        {0, 0, 49, 9},
+        {50, 0, 99, 9},
+    };
+    TEST_ASSERT(optimize_and_check(areas, 2) == 1);
+    TEST_ASSERT(areas[0].x1 == 0 && areas[0].x2 == 99);
+
+    /* Small gap is cheaper than a transaction */
+    areas[0] = (lvgl_port_area_t) {
+        0, 0, 9, 9
+    };
+    areas[1] = (lvgl_port_area_t) {
+        0, 12, 9, 21
+    };
+    TEST_ASSERT(optimize_and_check(areas, 2) == 1);
+
+    /* Far away areas stay separated */
+    areas[0] = (lvgl_port_area_t) {
+        0, 0, 9, 9
+    };
+    areas[1] = (lvgl_port_area_t) {
+        200, 200, 209, 209
+    };
+    TEST_ASSERT(optimize_and_check(areas, 2) == 2);
+}
+
+static void test_split(void)
+{
+    /* Crossing bars, bounding box would be too big, the overlap is cut off */
+    lvgl_port_area_t areas[MAX_AREAS] = {
+        {0, 100, 239, 139},
+        {100, 0, 139, 239},
+    };
+    const size_t count = optimize_and_check(areas, 2);
+    TEST_ASSERT(count == 3);
+    TEST_ASSERT(lvgl_port_area_cost(areas, count, PX_SIZE, 0) == (240 * 40 * 2 - 40 * 40) * PX_SIZE);
+}
+
+static void test_carousel(void)
+{
+    /* Zoomed icons of the washing carousel, previous and new size of each icon are invalidated */
+    lvgl_port_area_t areas[MAX_AREAS];
+    size_t count = 0;
+    for (int i = 0; i < 5; i++) {
+        const int cx = 40 + i * 40;
+        const int cy = 120 + ((i % 2) ? 10 : -10);
+        for (int r = 20; r <= 24; r += 2) {
+            areas[count++] = (lvgl_port_area_t) {
+                cx - r, cy - r, cx + r, cy + r
+            };
+        }
+        areas[count++] = (lvgl_port_area_t) {
+            cx - 30, cy + 28, cx + 30, cy + 40
+        };
+    }
+    const uint64_t cost_in = lvgl_port_area_cost(areas, count, PX_SIZE, TRANS_COST);
+    const size_t count_in = count;
+
+    count = optimize_and_check(areas, count);
+    const uint64_t cost_out = lvgl_port_area_cost(areas, count, PX_SIZE, TRANS_COST);
+    printf("carousel: %zu -> %zu areas, cost %llu -> %llu bytes\n", count_in, count,
+           (unsigned long long)cost_in, (unsigned long long)cost_out);
+    TEST_ASSERT(count < count_in);
+    TEST_ASSERT(cost_out < cost_in);
+}
+
+static void test_random(void)
+{
+    lvgl_port_area_t areas[MAX_AREAS];
+
+    srand(4321);
+    for (int i = 0; i < 300; i++) {
+        const size_t count = 1 + rand() % MAX_AREAS;
+        for (size_t a = 0; a < count; a++) {
+            const int w = 1 + rand() % 80;
+            const int h = 1 + rand() % 80;
+            const int x = rand() % (HRES - w + 1);
+            const int y = rand() % (VRES - h + 1);
+            areas[a] = (lvgl_port_area_t) {
+                x, y, x + w - 1, y + h - 1
+            };
+        }
+        optimize_and_check(areas, count);
+    }
+}
+
+int main(void)
+{
+    test_covered();
+    test_merge();
+    test_split();
+    test_carousel();
+    test_random();
+    printf("All area optimization tests passed\n");
+    return 0;
+}
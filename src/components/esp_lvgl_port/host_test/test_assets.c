@@ -0,0 +1,194 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Asset tables, built like scripts/lvgl_port_assets.py does. Every asset must be found by its
+ * index and name, and by its name alone, and tables with blobs outside of the bundle must be
+ * rejected when opened.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl_port_assets.h"
+#include "test_common.h"
+
+#define MAX_BUNDLE      (4096)
+
+typedef struct {
+    const char *name;
+    uint16_t w;
+    uint16_t h;
+    uint8_t cf;
+    uint8_t encoding;
+    uint32_t size;
+} test_asset_t;
+
+static const test_asset_t test_assets[] = {
+    {"AC_BG", 269, 269, 5, LVGL_PORT_ASSET_RLE, 301},
+    {"icon_light", 90, 90, 5, LVGL_PORT_ASSET_RAW, 1001},
+    {"standby_mouth_1", 29, 16, 4, LVGL_PORT_ASSET_RAW, 928},
+    {"img_washing_wave1", 139, 40, 5, LVGL_PORT_ASSET_RLE, 3},
+    {"Montserrat-Medium", 1000, 100, 0, LVGL_PORT_ASSET_FONT, 517},
+};
+
+#define TEST_COUNT  (sizeof(test_assets) / sizeof(test_assets[0]))
+
+static uint8_t *put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = v >> 24;
+    return p + 4;
+}
+
+static uint8_t *put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+    return p + 2;
+}
+
+/* Blobs are filled with the index of their asset */
+static size_t build(uint8_t *out)
+{
+    uint32_t offset = LVGL_PORT_ASSETS_HEADER_SIZE + TEST_COUNT * LVGL_PORT_ASSETS_ENTRY_SIZE;
+
+    memset(out, 0xEE, MAX_BUNDLE);
+    for (uint32_t i = 0; i < TEST_COUNT; i++) {
+        const test_asset_t *a = &test_assets[i];
+        uint8_t *e = out + LVGL_PORT_ASSETS_HEADER_SIZE + i * LVGL_PORT_ASSETS_ENTRY_SIZE;
+        offset = (offset + LVGL_PORT_ASSETS_ALIGN - 1) & ~(LVGL_PORT_ASSETS_ALIGN - 1);
+        e = put_u32(e, offset);
+        e = put_u32(e, a->size);
+        e = put_u32(e, lvgl_port_assets_hash(a->name));
+        e = put_u16(e, a->w);
+        e = put_u16(e, a->h);
+        *e++ = a->cf;
+        *e++ = a->encoding;
+        put_u16(e, 0);
+        memset(out + offset, i, a->size);
+        offset += a->size;
+    }
+
+    uint8_t *p = put_u32(out, LVGL_PORT_ASSETS_MAGIC);
+    p = put_u32(p, TEST_COUNT);
+    p = put_u32(p, offset);
+    put_u32(p, 0);
+    return offset;
+}
+
+static void test_lookup(void)
+{
+    static uint8_t bundle[MAX_BUNDLE];
+    lvgl_port_assets_t assets;
+    lvgl_port_asset_t asset;
+
+    const size_t size = build(bundle);
+    TEST_ASSERT(lvgl_port_assets_open(&assets, bundle, MAX_BUNDLE));
+    TEST_ASSERT(assets.count == TEST_COUNT);
+    TEST_ASSERT(assets.size == size);
+
+    for (uint32_t i = 0; i < TEST_COUNT; i++) {
+        const test_asset_t *a = &test_assets[i];
+        TEST_ASSERT(lvgl_port_assets_get(&assets, i, lvgl_port_assets_hash(a->name), &asset));
+        TEST_ASSERT(asset.w == a->w && asset.h == a->h);
+        TEST_ASSERT(asset.cf == a->cf && asset.encoding == a->encoding);
+        TEST_ASSERT(asset.size == a->size);
+        TEST_ASSERT((asset.data - bundle) % LVGL_PORT_ASSETS_ALIGN == 0);
+        TEST_ASSERT(asset.data[0] == i && asset.data[a->size - 1] == i);
+
+        /* Another name at this index, e.g. a table of another build */
+        const test_asset_t *other = &test_assets[(i + 1) % TEST_COUNT];
+        TEST_ASSERT(!lvgl_port_assets_get(&assets, i, lvgl_port_assets_hash(other->name), &asset));
+    }
+    TEST_ASSERT(!lvgl_port_assets_get(&assets, TEST_COUNT, lvgl_port_assets_hash(test_assets[0].name), &asset));
+
+    for (uint32_t i = 0; i < TEST_COUNT; i++) {
+        const test_asset_t *a = &test_assets[i];
+        TEST_ASSERT(lvgl_port_assets_find(&assets, lvgl_port_assets_hash(a->name), &asset));
+        TEST_ASSERT(asset.encoding == a->encoding && asset.size == a->size);
+        TEST_ASSERT(asset.data[0] == i);
+    }
+    TEST_ASSERT(!lvgl_port_assets_find(&assets, lvgl_port_assets_hash("Montserrat-Bold"), &asset));
+
+    /* FNV-1a reference values */
+    TEST_ASSERT(lvgl_port_assets_hash("") == 0x811C9DC5);
+    TEST_ASSERT(lvgl_port_assets_hash("a") == 0xE40C292C);
+}
+
+static void test_invalid(void)
+{
+    static uint8_t bundle[MAX_BUNDLE];
+    lvgl_port_assets_t assets;
+
+    size_t size = build(bundle);
+    TEST_ASSERT(lvgl_port_assets_open(&assets, bundle, size));
+
+    /* Partition shorter than the bundle */
+    TEST_ASSERT(!lvgl_port_assets_open(&assets, bundle, size - 1));
+    TEST_ASSERT(!lvgl_port_assets_open(&assets, bundle, LVGL_PORT_ASSETS_HEADER_SIZE - 1));
+
+    /* Erased partition */
+    memset(bundle, 0xFF, MAX_BUNDLE);
+    TEST_ASSERT(!lvgl_port_assets_open(&assets, bundle, MAX_BUNDLE));
+
+    /* Table longer than the bundle */
+    size = build(bundle);
+    put_u32(bundle + 4, 0x10000000);
+    TEST_ASSERT(!lvgl_port_assets_open(&assets, bundle, MAX_BUNDLE));
+
+    /* Bundle size below the header */
+    build(bundle);
+    put_u32(bundle + 8, 3);
+    TEST_ASSERT(!lvgl_port_assets_open(&assets, bundle, MAX_BUNDLE));
+
+    /* Blob past the end */
+    uint8_t *e = bundle + LVGL_PORT_ASSETS_HEADER_SIZE + (TEST_COUNT - 1) * LVGL_PORT_ASSETS_ENTRY_SIZE;
+    build(bundle);
+    put_u32(e + 4, test_assets[TEST_COUNT - 1].size + 1);
+    TEST_ASSERT(!lvgl_port_assets_open(&assets, bundle, MAX_BUNDLE));
+    TEST_ASSERT(assets.count == 0);
+
+    /* Blob offset overflowing with its size */
+    build(bundle);
+    put_u32(e, 0xFFFFFFFC);
+    TEST_ASSERT(!lvgl_port_assets_open(&assets, bundle, MAX_BUNDLE));
+
+    /* Blob inside of the table, unaligned blob */
+    build(bundle);
+    put_u32(e, LVGL_PORT_ASSETS_HEADER_SIZE);
+    TEST_ASSERT(!lvgl_port_assets_open(&assets, bundle, MAX_BUNDLE));
+    build(bundle);
+    put_u32(e, size - 2);
+    put_u32(e + 4, 1);
+    TEST_ASSERT(!lvgl_port_assets_open(&assets, bundle, MAX_BUNDLE));
+
+    /* Empty image, unknown encoding */
+    build(bundle);
+    put_u16(e + 12, 0);
+    TEST_ASSERT(!lvgl_port_assets_open(&assets, bundle, MAX_BUNDLE));
+    build(bundle);
+    e[17] = LVGL_PORT_ASSET_FONT + 1;
+    TEST_ASSERT(!lvgl_port_assets_open(&assets, bundle, MAX_BUNDLE));
+
+    /* Empty table */
+    uint8_t *p = put_u32(bundle, LVGL_PORT_ASSETS_MAGIC);
+    p = put_u32(p, 0);
+    put_u32(p, LVGL_PORT_ASSETS_HEADER_SIZE);
+    TEST_ASSERT(lvgl_port_assets_open(&assets, bundle, LVGL_PORT_ASSETS_HEADER_SIZE));
+    TEST_ASSERT(assets.count == 0);
+}
+
+int main(void)
+{
+    test_lookup();
+    test_invalid();
+
+    printf("All assets tests passed\n");
+    return 0;
+}
@@ -0,0 +1,298 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Cache of prepared images. Entries must be evicted in least recently used order to keep the
+ * byte budget, never while their source is pinned, and the statistics of each layer must add up
+ * to the entries held, also after a long run of random operations. Only keys missed twice are
+ * admitted.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl_port_cache.h"
+#include "test_common.h"
+
+#define ENTRY_BYTES(size)   (sizeof(lvgl_port_cache_entry_t) + (size))
+#define RANDOM_SOURCES      (12)
+#define RANDOM_OPS          (20000)
+
+static const char sources[RANDOM_SOURCES];
+
+static lvgl_port_cache_key_t key_of(int src, uint16_t zoom)
+{
+    lvgl_port_cache_key_t key;
+    memset(&key, 0, sizeof(key));
+    key.src = &sources[src];
+    key.zoom = zoom;
+    return key;
+}
+
+static lvgl_port_cache_entry_t *add(lvgl_port_cache_t *cache, int src, uint16_t zoom, size_t size)
+{
+    const lvgl_port_cache_key_t key = key_of(src, zoom);
+    lvgl_port_cache_entry_t *entry = lvgl_port_cache_add(cache, &key, size);
+    if (entry) {
+        memset(entry->data, src, size);
+    }
+    return entry;
+}
+
+static bool cached(lvgl_port_cache_t *cache, int src, uint16_t zoom)
+{
+    for (lvgl_port_cache_entry_t *e = cache->head; e; e = e->next) {
+        if (e->key.src == &sources[src] && e->key.zoom == zoom) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* List links, byte accounting, pins and pixels of every entry */
+static void check(const lvgl_port_cache_t *cache)
+{
+    bool seen[RANDOM_SOURCES] = { false };
+    lvgl_port_cache_layer_t sum[LVGL_PORT_CACHE_LAYERS];
+    const lvgl_port_cache_entry_t *prev = NULL;
+    size_t used = 0;
+
+    memset(sum, 0, sizeof(sum));
+    for (const lvgl_port_cache_entry_t *e = cache->head; e; prev = e, e = e->next) {
+        TEST_ASSERT(e->prev == prev);
+        TEST_ASSERT(e->data == (const uint8_t *)(e + 1));
+        const int src = (const char *)e->key.src - sources;
+        TEST_ASSERT(e->data[0] == src && e->data[e->size - 1] == src);
+        /* Only the last used entry of a pinned source */
+        TEST_ASSERT(!e->pinned || (lvgl_port_cache_pinned(cache, e->key.src) && !seen[src]));
+        seen[src] = true;
+        used += ENTRY_BYTES(e->size);
+        sum[e->layer].entries++;
+        sum[e->layer].bytes += ENTRY_BYTES(e->size);
+    }
+    TEST_ASSERT(cache->tail == prev);
+    TEST_ASSERT(cache->used == used);
+    TEST_ASSERT(cache->used <= cache->budget);
+    for (int i = 0; i < LVGL_PORT_CACHE_LAYERS; i++) {
+        TEST_ASSERT(cache->stats[i].entries == sum[i].entries);
+        TEST_ASSERT(cache->stats[i].bytes == sum[i].bytes);
+    }
+}
+
+static void test_lru(void)
+{
+    lvgl_port_cache_t cache;
+    const size_t size = 1000;
+
+    /* Room for three entries */
+    lvgl_port_cache_init(&cache, 3 * ENTRY_BYTES(size) + 10);
+    TEST_ASSERT(add(&cache, 0, 256, size));
+    TEST_ASSERT(add(&cache, 1, 256, size));
+    TEST_ASSERT(add(&cache, 2, 256, size));
+    check(&cache);
+
+    /* Same source with other parameters is another entry */
+    lvgl_port_cache_key_t key = key_of(0, 256);
+    TEST_ASSERT(lvgl_port_cache_find(&cache, &key) == cache.head);
+    key = key_of(0, 300);
+    TEST_ASSERT(lvgl_port_cache_find(&cache, &key) == NULL);
+    key.zoom = 256;
+    key.recolor_opa = 255;
+    TEST_ASSERT(lvgl_port_cache_find(&cache, &key) == NULL);
+    TEST_ASSERT(cache.stats[0].hits == 1 && cache.stats[0].misses == 2);
+
+    /* 1 is the least recently used one now */
+    TEST_ASSERT(add(&cache, 3, 256, size));
+    TEST_ASSERT(!cached(&cache, 1, 256));
+    TEST_ASSERT(cached(&cache, 0, 256) && cached(&cache, 2, 256) && cached(&cache, 3, 256));
+    TEST_ASSERT(cache.stats[0].evictions == 1);
+    check(&cache);
+
+    /* Two entries make room for a bigger one */
+    TEST_ASSERT(add(&cache, 4, 256, 2 * size));
+    TEST_ASSERT(cached(&cache, 3, 256) && cached(&cache, 4, 256) && cache.stats[0].entries == 2);
+    check(&cache);
+
+    /* Larger than the budget */
+    TEST_ASSERT(!add(&cache, 5, 256, cache.budget));
+    TEST_ASSERT(cache.stats[0].entries == 2);
+
+    /* Shrunk entries give their bytes back and stay linked */
+    lvgl_port_cache_entry_t *e = cache.head->next;
+    e = lvgl_port_cache_shrink(&cache, e, size / 2);
+    TEST_ASSERT(e->size == size / 2);
+    check(&cache);
+
+    lvgl_port_cache_deinit(&cache);
+    TEST_ASSERT(cache.head == NULL && cache.used == 0);
+
+    /* No budget caches nothing */
+    lvgl_port_cache_init(&cache, 0);
+    TEST_ASSERT(!add(&cache, 0, 256, 1));
+    lvgl_port_cache_deinit(&cache);
+}
+
+static void test_pin_layers(void)
+{
+    lvgl_port_cache_t cache;
+    const size_t size = 1000;
+
+    lvgl_port_cache_init(&cache, 3 * ENTRY_BYTES(size));
+    lvgl_port_cache_set_layer(&cache, 1);
+    TEST_ASSERT(lvgl_port_cache_pin(&cache, &sources[0], true));
+    TEST_ASSERT(lvgl_port_cache_pin(&cache, &sources[1], true));
+    TEST_ASSERT(add(&cache, 0, 256, size));
+    TEST_ASSERT(add(&cache, 1, 256, size));
+    TEST_ASSERT(add(&cache, 2, 256, size));
+
+    /* Only the unpinned one can go */
+    TEST_ASSERT(add(&cache, 3, 256, size));
+    TEST_ASSERT(cached(&cache, 0, 256) && cached(&cache, 1, 256) && !cached(&cache, 2, 256));
+    TEST_ASSERT(!add(&cache, 4, 256, 2 * size));
+    TEST_ASSERT(cached(&cache, 0, 256) && cached(&cache, 1, 256));
+    check(&cache);
+
+    /* Pinning is per source, any parameters */
+    TEST_ASSERT(lvgl_port_cache_pin(&cache, &sources[3], true));
+    TEST_ASSERT(!add(&cache, 0, 300, size));
+    TEST_ASSERT(lvgl_port_cache_pin(&cache, &sources[3], false));
+    TEST_ASSERT(add(&cache, 0, 300, size));
+    TEST_ASSERT(lvgl_port_cache_pinned(&cache, &sources[0]) && !lvgl_port_cache_pinned(&cache, &sources[3]));
+    check(&cache);
+
+    /* Only the last used parameters stay pinned */
+    TEST_ASSERT(add(&cache, 2, 256, size));
+    TEST_ASSERT(cached(&cache, 0, 300) && cached(&cache, 1, 256) && !cached(&cache, 0, 256));
+
+    /* The next layer starts without pins, statistics are its own */
+    lvgl_port_cache_set_layer(&cache, 2);
+    TEST_ASSERT(!lvgl_port_cache_pinned(&cache, &sources[0]));
+    lvgl_port_cache_key_t key = key_of(1, 256);
+    TEST_ASSERT(lvgl_port_cache_find(&cache, &key));
+    TEST_ASSERT(add(&cache, 5, 256, 2 * size));
+    TEST_ASSERT(cached(&cache, 1, 256) && cached(&cache, 5, 256));
+    TEST_ASSERT(cache.stats[2].hits == 1 && cache.stats[2].entries == 1);
+    TEST_ASSERT(cache.stats[1].entries == 1 && cache.stats[1].evictions == 5);
+    TEST_ASSERT(cache.stats[1].hits == 0 && cache.stats[2].misses == 0);
+    check(&cache);
+
+    /* Layers past the table count as the default one */
+    lvgl_port_cache_set_layer(&cache, LVGL_PORT_CACHE_LAYERS);
+    TEST_ASSERT(cache.layer == 0);
+
+    /* Pin table full */
+    static const char others[LVGL_PORT_CACHE_PINS];
+    for (int i = 0; i < LVGL_PORT_CACHE_PINS; i++) {
+        TEST_ASSERT(lvgl_port_cache_pin(&cache, &others[i], true));
+    }
+    TEST_ASSERT(!lvgl_port_cache_pin(&cache, &sources[0], true));
+    TEST_ASSERT(lvgl_port_cache_pin(&cache, &others[0], true));
+
+    lvgl_port_cache_deinit(&cache);
+}
+
+static void test_admit(void)
+{
+    lvgl_port_cache_t cache;
+
+    lvgl_port_cache_init(&cache, 1000);
+    lvgl_port_cache_key_t key = key_of(0, 256);
+    TEST_ASSERT(!lvgl_port_cache_admit(&cache, &key));
+    TEST_ASSERT(lvgl_port_cache_admit(&cache, &key));
+    /* Admitted once, remembered again */
+    TEST_ASSERT(!lvgl_port_cache_admit(&cache, &key));
+
+    /* A key changing every time is never admitted */
+    for (uint16_t zoom = 100; zoom < 200; zoom++) {
+        key = key_of(1, zoom);
+        TEST_ASSERT(!lvgl_port_cache_admit(&cache, &key));
+    }
+
+    /* Forgotten after LVGL_PORT_CACHE_GHOSTS other misses */
+    key = key_of(2, 256);
+    TEST_ASSERT(!lvgl_port_cache_admit(&cache, &key));
+    for (int i = 0; i < LVGL_PORT_CACHE_GHOSTS - 1; i++) {
+        lvgl_port_cache_key_t other = key_of(3, i);
+        lvgl_port_cache_admit(&cache, &other);
+    }
+    TEST_ASSERT(lvgl_port_cache_admit(&cache, &key));
+    key = key_of(4, 256);
+    TEST_ASSERT(!lvgl_port_cache_admit(&cache, &key));
+    for (int i = 0; i < LVGL_PORT_CACHE_GHOSTS; i++) {
+        lvgl_port_cache_key_t other = key_of(3, 300 + i);
+        lvgl_port_cache_admit(&cache, &other);
+    }
+    TEST_ASSERT(!lvgl_port_cache_admit(&cache, &key));
+
+    lvgl_port_cache_deinit(&cache);
+}
+
+static void test_random(void)
+{
+    lvgl_port_cache_t cache;
+
+    lvgl_port_cache_init(&cache, 20000);
+    for (int i = 0; i < RANDOM_OPS; i++) {
+        const int src = rand() % RANDOM_SOURCES;
+        const uint16_t zoom = 200 + rand() % 4;
+        lvgl_port_cache_key_t key = key_of(src, zoom);
+
+        switch (rand() % 8) {
+        case 0:
+            lvgl_port_cache_set_layer(&cache, rand() % LVGL_PORT_CACHE_LAYERS);
+            break;
+        case 1:
+            lvgl_port_cache_pin(&cache, &sources[src], rand() % 2);
+            break;
+        case 2:
+            if (cache.head) {
+                lvgl_port_cache_entry_t *e = cache.head;
+                for (int n = rand() % 4; n && e->next; n--) {
+                    e = e->next;
+                }
+                if (rand() % 2) {
+                    lvgl_port_cache_shrink(&cache, e, 1 + rand() % e->size);
+                } else {
+                    lvgl_port_cache_remove(&cache, e);
+                }
+            }
+            break;
+        default:
+            if (!lvgl_port_cache_find(&cache, &key)) {
+                const size_t used = cache.used;
+                /* Nothing is evicted for an entry not fitting */
+                if (!add(&cache, src, zoom, 1 + rand() % 6000)) {
+                    TEST_ASSERT(cache.used == used);
+                }
+            } else {
+                TEST_ASSERT(cache.head->key.src == &sources[src] && cache.head->key.zoom == zoom);
+            }
+            break;
+        }
+        check(&cache);
+    }
+
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    for (int i = 0; i < LVGL_PORT_CACHE_LAYERS; i++) {
+        hits += cache.stats[i].hits;
+        misses += cache.stats[i].misses;
+    }
+    printf("cache: %u hits, %u misses, %zu of %zu bytes held\n", hits, misses, cache.used, cache.budget);
+    lvgl_port_cache_deinit(&cache);
+}
+
+int main(void)
+{
+    srand(1);
+    test_lru();
+    test_pin_layers();
+    test_admit();
+    test_random();
+
+    printf("All cache tests passed\n");
+    return 0;
+}
@@ -0,0 +1,225 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Clip shapes of circles, fades and random rows. Applying any part of a row, in or out of the box,
+ * to a random mask must give the mask of mixing in every opacity of the shape one by one, the way
+ * of LVGL 8's mask_mix(), and the mask must not be written when the row is transparent or fully
+ * covering.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lvgl_port_clip.h"
+#include "test_common.h"
+
+#define MAX_W           (64)
+#define MAX_H           (48)
+#define RUNS            (300)
+#define BENCH_D         (226)
+#define BENCH_RUNS      (300)
+
+/* mask_mix() of lv_draw_mask.c */
+static uint8_t mix(uint8_t mask, uint8_t opa)
+{
+    if (opa >= LVGL_PORT_CLIP_OPA_MAX) {
+        return mask;
+    }
+    if (opa <= LVGL_PORT_CLIP_OPA_MIN) {
+        return 0;
+    }
+    return ((uint32_t)mask * opa * 0x8081U) >> 23;
+}
+
+static void reference(const uint8_t *map, uint16_t w, uint16_t h, uint8_t *mask, int32_t x, int32_t y, int32_t len)
+{
+    for (int32_t i = 0; i < len; i++) {
+        const int32_t px = x + i;
+        const bool in = px >= 0 && px < w && y >= 0 && y < h;
+        mask[i] = in ? mix(mask[i], map[y * w + px]) : 0;
+    }
+}
+
+/* Circle of 4x4 samples per pixel, the shape of a radius mask */
+static void make_circle(uint8_t *map, uint16_t w, uint16_t h)
+{
+    const float cx = w / 2.0f;
+    const float cy = h / 2.0f;
+    const float r = (w < h ? w : h) / 2.0f;
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            int in = 0;
+            for (int s = 0; s < 16; s++) {
+                const float dx = x + (s % 4 + 0.5f) / 4 - cx;
+                const float dy = y + (s / 4 + 0.5f) / 4 - cy;
+                in += dx * dx + dy * dy <= r * r;
+            }
+            map[y * w + x] = in * 255 / 16;
+        }
+    }
+}
+
+/* Fade in at the top and out at the bottom, like the fade masks of a roller */
+static void make_fade(uint8_t *map, uint16_t w, uint16_t h)
+{
+    const int top = h / 3;
+    for (int y = 0; y < h; y++) {
+        int opa = 255;
+        if (y < top) {
+            opa = 255 * y / top;
+        } else if (y >= h - top) {
+            opa = 255 * (h - 1 - y) / top;
+        }
+        memset(&map[y * w], opa, w);
+    }
+}
+
+/* Runs of random opacities, some transparent, covering or close to */
+static void make_random(uint8_t *map, uint16_t w, uint16_t h)
+{
+    static const uint8_t opas[] = {0, 1, 2, 3, 128, 252, 253, 254, 255};
+
+    for (int i = 0; i < w * h;) {
+        const int run = 1 + rand() % 12;
+        const uint8_t v = (rand() % 2) ? opas[rand() % sizeof(opas)] : rand();
+        for (int k = 0; k < run && i < w * h; k++) {
+            map[i++] = v;
+        }
+    }
+}
+
+static void check_shape(const uint8_t *map, uint16_t w, uint16_t h)
+{
+    static uint8_t mask[MAX_W * 2 + 1];
+    static uint8_t expected[MAX_W * 2];
+    static uint8_t before[MAX_W * 2];
+    lvgl_port_clip_t clip;
+
+    TEST_ASSERT(lvgl_port_clip_init(&clip, w, h));
+    for (uint16_t y = 0; y < h; y++) {
+        TEST_ASSERT(lvgl_port_clip_set_row(&clip, y, &map[y * w]));
+    }
+    TEST_ASSERT(!lvgl_port_clip_set_row(&clip, h, map));
+
+    for (int32_t y = -1; y <= h; y++) {
+        for (int run = 0; run < 20; run++) {
+            const int32_t x = rand() % (w + 8) - 4;
+            const int32_t len = 1 + rand() % (w + 8);
+            for (int32_t i = 0; i < len; i++) {
+                /* Full masks find the covering rows */
+                before[i] = (run % 2) ? 255 : rand();
+            }
+            memcpy(mask, before, len);
+            memcpy(expected, before, len);
+            mask[len] = 0xA5;
+            reference(map, w, h, expected, x, y, len);
+
+            const lvgl_port_clip_res_t res = lvgl_port_clip_apply(&clip, mask, x, y, len);
+            TEST_ASSERT(mask[len] == 0xA5);
+            if (res == LVGL_PORT_CLIP_CHANGED) {
+                TEST_ASSERT(memcmp(mask, expected, len) == 0);
+            } else {
+                TEST_ASSERT(memcmp(mask, before, len) == 0);
+                for (int32_t i = 0; i < len; i++) {
+                    TEST_ASSERT(expected[i] == (res == LVGL_PORT_CLIP_TRANSP ? 0 : before[i]));
+                }
+            }
+        }
+    }
+    lvgl_port_clip_deinit(&clip);
+}
+
+static void test_shapes(void)
+{
+    static uint8_t map[MAX_W * MAX_H];
+
+    for (int run = 0; run < RUNS; run++) {
+        const uint16_t w = 1 + rand() % MAX_W;
+        const uint16_t h = 1 + rand() % MAX_H;
+        switch (run % 3) {
+        case 0:
+            make_circle(map, w, h);
+            break;
+        case 1:
+            make_fade(map, w, h);
+            break;
+        default:
+            make_random(map, w, h);
+            break;
+        }
+        check_shape(map, w, h);
+    }
+}
+
+static void test_rows(void)
+{
+    static const uint8_t row[8] = {0, 1, 100, 255, 254, 253, 100, 2};
+    lvgl_port_clip_t clip;
+    uint8_t mask[8];
+
+    /* Transparent sides and a covering span are not stored */
+    TEST_ASSERT(lvgl_port_clip_init(&clip, 8, 2));
+    TEST_ASSERT(lvgl_port_clip_set_row(&clip, 0, row));
+    TEST_ASSERT(clip.rows[0].x1 == 2 && clip.rows[0].x2 == 7);
+    TEST_ASSERT(clip.rows[0].span_x1 == 3 && clip.rows[0].span_x2 == 6 && clip.rows[0].opa == 255);
+    TEST_ASSERT(clip.edges_len == 2);
+    memset(mask, 0x7F, sizeof(mask));
+    TEST_ASSERT(lvgl_port_clip_apply(&clip, mask, 3, 0, 3) == LVGL_PORT_CLIP_FULL_COVER);
+    TEST_ASSERT(lvgl_port_clip_apply(&clip, mask, -4, 0, 6) == LVGL_PORT_CLIP_TRANSP);
+    TEST_ASSERT(lvgl_port_clip_apply(&clip, mask, 7, 0, 4) == LVGL_PORT_CLIP_TRANSP);
+
+    /* Unset rows are transparent */
+    TEST_ASSERT(lvgl_port_clip_apply(&clip, mask, 0, 1, 8) == LVGL_PORT_CLIP_TRANSP);
+    lvgl_port_clip_deinit(&clip);
+}
+
+static void bench_circle(void)
+{
+    static uint8_t map[BENCH_D * BENCH_D];
+    static uint8_t mask[BENCH_D];
+    lvgl_port_clip_t clip;
+    struct timespec start, end;
+    double s[2];
+
+    make_circle(map, BENCH_D, BENCH_D);
+    TEST_ASSERT(lvgl_port_clip_init(&clip, BENCH_D, BENCH_D));
+    for (uint16_t y = 0; y < BENCH_D; y++) {
+        TEST_ASSERT(lvgl_port_clip_set_row(&clip, y, &map[y * BENCH_D]));
+    }
+    for (int impl = 0; impl < 2; impl++) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < BENCH_RUNS; i++) {
+            for (int32_t y = 0; y < BENCH_D; y++) {
+                memset(mask, 255, sizeof(mask));
+                if (impl) {
+                    lvgl_port_clip_apply(&clip, mask, 0, y, BENCH_D);
+                } else {
+                    reference(map, BENCH_D, BENCH_D, mask, 0, y, BENCH_D);
+                }
+                map[0] ^= mask[y];
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        s[impl] = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    }
+    printf("clip circle %ux%u: per pixel %.1f us, spans %.1f us, %u B of edges\n", BENCH_D, BENCH_D,
+           s[0] / BENCH_RUNS * 1e6, s[1] / BENCH_RUNS * 1e6, (unsigned)clip.edges_len);
+    lvgl_port_clip_deinit(&clip);
+}
+
+int main(void)
+{
+    srand(1);
+    test_rows();
+    test_shapes();
+    bench_circle();
+
+    printf("All clip tests passed\n");
+    return 0;
+}
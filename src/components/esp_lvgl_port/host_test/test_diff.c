@@ -0,0 +1,193 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Changed spans of flushed areas, sent through lvgl_port_round_flush_spans() to a mock panel,
+ * which must always show the screen content.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl_port_diff.h"
+#include "lvgl_port_round.h"
+#include "test_common.h"
+
+#define HRES            (240)
+#define VRES            (240)
+#define TILE_W          (32)
+#define TRANS_COST      (128)
+#define RANDOM_STEPS    (2000)
+
+static uint16_t screen[VRES][HRES];     /* Content rendered by LVGL */
+static uint16_t panel[VRES][HRES];      /* Content of the LCD */
+static uint16_t area_buf[VRES * HRES];
+static uint32_t bytes_sent;
+
+static void mock_panel_send(void *user_ctx, int x1, int y1, int x2, int y2, const void *data)
+{
+    (void)user_ctx;
+    const uint16_t *px = data;
+
+    for (int y = y1; y <= y2; y++) {
+        for (int x = x1; x <= x2; x++) {
+            panel[y][x] = *px++;
+        }
+    }
+    bytes_sent += (x2 - x1 + 1) * (y2 - y1 + 1) * sizeof(uint16_t);
+}
+
+/* Render the area into the draw buffer and flush its changed spans */
+static uint32_t flush(lvgl_port_diff_t *diff, const lvgl_port_round_t *round, int x1, int y1, int x2, int y2)
+{
+    const int w = x2 - x1 + 1;
+
+    for (int y = y1; y <= y2; y++) {
+        memcpy(&area_buf[(y - y1) * w], &screen[y][x1], w * sizeof(uint16_t));
+    }
+    bytes_sent = 0;
+    lvgl_port_diff_area(diff, x1, y1, x2, y2, area_buf, round ? round->span_x1 : NULL, round ? round->span_x2 : NULL);
+    lvgl_port_round_flush_spans(diff->span_x1, diff->span_x2, TRANS_COST, x1, y1, x2, y2, area_buf, sizeof(uint16_t),
+                                mock_panel_send, NULL, NULL);
+    return bytes_sent;
+}
+
+static void check_panel(const lvgl_port_round_t *round)
+{
+    for (int y = 0; y < VRES; y++) {
+        for (int x = 0; x < HRES; x++) {
+            if (!round || (x >= round->span_x1[y] && x <= round->span_x2[y])) {
+                TEST_ASSERT(panel[y][x] == screen[y][x]);
+            }
+        }
+    }
+}
+
+static void fill_random(int x1, int y1, int x2, int y2)
+{
+    for (int y = y1; y <= y2; y++) {
+        for (int x = x1; x <= x2; x++) {
+            screen[y][x] = rand();
+        }
+    }
+}
+
+static void test_unchanged(void)
+{
+    lvgl_port_diff_t diff;
+    TEST_ASSERT(lvgl_port_diff_init(&diff, HRES, VRES, TILE_W));
+    TEST_ASSERT(diff.tiles == (HRES + TILE_W - 1) / TILE_W);
+    TEST_ASSERT(lvgl_port_diff_mem(&diff) == (size_t)VRES * diff.tiles * 4 + VRES * 4);
+
+    fill_random(0, 0, HRES - 1, VRES - 1);
+    TEST_ASSERT(flush(&diff, NULL, 0, 0, HRES - 1, VRES - 1) == HRES * VRES * 2);
+    check_panel(NULL);
+
+    /* Same content again, nothing is sent */
+    TEST_ASSERT(flush(&diff, NULL, 0, 0, HRES - 1, VRES - 1) == 0);
+    TEST_ASSERT(flush(&diff, NULL, 64, 100, 127, 139) == 0);
+
+    /* After a reset everything is sent */
+    lvgl_port_diff_reset(&diff);
+    TEST_ASSERT(flush(&diff, NULL, 64, 100, 127, 139) == 64 * 40 * 2);
+
+    lvgl_port_diff_deinit(&diff);
+}
+
+static void test_one_pixel(void)
+{
+    lvgl_port_diff_t diff;
+    TEST_ASSERT(lvgl_port_diff_init(&diff, HRES, VRES, TILE_W));
+    fill_random(0, 0, HRES - 1, VRES - 1);
+    flush(&diff, NULL, 0, 0, HRES - 1, VRES - 1);
+
+    /* One pixel of a label changes, only its tile is sent */
+    screen[120][70]++;
+    TEST_ASSERT(flush(&diff, NULL, 64, 110, 127, 129) == TILE_W * 2);
+    TEST_ASSERT(diff.span_x1[120] == 64 && diff.span_x2[120] == 64 + TILE_W - 1);
+    TEST_ASSERT(diff.span_x1[119] > diff.span_x2[119]);
+    check_panel(NULL);
+
+    /* Two tiles of one row, the unchanged tile in between is cheaper than another window */
+    screen[121][65]++;
+    screen[121][127]++;
+    TEST_ASSERT(flush(&diff, NULL, 64, 110, 127, 129) == 2 * TILE_W * 2);
+    check_panel(NULL);
+
+    lvgl_port_diff_deinit(&diff);
+}
+
+static void test_partial_tiles(void)
+{
+    lvgl_port_diff_t diff;
+    TEST_ASSERT(lvgl_port_diff_init(&diff, HRES, VRES, TILE_W));
+    fill_random(0, 0, HRES - 1, VRES - 1);
+    flush(&diff, NULL, 0, 0, HRES - 1, VRES - 1);
+
+    /* Tiles cut by the area can't be compared, they are sent and become unknown */
+    TEST_ASSERT(flush(&diff, NULL, 40, 0, 70, 9) == (64 - 40 + 70 - 64 + 1) * 10 * 2);
+    TEST_ASSERT(flush(&diff, NULL, 32, 0, 95, 9) == 2 * TILE_W * 10 * 2);
+    TEST_ASSERT(flush(&diff, NULL, 32, 0, 95, 9) == 0);
+
+    int x1 = 40;
+    int x2 = 70;
+    lvgl_port_diff_align(&diff, &x1, &x2);
+    TEST_ASSERT(x1 == 32 && x2 == 95);
+    x1 = 200;
+    x2 = 230;
+    lvgl_port_diff_align(&diff, &x1, &x2);
+    TEST_ASSERT(x1 == 192 && x2 == HRES - 1);
+
+    lvgl_port_diff_deinit(&diff);
+}
+
+/* Random areas and changes, the panel must always match the screen */
+static void test_random(bool is_round)
+{
+    lvgl_port_diff_t diff;
+    lvgl_port_round_t round;
+    TEST_ASSERT(lvgl_port_diff_init(&diff, HRES, VRES, TILE_W));
+    TEST_ASSERT(lvgl_port_round_init(&round, HRES, VRES, TRANS_COST));
+    const lvgl_port_round_t *vis = is_round ? &round : NULL;
+
+    srand(1);
+    fill_random(0, 0, HRES - 1, VRES - 1);
+    memset(panel, 0, sizeof(panel));
+    flush(&diff, vis, 0, 0, HRES - 1, VRES - 1);
+    check_panel(vis);
+
+    for (int i = 0; i < RANDOM_STEPS; i++) {
+        int x1 = rand() % HRES;
+        int x2 = x1 + rand() % (HRES - x1);
+        const int y1 = rand() % VRES;
+        const int y2 = y1 + rand() % (VRES - y1 < 40 ? VRES - y1 : 40);
+        if (rand() % 2) {
+            lvgl_port_diff_align(&diff, &x1, &x2);
+        }
+        for (int n = rand() % 4; n > 0; n--) {
+            const int cx = x1 + rand() % (x2 - x1 + 1);
+            const int cy = y1 + rand() % (y2 - y1 + 1);
+            screen[cy][cx] = rand();
+        }
+        flush(&diff, vis, x1, y1, x2, y2);
+        check_panel(vis);
+    }
+
+    lvgl_port_round_deinit(&round);
+    lvgl_port_diff_deinit(&diff);
+}
+
+int main(void)
+{
+    test_unchanged();
+    test_one_pixel();
+    test_partial_tiles();
+    test_random(false);
+    test_random(true);
+
+    printf("All diff tests passed\n");
+    return 0;
+}
@@ -0,0 +1,173 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Glyph bitmaps of random sizes and pixels. The expanded mask must equal the one of a copy of the
+ * pixel loop of LVGL 8's lv_draw_sw_letter.c, for each bit depth and opacity, without writing past
+ * the glyph, and bit depths LVGL can't draw must be rejected.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lvgl_port_glyph.h"
+#include "test_common.h"
+
+#define MAX_W           (40)
+#define MAX_H           (40)
+#define RUNS            (500)
+#define BENCH_W         (14)
+#define BENCH_H         (20)
+#define BENCH_RUNS      (200000)
+
+static const uint8_t bpp1_opa_table[2] = {0, 255};
+static const uint8_t bpp2_opa_table[4] = {0, 85, 170, 255};
+static const uint8_t bpp4_opa_table[16] = {0, 17, 34, 51, 68, 85, 102, 119, 136, 153, 170, 187, 204, 221, 238, 255};
+
+/* Pixel loop of draw_letter_normal(), unclipped */
+static void reference(const uint8_t *map_p, uint8_t bpp, uint16_t w, uint16_t h, uint8_t opa, uint8_t *mask)
+{
+    static uint8_t bpp8_opa_table[256];
+    static uint8_t opa_table[256];
+    const uint8_t *bpp_opa_table_p;
+    uint32_t bitmask_init;
+    uint32_t shades;
+
+    for (int i = 0; i < 256; i++) {
+        bpp8_opa_table[i] = i;
+    }
+    if (bpp == 3) {
+        bpp = 4;
+    }
+    switch (bpp) {
+    case 1:
+        bpp_opa_table_p = bpp1_opa_table;
+        bitmask_init = 0x80;
+        shades = 2;
+        break;
+    case 2:
+        bpp_opa_table_p = bpp2_opa_table;
+        bitmask_init = 0xC0;
+        shades = 4;
+        break;
+    case 4:
+        bpp_opa_table_p = bpp4_opa_table;
+        bitmask_init = 0xF0;
+        shades = 16;
+        break;
+    default:
+        bpp_opa_table_p = bpp8_opa_table;
+        bitmask_init = 0xFF;
+        shades = 256;
+        break;
+    }
+    if (opa < LVGL_PORT_GLYPH_OPA_MAX) {
+        for (uint32_t i = 0; i < shades; i++) {
+            opa_table[i] = bpp_opa_table_p[i] == 255 ? opa : ((bpp_opa_table_p[i] * opa) >> 8);
+        }
+        bpp_opa_table_p = opa_table;
+    }
+
+    uint32_t col_bit = 0;
+    uint32_t col_bit_max = 8 - bpp;
+    uint32_t mask_p = 0;
+    for (uint32_t row = 0; row < h; row++) {
+        uint32_t bitmask = bitmask_init >> col_bit;
+        for (uint32_t col = 0; col < w; col++) {
+            const uint8_t letter_px = (*map_p & bitmask) >> (col_bit_max - col_bit);
+            mask[mask_p++] = letter_px ? bpp_opa_table_p[letter_px] : 0;
+            if (col_bit < col_bit_max) {
+                col_bit += bpp;
+                bitmask = bitmask >> bpp;
+            } else {
+                col_bit = 0;
+                bitmask = bitmask_init;
+                map_p++;
+            }
+        }
+    }
+}
+
+static void test_mask(uint8_t bpp)
+{
+    static uint8_t bitmap[MAX_W * MAX_H + 1];
+    static uint8_t expected[MAX_W * MAX_H];
+    static uint8_t mask[MAX_W * MAX_H + 1];
+    static const uint8_t opas[] = {255, 254, 253, 252, 128, 1};
+
+    for (int run = 0; run < RUNS; run++) {
+        const uint16_t w = rand() % (MAX_W + 1);
+        const uint16_t h = rand() % (MAX_H + 1);
+        const uint8_t opa = opas[run % sizeof(opas)];
+        const uint32_t count = (uint32_t)w * h;
+
+        for (size_t i = 0; i < sizeof(bitmap); i++) {
+            bitmap[i] = rand();
+        }
+        reference(bitmap, bpp, w, h, opa, expected);
+        memset(mask, 0xA5, sizeof(mask));
+        TEST_ASSERT(lvgl_port_glyph_mask(bitmap, bpp, w, h, opa, mask));
+        TEST_ASSERT(memcmp(mask, expected, count) == 0);
+        TEST_ASSERT(mask[count] == 0xA5);
+    }
+}
+
+static void test_invalid(void)
+{
+    static const uint8_t bitmap[4];
+    uint8_t mask[4] = {0};
+
+    TEST_ASSERT(!lvgl_port_glyph_bpp_valid(0));
+    TEST_ASSERT(!lvgl_port_glyph_bpp_valid(5));
+    TEST_ASSERT(!lvgl_port_glyph_bpp_valid(9));
+    TEST_ASSERT(!lvgl_port_glyph_mask(bitmap, 5, 2, 2, 255, mask));
+    TEST_ASSERT(lvgl_port_glyph_mask(bitmap, 8, 0, 0, 255, mask));
+}
+
+static void bench_mask(void)
+{
+    static uint8_t bitmap[BENCH_W * BENCH_H];
+    static uint8_t mask[BENCH_W * BENCH_H];
+    struct timespec start, end;
+
+    for (size_t i = 0; i < sizeof(bitmap); i++) {
+        bitmap[i] = rand();
+    }
+    for (uint8_t bpp = 1; bpp <= 8; bpp *= 2) {
+        double s[2];
+        for (int impl = 0; impl < 2; impl++) {
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (int i = 0; i < BENCH_RUNS; i++) {
+                if (impl) {
+                    lvgl_port_glyph_mask(bitmap, bpp, BENCH_W, BENCH_H, 255, mask);
+                } else {
+                    reference(bitmap, bpp, BENCH_W, BENCH_H, 255, mask);
+                }
+                bitmap[0] ^= mask[i % sizeof(mask)];
+            }
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            s[impl] = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+        }
+        printf("glyph %u-bit %ux%u: LVGL loop %.0f ns, expanded %.0f ns\n", bpp, BENCH_W, BENCH_H,
+               s[0] / BENCH_RUNS * 1e9, s[1] / BENCH_RUNS * 1e9);
+    }
+}
+
+int main(void)
+{
+    srand(1);
+    test_mask(1);
+    test_mask(2);
+    test_mask(3);
+    test_mask(4);
+    test_mask(8);
+    test_invalid();
+    bench_mask();
+
+    printf("All glyph tests passed\n");
+    return 0;
+}
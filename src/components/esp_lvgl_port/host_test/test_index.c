@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Indexed images, packed like scripts/lvgl_port_img_index.py does. Every part of every row must
+ * expand to the palette colors of a reference unpacker, for each index size and output format, and
+ * data too short for the image must be rejected.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lvgl_port_index.h"
+#include "test_common.h"
+
+#define W               (37)
+#define H               (5)
+#define BENCH_W         (240)
+#define BENCH_H         (240)
+#define BENCH_RUNS      (50)
+
+/* Random palette and indices, packed from the most significant bit, rows byte aligned */
+static size_t make_image(uint8_t *out, uint8_t *idx, uint32_t w, uint32_t h, uint8_t bpp, bool opaque)
+{
+    const uint32_t count = 1u << bpp;
+    const uint32_t stride = (w * bpp + 7) / 8;
+    uint8_t *p = out;
+
+    for (uint32_t i = 0; i < count * 4; i++) {
+        *p++ = ((i & 3) == 3 && opaque) ? 0xFF : rand() & 0xFF;
+    }
+    memset(p, 0, stride * h);
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = 0; x < w; x++) {
+            const uint8_t i = rand() % count;
+            const uint32_t bit = x * bpp;
+            idx[y * w + x] = i;
+            p[y * stride + bit / 8] |= i << (8 - bpp - bit % 8);
+        }
+    }
+    return count * 4 + stride * h;
+}
+
+static void expect(const uint8_t *palette, uint8_t i, bool alpha, uint8_t *out)
+{
+    const uint8_t *c = palette + i * 4;
+    const uint16_t px = ((c[2] & 0xF8) << 8) | ((c[1] & 0xFC) << 3) | (c[0] >> 3);
+    out[0] = px & 0xFF;
+    out[1] = px >> 8;
+    if (alpha) {
+        out[2] = c[3];
+    }
+}
+
+static void test_read(uint8_t bpp)
+{
+    static uint8_t data[1024 + W * H];
+    static uint8_t idx[W * H];
+    static uint8_t out[W * 3 + 1];
+    static uint8_t ref[W * 3];
+    static lvgl_port_index_palette_t pal;
+    lvgl_port_index_img_t img;
+
+    for (int opaque = 0; opaque < 2; opaque++) {
+        const size_t size = make_image(data, idx, W, H, bpp, opaque);
+        TEST_ASSERT(lvgl_port_index_open(&img, data, size, W, H, bpp));
+        TEST_ASSERT(img.stride == (W * bpp + 7) / 8u);
+
+        /* Not converted yet */
+        memset(&pal, 0, sizeof(pal));
+        TEST_ASSERT(!lvgl_port_index_read(&img, &pal, 0, 0, W, false, out));
+        lvgl_port_index_palette(&pal, &img);
+        TEST_ASSERT(pal.opaque == (bool)opaque);
+
+        for (int alpha = 0; alpha < 2; alpha++) {
+            const uint32_t px_size = alpha ? 3 : 2;
+            for (uint32_t y = 0; y < H; y++) {
+                for (uint32_t x = 0; x < W; x++) {
+                    for (uint32_t len = 0; x + len <= W; len++) {
+                        out[len * px_size] = 0xA5;
+                        TEST_ASSERT(lvgl_port_index_read(&img, &pal, x, y, len, alpha, out));
+                        for (uint32_t i = 0; i < len; i++) {
+                            expect(data, idx[y * W + x + i], alpha, ref + i * px_size);
+                        }
+                        TEST_ASSERT(memcmp(out, ref, len * px_size) == 0);
+                        TEST_ASSERT(out[len * px_size] == 0xA5);
+                    }
+                }
+            }
+        }
+
+        /* Outside of the image */
+        TEST_ASSERT(!lvgl_port_index_read(&img, &pal, 0, H, 1, false, out));
+        TEST_ASSERT(!lvgl_port_index_read(&img, &pal, W - 1, 0, 2, false, out));
+        TEST_ASSERT(!lvgl_port_index_read(&img, &pal, W + 1, 0, 0, false, out));
+        TEST_ASSERT(!lvgl_port_index_read(&img, &pal, 1, 0, UINT32_MAX, false, out));
+
+        /* Data too short */
+        TEST_ASSERT(!lvgl_port_index_open(&img, data, size - 1, W, H, bpp));
+    }
+}
+
+static void test_invalid(void)
+{
+    static uint8_t data[64];
+    lvgl_port_index_img_t img;
+
+    TEST_ASSERT(!lvgl_port_index_open(&img, data, sizeof(data), 1, 1, 3));
+    TEST_ASSERT(!lvgl_port_index_open(&img, data, sizeof(data), 1, 1, 16));
+    TEST_ASSERT(!lvgl_port_index_open(&img, data, sizeof(data), 0, 1, 1));
+    TEST_ASSERT(!lvgl_port_index_open(&img, NULL, sizeof(data), 1, 1, 1));
+    /* Palette of 16 entries and a row of one byte */
+    TEST_ASSERT(!lvgl_port_index_open(&img, data, 64, 2, 1, 4));
+    TEST_ASSERT(lvgl_port_index_open(&img, data, 9, 8, 1, 1));
+}
+
+static void bench_read(void)
+{
+    static uint8_t data[1024 + BENCH_W * BENCH_H];
+    static uint8_t idx[BENCH_W * BENCH_H];
+    static uint8_t out[BENCH_W * 3];
+    static lvgl_port_index_palette_t pal;
+    lvgl_port_index_img_t img;
+    struct timespec start;
+    struct timespec end;
+
+    for (uint8_t bpp = 1; bpp <= 8; bpp *= 2) {
+        const size_t size = make_image(data, idx, BENCH_W, BENCH_H, bpp, true);
+        TEST_ASSERT(lvgl_port_index_open(&img, data, size, BENCH_W, BENCH_H, bpp));
+        pal.key = NULL;
+        lvgl_port_index_palette(&pal, &img);
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < BENCH_RUNS; i++) {
+            for (uint32_t y = 0; y < BENCH_H; y++) {
+                lvgl_port_index_read(&img, &pal, 0, y, BENCH_W, false, out);
+                __asm__ volatile("" ::: "memory");
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        const double s = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+        printf("index %u-bit: %u -> %zu bytes, expand %.0f Mpx/s\n", bpp, BENCH_W * BENCH_H * 2, size,
+               (double)BENCH_W * BENCH_H * BENCH_RUNS / s / 1e6);
+    }
+}
+
+int main(void)
+{
+    srand(1);
+    test_read(1);
+    test_read(2);
+    test_read(4);
+    test_read(8);
+    test_invalid();
+    bench_read();
+
+    printf("All index tests passed\n");
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Frame pacing with estimated vsync and with a simulated TE output.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "lvgl_port_pacing.h"
+#include "test_common.h"
+
+#define SCAN_US         (16667)
+
+static void test_estimated_vsync(void)
+{
+    lvgl_port_pacing_t pacing;
+    lvgl_port_pacing_init(&pacing, SCAN_US, 1000);
+
+    TEST_ASSERT(!pacing.te_locked);
+    TEST_ASSERT(lvgl_port_pacing_next_vsync(&pacing, 1000) == 1000);
+    TEST_ASSERT(lvgl_port_pacing_next_vsync(&pacing, 1001) == 1000 + SCAN_US);
+    TEST_ASSERT(lvgl_port_pacing_next_vsync(&pacing, 1000 + 10 * SCAN_US) == 1000 + 10 * SCAN_US);
+    TEST_ASSERT(lvgl_port_pacing_next_vsync(&pacing, 1000 + 10 * SCAN_US + 5) == 1000 + 11 * SCAN_US);
+    TEST_ASSERT(lvgl_port_pacing_next_vsync(&pacing, 0) == 1000);
+
+    /* Refresh periods are whole scans */
+    TEST_ASSERT(lvgl_port_pacing_period(&pacing, 0) == 17);
+    TEST_ASSERT(lvgl_port_pacing_period(&pacing, 10) == 17);
+    TEST_ASSERT(lvgl_port_pacing_period(&pacing, 17) == 34);
+    TEST_ASSERT(lvgl_port_pacing_period(&pacing, 30) == 34);
+    TEST_ASSERT(lvgl_port_pacing_period(&pacing, 50) == 51);
+}
+
+static void test_te_lock(void)
+{
+    lvgl_port_pacing_t pacing;
+    lvgl_port_pacing_init(&pacing, SCAN_US, 0);
+
+    /* Real panel scans a bit slower with some jitter, one edge is missed */
+    const int real_scan = 17200;
+    int64_t t = 5000;
+    srand(7);
+    for (int i = 0; i < 200; i++) {
+        if (i != 50) {
+            lvgl_port_pacing_vsync(&pacing, t + (rand() % 41) - 20);
+        }
+        t += real_scan;
+    }
+    printf("TE: scan period %u us (real %d us)\n", pacing.scan_us, real_scan);
+    TEST_ASSERT(pacing.te_locked);
+    TEST_ASSERT(pacing.te_count == 199);
+    TEST_ASSERT(abs((int)pacing.scan_us - real_scan) < 50);
+
+    /* Next vsync is predicted from the last edge */
+    const int64_t next = lvgl_port_pacing_next_vsync(&pacing, t - 100);
+    TEST_ASSERT(llabs(next - t) < 100);
+}
+
+static void test_start(void)
+{
+    lvgl_port_pacing_t pacing;
+    lvgl_port_pacing_init(&pacing, SCAN_US, 0);
+
+    /* No lead known, start at vsync */
+    TEST_ASSERT(lvgl_port_pacing_start(&pacing, 100) == SCAN_US);
+
+    /* Rendering of the first strip takes 4 ms, start 4 ms before vsync */
+    lvgl_port_pacing_frame(&pacing, 0, 4000, 12000, 0);
+    TEST_ASSERT(pacing.lead_us == 4000);
+    TEST_ASSERT(lvgl_port_pacing_start(&pacing, 100) == SCAN_US - 4000);
+    /* Too late for this vsync, the next one */
+    TEST_ASSERT(lvgl_port_pacing_start(&pacing, SCAN_US - 3000) == 2 * SCAN_US - 4000);
+
+    /* First flush always comes right after a vsync */
+    for (int64_t now = 0; now < 10 * SCAN_US; now += 997) {
+        const int64_t start = lvgl_port_pacing_start(&pacing, now);
+        TEST_ASSERT(start >= now && start < now + SCAN_US);
+        TEST_ASSERT(lvgl_port_pacing_next_vsync(&pacing, start + pacing.lead_us) == start + pacing.lead_us);
+    }
+}
+
+static void test_stats(void)
+{
+    lvgl_port_pacing_t pacing;
+    lvgl_port_pacing_init(&pacing, SCAN_US, 0);
+
+    /* Paced animation, one frame every scan */
+    for (int i = 1; i <= 10; i++) {
+        const int64_t vsync = (int64_t)i * SCAN_US;
+        lvgl_port_pacing_frame(&pacing, vsync - 2000, vsync, vsync + 9000, 1);
+    }
+    TEST_ASSERT(pacing.frames == 10);
+    TEST_ASSERT(pacing.dropped == 0);
+    TEST_ASSERT(pacing.wasted == 0);
+
+    /* Slow frame misses two scans */
+    lvgl_port_pacing_frame(&pacing, 13 * SCAN_US - 2000, 13 * SCAN_US, 13 * SCAN_US + 9000, 1);
+    TEST_ASSERT(pacing.dropped == 2);
+
+    /* Two frames in one scan, the first one is never shown whole */
+    lvgl_port_pacing_frame(&pacing, 14 * SCAN_US, 14 * SCAN_US + 1000, 14 * SCAN_US + 3000, 0);
+    lvgl_port_pacing_frame(&pacing, 14 * SCAN_US + 4000, 14 * SCAN_US + 5000, 14 * SCAN_US + 8000, 0);
+    TEST_ASSERT(pacing.wasted == 1);
+    TEST_ASSERT(pacing.dropped == 2);
+}
+
+int main(void)
+{
+    test_estimated_vsync();
+    test_te_lock();
+    test_start();
+    test_stats();
+    printf("All frame pacing tests passed\n");
+    return 0;
+}
@@ -0,0 +1,137 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Lock-free command queue: order, full and empty queue, and concurrent producers.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include "lvgl_port_queue.h"
+#include "test_common.h"
+
+#define TEST_PRODUCERS      (4)
+#define TEST_PER_PRODUCER   (100000)
+
+static lvgl_port_queue_t queue;
+
+static void cmd_cb(void *arg)
+{
+    (void)arg;
+}
+
+static lvgl_port_queue_cmd_t cmd_of(uintptr_t value)
+{
+    lvgl_port_queue_cmd_t cmd = {
+        .cb = cmd_cb,
+        .arg = (void *)value,
+    };
+    return cmd;
+}
+
+static void test_order(void)
+{
+    lvgl_port_queue_cmd_t cmd;
+    lvgl_port_queue_init(&queue);
+
+    TEST_ASSERT(!lvgl_port_queue_pop(&queue, &cmd));
+
+    /* Several rounds over the cells */
+    for (uintptr_t round = 0; round < 5; round++) {
+        for (uintptr_t i = 0; i < LVGL_PORT_QUEUE_LEN / 2 + round; i++) {
+            cmd = cmd_of(round * 1000 + i);
+            TEST_ASSERT(lvgl_port_queue_push(&queue, &cmd));
+        }
+        for (uintptr_t i = 0; i < LVGL_PORT_QUEUE_LEN / 2 + round; i++) {
+            TEST_ASSERT(lvgl_port_queue_pop(&queue, &cmd));
+            TEST_ASSERT(cmd.cb == cmd_cb && (uintptr_t)cmd.arg == round * 1000 + i);
+        }
+        TEST_ASSERT(!lvgl_port_queue_pop(&queue, &cmd));
+    }
+}
+
+static void test_full(void)
+{
+    lvgl_port_queue_cmd_t cmd;
+    lvgl_port_queue_init(&queue);
+
+    for (uintptr_t i = 0; i < LVGL_PORT_QUEUE_LEN; i++) {
+        cmd = cmd_of(i);
+        TEST_ASSERT(lvgl_port_queue_push(&queue, &cmd));
+    }
+    cmd = cmd_of(LVGL_PORT_QUEUE_LEN);
+    TEST_ASSERT(!lvgl_port_queue_push(&queue, &cmd));
+    TEST_ASSERT(queue.dropped == 1 && queue.pushed == LVGL_PORT_QUEUE_LEN);
+
+    /* One pop frees one cell */
+    TEST_ASSERT(lvgl_port_queue_pop(&queue, &cmd) && (uintptr_t)cmd.arg == 0);
+    cmd = cmd_of(LVGL_PORT_QUEUE_LEN);
+    TEST_ASSERT(lvgl_port_queue_push(&queue, &cmd));
+    TEST_ASSERT(!lvgl_port_queue_push(&queue, &cmd));
+
+    for (uintptr_t i = 1; i <= LVGL_PORT_QUEUE_LEN; i++) {
+        TEST_ASSERT(lvgl_port_queue_pop(&queue, &cmd) && (uintptr_t)cmd.arg == i);
+    }
+    TEST_ASSERT(!lvgl_port_queue_pop(&queue, &cmd));
+}
+
+static void *producer(void *arg)
+{
+    const uintptr_t id = (uintptr_t)arg;
+
+    for (uintptr_t i = 0; i < TEST_PER_PRODUCER; i++) {
+        const lvgl_port_queue_cmd_t cmd = cmd_of((id << 24) | i);
+        while (!lvgl_port_queue_push(&queue, &cmd)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/* Every command arrives once, commands of one producer in order */
+static void test_producers(void)
+{
+    pthread_t threads[TEST_PRODUCERS];
+    uintptr_t next[TEST_PRODUCERS] = {0};
+    lvgl_port_queue_cmd_t cmd;
+    uint32_t received = 0;
+
+    lvgl_port_queue_init(&queue);
+    for (uintptr_t i = 0; i < TEST_PRODUCERS; i++) {
+        TEST_ASSERT(pthread_create(&threads[i], NULL, producer, (void *)i) == 0);
+    }
+
+    while (received < TEST_PRODUCERS * TEST_PER_PRODUCER) {
+        if (!lvgl_port_queue_pop(&queue, &cmd)) {
+            sched_yield();
+            continue;
+        }
+        const uintptr_t id = (uintptr_t)cmd.arg >> 24;
+        const uintptr_t seq = (uintptr_t)cmd.arg & 0xFFFFFF;
+        TEST_ASSERT(id < TEST_PRODUCERS);
+        TEST_ASSERT(seq == next[id]);
+        next[id]++;
+        received++;
+    }
+
+    for (int i = 0; i < TEST_PRODUCERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    TEST_ASSERT(!lvgl_port_queue_pop(&queue, &cmd));
+    TEST_ASSERT(queue.pushed == TEST_PRODUCERS * TEST_PER_PRODUCER);
+}
+
+int main(void)
+{
+    test_order();
+    test_full();
+    test_producers();
+    printf("All command queue tests passed\n");
+    return 0;
+}
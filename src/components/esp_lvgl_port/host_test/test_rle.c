@@ -0,0 +1,232 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Run-length encoded images, encoded like scripts/lvgl_port_img_rle.py does. Every part of every
+ * row must decode to the original pixels, with and without the cache, and corrupted data must be
+ * rejected instead of read out of bounds.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lvgl_port_rle.h"
+#include "test_common.h"
+
+#define W               (97)
+#define H               (23)
+#define MAX_PACKET      (128)
+#define BENCH_W         (240)
+#define BENCH_H         (240)
+#define BENCH_RUNS      (50)
+
+static uint8_t *put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = v >> 24;
+    return p + 4;
+}
+
+/* Reference encoder, the same packets as the script */
+static size_t encode(const uint8_t *px, uint32_t w, uint32_t h, uint8_t px_size, uint8_t *out)
+{
+    uint8_t *p = put_u32(out, LVGL_PORT_RLE_MAGIC);
+    *p++ = (px_size == 3) ? 5 : 4;
+    *p++ = px_size;
+    *p++ = 0;
+    *p++ = 0;
+    uint8_t *rows = p;
+    p += h * 4;
+
+    for (uint32_t y = 0; y < h; y++) {
+        const uint8_t *row = px + y * w * px_size;
+        uint32_t lit_start = 0;
+        uint32_t lit_len = 0;
+
+        put_u32(rows + y * 4, (uint32_t)(p - out));
+        for (uint32_t x = 0; x <= w;) {
+            uint32_t run = 1;
+            while (x < w && x + run < w && run < MAX_PACKET && memcmp(row + (x + run) * px_size, row + x * px_size, px_size) == 0) {
+                run++;
+            }
+            if (x == w || run >= 2 || lit_len == MAX_PACKET) {
+                if (lit_len > 0) {
+                    *p++ = lit_len - 1;
+                    memcpy(p, row + lit_start * px_size, lit_len * px_size);
+                    p += lit_len * px_size;
+                    lit_len = 0;
+                }
+                if (x == w) {
+                    break;
+                }
+            }
+            if (run >= 2) {
+                *p++ = 0x80 | (run - 1);
+                memcpy(p, row + x * px_size, px_size);
+                p += px_size;
+            } else {
+                if (lit_len == 0) {
+                    lit_start = x;
+                }
+                lit_len++;
+            }
+            x += run;
+        }
+    }
+
+    return p - out;
+}
+
+/* Flat art: runs of random length, some literal noise */
+static void make_image(uint8_t *px, uint32_t w, uint32_t h, uint8_t px_size)
+{
+    for (uint32_t y = 0; y < h; y++) {
+        uint32_t x = 0;
+        while (x < w) {
+            uint32_t len = 1 + rand() % ((rand() % 4) ? 300 : 3);
+            uint8_t color[3] = {rand() & 0xFF, rand() & 0xFF, rand() & 0xFF};
+            for (uint32_t i = 0; i < len && x < w; i++, x++) {
+                memcpy(px + (y * w + x) * px_size, color, px_size);
+            }
+        }
+    }
+}
+
+static void test_read(uint8_t px_size)
+{
+    static uint8_t px[W * H * 3];
+    static uint8_t enc[W * H * 4 + 1024];
+    uint8_t out[W * 3 + 1];
+    lvgl_port_rle_img_t img;
+
+    make_image(px, W, H, px_size);
+    const size_t size = encode(px, W, H, px_size, enc);
+    TEST_ASSERT(lvgl_port_rle_open(&img, enc, size, W, H));
+    TEST_ASSERT(img.px_size == px_size);
+
+    for (uint32_t y = 0; y < H; y++) {
+        for (uint32_t x = 0; x < W; x++) {
+            for (uint32_t len = 0; x + len <= W; len += 1 + len / 4) {
+                out[len * px_size] = 0xA5;
+                TEST_ASSERT(lvgl_port_rle_read(&img, x, y, len, out));
+                TEST_ASSERT(memcmp(out, px + (y * W + x) * px_size, len * px_size) == 0);
+                TEST_ASSERT(out[len * px_size] == 0xA5);
+            }
+        }
+    }
+
+    /* Outside of the image */
+    TEST_ASSERT(!lvgl_port_rle_read(&img, 0, H, 1, out));
+    TEST_ASSERT(!lvgl_port_rle_read(&img, W - 1, 0, 2, out));
+
+    /* Truncated data of the last row */
+    TEST_ASSERT(lvgl_port_rle_open(&img, enc, size - 1, W, H));
+    TEST_ASSERT(!lvgl_port_rle_read(&img, 0, H - 1, W, out));
+
+    /* Bad headers */
+    TEST_ASSERT(!lvgl_port_rle_open(&img, enc, LVGL_PORT_RLE_HEADER_SIZE + H * 4 - 1, W, H));
+    enc[0] ^= 1;
+    TEST_ASSERT(!lvgl_port_rle_open(&img, enc, size, W, H));
+    enc[0] ^= 1;
+    enc[5] = 4;
+    TEST_ASSERT(!lvgl_port_rle_open(&img, enc, size, W, H));
+}
+
+static void test_cache(void)
+{
+    static uint8_t px[2][W * H * 3];
+    static uint8_t enc[2][W * H * 4 + 1024];
+    uint8_t out[W * 3];
+    lvgl_port_rle_img_t img[2];
+    lvgl_port_rle_cache_t cache;
+
+    for (int i = 0; i < 2; i++) {
+        make_image(px[i], W, H, 3);
+        const size_t size = encode(px[i], W, H, 3, enc[i]);
+        TEST_ASSERT(lvgl_port_rle_open(&img[i], enc[i], size, W, H));
+    }
+
+    /* Eight rows fit */
+    TEST_ASSERT(lvgl_port_rle_cache_init(&cache, W * 3 * 8));
+    for (int pass = 0; pass < 3; pass++) {
+        for (int i = 0; i < 2; i++) {
+            for (uint32_t y = 4; y < 8; y++) {
+                const uint32_t x = (y * 7 + pass) % W;
+                const uint32_t len = W - x;
+                TEST_ASSERT(lvgl_port_rle_cache_read(&cache, &img[i], x, y, len, out));
+                TEST_ASSERT(memcmp(out, px[i] + (y * W + x) * 3, len * 3) == 0);
+            }
+        }
+    }
+    TEST_ASSERT(cache.hits + cache.misses == 24);
+    TEST_ASSERT(cache.hits >= 8);
+
+    /* Whole images, most rows are evicted */
+    for (int i = 0; i < 2; i++) {
+        for (uint32_t y = 0; y < H; y++) {
+            TEST_ASSERT(lvgl_port_rle_cache_read(&cache, &img[i], 1, y, W - 2, out));
+            TEST_ASSERT(memcmp(out, px[i] + (y * W + 1) * 3, (W - 2) * 3) == 0);
+        }
+    }
+    TEST_ASSERT(!lvgl_port_rle_cache_read(&cache, &img[0], 0, H, 1, out));
+    TEST_ASSERT(!lvgl_port_rle_cache_read(&cache, &img[0], 1, 0, W, out));
+    lvgl_port_rle_cache_deinit(&cache);
+
+    /* No cache, rows are decoded directly */
+    TEST_ASSERT(lvgl_port_rle_cache_init(&cache, 0));
+    TEST_ASSERT(lvgl_port_rle_cache_read(&cache, &img[1], 3, 5, 10, out));
+    TEST_ASSERT(memcmp(out, px[1] + (5 * W + 3) * 3, 10 * 3) == 0);
+    TEST_ASSERT(cache.hits == 0 && cache.misses == 0 && cache.px_decoded == 10);
+    lvgl_port_rle_cache_deinit(&cache);
+}
+
+static void bench_read(void)
+{
+    static uint8_t px[BENCH_W * BENCH_H * 3];
+    static uint8_t enc[BENCH_W * BENCH_H * 4];
+    static uint8_t out[BENCH_W * 3];
+    lvgl_port_rle_img_t img;
+    struct timespec start;
+    struct timespec end;
+
+    make_image(px, BENCH_W, BENCH_H, 3);
+    const size_t size = encode(px, BENCH_W, BENCH_H, 3, enc);
+    TEST_ASSERT(lvgl_port_rle_open(&img, enc, size, BENCH_W, BENCH_H));
+
+    double s[2];
+    for (int copy = 0; copy < 2; copy++) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < BENCH_RUNS; i++) {
+            for (uint32_t y = 0; y < BENCH_H; y++) {
+                if (copy) {
+                    memcpy(out, px + y * BENCH_W * 3, BENCH_W * 3);
+                } else {
+                    lvgl_port_rle_read(&img, 0, y, BENCH_W, out);
+                }
+                __asm__ volatile("" ::: "memory");
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        s[copy] = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    }
+    printf("rle: %u -> %zu bytes, decode %.0f Mpx/s, copy of raw rows %.0f Mpx/s\n", BENCH_W * BENCH_H * 3, size,
+           (double)BENCH_W * BENCH_H * BENCH_RUNS / s[0] / 1e6, (double)BENCH_W * BENCH_H * BENCH_RUNS / s[1] / 1e6);
+}
+
+int main(void)
+{
+    srand(1);
+    test_read(2);
+    test_read(3);
+    test_cache();
+    bench_read();
+
+    printf("All rle tests passed\n");
+    return 0;
+}
@@ -0,0 +1,305 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Round display flush against a mock panel, which records every transmitted window.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl_port_round.h"
+#include "test_common.h"
+
+#define HRES            (240)
+#define VRES            (240)
+#define TRANS_COST      (128)
+#define MAX_WINDOWS     (VRES)
+#define PX_UNSET        (0xFFFFFFFFUL)
+
+typedef struct {
+    int x1, y1, x2, y2;
+    const uint8_t *data;
+} mock_window_t;
+
+/* Mock LCD, 32-bit pixels hold their own coordinates */
+typedef struct {
+    uint32_t fb[VRES][HRES];
+    mock_window_t windows[MAX_WINDOWS];
+    int window_count;
+    const uint8_t *buf;
+    const uint8_t *buf_sent;    /* End of the data already handed to the panel */
+} mock_panel_t;
+
+static mock_panel_t panel;
+
+static uint32_t px_value(int x, int y)
+{
+    return ((uint32_t)y << 16) | (uint32_t)x;
+}
+
+static void mock_panel_reset(const void *buf)
+{
+    for (int y = 0; y < VRES; y++) {
+        for (int x = 0; x < HRES; x++) {
+            panel.fb[y][x] = PX_UNSET;
+        }
+    }
+    panel.window_count = 0;
+    panel.buf = buf;
+    panel.buf_sent = buf;
+}
+
+static void mock_panel_send(void *user_ctx, int x1, int y1, int x2, int y2, const void *data)
+{
+    TEST_ASSERT(user_ctx == &panel);
+    TEST_ASSERT(x1 <= x2 && y1 <= y2);
+    TEST_ASSERT(panel.window_count < MAX_WINDOWS);
+
+    /* Window data must follow the data sent before, the DMA may still read them */
+    const uint8_t *d = data;
+    TEST_ASSERT(d >= panel.buf_sent);
+
+    const uint32_t *px = data;
+    for (int y = y1; y <= y2; y++) {
+        for (int x = x1; x <= x2; x++) {
+            panel.fb[y][x] = *px++;
+        }
+    }
+    panel.buf_sent = (const uint8_t *)px;
+    panel.windows[panel.window_count++] = (mock_window_t) {
+        .x1 = x1, .y1 = y1, .x2 = x2, .y2 = y2, .data = data,
+    };
+}
+
+static bool is_visible(int x, int y)
+{
+    /* Doubled coordinates of the pixel center against the inscribed circle */
+    const int dx = 2 * x + 1 - HRES;
+    const int dy = 2 * y + 1 - VRES;
+    return dx * dx + dy * dy <= HRES * HRES;
+}
+
+static uint32_t *area_pixels(int x1, int y1, int x2, int y2)
+{
+    uint32_t *buf = malloc((x2 - x1 + 1) * (y2 - y1 + 1) * sizeof(uint32_t));
+    TEST_ASSERT(buf);
+    uint32_t *px = buf;
+    for (int y = y1; y <= y2; y++) {
+        for (int x = x1; x <= x2; x++) {
+            *px++ = px_value(x, y);
+        }
+    }
+    return buf;
+}
+
+/* Flush the area and check, that all visible pixels and nothing outside of the area got to the panel */
+static lvgl_port_round_result_t flush_and_check(const lvgl_port_round_t *round, int x1, int y1, int x2, int y2)
+{
+    lvgl_port_round_result_t res;
+    uint32_t *buf = area_pixels(x1, y1, x2, y2);
+    mock_panel_reset(buf);
+
+    lvgl_port_round_flush(round, x1, y1, x2, y2, buf, sizeof(uint32_t), mock_panel_send, &panel, &res);
+
+    uint32_t sent = 0;
+    for (int y = 0; y < VRES; y++) {
+        for (int x = 0; x < HRES; x++) {
+            const bool in_area = (x >= x1 && x <= x2 && y >= y1 && y <= y2);
+            if (panel.fb[y][x] != PX_UNSET) {
+                TEST_ASSERT(in_area);
+                TEST_ASSERT(panel.fb[y][x] == px_value(x, y));
+                sent++;
+            } else {
+                TEST_ASSERT(!(in_area && is_visible(x, y)));
+            }
+        }
+    }
+
+    const uint32_t area_bytes = (x2 - x1 + 1) * (y2 - y1 + 1) * sizeof(uint32_t);
+    TEST_ASSERT(res.trans_count == (uint32_t)panel.window_count);
+    TEST_ASSERT(res.bytes_sent == sent * sizeof(uint32_t));
+    TEST_ASSERT(res.bytes_sent + res.bytes_saved == area_bytes);
+    TEST_ASSERT(panel.window_count == 0 || panel.windows[0].data == (const uint8_t *)buf);
+
+    free(buf);
+    return res;
+}
+
+static void test_spans(void)
+{
+    lvgl_port_round_t round;
+    TEST_ASSERT(lvgl_port_round_init(&round, HRES, VRES, TRANS_COST));
+
+    uint32_t visible = 0;
+    for (int y = 0; y < VRES; y++) {
+        for (int x = 0; x < HRES; x++) {
+            const bool in_span = (x >= round.span_x1[y] && x <= round.span_x2[y]);
+            TEST_ASSERT(in_span == is_visible(x, y));
+            visible += in_span;
+        }
+        /* Symmetric in both axes */
+        TEST_ASSERT(round.span_x1[y] + round.span_x2[y] == HRES - 1);
+        TEST_ASSERT(round.span_x1[y] == round.span_x1[VRES - 1 - y]);
+    }
+    TEST_ASSERT(round.span_x1[VRES / 2] == 0);
+    printf("visible pixels: %u of %u (%u %% invisible)\n", visible, HRES * VRES, 100 - visible * 100 / (HRES * VRES));
+    TEST_ASSERT(visible > HRES * VRES * 78 / 100 && visible < HRES * VRES * 79 / 100);
+
+    lvgl_port_round_deinit(&round);
+    TEST_ASSERT(round.span_x1 == NULL && round.span_x2 == NULL);
+}
+
+static void test_full_screen(void)
+{
+    lvgl_port_round_t round;
+    TEST_ASSERT(lvgl_port_round_init(&round, HRES, VRES, TRANS_COST));
+
+    lvgl_port_round_result_t res = flush_and_check(&round, 0, 0, HRES - 1, VRES - 1);
+    printf("full screen: %u windows, %u bytes sent, %u bytes saved (%u %%)\n", res.trans_count, res.bytes_sent,
+           res.bytes_saved, res.bytes_saved * 100 / (res.bytes_sent + res.bytes_saved));
+    /* Merging gives up a part of the 21 % of invisible pixels to save transactions */
+    TEST_ASSERT(res.bytes_saved * 100 / (res.bytes_sent + res.bytes_saved) >= 15);
+    TEST_ASSERT(res.trans_count > 1 && res.trans_count < 64);
+
+    lvgl_port_round_deinit(&round);
+}
+
+static void test_strips(void)
+{
+    lvgl_port_round_t round;
+    TEST_ASSERT(lvgl_port_round_init(&round, HRES, VRES, TRANS_COST));
+
+    for (int lines = 1; lines <= 60; lines += 7) {
+        uint32_t saved = 0;
+        for (int y = 0; y < VRES; y += lines) {
+            const int y2 = (y + lines - 1 < VRES) ? (y + lines - 1) : (VRES - 1);
+            saved += flush_and_check(&round, 0, y, HRES - 1, y2).bytes_saved;
+        }
+        TEST_ASSERT(saved > 0);
+    }
+
+    lvgl_port_round_deinit(&round);
+}
+
+static void test_areas(void)
+{
+    lvgl_port_round_t round;
+    TEST_ASSERT(lvgl_port_round_init(&round, HRES, VRES, TRANS_COST));
+
+    srand(1234);
+    for (int i = 0; i < 500; i++) {
+        int x1 = rand() % HRES;
+        int x2 = rand() % HRES;
+        int y1 = rand() % VRES;
+        int y2 = rand() % VRES;
+        if (x1 > x2) {
+            int t = x1;
+            x1 = x2;
+            x2 = t;
+        }
+        if (y1 > y2) {
+            int t = y1;
+            y1 = y2;
+            y2 = t;
+        }
+        flush_and_check(&round, x1, y1, x2, y2);
+    }
+
+    /* Invisible corner costs nothing */
+    lvgl_port_round_result_t res = flush_and_check(&round, 0, 0, 19, 19);
+    TEST_ASSERT(res.trans_count == 0 && res.bytes_sent == 0);
+
+    /* Fully visible area is sent at once */
+    res = flush_and_check(&round, 100, 100, 139, 139);
+    TEST_ASSERT(res.trans_count == 1 && res.bytes_saved == 0);
+
+    lvgl_port_round_deinit(&round);
+}
+
+static void test_trans_cost(void)
+{
+    lvgl_port_round_t round;
+
+    /* Free transactions, only rows with the same span are merged */
+    TEST_ASSERT(lvgl_port_round_init(&round, HRES, VRES, 0));
+    lvgl_port_round_result_t res = flush_and_check(&round, 0, 0, HRES - 1, VRES - 1);
+    uint32_t visible = 0;
+    for (int y = 0; y < VRES; y++) {
+        for (int x = 0; x < HRES; x++) {
+            visible += is_visible(x, y);
+        }
+    }
+    TEST_ASSERT(res.bytes_sent == visible * sizeof(uint32_t));
+    for (int i = 0; i < panel.window_count; i++) {
+        const mock_window_t *w = &panel.windows[i];
+        for (int y = w->y1; y <= w->y2; y++) {
+            TEST_ASSERT(w->x1 == round.span_x1[y] && w->x2 == round.span_x2[y]);
+        }
+    }
+    lvgl_port_round_deinit(&round);
+
+    /* Expensive transactions, whole area is sent in one window */
+    TEST_ASSERT(lvgl_port_round_init(&round, HRES, VRES, UINT32_MAX));
+    res = flush_and_check(&round, 0, 0, HRES - 1, VRES - 1);
+    TEST_ASSERT(res.trans_count == 1 && res.bytes_saved == 0);
+    lvgl_port_round_deinit(&round);
+}
+
+static void test_clip(void)
+{
+    lvgl_port_round_t round;
+    TEST_ASSERT(lvgl_port_round_init(&round, HRES, VRES, TRANS_COST));
+
+    /* First row is narrow */
+    int x1 = 0, x2 = HRES - 1;
+    lvgl_port_round_clip(&round, &x1, 0, &x2, 0);
+    TEST_ASSERT(x1 == round.span_x1[0] && x2 == round.span_x2[0]);
+
+    /* Middle row is not clipped */
+    x1 = 0;
+    x2 = HRES - 1;
+    lvgl_port_round_clip(&round, &x1, 0, &x2, VRES - 1);
+    TEST_ASSERT(x1 == 0 && x2 == HRES - 1);
+
+    /* Invisible corner keeps one column */
+    x1 = HRES - 20;
+    x2 = HRES - 1;
+    lvgl_port_round_clip(&round, &x1, VRES - 20, &x2, VRES - 1);
+    TEST_ASSERT(x1 == HRES - 20 && x2 == HRES - 20);
+
+    /* Clipped area still contains every visible pixel of the original one */
+    srand(42);
+    for (int i = 0; i < 500; i++) {
+        const int ox1 = rand() % (HRES / 2);
+        const int ox2 = ox1 + rand() % (HRES - ox1);
+        const int y1 = rand() % (VRES / 2);
+        const int y2 = y1 + rand() % (VRES - y1);
+        x1 = ox1;
+        x2 = ox2;
+        lvgl_port_round_clip(&round, &x1, y1, &x2, y2);
+        TEST_ASSERT(x1 >= ox1 && x2 <= ox2 && x1 <= x2);
+        for (int y = y1; y <= y2; y++) {
+            for (int x = ox1; x <= ox2; x++) {
+                TEST_ASSERT(!is_visible(x, y) || (x >= x1 && x <= x2));
+            }
+        }
+    }
+
+    lvgl_port_round_deinit(&round);
+}
+
+int main(void)
+{
+    test_spans();
+    test_full_screen();
+    test_strips();
+    test_areas();
+    test_trans_cost();
+    test_clip();
+    printf("All round display tests passed\n");
+    return 0;
+}
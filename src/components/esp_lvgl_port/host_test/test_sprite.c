@@ -0,0 +1,250 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Sprites packed like scripts/lvgl_port_sprite.py does, from random frames. Every frame drawn from
+ * its parts must equal the original, without a pixel drawn twice, and every pixel differing
+ * between two frames must be inside of the areas redrawn on the change. Animations must show their
+ * keys for the given times.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl_port_sprite.h"
+#include "test_common.h"
+
+#define W               (40)
+#define H               (30)
+#define FRAMES          (6)
+#define RUNS            (300)
+
+static uint8_t frames[FRAMES][H][W];
+static uint8_t atlas[H * FRAMES][W];
+static lvgl_port_sprite_frame_t frame_table[FRAMES];
+
+static void fill_rect(uint8_t frame[H][W], bool clear)
+{
+    const int x1 = rand() % W;
+    const int y1 = rand() % H;
+    const int x2 = x1 + rand() % (W - x1);
+    const int y2 = y1 + rand() % (H - y1);
+
+    for (int y = y1; y <= y2; y++) {
+        for (int x = x1; x <= x2; x++) {
+            frame[y][x] = clear ? 0 : 1 + rand() % 255;
+        }
+    }
+}
+
+/* Bounding box of the pixels differing from ref (or set, without ref) */
+static lvgl_port_sprite_area_t bounds(uint8_t frame[H][W], uint8_t ref[H][W])
+{
+    lvgl_port_sprite_area_t a = {W, H, -1, -1};
+
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            if (ref ? frame[y][x] != ref[y][x] : frame[y][x] != 0) {
+                a.x1 = x < a.x1 ? x : a.x1;
+                a.y1 = y < a.y1 ? y : a.y1;
+                a.x2 = x > a.x2 ? x : a.x2;
+                a.y2 = y > a.y2 ? y : a.y2;
+            }
+        }
+    }
+    return a;
+}
+
+/* Cells stacked in the atlas */
+static lvgl_port_sprite_cell_t pack(uint8_t frame[H][W], lvgl_port_sprite_area_t area, uint16_t *atlas_y)
+{
+    lvgl_port_sprite_cell_t cell = {.atlas_x = 0, .atlas_y = *atlas_y, .area = area};
+
+    if (area.x2 < area.x1) {
+        return cell;
+    }
+    for (int y = area.y1; y <= area.y2; y++) {
+        memcpy(&atlas[*atlas_y + y - area.y1][0], &frame[y][area.x1], area.x2 - area.x1 + 1);
+    }
+    *atlas_y += area.y2 - area.y1 + 1;
+    return cell;
+}
+
+static void make_sprite(lvgl_port_sprite_t *sprite)
+{
+    uint16_t atlas_y = 0;
+
+    memset(frames, 0, sizeof(frames));
+    memset(atlas, 0xA5, sizeof(atlas));
+    for (int i = 0; i < 1 + rand() % 3; i++) {
+        fill_rect(frames[0], false);
+    }
+    for (int f = 1; f < FRAMES; f++) {
+        memcpy(frames[f], frames[0], sizeof(frames[0]));
+        /* Some frames equal the key frame */
+        for (int i = 0; i < rand() % 3; i++) {
+            fill_rect(frames[f], rand() % 4 == 0);
+        }
+    }
+
+    memset(sprite, 0, sizeof(*sprite));
+    sprite->atlas = atlas;
+    sprite->w = W;
+    sprite->h = H;
+    sprite->key = pack(frames[0], bounds(frames[0], NULL), &atlas_y);
+    frame_table[0].patch.area = (lvgl_port_sprite_area_t) {0, 0, -1, -1};
+    for (int f = 1; f < FRAMES; f++) {
+        frame_table[f].patch = pack(frames[f], bounds(frames[f], frames[0]), &atlas_y);
+    }
+    sprite->atlas_w = W;
+    sprite->atlas_h = atlas_y ? atlas_y : 1;
+    sprite->frames = frame_table;
+    sprite->frame_count = FRAMES;
+}
+
+static void draw(const lvgl_port_sprite_t *sprite, uint8_t frame, uint8_t out[H][W])
+{
+    static uint8_t drawn[H][W];
+    lvgl_port_sprite_cell_t parts[5];
+    const size_t count = lvgl_port_sprite_parts(sprite, frame, parts);
+
+    TEST_ASSERT(count <= 5);
+    memset(out, 0, H * W);
+    memset(drawn, 0, sizeof(drawn));
+    for (size_t i = 0; i < count; i++) {
+        const lvgl_port_sprite_area_t *a = &parts[i].area;
+        TEST_ASSERT(a->x1 <= a->x2 && a->y1 <= a->y2);
+        for (int y = a->y1; y <= a->y2; y++) {
+            for (int x = a->x1; x <= a->x2; x++) {
+                TEST_ASSERT(!drawn[y][x]);
+                drawn[y][x] = 1;
+                out[y][x] = atlas[parts[i].atlas_y + y - a->y1][parts[i].atlas_x + x - a->x1];
+            }
+        }
+    }
+}
+
+static bool inside(const lvgl_port_sprite_area_t *areas, size_t count, int x, int y)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (x >= areas[i].x1 && x <= areas[i].x2 && y >= areas[i].y1 && y <= areas[i].y2) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void test_frames(void)
+{
+    static uint8_t a[H][W];
+    static uint8_t b[H][W];
+    lvgl_port_sprite_t sprite;
+    lvgl_port_sprite_area_t areas[2];
+
+    for (int run = 0; run < RUNS; run++) {
+        make_sprite(&sprite);
+        TEST_ASSERT(lvgl_port_sprite_check(&sprite));
+        for (uint8_t f = 0; f < FRAMES; f++) {
+            draw(&sprite, f, a);
+            TEST_ASSERT(memcmp(a, frames[f], sizeof(a)) == 0);
+        }
+        for (uint8_t from = 0; from < FRAMES; from++) {
+            for (uint8_t to = 0; to < FRAMES; to++) {
+                const size_t count = lvgl_port_sprite_changed(&sprite, from, to, areas);
+                TEST_ASSERT(count <= 2);
+                TEST_ASSERT(from != to || count == 0);
+                draw(&sprite, from, a);
+                draw(&sprite, to, b);
+                for (int y = 0; y < H; y++) {
+                    for (int x = 0; x < W; x++) {
+                        TEST_ASSERT(a[y][x] == b[y][x] || inside(areas, count, x, y));
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void test_check(void)
+{
+    lvgl_port_sprite_t sprite;
+    lvgl_port_sprite_key_t keys[] = {{.frame = 1, .time = 10}, {.frame = FRAMES, .time = 10}};
+    lvgl_port_sprite_anim_t anim = {.name = "a", .keys = keys, .key_count = 2};
+
+    do {
+        make_sprite(&sprite);
+    } while (sprite.frames[1].patch.area.x2 < sprite.frames[1].patch.area.x1);
+    TEST_ASSERT(!lvgl_port_sprite_check(NULL));
+
+    /* Patch past the atlas or the frame */
+    sprite.atlas_h--;
+    TEST_ASSERT(!lvgl_port_sprite_check(&sprite));
+    sprite.atlas_h++;
+    TEST_ASSERT(lvgl_port_sprite_check(&sprite));
+    frame_table[1].patch.area.x2 += W;
+    TEST_ASSERT(!lvgl_port_sprite_check(&sprite));
+    frame_table[1].patch.area.x2 -= W;
+
+    /* Key frame with a patch */
+    frame_table[0].patch = frame_table[1].patch;
+    TEST_ASSERT(!lvgl_port_sprite_check(&sprite));
+    frame_table[0].patch.area = (lvgl_port_sprite_area_t) {0, 0, -1, -1};
+
+    /* Key of a missing frame */
+    sprite.anims = &anim;
+    sprite.anim_count = 1;
+    TEST_ASSERT(!lvgl_port_sprite_check(&sprite));
+    keys[1].frame = FRAMES - 1;
+    TEST_ASSERT(lvgl_port_sprite_check(&sprite));
+    anim.key_count = 0;
+    TEST_ASSERT(!lvgl_port_sprite_check(&sprite));
+}
+
+static void test_anim(void)
+{
+    static const lvgl_port_sprite_frame_t named[] = {{.name = "open"}, {.name = "fade"}, {.name = "sleep"}};
+    static const lvgl_port_sprite_key_t keys[] = {{0, 100}, {1, 50}, {0, 0}, {2, 30}};
+    lvgl_port_sprite_anim_t anims[] = {
+        {.name = "once", .keys = keys, .key_count = 4, .loop = false},
+        {.name = "loop", .keys = keys, .key_count = 4, .loop = true},
+        {.name = "still", .keys = &keys[2], .key_count = 1, .loop = true},
+    };
+    const lvgl_port_sprite_t sprite = {.frames = named, .frame_count = 3, .anims = anims, .anim_count = 3};
+
+    TEST_ASSERT(lvgl_port_sprite_find_frame(&sprite, "fade") == 1);
+    TEST_ASSERT(lvgl_port_sprite_find_frame(&sprite, "wink") == -1);
+    TEST_ASSERT(lvgl_port_sprite_find_frame(&sprite, NULL) == -1);
+    TEST_ASSERT(lvgl_port_sprite_find_anim(&sprite, "loop") == &anims[1]);
+    TEST_ASSERT(lvgl_port_sprite_find_anim(&sprite, "none") == NULL);
+
+    /* Keys of no time are skipped, the last one stays */
+    TEST_ASSERT(lvgl_port_sprite_anim_time(&anims[0]) == 150);
+    TEST_ASSERT(lvgl_port_sprite_anim_frame(&anims[0], 0) == 0);
+    TEST_ASSERT(lvgl_port_sprite_anim_frame(&anims[0], 99) == 0);
+    TEST_ASSERT(lvgl_port_sprite_anim_frame(&anims[0], 100) == 1);
+    TEST_ASSERT(lvgl_port_sprite_anim_frame(&anims[0], 149) == 1);
+    TEST_ASSERT(lvgl_port_sprite_anim_frame(&anims[0], 150) == 2);
+    TEST_ASSERT(lvgl_port_sprite_anim_frame(&anims[0], 100000) == 2);
+
+    TEST_ASSERT(lvgl_port_sprite_anim_time(&anims[1]) == 180);
+    TEST_ASSERT(lvgl_port_sprite_anim_frame(&anims[1], 179) == 2);
+    TEST_ASSERT(lvgl_port_sprite_anim_frame(&anims[1], 180) == 0);
+    TEST_ASSERT(lvgl_port_sprite_anim_frame(&anims[1], 180 * 7 + 120) == 1);
+
+    TEST_ASSERT(lvgl_port_sprite_anim_time(&anims[2]) == 0);
+    TEST_ASSERT(lvgl_port_sprite_anim_frame(&anims[2], 12345) == 0);
+}
+
+int main(void)
+{
+    srand(1);
+    test_frames();
+    test_check();
+    test_anim();
+
+    printf("All sprite tests passed\n");
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Rolling frame statistics and their percentiles.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "lvgl_port_stats.h"
+#include "test_common.h"
+
+static void add_render(lvgl_port_stats_t *stats, uint32_t render_us)
+{
+    lvgl_port_stats_sample_t sample = {0};
+    sample.value[LVGL_PORT_STATS_RENDER_US] = render_us;
+    sample.value[LVGL_PORT_STATS_BYTES] = render_us * 2;
+    lvgl_port_stats_add(stats, &sample);
+}
+
+static void pct_of(const lvgl_port_stats_t *stats, lvgl_port_stats_metric_t metric, lvgl_port_stats_pct_t *pct)
+{
+    uint32_t values[LVGL_PORT_STATS_WINDOW];
+    const size_t count = lvgl_port_stats_copy(stats, metric, values);
+    lvgl_port_stats_percentiles(values, count, pct);
+}
+
+static void test_empty(void)
+{
+    lvgl_port_stats_t stats;
+    lvgl_port_stats_pct_t pct;
+    lvgl_port_stats_init(&stats);
+
+    pct_of(&stats, LVGL_PORT_STATS_RENDER_US, &pct);
+    TEST_ASSERT(pct.p50 == 0 && pct.p95 == 0 && pct.p99 == 0 && pct.max == 0);
+
+    add_render(&stats, 7);
+    pct_of(&stats, LVGL_PORT_STATS_RENDER_US, &pct);
+    TEST_ASSERT(pct.p50 == 7 && pct.p95 == 7 && pct.p99 == 7 && pct.max == 7);
+}
+
+static void test_percentiles(void)
+{
+    lvgl_port_stats_t stats;
+    lvgl_port_stats_pct_t pct;
+    lvgl_port_stats_init(&stats);
+
+    /* 1..40 in shuffled order */
+    for (uint32_t i = 0; i < 40; i++) {
+        add_render(&stats, (i * 17) % 40 + 1);
+    }
+    pct_of(&stats, LVGL_PORT_STATS_RENDER_US, &pct);
+    TEST_ASSERT(pct.p50 == 20);
+    TEST_ASSERT(pct.p95 == 38);
+    TEST_ASSERT(pct.p99 == 40);
+    TEST_ASSERT(pct.max == 40);
+
+    pct_of(&stats, LVGL_PORT_STATS_BYTES, &pct);
+    TEST_ASSERT(pct.p50 == 40 && pct.max == 80);
+    TEST_ASSERT(stats.frames == 40);
+}
+
+static void test_rolling(void)
+{
+    lvgl_port_stats_t stats;
+    lvgl_port_stats_pct_t pct;
+    lvgl_port_stats_init(&stats);
+
+    /* Slow frames are dropped from the window by the later fast ones */
+    for (int i = 0; i < 100; i++) {
+        add_render(&stats, 50000);
+    }
+    for (int i = 0; i < LVGL_PORT_STATS_WINDOW - 1; i++) {
+        add_render(&stats, 1000);
+    }
+    add_render(&stats, 9000);
+    TEST_ASSERT(stats.count == LVGL_PORT_STATS_WINDOW);
+    TEST_ASSERT(stats.frames == 100 + LVGL_PORT_STATS_WINDOW);
+
+    pct_of(&stats, LVGL_PORT_STATS_RENDER_US, &pct);
+    TEST_ASSERT(pct.p50 == 1000);
+    TEST_ASSERT(pct.p95 == 1000);
+    TEST_ASSERT(pct.p99 == 9000);
+    TEST_ASSERT(pct.max == 9000);
+}
+
+int main(void)
+{
+    test_empty();
+    test_percentiles();
+    test_rolling();
+    printf("All frame statistics tests passed\n");
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Byte swap of RGB565 pixels at every alignment and length, the bytes around must stay untouched.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lvgl_port_swap.h"
+#include "test_common.h"
+
+#define MAX_PX          (67)
+#define GUARD           (0xA5)
+#define BENCH_PX        (240 * 40)
+#define BENCH_RUNS      (2000)
+
+static void test_swap(size_t offset, size_t count)
+{
+    uint16_t buf[MAX_PX + 4];
+    uint16_t ref[MAX_PX + 4];
+
+    memset(buf, GUARD, sizeof(buf));
+    for (size_t i = 0; i < count; i++) {
+        buf[offset + i] = (uint16_t)(i * 0x0301 + 0x1234);
+    }
+    memcpy(ref, buf, sizeof(buf));
+
+    lvgl_port_swap_rgb565(&buf[offset], count);
+
+    for (size_t i = 0; i < MAX_PX + 4; i++) {
+        if (i >= offset && i < offset + count) {
+            TEST_ASSERT(buf[i] == (uint16_t)((ref[i] >> 8) | (ref[i] << 8)));
+        } else {
+            TEST_ASSERT(buf[i] == ref[i]);
+        }
+    }
+
+    /* Swapping twice gives the original */
+    lvgl_port_swap_rgb565(&buf[offset], count);
+    TEST_ASSERT(memcmp(buf, ref, sizeof(buf)) == 0);
+}
+
+static void bench_swap(void)
+{
+    static uint16_t strip[BENCH_PX];
+    struct timespec start;
+    struct timespec end;
+
+    memset(strip, 0x5A, sizeof(strip));
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < BENCH_RUNS; i++) {
+        lvgl_port_swap_rgb565(strip, BENCH_PX);
+        __asm__ volatile("" ::: "memory");
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    const double s = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    printf("swap: %.0f Mpx/s\n", (double)BENCH_PX * BENCH_RUNS / s / 1e6);
+}
+
+int main(void)
+{
+    for (size_t offset = 0; offset < 4; offset++) {
+        for (size_t count = 0; count <= MAX_PX; count++) {
+            test_swap(offset, count);
+        }
+    }
+    bench_swap();
+
+    printf("All swap tests passed\n");
+    return 0;
+}
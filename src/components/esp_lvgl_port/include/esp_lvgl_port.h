@@ -0,0 +1,1052 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "esp_lcd_panel_io.h"
+#include "esp_lcd_panel_ops.h"
+#include "lvgl.h"
+#include "lvgl_port_sprite.h"
+
+#if __has_include ("esp_lcd_touch.h")
+#include "esp_lcd_touch.h"
+#define ESP_LVGL_PORT_TOUCH_COMPONENT 1
+#endif
+
+#if __has_include ("iot_knob.h")
+#include "iot_knob.h"
+#include "iot_button.h"
+#define ESP_LVGL_PORT_KNOB_COMPONENT 1
+#endif
+
+#if __has_include ("iot_button.h")
+#include "iot_button.h"
+#define ESP_LVGL_PORT_BUTTON_COMPONENT 1
+#endif
+
+#if __has_include ("usb/hid_host.h")
+#define ESP_LVGL_PORT_USB_HOST_HID_COMPONENT 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Init configuration structure
+ */
+typedef struct {
+    int task_priority;      /*!< LVGL task priority */
+    int task_stack;         /*!< LVGL task stack size */
+    int task_affinity;      /*!< LVGL task pinned to core (-1 is no affinity) */
+    int task_max_sleep_ms;  /*!< Maximum sleep in LVGL task */
+    int timer_period_ms;    /*!< LVGL timer tick period in ms */
+    bool task_wake_on_event;/*!< LVGL task sleeps until the next LVGL timer is due and is woken up by input, flush and unlock (instead of polling) */
+} lvgl_port_cfg_t;
+
+/**
+ * @brief Rotation configuration
+ */
+typedef struct {
+    bool swap_xy;  /*!< LCD Screen swapped X and Y (in esp_lcd driver) */
+    bool mirror_x; /*!< LCD Screen mirrored X (in esp_lcd driver) */
+    bool mirror_y; /*!< LCD Screen mirrored Y (in esp_lcd driver) */
+} lvgl_port_rotation_cfg_t;
+
+/**
+ * @brief Strip buffers configuration
+ *
+ * Used when `flags.buff_strip` is set. Two buffers of the same height are allocated, the height is
+ * computed from the free DMA capable memory at the moment of lvgl_port_add_disp().
+ */
+typedef struct {
+    uint32_t min_lines;     /*!< Minimal height of one strip in lines, adding the display fails below it */
+    uint32_t max_lines;     /*!< Maximal height of one strip in lines (0 for a quarter of the screen) */
+    uint32_t heap_reserve;  /*!< DMA capable memory in bytes, which must stay free for the application */
+} lvgl_port_strip_cfg_t;
+
+/**
+ * @brief Frame pacing configuration
+ *
+ * Used when `flags.pacing` is set. Refresh is started so the first window of a frame is sent just after
+ * the vertical sync of the LCD, taken from its TE output (`flags.pacing_te`) or estimated from the scan period.
+ */
+typedef struct {
+    uint32_t scan_period_us;    /*!< Scan period of the LCD, refined from TE if available (0 for 60 Hz) */
+    uint32_t fast_period_ms;    /*!< Refresh period while animations run, rounded up to whole scans (0 for every scan) */
+    uint32_t slow_period_ms;    /*!< Refresh period of static screen, rounded up to whole scans (0 for LV_DISP_DEF_REFR_PERIOD) */
+    int      te_gpio;           /*!< GPIO connected to the TE output of the LCD (only with flags.pacing_te) */
+} lvgl_port_pacing_cfg_t;
+
+/**
+ * @brief Configuration display structure
+ */
+typedef struct {
+    esp_lcd_panel_io_handle_t io_handle;    /*!< LCD panel IO handle */
+    esp_lcd_panel_handle_t panel_handle;    /*!< LCD panel handle */
+    uint32_t    buffer_size;    /*!< Size of the buffer for the screen in pixels */
+    bool        double_buffer;  /*!< True, if should be allocated two buffers */
+    uint32_t    hres;           /*!< LCD display horizontal resolution */
+    uint32_t    vres;           /*!< LCD display vertical resolution */
+    bool        monochrome;     /*!< True, if display is monochrome and using 1bit for 1px */
+    lvgl_port_rotation_cfg_t rotation;    /*!< Default values of the screen rotation */
+    lvgl_port_strip_cfg_t strip;          /*!< Strip buffers sizing (only with flags.buff_strip) */
+    uint32_t    trans_cost;     /*!< Overhead of one LCD window in pixel bytes, used by flags.merge_areas and flags.round (0 for default) */
+    lvgl_port_pacing_cfg_t pacing;        /*!< Frame pacing (only with flags.pacing) */
+
+    struct {
+        unsigned int buff_dma: 1;    /*!< Allocated LVGL buffer will be DMA capable */
+        unsigned int buff_spiram: 1; /*!< Allocated LVGL buffer will be in PSRAM */
+        unsigned int buff_strip: 1;  /*!< Allocate two DMA capable strip buffers sized by `strip` (buffer_size and double_buffer are ignored) */
+        unsigned int round: 1;       /*!< Display is round, pixels outside of the inscribed circle are neither rendered nor sent */
+        unsigned int merge_areas: 1; /*!< Merge and split invalidated areas by the cost of windows and redundant pixels before refresh */
+        unsigned int pacing: 1;      /*!< Pace the refresh by the LCD scan */
+        unsigned int pacing_te: 1;   /*!< Take the vertical sync from the TE output of the LCD */
+        unsigned int swap_bytes: 1;  /*!< Swap bytes of RGB565 pixels before they are sent, for LCDs taking big-endian colors (needs LV_COLOR_16_SWAP disabled) */
+        unsigned int diff: 1;        /*!< Send only the parts of flushed rows, which differ from the LCD content, see lvgl_port_set_diff() */
+    } flags;
+} lvgl_port_display_cfg_t;
+
+/**
+ * @brief Draw buffers and flush statistics
+ */
+typedef struct {
+    uint32_t buffer_lines;  /*!< Height of one draw buffer in lines */
+    uint32_t buffer_bytes;  /*!< Memory allocated for all draw buffers in bytes */
+    uint32_t flush_count;   /*!< Number of flushed buffers */
+    uint64_t transfer_us;   /*!< Time spent by transferring the buffers to the LCD */
+    uint64_t wait_us;       /*!< Time the rendering was blocked by waiting for a free buffer */
+    uint32_t overlap_pct;   /*!< Part of the transfer time hidden behind rendering [%] */
+    uint32_t frame_count;   /*!< Number of finished frames */
+    uint32_t trans_count;   /*!< Number of windows sent to the LCD */
+    uint64_t bytes_sent;    /*!< Pixel bytes sent to the LCD */
+    uint64_t bytes_saved;   /*!< Pixel bytes of flushed areas, which were not sent (round display and diff only) */
+    uint32_t frame_saved;   /*!< Pixel bytes not sent in the last finished frame (round display and diff only) */
+    uint32_t frame_trans;   /*!< Windows sent in the last finished frame */
+    uint32_t frame_bytes;   /*!< Pixel bytes sent in the last finished frame */
+    uint32_t areas_invalidated; /*!< Invalidated areas before merging (flags.merge_areas only) */
+    uint32_t areas_refreshed;   /*!< Refreshed areas after merging (flags.merge_areas only) */
+    uint32_t diff_mem;      /*!< Memory of the row signatures in bytes, 0 when the diff was never enabled */
+    uint64_t diff_saved;    /*!< Visible pixel bytes not sent because they did not change (diff only) */
+    uint32_t frame_diff_saved;  /*!< Visible pixel bytes not sent by the diff in the last finished frame */
+} lvgl_port_buffer_stats_t;
+
+/**
+ * @brief Frame pacing statistics
+ */
+typedef struct {
+    uint32_t frames;            /*!< Number of rendered frames */
+    uint32_t dropped;           /*!< Scan periods missed by frames of running animations */
+    uint32_t wasted;            /*!< Frames overwritten by the next frame before a vertical sync */
+    uint32_t te_count;          /*!< Number of TE edges (0 when the vertical sync is estimated) */
+    uint32_t scan_period_us;    /*!< Current scan period of the LCD */
+    uint32_t lead_us;           /*!< Averaged time from the start of refresh to the first flush */
+    uint32_t refr_period_ms;    /*!< Current refresh period */
+} lvgl_port_pacing_stats_t;
+
+/**
+ * @brief LVGL task statistics
+ */
+typedef struct {
+    uint32_t wakeups;           /*!< Wake-ups of the LVGL task */
+    uint32_t notified;          /*!< Wake-ups by input, flush or unlock, the rest are timeouts of LVGL timers */
+    uint32_t wakeups_per_sec;   /*!< Average wake-ups per second since the reset */
+    uint32_t input_events;      /*!< Input events followed by a flush */
+    uint32_t input_latency_avg_us; /*!< Average time from input event to the first flush after it */
+    uint32_t input_latency_max_us; /*!< Longest time from input event to the first flush after it */
+    uint32_t commands;          /*!< Commands posted by lvgl_port_post() and run */
+    uint32_t commands_dropped;  /*!< Commands not posted, because the queue was full */
+} lvgl_port_task_stats_t;
+
+/* Call sites in the LVGL mutex statistics, locks from further sites are only counted */
+#define LVGL_PORT_LOCK_SITES    (16)
+
+/**
+ * @brief LVGL mutex statistics of one call site of lvgl_port_lock()
+ *
+ * A recursive lock is accounted to the outermost lock of the task.
+ */
+typedef struct {
+    const void *caller;     /*!< Return address of the lvgl_port_lock() call, resolve it with addr2line */
+    char task[16];          /*!< Task which locked here last (truncated name) */
+    uint32_t locks;         /*!< Taken mutex */
+    uint32_t timeouts;      /*!< Locks which timed out */
+    uint32_t contended;     /*!< Locks which found the mutex held by another task */
+    const void *blocked_by; /*!< Call site of the holder at the last contended lock */
+    uint64_t wait_us;       /*!< Time spent waiting for the mutex */
+    uint32_t wait_max_us;   /*!< Longest wait */
+    uint64_t hold_us;       /*!< Time the mutex was held */
+    uint32_t hold_max_us;   /*!< Longest hold */
+} lvgl_port_lock_site_stats_t;
+
+/**
+ * @brief LVGL mutex statistics
+ */
+typedef struct {
+    uint32_t sites;         /*!< Used entries of site, in the order of the first lock */
+    uint32_t untracked;     /*!< Locks from call sites over LVGL_PORT_LOCK_SITES */
+    lvgl_port_lock_site_stats_t site[LVGL_PORT_LOCK_SITES]; /*!< Call sites */
+} lvgl_port_lock_stats_t;
+
+/**
+ * @brief Statistics of the decoder of run-length encoded images
+ */
+typedef struct {
+    uint32_t opened;        /*!< Images opened for drawing */
+    uint32_t lines;         /*!< Lines read while drawing */
+    uint64_t px_decoded;    /*!< Decoded pixels, lines served from the cache are not decoded again */
+    uint32_t cache_hits;    /*!< Lines served from the cache */
+    uint32_t cache_misses;  /*!< Rows decoded into the cache */
+    uint32_t cache_size;    /*!< Memory of the cache in bytes */
+} lvgl_port_rle_stats_t;
+
+/**
+ * @brief Statistics of the image cache for a layer
+ */
+typedef struct {
+    uint32_t hits;          /*!< Draws blended from the cache */
+    uint32_t misses;        /*!< Draws not found in the cache, the image is prepared again */
+    uint32_t evictions;     /*!< Images cached by the layer and evicted for others */
+    uint32_t entries;       /*!< Images cached by the layer */
+    uint32_t bytes;         /*!< Memory of these images in bytes */
+} lvgl_port_img_cache_stats_t;
+
+/**
+ * @brief Statistics of the cache of decoded glyphs, of glyph masks or of rasterized glyphs
+ */
+typedef struct {
+    uint32_t hits;          /*!< Glyphs drawn from the cache */
+    uint32_t misses;        /*!< Glyphs decoded, expanded into a mask or rasterized */
+    uint32_t evictions;     /*!< Glyphs evicted for others */
+    uint32_t glyphs;        /*!< Glyphs cached */
+    uint32_t bytes;         /*!< Memory of these glyphs in bytes */
+} lvgl_port_font_cache_stats_t;
+
+/**
+ * @brief Command for the LVGL task, see lvgl_port_post()
+ */
+typedef void (*lvgl_port_cmd_cb_t)(void *arg);
+
+/**
+ * @brief Percentiles of one frame metric over the last frames
+ */
+typedef struct {
+    uint32_t p50;   /*!< Median */
+    uint32_t p95;   /*!< 95th percentile */
+    uint32_t p99;   /*!< 99th percentile */
+    uint32_t max;   /*!< Maximum */
+} lvgl_port_percentiles_t;
+
+/**
+ * @brief Frame statistics
+ *
+ * Percentiles are computed over the last 64 frames of all displays.
+ */
+typedef struct {
+    uint32_t frames;                    /*!< Frames since the reset */
+    uint32_t samples;                   /*!< Last frames in the percentiles */
+    lvgl_port_percentiles_t render_us;  /*!< Refresh time without waiting for a free draw buffer */
+    lvgl_port_percentiles_t flush_us;   /*!< Time from the first flush to the end of the last transfer */
+    lvgl_port_percentiles_t bytes;      /*!< Pixel bytes sent */
+    lvgl_port_percentiles_t areas;      /*!< Refreshed areas */
+    lvgl_port_percentiles_t lock_wait_us; /*!< Time the LVGL task waited for the LVGL mutex before the frame */
+    lvgl_port_percentiles_t handler_us; /*!< Time in lv_timer_handler() without the refresh (input, animations, user timers) */
+} lvgl_port_frame_stats_t;
+
+#ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
+/**
+ * @brief Configuration touch structure
+ */
+typedef struct {
+    lv_disp_t *disp;    /*!< LVGL display handle (returned from lvgl_port_add_disp) */
+    esp_lcd_touch_handle_t   handle;   /*!< LCD touch IO handle */
+} lvgl_port_touch_cfg_t;
+#endif
+
+#ifdef ESP_LVGL_PORT_KNOB_COMPONENT
+/**
+ * @brief Configuration of the encoder structure
+ */
+typedef struct {
+    lv_disp_t *disp;    /*!< LVGL display handle (returned from lvgl_port_add_disp) */
+    const knob_config_t *encoder_a_b;
+    const button_config_t *encoder_enter;  /*!< Navigation button for enter */
+} lvgl_port_encoder_cfg_t;
+#endif
+
+#ifdef ESP_LVGL_PORT_BUTTON_COMPONENT
+/**
+ * @brief Configuration of the navigation buttons structure
+ */
+typedef struct {
+    lv_disp_t *disp;                /*!< LVGL display handle (returned from lvgl_port_add_disp) */
+    const button_config_t *button_prev;   /*!< Navigation button for previous */
+    const button_config_t *button_next;   /*!< Navigation button for next */
+    const button_config_t *button_enter;  /*!< Navigation button for enter */
+} lvgl_port_nav_btns_cfg_t;
+#endif
+
+#ifdef ESP_LVGL_PORT_USB_HOST_HID_COMPONENT
+/**
+ * @brief Configuration of the mouse input
+ */
+typedef struct {
+    lv_disp_t *disp;        /*!< LVGL display handle (returned from lvgl_port_add_disp) */
+    uint8_t sensitivity;    /*!< Mouse sensitivity (cannot be zero) */
+    lv_obj_t *cursor_img;   /*!< Mouse cursor image, if NULL then used default */
+} lvgl_port_hid_mouse_cfg_t;
+
+/**
+ * @brief Configuration of the keyboard input
+ */
+typedef struct {
+    lv_disp_t *disp;        /*!< LVGL display handle (returned from lvgl_port_add_disp) */
+} lvgl_port_hid_keyboard_cfg_t;
+#endif
+
+/**
+ * @brief LVGL port configuration structure
+ *
+ */
+#define ESP_LVGL_PORT_INIT_CONFIG() \
+    {                               \
+        .task_priority = 4,       \
+        .task_stack = 4096,       \
+        .task_affinity = -1,      \
+        .task_max_sleep_ms = 500, \
+        .timer_period_ms = 5,     \
+    }
+
+/**
+ * @brief Initialize LVGL portation
+ *
+ * @note This function initialize LVGL and create timer and task for LVGL right working.
+ *
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the create_args are not valid
+ *      - ESP_ERR_INVALID_STATE     if esp_timer library is not initialized yet
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t lvgl_port_init(const lvgl_port_cfg_t *cfg);
+
+/**
+ * @brief Deinitialize LVGL portation
+ *
+ * @note This function deinitializes LVGL and stops the task if running.
+ * Some deinitialization will be done after the task will be stopped.
+ *
+ * @return
+ *      - ESP_OK                    on success
+ */
+esp_err_t lvgl_port_deinit(void);
+
+/**
+ * @brief Add display handling to LVGL
+ *
+ * @note Allocated memory in this function is not free in deinit. You must call lvgl_port_remove_disp for free all memory!
+ *
+ * @param disp_cfg Display configuration structure
+ * @return Pointer to LVGL display or NULL when error occured
+ */
+lv_disp_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg);
+
+/**
+ * @brief Remove display handling from LVGL
+ *
+ * @note Free all memory used for this display.
+ *
+ * @return
+ *      - ESP_OK                    on success
+ */
+esp_err_t lvgl_port_remove_disp(lv_disp_t *disp);
+
+/**
+ * @brief Send only the changed parts of flushed areas
+ *
+ * A 32-bit signature of every 32 pixels of each row sent to the LCD is kept. Flushed rows are
+ * compared with them and only the span from the first to the last changed part of each row is sent.
+ * Invalidated areas are widened to whole parts, so they can be compared. Signatures are allocated
+ * on the first enable (4 bytes per 32 pixels, `diff_mem` of the buffer statistics) and reset on
+ * every enable, so the mode can be switched at any time for A/B measurements.
+ *
+ * @note Only RGB565 colors are supported. Nothing else may write to the LCD while the diff is enabled.
+ *
+ * @param disp      LVGL display handle (returned from lvgl_port_add_disp)
+ * @param enable    Enable the diff
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ *      - ESP_ERR_NOT_SUPPORTED     if the colors are not RGB565
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t lvgl_port_set_diff(lv_disp_t *disp, bool enable);
+
+/**
+ * @brief Get draw buffers and flush statistics of the display
+ *
+ * @param disp  LVGL display handle (returned from lvgl_port_add_disp)
+ * @param stats Output statistics
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ */
+esp_err_t lvgl_port_get_buffer_stats(lv_disp_t *disp, lvgl_port_buffer_stats_t *stats);
+
+/**
+ * @brief Reset draw buffers and flush statistics of the display
+ *
+ * @param disp  LVGL display handle (returned from lvgl_port_add_disp)
+ */
+void lvgl_port_reset_buffer_stats(lv_disp_t *disp);
+
+/**
+ * @brief Get frame pacing statistics of the display
+ *
+ * @param disp  LVGL display handle (returned from lvgl_port_add_disp)
+ * @param stats Output statistics
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ *      - ESP_ERR_INVALID_STATE     if frame pacing is not enabled on the display
+ */
+esp_err_t lvgl_port_get_pacing_stats(lv_disp_t *disp, lvgl_port_pacing_stats_t *stats);
+
+/**
+ * @brief Get LVGL task statistics
+ *
+ * @param stats Output statistics
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ */
+esp_err_t lvgl_port_get_task_stats(lvgl_port_task_stats_t *stats);
+
+/**
+ * @brief Reset LVGL task statistics
+ */
+void lvgl_port_reset_task_stats(void);
+
+/**
+ * @brief Get frame statistics
+ *
+ * @param stats Output statistics
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ */
+esp_err_t lvgl_port_get_frame_stats(lvgl_port_frame_stats_t *stats);
+
+/**
+ * @brief Reset frame statistics
+ */
+void lvgl_port_reset_frame_stats(void);
+
+/**
+ * @brief Get LVGL mutex statistics per call site
+ *
+ * @param stats Output statistics
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ */
+esp_err_t lvgl_port_get_lock_stats(lvgl_port_lock_stats_t *stats);
+
+/**
+ * @brief Reset LVGL mutex statistics
+ */
+void lvgl_port_reset_lock_stats(void);
+
+/**
+ * @brief Show or hide the performance overlay
+ *
+ * Small label on the system layer with p50/p95/p99 of render and flush time, p95 of the time in
+ * lv_timer_handler() without the refresh and of the lock wait, and frames per second. It is updated every second,
+ * on round displays it is kept inside of the visible circle.
+ *
+ * @note The overlay refreshes its own area every second, these frames are in the statistics too.
+ *
+ * @param disp      LVGL display handle (returned from lvgl_port_add_disp)
+ * @param enable    Show the overlay
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t lvgl_port_stats_overlay(lv_disp_t *disp, bool enable);
+
+/**
+ * @brief Add the decoder of run-length encoded images
+ *
+ * Draws images converted by scripts/lvgl_port_img_rle.py (`LV_IMG_CF_USER_ENCODED_0`). They are
+ * decoded line by line while drawn, directly into the line LVGL blends, so no decoded copy of the
+ * image is held. Rows of recently drawn images are kept decoded in a small cache.
+ *
+ * @note Rotated and zoomed images can't be drawn line by line, keep them uncompressed.
+ *
+ * @param cache_size    Bytes of cached decoded rows, 0 for no cache
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t lvgl_port_add_rle_decoder(size_t cache_size);
+
+/**
+ * @brief Add images from an asset partition
+ *
+ * Maps the asset table built by lvgl_port_assets_partition() (see project_include.cmake) into
+ * the address space and adds the decoder of its images. The application refers to them with
+ * the generated descriptors of the same names as the image sources. Each of them is found in the
+ * table in O(1). Raw images are drawn straight from flash, run-length encoded ones like by
+ * lvgl_port_add_rle_decoder(), add that before to cache their decoded rows.
+ *
+ * @note Images of a table from another build are not drawn, the names of the assets are checked.
+ *
+ * @param partition_label   Label of the data partition
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ *      - ESP_ERR_NOT_FOUND         if there is no such partition
+ *      - ESP_ERR_INVALID_STATE     if the partition has no valid asset table or assets are added already
+ */
+esp_err_t lvgl_port_add_assets(const char *partition_label);
+
+/**
+ * @brief Get statistics of the decoder of run-length encoded images
+ *
+ * @param stats Output statistics
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ */
+esp_err_t lvgl_port_get_rle_stats(lvgl_port_rle_stats_t *stats);
+
+/**
+ * @brief Add a cache of prepared images to a display
+ *
+ * Images drawn rotated, zoomed or recolored, and images LVGL reads line by line (compressed, indexed
+ * or from an asset table), are kept as drawn: decoded, transformed and recolored. They are blended
+ * from the cache as long as the source, frame, angle, zoom, pivot and recolor stay the same. The cache
+ * is bounded by bytes and evicts the least recently used images first. Plain images are blended
+ * straight from their pixels, like without the cache.
+ *
+ * @note Images are identified by the address of their source, an image changed at run time would be drawn stale.
+ * @note All displays share one cache, its budget is set by the first one.
+ *
+ * @param disp      LVGL display handle (returned from lvgl_port_add_disp)
+ * @param budget    Bytes of the cached images
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ *      - ESP_ERR_NOT_SUPPORTED     if the display is not drawn by the software renderer in native RGB565
+ */
+esp_err_t lvgl_port_add_img_cache(lv_disp_t *disp, size_t budget);
+
+/**
+ * @brief Set the layer (screen) the image cache works for
+ *
+ * The images pinned by the previous layer are unpinned, they stay cached until evicted. Hits and
+ * misses are counted for the new layer from now on.
+ *
+ * @param layer Name of the layer, must stay valid, NULL for the default layer. Layers past the
+ *              first seven count as the default one.
+ * @return
+ *      - ESP_OK                    on success
+ */
+esp_err_t lvgl_port_set_img_cache_layer(const char *layer);
+
+/**
+ * @brief Pin an image in the image cache
+ *
+ * Cached images of a pinned source are never evicted while the current layer is set. Pin the images
+ * a screen draws every frame, when the others don't fit next to them.
+ *
+ * @param src   Image source (`lv_img_dsc_t`)
+ * @param pin   Pin or unpin
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ *      - ESP_ERR_NO_MEM            if 16 images are pinned already
+ */
+esp_err_t lvgl_port_pin_img(const void *src, bool pin);
+
+/**
+ * @brief Get statistics of the image cache for a layer
+ *
+ * @param layer Name of the layer, NULL for the default one
+ * @param stats Output statistics
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ *      - ESP_ERR_NOT_FOUND         if the layer was never set
+ */
+esp_err_t lvgl_port_get_img_cache_stats(const char *layer, lvgl_port_img_cache_stats_t *stats);
+
+/**
+ * @brief Render an image in steps of zoom, for animations through a range of zoom
+ *
+ * A zoomed image is transformed on every draw, and when its zoom changes every frame the image
+ * cache can't keep it either. Steps are transformed once, from zoom_min to zoom_max evenly, around
+ * the center of the image. The animation shows the step nearest to its zoom instead, with zoom 1:1,
+ * and LVGL blends it like a plain image. Images recolored with LV_OPA_COVER only show their alpha,
+ * with `mask` their steps keep the alpha only and take the image recolor as their color, which can
+ * change every frame without any rendering.
+ *
+ * @param src       Image source (`lv_img_dsc_t`) of a true color format
+ * @param zoom_min  Zoom of the first step, 256 is 1:1
+ * @param zoom_max  Zoom of the last step
+ * @param mask      Keep the alpha only (LV_IMG_CF_ALPHA_8BIT), 1 byte instead of 3 per pixel
+ * @param steps     Output images, must stay valid while drawn
+ * @param count     Number of steps, memory grows with it
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ *      - ESP_ERR_NO_MEM            if the image can't be rendered or there is not enough memory
+ */
+esp_err_t lvgl_port_create_img_steps(const void *src, uint16_t zoom_min, uint16_t zoom_max, bool mask, lv_img_dsc_t *steps, uint8_t count);
+
+/**
+ * @brief Free the steps of an image
+ *
+ * @param steps Images of lvgl_port_create_img_steps(), not drawn anymore
+ * @param count Number of steps
+ */
+void lvgl_port_delete_img_steps(lv_img_dsc_t *steps, uint8_t count);
+
+/**
+ * @brief Add a cache of decoded glyphs of compressed fonts
+ *
+ * LVGL decodes each glyph of a compressed font every time it is drawn. Fonts compressed by
+ * lvgl_port_subset_fonts() (see project_include.cmake) keep their decoded glyphs in this cache
+ * instead, so labels are redrawn without decoding. It is bounded by bytes and evicts the least
+ * recently drawn glyphs first. Without it the glyphs are decoded on every draw, like by LVGL.
+ *
+ * @param budget    Bytes of the cached glyphs
+ * @return
+ *      - ESP_OK                    on success
+ */
+esp_err_t lvgl_port_add_font_cache(size_t budget);
+
+/**
+ * @brief Get statistics of the cache of decoded glyphs
+ *
+ * @param stats Output statistics
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ */
+esp_err_t lvgl_port_get_font_cache_stats(lvgl_port_font_cache_stats_t *stats);
+
+/**
+ * @brief Add a cache of glyph masks to a display
+ *
+ * LVGL's software renderer unpacks the bitmap of a letter into a mask of opacities pixel by pixel
+ * every time the letter is drawn. With this cache the masks are kept, keyed by the font, the letter
+ * and the opacity, and blended from there, so redrawn digits and labels unpack nothing. The color is
+ * applied while blending, one mask serves all colors of a letter. Masks of translucent letters are
+ * added when drawn twice with the same opacity, so fading labels don't evict the others. The cache
+ * is bounded by bytes and evicts the least recently drawn masks first.
+ *
+ * @note All displays share one cache, its budget is set by the first one.
+ *
+ * @param disp      LVGL display handle (returned from lvgl_port_add_disp)
+ * @param budget    Bytes of the cached masks
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ *      - ESP_ERR_NOT_SUPPORTED     if the letters of the display are not drawn by the software renderer
+ */
+esp_err_t lvgl_port_add_glyph_cache(lv_disp_t *disp, size_t budget);
+
+/**
+ * @brief Get statistics of the cache of glyph masks
+ *
+ * @param stats Output statistics
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ */
+esp_err_t lvgl_port_get_glyph_cache_stats(lvgl_port_font_cache_stats_t *stats);
+
+/**
+ * @brief Add the cache of glyphs of scalable fonts
+ *
+ * TrueType fonts built into the asset partition by lvgl_port_assets_partition() (see
+ * project_include.cmake) are drawn in any size by lvgl_port_get_ttf_font(). Their glyphs are
+ * rasterized when first drawn into this cache, shared by all families and sizes. It is bounded by
+ * bytes and evicts the least recently drawn glyphs first.
+ *
+ * @param budget    Bytes of the cached glyphs
+ * @return
+ *      - ESP_OK                    on success
+ */
+esp_err_t lvgl_port_add_ttf_cache(size_t budget);
+
+/**
+ * @brief Get a scalable font of the asset partition
+ *
+ * Fonts are created once per family and size, screens asking for the same size share it. The
+ * font stays valid until lvgl_port_deinit().
+ *
+ * @note Needs lvgl_port_add_ttf_cache() and lvgl_port_add_assets() before.
+ *
+ * @param family    Family, the name of the font file without the extension (e.g. "Montserrat-Medium")
+ * @param px        Size of the em square in pixels, like the size of the fonts of lv_font_conv
+ * @return Font, NULL when the partition has no such family
+ */
+const lv_font_t *lvgl_port_get_ttf_font(const char *family, uint16_t px);
+
+/**
+ * @brief Rasterize the glyphs of a text ahead
+ *
+ * Called by a screen when it is created, with the texts it will draw, so its first frames draw
+ * the glyphs from the cache.
+ *
+ * @param font  Font of lvgl_port_get_ttf_font()
+ * @param text  UTF-8 text, characters repeated or without a glyph are skipped
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ */
+esp_err_t lvgl_port_prewarm_ttf_font(const lv_font_t *font, const char *text);
+
+/**
+ * @brief Get statistics of the cache of glyphs of scalable fonts
+ *
+ * @param stats Output statistics
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ */
+esp_err_t lvgl_port_get_ttf_cache_stats(lvgl_port_font_cache_stats_t *stats);
+
+/**
+ * @brief Create an object drawing a sprite
+ *
+ * Sprites are animations built from a sprite description into one atlas image by
+ * lvgl_port_sprites() (see lvgl_port_sprite.h and scripts/lvgl_port_sprite.py). The object shows
+ * the key frame until an animation is played or a frame set. The frames are drawn from their parts
+ * of the atlas, a change of the frame redraws only where the two frames differ and sends
+ * LV_EVENT_VALUE_CHANGED to the object. The image style (opacity, recolor) of the object applies.
+ *
+ * @param parent    Parent object
+ * @param sprite    Sprite, must stay valid while the object exists
+ * @return Sprite object of the size of the frames, NULL when the sprite is invalid
+ */
+lv_obj_t *lvgl_port_create_sprite(lv_obj_t *parent, const lvgl_port_sprite_t *sprite);
+
+/**
+ * @brief Play an animation of a sprite from its start
+ *
+ * @param sprite    Sprite object (returned from lvgl_port_create_sprite)
+ * @param anim      Name of the animation
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ *      - ESP_ERR_NOT_FOUND         if the object is no sprite object or has no such animation
+ */
+esp_err_t lvgl_port_play_sprite(lv_obj_t *sprite, const char *anim);
+
+/**
+ * @brief Stop the animation of a sprite and show a frame
+ *
+ * @param sprite    Sprite object (returned from lvgl_port_create_sprite)
+ * @param frame     Name of the frame
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ *      - ESP_ERR_NOT_FOUND         if the object is no sprite object or has no such frame
+ */
+esp_err_t lvgl_port_set_sprite_frame(lv_obj_t *sprite, const char *frame);
+
+/**
+ * @brief Get the frame a sprite shows
+ *
+ * @param sprite    Sprite object (returned from lvgl_port_create_sprite)
+ * @return Name of the frame, NULL if the object is no sprite object
+ */
+const char *lvgl_port_get_sprite_frame(lv_obj_t *sprite);
+
+/**
+ * @brief Create an object scrolling a texture
+ *
+ * The object shows the image repeated horizontally, starting from a column of the image. Looping
+ * animations of a texture (waves, a moving background) change that column instead of moving an
+ * image object: only the box of the object is redrawn, and objects under an opaque texture
+ * (LV_IMG_CF_TRUE_COLOR) are not drawn at all. The object has the size of the image, a different
+ * size shows more or fewer copies, rows below the image stay empty. The image style of the object
+ * applies.
+ *
+ * @param parent    Parent object
+ * @param src       Image source of the texture, must stay valid while the object exists
+ * @return Scroll object, NULL when the image can't be opened
+ */
+lv_obj_t *lvgl_port_create_scroll(lv_obj_t *parent, const void *src);
+
+/**
+ * @brief Set the column of the texture shown at the left of a scroll object
+ *
+ * @param scroll    Scroll object (returned from lvgl_port_create_scroll)
+ * @param x         Column of the texture, any value, wrapped by the width of the texture
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if the object is no scroll object
+ */
+esp_err_t lvgl_port_set_scroll_offset(lv_obj_t *scroll, lv_coord_t x);
+
+/**
+ * @brief Clip an object and its children to a rounded rectangle while drawn
+ *
+ * Replaces a radius draw mask initialized on every draw. The opacities of the rows of the shape are
+ * computed once and shared by all objects clipped to a shape of the same size (see
+ * lvgl_port_clip.h), drawings inside the rectangle skip the mask. The shape is freed with the last
+ * object clipped to it.
+ *
+ * @param obj       Clipped object
+ * @param box       Object of the rectangle, NULL for obj itself; its coordinates are read on every draw
+ * @param radius    Radius of the corners, LV_RADIUS_CIRCLE for a circle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t lvgl_port_add_clip_radius(lv_obj_t *obj, const lv_obj_t *box, lv_coord_t radius);
+
+/**
+ * @brief Fade an object and its children in at its top and out at its bottom while drawn
+ *
+ * Replaces a pair of fade draw masks initialized on every draw, like the one of a roller showing
+ * the selected row only. The opacities of the rows are computed once, drawings between the fades
+ * skip the mask.
+ *
+ * @param obj       Faded object
+ * @param top       Rows from transparent to covering at the top
+ * @param bottom    Rows from covering to transparent at the bottom
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t lvgl_port_add_clip_fade(lv_obj_t *obj, lv_coord_t top, lv_coord_t bottom);
+
+/**
+ * @brief Draw the text of a roller from bands rendered once
+ *
+ * A roller lays out and draws its whole text letter by letter on every frame it scrolls, in the
+ * font of the rows and in the font of the selected row. Here both texts are rendered once into
+ * bands of one opacity byte per pixel (see lvgl_port_roller_obj.h), drawn as masks of a fill in the
+ * text color where the roller would draw the texts. A fade of the roller (lvgl_port_add_clip_fade)
+ * applies to the bands. The bands hold one byte per pixel of the rows of the texts with coverage.
+ *
+ * @note Set the options and the text styles before; the text opacities of the roller are set
+ *       transparent. The bands are rendered again when the roller or its text changes size.
+ *
+ * @param roller    Roller object
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if the object is no roller
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t lvgl_port_add_roller_band(lv_obj_t *roller);
+
+#ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
+/**
+ * @brief Add LCD touch as an input device
+ *
+ * @note Allocated memory in this function is not free in deinit. You must call lvgl_port_remove_touch for free all memory!
+ *
+ * @param touch_cfg Touch configuration structure
+ * @return Pointer to LVGL touch input device or NULL when error occured
+ */
+lv_indev_t *lvgl_port_add_touch(const lvgl_port_touch_cfg_t *touch_cfg);
+
+/**
+ * @brief Remove selected LCD touch from input devices
+ *
+ * @note Free all memory used for this display.
+ *
+ * @return
+ *      - ESP_OK                    on success
+ */
+esp_err_t lvgl_port_remove_touch(lv_indev_t *touch);
+#endif
+
+#ifdef ESP_LVGL_PORT_KNOB_COMPONENT
+/**
+ * @brief Add encoder as an input device
+ *
+ * @note Allocated memory in this function is not free in deinit. You must call lvgl_port_remove_encoder for free all memory!
+ *
+ * @param encoder_cfg Encoder configuration structure
+ * @return Pointer to LVGL encoder input device or NULL when error occured
+ */
+lv_indev_t *lvgl_port_add_encoder(const lvgl_port_encoder_cfg_t *encoder_cfg);
+
+/**
+ * @brief Remove encoder from input devices
+ *
+ * @note Free all memory used for this input device.
+ *
+ * @return
+ *      - ESP_OK                    on success
+ */
+esp_err_t lvgl_port_remove_encoder(lv_indev_t *encoder);
+#endif
+
+#ifdef ESP_LVGL_PORT_BUTTON_COMPONENT
+/**
+ * @brief Add buttons as an input device
+ *
+ * @note Allocated memory in this function is not free in deinit. You must call lvgl_port_remove_navigation_buttons for free all memory!
+ *
+ * @param buttons_cfg Buttons configuration structure
+ * @return Pointer to LVGL buttons input device or NULL when error occured
+ */
+lv_indev_t *lvgl_port_add_navigation_buttons(const lvgl_port_nav_btns_cfg_t *buttons_cfg);
+
+/**
+ * @brief Remove selected buttons from input devices
+ *
+ * @note Free all memory used for this input device.
+ *
+ * @return
+ *      - ESP_OK                    on success
+ */
+esp_err_t lvgl_port_remove_navigation_buttons(lv_indev_t *buttons);
+#endif
+
+#ifdef ESP_LVGL_PORT_USB_HOST_HID_COMPONENT
+/**
+ * @brief Add USB HID mouse as an input device
+ *
+ * @note The USB host must be initialized before. Use `usb_host_install` for host initialization.
+ *
+ * @param mouse_cfg mouse configuration structure
+ * @return Pointer to LVGL buttons input device or NULL when error occured
+ */
+lv_indev_t *lvgl_port_add_usb_hid_mouse_input(const lvgl_port_hid_mouse_cfg_t *mouse_cfg);
+
+/**
+ * @brief Add USB HID keyboard as an input device
+ *
+ * @note The USB host must be initialized before. Use `usb_host_install` for host initialization.
+ *
+ * @param keyboard_cfg keyboard configuration structure
+ * @return Pointer to LVGL buttons input device or NULL when error occured
+ */
+lv_indev_t *lvgl_port_add_usb_hid_keyboard_input(const lvgl_port_hid_keyboard_cfg_t *keyboard_cfg);
+
+/**
+ * @brief Remove selected USB HID from input devices
+ *
+ * @note Free all memory used for this input device. When removed all HID devices, the HID task will be freed.
+ *
+ * @return
+ *      - ESP_OK                    on success
+ */
+esp_err_t lvgl_port_remove_usb_hid_input(lv_indev_t *hid);
+#endif
+
+/**
+ * @brief Take LVGL mutex
+ *
+ * @note Wait and hold time are accounted to the call site, see lvgl_port_get_lock_stats().
+ *
+ * @param timeout_ms Timeout in [ms]. 0 will block indefinitely.
+ * @return
+ *      - true  Mutex was taken
+ *      - false Mutex was NOT taken
+ */
+bool lvgl_port_lock(uint32_t timeout_ms);
+
+/**
+ * @brief Take LVGL mutex on behalf of a caller
+ *
+ * For wrappers of lvgl_port_lock() (e.g. in a BSP), the statistics are accounted to the caller of the wrapper
+ * instead of to the wrapper itself. Pass `__builtin_return_address(0)` of the wrapper.
+ *
+ * @param timeout_ms Timeout in [ms]. 0 will block indefinitely.
+ * @param caller     Call site in the lock statistics
+ * @return
+ *      - true  Mutex was taken
+ *      - false Mutex was NOT taken
+ */
+bool lvgl_port_lock_from(uint32_t timeout_ms, const void *caller);
+
+/**
+ * @brief Give LVGL mutex
+ *
+ */
+void lvgl_port_unlock(void);
+
+/**
+ * @brief Wake up LVGL task
+ *
+ * @note Only needed with `task_wake_on_event`, when something outside of LVGL changes, what should be handled now
+ *       (e.g. a custom input device has new data). Unlocking the LVGL mutex wakes up the task itself.
+ *       Can be called from an interrupt.
+ *
+ * @param input Input device has new data, its reading is not postponed until its read timer is due
+ */
+void lvgl_port_task_wake(bool input);
+
+/**
+ * @brief Post a command to the LVGL task
+ *
+ * The LVGL task runs the posted commands in order before its next lv_timer_handler(), with the LVGL mutex taken,
+ * so they can call LVGL. The queue is lock-free: posting never waits for the LVGL mutex, so audio callbacks,
+ * settings changes or sensor updates do not block on a running refresh. Can be called from an interrupt.
+ *
+ * @note The queue has 32 entries, at most that many commands are run per frame.
+ *
+ * @param cb  Command
+ * @param arg Argument of the command, must stay valid until it runs
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if some of the arguments are not valid
+ *      - ESP_ERR_INVALID_STATE     if lvgl_port_init was not called
+ *      - ESP_ERR_NO_MEM            if the queue is full
+ */
+esp_err_t lvgl_port_post(lvgl_port_cmd_cb_t cb, void *arg);
+
+/**
+ * @brief Notify LVGL, that data was flushed to LCD display
+ *
+ * @note It should be used only when not called inside LVGL port (more in README).
+ *
+ * @param disp          LVGL display handle (returned from lvgl_port_add_disp)
+ */
+void lvgl_port_flush_ready(lv_disp_t *disp);
+
+/**
+ * @brief Stop lvgl task
+ *
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if the timer is not running
+ */
+esp_err_t lvgl_port_stop(void);
+
+/**
+ * @brief Resume lvgl task
+ *
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if the timer is not running
+ */
+esp_err_t lvgl_port_resume(void);
+
+#ifdef __cplusplus
+}
+#endif
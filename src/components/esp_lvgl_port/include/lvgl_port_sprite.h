@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Sprite atlases
+ *
+ * A sprite is an animation of frames of the same size, made by scripts/lvgl_port_sprite.py from a
+ * sprite description. All frames are stored in one atlas image. The first frame is the key frame,
+ * the other ones are stored as a patch, the smallest rectangle where they differ from the key frame.
+ * A frame is drawn as the key frame around its patch and the patch, a change of the frame redraws
+ * the patches of the two frames only.
+ * Sprites are drawn by lvgl_port_create_sprite() of esp_lvgl_port.h.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Area of a sprite, coordinates are inclusive, x2 < x1 for an empty one
+ */
+typedef struct {
+    int16_t x1; /*!< First column */
+    int16_t y1; /*!< First row */
+    int16_t x2; /*!< Last column */
+    int16_t y2; /*!< Last row */
+} lvgl_port_sprite_area_t;
+
+/**
+ * @brief Part of the atlas drawn to an area of the sprite
+ */
+typedef struct {
+    uint16_t atlas_x;               /*!< First column in the atlas */
+    uint16_t atlas_y;               /*!< First row in the atlas */
+    lvgl_port_sprite_area_t area;   /*!< Area in the sprite */
+} lvgl_port_sprite_cell_t;
+
+/**
+ * @brief Frame of a sprite
+ */
+typedef struct {
+    const char *name;               /*!< Name of the frame */
+    lvgl_port_sprite_cell_t patch;  /*!< Where the frame differs from the key frame, empty for the key frame */
+} lvgl_port_sprite_frame_t;
+
+/**
+ * @brief Key of an animation
+ */
+typedef struct {
+    uint8_t frame;                  /*!< Index of the frame */
+    uint16_t time;                  /*!< Time the frame is shown in ms, ignored for the last key of an animation without loop */
+} lvgl_port_sprite_key_t;
+
+/**
+ * @brief Animation of a sprite
+ */
+typedef struct {
+    const char *name;                   /*!< Name of the animation */
+    const lvgl_port_sprite_key_t *keys; /*!< Keys in the order they are shown */
+    uint8_t key_count;                  /*!< Number of keys, at least one */
+    bool loop;                          /*!< Starts over after the last key, else the last frame stays */
+} lvgl_port_sprite_anim_t;
+
+/**
+ * @brief Sprite
+ */
+typedef struct {
+    const void *atlas;                      /*!< Image source of the atlas (`lv_img_dsc_t`) */
+    uint16_t atlas_w;                       /*!< Width of the atlas */
+    uint16_t atlas_h;                       /*!< Height of the atlas */
+    uint16_t w;                             /*!< Width of the frames */
+    uint16_t h;                             /*!< Height of the frames */
+    lvgl_port_sprite_cell_t key;            /*!< Visible part of the key frame */
+    const lvgl_port_sprite_frame_t *frames; /*!< Frames, the key frame first */
+    uint8_t frame_count;                    /*!< Number of frames */
+    const lvgl_port_sprite_anim_t *anims;   /*!< Animations */
+    uint8_t anim_count;                     /*!< Number of animations */
+} lvgl_port_sprite_t;
+
+/**
+ * @brief Declare a sprite built by lvgl_port_sprites() of the component CMake functions
+ */
+#define LVGL_PORT_SPRITE_DECLARE(name) extern const lvgl_port_sprite_t name;
+
+/**
+ * @brief Check that all parts of a sprite are inside of the atlas and the frames
+ *
+ * @param sprite    Sprite
+ * @return true when the sprite can be drawn
+ */
+bool lvgl_port_sprite_check(const lvgl_port_sprite_t *sprite);
+
+/**
+ * @brief Find a frame by its name
+ *
+ * @param sprite    Sprite
+ * @param name      Name of the frame
+ * @return Index of the frame, -1 when not found
+ */
+int lvgl_port_sprite_find_frame(const lvgl_port_sprite_t *sprite, const char *name);
+
+/**
+ * @brief Find an animation by its name
+ *
+ * @param sprite    Sprite
+ * @param name      Name of the animation
+ * @return Animation, NULL when not found
+ */
+const lvgl_port_sprite_anim_t *lvgl_port_sprite_find_anim(const lvgl_port_sprite_t *sprite, const char *name);
+
+/**
+ * @brief Get the time of one run of an animation
+ *
+ * @param anim  Animation
+ * @return Time in ms until the animation starts over (loop) or shows its last frame for good
+ */
+uint32_t lvgl_port_sprite_anim_time(const lvgl_port_sprite_anim_t *anim);
+
+/**
+ * @brief Get the frame an animation shows
+ *
+ * @param anim  Animation
+ * @param t     Time since the start in ms
+ * @return Index of the frame
+ */
+uint8_t lvgl_port_sprite_anim_frame(const lvgl_port_sprite_anim_t *anim, uint32_t t);
+
+/**
+ * @brief Get the parts of the atlas a frame is drawn from
+ *
+ * The parts don't overlap: up to four parts of the key frame around the patch, then the patch.
+ *
+ * @param sprite    Sprite
+ * @param frame     Index of the frame
+ * @param parts     Parts, room for 5
+ * @return Number of parts
+ */
+size_t lvgl_port_sprite_parts(const lvgl_port_sprite_t *sprite, uint8_t frame, lvgl_port_sprite_cell_t parts[5]);
+
+/**
+ * @brief Get the areas of the sprite to redraw when the frame changes
+ *
+ * @param sprite    Sprite
+ * @param from      Index of the shown frame
+ * @param to        Index of the next frame
+ * @param areas     Areas, room for 2
+ * @return Number of areas, 0 when the frames look the same
+ */
+size_t lvgl_port_sprite_changed(const lvgl_port_sprite_t *sprite, uint8_t from, uint8_t to, lvgl_port_sprite_area_t areas[2]);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,191 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include "lvgl_port_area.h"
+
+/* Area can be split into 4 parts at most: above, below, left and right of the other one */
+#define LVGL_PORT_AREA_MAX_PARTS    (4)
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static inline int64_t lvgl_port_area_cost_one(const lvgl_port_area_t *a, uint32_t px_size, uint32_t trans_cost)
+{
+    return trans_cost + (int64_t)(a->x2 - a->x1 + 1) * (a->y2 - a->y1 + 1) * px_size;
+}
+
+static inline bool lvgl_port_area_is_in(const lvgl_port_area_t *in, const lvgl_port_area_t *out)
+{
+    return (in->x1 >= out->x1 && in->y1 >= out->y1 && in->x2 <= out->x2 && in->y2 <= out->y2);
+}
+
+static inline bool lvgl_port_area_is_on(const lvgl_port_area_t *a, const lvgl_port_area_t *b)
+{
+    return (a->x1 <= b->x2 && b->x1 <= a->x2 && a->y1 <= b->y2 && b->y1 <= a->y2);
+}
+
+static inline void lvgl_port_area_join(lvgl_port_area_t *res, const lvgl_port_area_t *a, const lvgl_port_area_t *b)
+{
+    res->x1 = (a->x1 < b->x1) ? a->x1 : b->x1;
+    res->y1 = (a->y1 < b->y1) ? a->y1 : b->y1;
+    res->x2 = (a->x2 > b->x2) ? a->x2 : b->x2;
+    res->y2 = (a->y2 > b->y2) ? a->y2 : b->y2;
+}
+
+/* Drop areas inside of another one, order of the rest is not kept */
+static size_t lvgl_port_area_drop_covered(lvgl_port_area_t *areas, size_t count)
+{
+    size_t i = 0;
+    while (i < count) {
+        bool covered = false;
+        for (size_t j = 0; j < count && !covered; j++) {
+            covered = (i != j && lvgl_port_area_is_in(&areas[i], &areas[j]));
+        }
+        if (covered) {
+            areas[i] = areas[--count];
+        } else {
+            i++;
+        }
+    }
+
+    return count;
+}
+
+/* Merge the pair with the best gain, false when no merge pays off */
+static bool lvgl_port_area_merge_best(lvgl_port_area_t *areas, size_t *count, uint32_t px_size, uint32_t trans_cost)
+{
+    int64_t best_gain = 0;
+    size_t best_i = 0;
+    size_t best_j = 0;
+    lvgl_port_area_t best_area = {0};
+    lvgl_port_area_t joined;
+
+    for (size_t i = 0; i < *count; i++) {
+        for (size_t j = i + 1; j < *count; j++) {
+            lvgl_port_area_join(&joined, &areas[i], &areas[j]);
+            const int64_t gain = lvgl_port_area_cost_one(&areas[i], px_size, trans_cost) + lvgl_port_area_cost_one(&areas[j], px_size, trans_cost)
+                                 - lvgl_port_area_cost_one(&joined, px_size, trans_cost);
+            if (gain > best_gain) {
+                best_gain = gain;
+                best_i = i;
+                best_j = j;
+                best_area = joined;
+            }
+        }
+    }
+
+    if (best_gain <= 0) {
+        return false;
+    }
+
+    areas[best_i] = best_area;
+    areas[best_j] = areas[--(*count)];
+    *count = lvgl_port_area_drop_covered(areas, *count);
+    return true;
+}
+
+/* Parts of `a` outside of the overlapping `b` */
+static size_t lvgl_port_area_subtract(const lvgl_port_area_t *a, const lvgl_port_area_t *b, lvgl_port_area_t *parts)
+{
+    size_t n = 0;
+    int y1 = a->y1;
+    int y2 = a->y2;
+
+    if (a->y1 < b->y1) {
+        parts[n++] = (lvgl_port_area_t) {
+            a->x1, a->y1, a->x2, b->y1 - 1
+        };
+        y1 = b->y1;
+    }
+    if (a->y2 > b->y2) {
+        parts[n++] = (lvgl_port_area_t) {
+            a->x1, b->y2 + 1, a->x2, a->y2
+        };
+        y2 = b->y2;
+    }
+    if (a->x1 < b->x1) {
+        parts[n++] = (lvgl_port_area_t) {
+            a->x1, y1, b->x1 - 1, y2
+        };
+    }
+    if (a->x2 > b->x2) {
+        parts[n++] = (lvgl_port_area_t) {
+            b->x2 + 1, y1, a->x2, y2
+        };
+    }
+
+    return n;
+}
+
+/* Split the first area, where cutting off the overlap pays off, false when there is none */
+static bool lvgl_port_area_split_one(lvgl_port_area_t *areas, size_t *count, size_t max_count, uint32_t px_size, uint32_t trans_cost)
+{
+    lvgl_port_area_t parts[LVGL_PORT_AREA_MAX_PARTS];
+
+    for (size_t i = 0; i < *count; i++) {
+        for (size_t j = 0; j < *count; j++) {
+            if (i == j || !lvgl_port_area_is_on(&areas[i], &areas[j])) {
+                continue;
+            }
+
+            const size_t n = lvgl_port_area_subtract(&areas[j], &areas[i], parts);
+            if (n == 0) {
+                areas[j] = areas[--(*count)];
+                return true;
+            }
+            if (*count - 1 + n > max_count) {
+                continue;
+            }
+            if (lvgl_port_area_cost(parts, n, px_size, trans_cost) >= (uint64_t)lvgl_port_area_cost_one(&areas[j], px_size, trans_cost)) {
+                continue;
+            }
+
+            areas[j] = parts[0];
+            for (size_t p = 1; p < n; p++) {
+                areas[(*count)++] = parts[p];
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+uint64_t lvgl_port_area_cost(const lvgl_port_area_t *areas, size_t count, uint32_t px_size, uint32_t trans_cost)
+{
+    uint64_t cost = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        cost += lvgl_port_area_cost_one(&areas[i], px_size, trans_cost);
+    }
+
+    return cost;
+}
+
+size_t lvgl_port_area_optimize(lvgl_port_area_t *areas, size_t count, size_t max_count, uint32_t px_size, uint32_t trans_cost)
+{
+    count = lvgl_port_area_drop_covered(areas, count);
+
+    /* Every step lowers the total cost, so the loop always ends */
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        while (lvgl_port_area_merge_best(areas, &count, px_size, trans_cost)) {
+            changed = true;
+        }
+        if (lvgl_port_area_split_one(areas, &count, max_count, px_size, trans_cost)) {
+            changed = true;
+        }
+    }
+
+    return count;
+}
@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "lvgl_port_assets.h"
+
+#define LVGL_PORT_ASSETS_FNV_OFFSET (2166136261u)
+#define LVGL_PORT_ASSETS_FNV_PRIME  (16777619u)
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static inline uint32_t lvgl_port_assets_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint16_t lvgl_port_assets_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline const uint8_t *lvgl_port_assets_entry(const lvgl_port_assets_t *assets, uint32_t id)
+{
+    return assets->data + LVGL_PORT_ASSETS_HEADER_SIZE + (size_t)id * LVGL_PORT_ASSETS_ENTRY_SIZE;
+}
+
+static inline void lvgl_port_assets_fill(const lvgl_port_assets_t *assets, const uint8_t *e, lvgl_port_asset_t *asset)
+{
+    asset->data = assets->data + lvgl_port_assets_u32(e);
+    asset->size = lvgl_port_assets_u32(e + 4);
+    asset->w = lvgl_port_assets_u16(e + 12);
+    asset->h = lvgl_port_assets_u16(e + 14);
+    asset->cf = e[16];
+    asset->encoding = e[17];
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+bool lvgl_port_assets_open(lvgl_port_assets_t *assets, const void *data, size_t size)
+{
+    const uint8_t *p = (const uint8_t *)data;
+
+    if (assets == NULL || p == NULL || size < LVGL_PORT_ASSETS_HEADER_SIZE) {
+        return false;
+    }
+    const uint32_t count = lvgl_port_assets_u32(p + 4);
+    const uint32_t bundle_size = lvgl_port_assets_u32(p + 8);
+    if (lvgl_port_assets_u32(p) != LVGL_PORT_ASSETS_MAGIC || bundle_size < LVGL_PORT_ASSETS_HEADER_SIZE || bundle_size > size) {
+        return false;
+    }
+    if (count > (bundle_size - LVGL_PORT_ASSETS_HEADER_SIZE) / LVGL_PORT_ASSETS_ENTRY_SIZE) {
+        return false;
+    }
+
+    /* Check every entry once, lookups trust them */
+    const uint32_t table_end = LVGL_PORT_ASSETS_HEADER_SIZE + count * LVGL_PORT_ASSETS_ENTRY_SIZE;
+    assets->data = p;
+    assets->size = bundle_size;
+    assets->count = count;
+    for (uint32_t id = 0; id < count; id++) {
+        const uint8_t *e = lvgl_port_assets_entry(assets, id);
+        const uint32_t offset = lvgl_port_assets_u32(e);
+        const uint32_t blob_size = lvgl_port_assets_u32(e + 4);
+        if (offset < table_end || offset % LVGL_PORT_ASSETS_ALIGN || offset > bundle_size || blob_size > bundle_size - offset ||
+                lvgl_port_assets_u16(e + 12) == 0 || lvgl_port_assets_u16(e + 14) == 0 || e[17] > LVGL_PORT_ASSET_FONT) {
+            assets->count = 0;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool lvgl_port_assets_get(const lvgl_port_assets_t *assets, uint32_t id, uint32_t name_hash, lvgl_port_asset_t *asset)
+{
+    if (id >= assets->count) {
+        return false;
+    }
+    const uint8_t *e = lvgl_port_assets_entry(assets, id);
+    if (lvgl_port_assets_u32(e + 8) != name_hash) {
+        return false;
+    }
+
+    lvgl_port_assets_fill(assets, e, asset);
+    return true;
+}
+
+/* Fonts are looked up once per family and size, the table is short */
+bool lvgl_port_assets_find(const lvgl_port_assets_t *assets, uint32_t name_hash, lvgl_port_asset_t *asset)
+{
+    for (uint32_t id = 0; id < assets->count; id++) {
+        const uint8_t *e = lvgl_port_assets_entry(assets, id);
+        if (lvgl_port_assets_u32(e + 8) == name_hash) {
+            lvgl_port_assets_fill(assets, e, asset);
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t lvgl_port_assets_hash(const char *name)
+{
+    uint32_t hash = LVGL_PORT_ASSETS_FNV_OFFSET;
+
+    for (const uint8_t *c = (const uint8_t *)name; *c; c++) {
+        hash = (hash ^ *c) * LVGL_PORT_ASSETS_FNV_PRIME;
+    }
+    return hash;
+}
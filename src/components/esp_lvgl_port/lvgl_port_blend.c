@@ -0,0 +1,59 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "lvgl.h"
+#include "src/draw/sw/lv_draw_sw.h"
+#include "lvgl_port_blend.h"
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void lvgl_port_blend_mask(lv_draw_ctx_t *draw_ctx, const lv_area_t *box, const lv_opa_t *mask, lv_color_t color,
+                          lv_opa_t opa, lv_blend_mode_t blend_mode)
+{
+    lv_draw_sw_blend_dsc_t blend;
+    lv_area_t area;
+
+    if (!_lv_area_intersect(&area, box, draw_ctx->clip_area)) {
+        return;
+    }
+    memset(&blend, 0, sizeof(blend));
+    blend.color = color;
+    blend.opa = opa;
+    blend.blend_mode = blend_mode;
+    blend.blend_area = &area;
+    blend.mask_res = LV_DRAW_MASK_RES_CHANGED;
+
+#if LV_DRAW_COMPLEX
+    if (lv_draw_mask_is_any(&area)) {
+        const lv_coord_t w = lv_area_get_width(&area);
+        const lv_coord_t box_w = lv_area_get_width(box);
+        lv_opa_t *buf = lv_mem_buf_get(lv_area_get_size(&area));
+        if (buf == NULL) {
+            return;
+        }
+        for (lv_coord_t y = area.y1; y <= area.y2; y++) {
+            lv_opa_t *row = buf + (y - area.y1) * w;
+            memcpy(row, mask + (y - box->y1) * box_w + (area.x1 - box->x1), w);
+            if (lv_draw_mask_apply(row, area.x1, y, w) == LV_DRAW_MASK_RES_TRANSP) {
+                memset(row, 0, w);
+            }
+        }
+        blend.mask_buf = buf;
+        blend.mask_area = &area;
+        lv_draw_sw_blend(draw_ctx, &blend);
+        lv_mem_buf_release(buf);
+        return;
+    }
+#endif
+
+    /* Blended in place, the blend clips the mask to the area */
+    blend.mask_buf = (lv_opa_t *)mask;
+    blend.mask_area = box;
+    lv_draw_sw_blend(draw_ctx, &blend);
+}
@@ -0,0 +1,252 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl_port_cache.h"
+
+/* Bytes an entry holds, the pixels are allocated with the entry */
+#define LVGL_PORT_CACHE_BYTES(size)    (sizeof(lvgl_port_cache_entry_t) + (size))
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static inline bool lvgl_port_cache_key_eq(const lvgl_port_cache_key_t *a, const lvgl_port_cache_key_t *b)
+{
+    return a->src == b->src && a->frame_id == b->frame_id && a->angle == b->angle && a->zoom == b->zoom &&
+           a->pivot_x == b->pivot_x && a->pivot_y == b->pivot_y && a->recolor == b->recolor &&
+           a->recolor_opa == b->recolor_opa && a->antialias == b->antialias;
+}
+
+static void lvgl_port_cache_unlink(lvgl_port_cache_t *cache, lvgl_port_cache_entry_t *entry)
+{
+    if (entry->prev) {
+        entry->prev->next = entry->next;
+    } else {
+        cache->head = entry->next;
+    }
+    if (entry->next) {
+        entry->next->prev = entry->prev;
+    } else {
+        cache->tail = entry->prev;
+    }
+    entry->prev = NULL;
+    entry->next = NULL;
+}
+
+static void lvgl_port_cache_push(lvgl_port_cache_t *cache, lvgl_port_cache_entry_t *entry)
+{
+    entry->prev = NULL;
+    entry->next = cache->head;
+    if (cache->head) {
+        cache->head->prev = entry;
+    } else {
+        cache->tail = entry;
+    }
+    cache->head = entry;
+}
+
+/* Pin the entry when its source is, instead of the one used before */
+static void lvgl_port_cache_protect(lvgl_port_cache_t *cache, lvgl_port_cache_entry_t *entry)
+{
+    if (!lvgl_port_cache_pinned(cache, entry->key.src)) {
+        return;
+    }
+    for (lvgl_port_cache_entry_t *e = cache->head; e; e = e->next) {
+        if (e->key.src == entry->key.src) {
+            e->pinned = (e == entry);
+        }
+    }
+}
+
+/* Evict least recently used entries not pinned until bytes are free, none when pinned ones are in the way */
+static bool lvgl_port_cache_make_room(lvgl_port_cache_t *cache, size_t bytes)
+{
+    lvgl_port_cache_entry_t *entry;
+    size_t evictable = cache->budget - cache->used;
+
+    for (entry = cache->tail; entry && evictable < bytes; entry = entry->prev) {
+        if (!entry->pinned) {
+            evictable += LVGL_PORT_CACHE_BYTES(entry->size);
+        }
+    }
+    if (evictable < bytes) {
+        return false;
+    }
+
+    entry = cache->tail;
+    while (cache->budget - cache->used < bytes) {
+        while (entry && entry->pinned) {
+            entry = entry->prev;
+        }
+        lvgl_port_cache_entry_t *prev = entry->prev;
+        cache->stats[entry->layer].evictions++;
+        lvgl_port_cache_remove(cache, entry);
+        entry = prev;
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void lvgl_port_cache_init(lvgl_port_cache_t *cache, size_t budget)
+{
+    memset(cache, 0, sizeof(lvgl_port_cache_t));
+    cache->budget = budget;
+}
+
+void lvgl_port_cache_deinit(lvgl_port_cache_t *cache)
+{
+    while (cache->head) {
+        lvgl_port_cache_remove(cache, cache->head);
+    }
+    memset(cache, 0, sizeof(lvgl_port_cache_t));
+}
+
+lvgl_port_cache_entry_t *lvgl_port_cache_find(lvgl_port_cache_t *cache, const lvgl_port_cache_key_t *key)
+{
+    for (lvgl_port_cache_entry_t *entry = cache->head; entry; entry = entry->next) {
+        if (lvgl_port_cache_key_eq(&entry->key, key)) {
+            if (entry != cache->head) {
+                lvgl_port_cache_unlink(cache, entry);
+                lvgl_port_cache_push(cache, entry);
+            }
+            lvgl_port_cache_protect(cache, entry);
+            cache->stats[cache->layer].hits++;
+            return entry;
+        }
+    }
+    cache->stats[cache->layer].misses++;
+    return NULL;
+}
+
+bool lvgl_port_cache_admit(lvgl_port_cache_t *cache, const lvgl_port_cache_key_t *key)
+{
+    for (uint32_t i = 0; i < LVGL_PORT_CACHE_GHOSTS; i++) {
+        if (cache->ghosts[i].src && lvgl_port_cache_key_eq(&cache->ghosts[i], key)) {
+            memset(&cache->ghosts[i], 0, sizeof(lvgl_port_cache_key_t));
+            return true;
+        }
+    }
+    cache->ghosts[cache->ghost_next] = *key;
+    cache->ghost_next = (cache->ghost_next + 1) % LVGL_PORT_CACHE_GHOSTS;
+    return false;
+}
+
+lvgl_port_cache_entry_t *lvgl_port_cache_add(lvgl_port_cache_t *cache, const lvgl_port_cache_key_t *key, size_t size)
+{
+    const size_t bytes = LVGL_PORT_CACHE_BYTES(size);
+
+    if (size == 0 || bytes > cache->budget || !lvgl_port_cache_make_room(cache, bytes)) {
+        return NULL;
+    }
+    lvgl_port_cache_entry_t *entry = malloc(bytes);
+    if (entry == NULL) {
+        return NULL;
+    }
+
+    memset(entry, 0, sizeof(lvgl_port_cache_entry_t));
+    entry->key = *key;
+    entry->data = (uint8_t *)(entry + 1);
+    entry->size = size;
+    entry->layer = cache->layer;
+    lvgl_port_cache_push(cache, entry);
+    lvgl_port_cache_protect(cache, entry);
+    cache->used += bytes;
+    cache->stats[entry->layer].entries++;
+    cache->stats[entry->layer].bytes += bytes;
+    return entry;
+}
+
+lvgl_port_cache_entry_t *lvgl_port_cache_shrink(lvgl_port_cache_t *cache, lvgl_port_cache_entry_t *entry, size_t size)
+{
+    if (size == 0 || size >= entry->size) {
+        return entry;
+    }
+    lvgl_port_cache_entry_t *prev = entry->prev;
+    lvgl_port_cache_entry_t *next = entry->next;
+    const size_t freed = entry->size - size;
+    lvgl_port_cache_entry_t *moved = realloc(entry, LVGL_PORT_CACHE_BYTES(size));
+    if (moved == NULL) {
+        return entry;
+    }
+
+    /* The neighbours point to the old address */
+    moved->data = (uint8_t *)(moved + 1);
+    moved->size = size;
+    if (prev) {
+        prev->next = moved;
+    } else {
+        cache->head = moved;
+    }
+    if (next) {
+        next->prev = moved;
+    } else {
+        cache->tail = moved;
+    }
+    cache->used -= freed;
+    cache->stats[moved->layer].bytes -= freed;
+    return moved;
+}
+
+void lvgl_port_cache_remove(lvgl_port_cache_t *cache, lvgl_port_cache_entry_t *entry)
+{
+    const size_t bytes = LVGL_PORT_CACHE_BYTES(entry->size);
+
+    lvgl_port_cache_unlink(cache, entry);
+    cache->used -= bytes;
+    cache->stats[entry->layer].entries--;
+    cache->stats[entry->layer].bytes -= bytes;
+    free(entry);
+}
+
+void lvgl_port_cache_set_layer(lvgl_port_cache_t *cache, uint8_t layer)
+{
+    cache->layer = (layer < LVGL_PORT_CACHE_LAYERS) ? layer : 0;
+    cache->pin_count = 0;
+    for (lvgl_port_cache_entry_t *e = cache->head; e; e = e->next) {
+        e->pinned = false;
+    }
+}
+
+bool lvgl_port_cache_pin(lvgl_port_cache_t *cache, const void *src, bool pin)
+{
+    uint32_t i;
+
+    for (i = 0; i < cache->pin_count && cache->pins[i] != src; i++) {
+    }
+    if (pin && i == cache->pin_count) {
+        if (cache->pin_count >= LVGL_PORT_CACHE_PINS) {
+            return false;
+        }
+        cache->pins[cache->pin_count++] = src;
+    } else if (!pin && i < cache->pin_count) {
+        cache->pins[i] = cache->pins[--cache->pin_count];
+    }
+
+    /* The list is in the order of use, the first entry of the source is the last used one */
+    bool first = true;
+    for (lvgl_port_cache_entry_t *e = cache->head; e; e = e->next) {
+        if (e->key.src == src) {
+            e->pinned = pin && first;
+            first = false;
+        }
+    }
+    return true;
+}
+
+bool lvgl_port_cache_pinned(const lvgl_port_cache_t *cache, const void *src)
+{
+    for (uint32_t i = 0; i < cache->pin_count; i++) {
+        if (cache->pins[i] == src) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,178 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl_port_clip.h"
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static inline uint8_t lvgl_port_clip_opa(uint8_t opa)
+{
+    if (opa >= LVGL_PORT_CLIP_OPA_MAX) {
+        return 255;
+    }
+    return opa <= LVGL_PORT_CLIP_OPA_MIN ? 0 : opa;
+}
+
+/* mask_mix() of lv_draw_mask.c, with an opacity of lvgl_port_clip_opa() */
+static inline uint8_t lvgl_port_clip_mix(uint8_t mask, uint8_t opa)
+{
+    if (opa == 255) {
+        return mask;
+    }
+    return opa == 0 ? 0 : (uint8_t)(((uint32_t)mask * opa * 0x8081U) >> 23);
+}
+
+static void lvgl_port_clip_mix_edges(uint8_t *mask, const uint8_t *opa, int32_t len)
+{
+    for (int32_t i = 0; i < len; i++) {
+        mask[i] = lvgl_port_clip_mix(mask[i], opa[i]);
+    }
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+bool lvgl_port_clip_init(lvgl_port_clip_t *clip, uint16_t w, uint16_t h)
+{
+    memset(clip, 0, sizeof(*clip));
+    clip->rows = calloc(h ? h : 1, sizeof(lvgl_port_clip_row_t));
+    if (clip->rows == NULL) {
+        return false;
+    }
+    clip->w = w;
+    clip->h = h;
+    return true;
+}
+
+void lvgl_port_clip_deinit(lvgl_port_clip_t *clip)
+{
+    free(clip->rows);
+    free(clip->edges);
+    memset(clip, 0, sizeof(*clip));
+}
+
+bool lvgl_port_clip_set_row(lvgl_port_clip_t *clip, uint16_t y, const uint8_t *opa)
+{
+    lvgl_port_clip_row_t row = {0};
+    uint32_t x1 = 0;
+    uint32_t x2 = clip->w;
+
+    if (y >= clip->h) {
+        return false;
+    }
+    while (x1 < x2 && lvgl_port_clip_opa(opa[x1]) == 0) {
+        x1++;
+    }
+    while (x2 > x1 && lvgl_port_clip_opa(opa[x2 - 1]) == 0) {
+        x2--;
+    }
+    if (x1 == x2) {
+        clip->rows[y] = row;
+        return true;
+    }
+
+    /* Longest run of one opacity */
+    uint32_t span_x1 = x1;
+    uint32_t span_x2 = x1;
+    for (uint32_t start = x1; start < x2;) {
+        const uint8_t v = lvgl_port_clip_opa(opa[start]);
+        uint32_t end = start + 1;
+        while (end < x2 && lvgl_port_clip_opa(opa[end]) == v) {
+            end++;
+        }
+        if (end - start > span_x2 - span_x1) {
+            span_x1 = start;
+            span_x2 = end;
+        }
+        start = end;
+    }
+
+    const size_t len = (span_x1 - x1) + (x2 - span_x2);
+    if (clip->edges_len + len > clip->edges_size) {
+        size_t size = clip->edges_size ? clip->edges_size : 64;
+        while (size < clip->edges_len + len) {
+            size *= 2;
+        }
+        uint8_t *edges = realloc(clip->edges, size);
+        if (edges == NULL) {
+            return false;
+        }
+        clip->edges = edges;
+        clip->edges_size = size;
+    }
+    row.x1 = x1;
+    row.span_x1 = span_x1;
+    row.span_x2 = span_x2;
+    row.x2 = x2;
+    row.edges = clip->edges_len;
+    row.opa = lvgl_port_clip_opa(opa[span_x1]);
+    uint8_t *edges = clip->edges + clip->edges_len;
+    for (uint32_t x = x1; x < span_x1; x++) {
+        *edges++ = lvgl_port_clip_opa(opa[x]);
+    }
+    for (uint32_t x = span_x2; x < x2; x++) {
+        *edges++ = lvgl_port_clip_opa(opa[x]);
+    }
+    clip->edges_len += len;
+    clip->rows[y] = row;
+    return true;
+}
+
+lvgl_port_clip_res_t lvgl_port_clip_apply(const lvgl_port_clip_t *clip, uint8_t *mask, int32_t x, int32_t y, int32_t len)
+{
+    if (y < 0 || y >= clip->h || len <= 0) {
+        return LVGL_PORT_CLIP_TRANSP;
+    }
+    const lvgl_port_clip_row_t *row = &clip->rows[y];
+    const int32_t end = x + len;
+    if (end <= row->x1 || x >= row->x2) {
+        return LVGL_PORT_CLIP_TRANSP;
+    }
+    if (row->opa == 255 && x >= row->span_x1 && end <= row->span_x2) {
+        return LVGL_PORT_CLIP_FULL_COVER;
+    }
+
+    /* Transparent sides */
+    if (x < row->x1) {
+        memset(mask, 0, row->x1 - x);
+    }
+    if (end > row->x2) {
+        memset(mask + (row->x2 - x), 0, end - row->x2);
+    }
+
+    /* Left edge */
+    int32_t from = x > row->x1 ? x : row->x1;
+    int32_t to = end < row->span_x1 ? end : row->span_x1;
+    if (from < to) {
+        lvgl_port_clip_mix_edges(mask + (from - x), clip->edges + row->edges + (from - row->x1), to - from);
+    }
+
+    /* Span */
+    from = x > row->span_x1 ? x : row->span_x1;
+    to = end < row->span_x2 ? end : row->span_x2;
+    if (from < to && row->opa == 0) {
+        memset(mask + (from - x), 0, to - from);
+    } else if (from < to && row->opa != 255) {
+        uint8_t *m = mask + (from - x);
+        for (int32_t i = 0; i < to - from; i++) {
+            m[i] = lvgl_port_clip_mix(m[i], row->opa);
+        }
+    }
+
+    /* Right edge */
+    from = x > row->span_x2 ? x : row->span_x2;
+    to = end < row->x2 ? end : row->x2;
+    if (from < to) {
+        const uint32_t left = row->span_x1 - row->x1;
+        lvgl_port_clip_mix_edges(mask + (from - x), clip->edges + row->edges + left + (from - row->span_x2), to - from);
+    }
+    return LVGL_PORT_CLIP_CHANGED;
+}
@@ -0,0 +1,257 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl.h"
+#include "lvgl_port_clip.h"
+#include "lvgl_port_clip_obj.h"
+
+typedef enum {
+    LVGL_PORT_CLIP_OBJ_RADIUS,
+    LVGL_PORT_CLIP_OBJ_FADE,
+} lvgl_port_clip_obj_kind_t;
+
+/* Shape of one kind and size, shared by the objects clipped to it */
+typedef struct lvgl_port_clip_obj_shape {
+    lvgl_port_clip_t clip;
+    lvgl_port_clip_obj_kind_t kind;
+    lv_coord_t a;                       /* Radius, or rows of the fade at the top */
+    lv_coord_t b;                       /* Rows of the fade at the bottom */
+    uint16_t users;
+    struct lvgl_port_clip_obj_shape *next;
+} lvgl_port_clip_obj_shape_t;
+
+typedef struct {
+    lv_draw_mask_radius_param_t param;  /* Added as a radius mask of the covered area, with the callback of the shape */
+    lvgl_port_clip_obj_shape_t *shape;  /* Shape of the last draw, NULL before */
+    const lv_obj_t *box;
+    lvgl_port_clip_obj_kind_t kind;
+    lv_coord_t a;
+    lv_coord_t b;
+    lv_coord_t x;                       /* Top left of the box */
+    lv_coord_t y;
+    int16_t id;                         /* Of the added mask */
+} lvgl_port_clip_obj_t;
+
+/* Accessed by the LVGL task only */
+static lvgl_port_clip_obj_shape_t *lvgl_port_clip_obj_shapes;
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static lv_coord_t lvgl_port_clip_obj_radius(lv_coord_t radius, lv_coord_t w, lv_coord_t h)
+{
+    /* As lv_draw_mask_radius_init() does */
+    const lv_coord_t short_side = LV_MIN(w, h);
+    return LV_CLAMP(0, radius, short_side >> 1);
+}
+
+/* Rows of the LVGL masks, applied like lv_draw_mask_apply() does */
+static bool lvgl_port_clip_obj_fill(lvgl_port_clip_t *clip, void **params, size_t count)
+{
+    bool ret = true;
+    uint8_t *row = lv_mem_buf_get(clip->w);
+    if (row == NULL) {
+        return false;
+    }
+    for (uint16_t y = 0; y < clip->h && ret; y++) {
+        memset(row, 0xFF, clip->w);
+        for (size_t i = 0; i < count; i++) {
+            const _lv_draw_mask_common_dsc_t *dsc = params[i];
+            if (dsc->cb(row, 0, y, clip->w, params[i]) == LV_DRAW_MASK_RES_TRANSP) {
+                memset(row, 0, clip->w);
+                break;
+            }
+        }
+        ret = lvgl_port_clip_set_row(clip, y, row);
+    }
+    lv_mem_buf_release(row);
+    return ret;
+}
+
+static bool lvgl_port_clip_obj_build(lvgl_port_clip_obj_shape_t *shape)
+{
+    const lv_area_t box = {0, 0, shape->clip.w - 1, shape->clip.h - 1};
+    lv_draw_mask_radius_param_t radius;
+    lv_draw_mask_fade_param_t fade[2];
+    void *params[2];
+    size_t count = 0;
+    bool ret;
+
+    if (shape->kind == LVGL_PORT_CLIP_OBJ_RADIUS) {
+        lv_draw_mask_radius_init(&radius, &box, shape->a, false);
+        params[count++] = &radius;
+        ret = lvgl_port_clip_obj_fill(&shape->clip, params, count);
+        lv_draw_mask_free_param(&radius);
+        return ret;
+    }
+
+    lv_area_t area = box;
+    if (shape->a > 0) {
+        area.y2 = shape->a - 1;
+        lv_draw_mask_fade_init(&fade[count], &area, LV_OPA_TRANSP, area.y1, LV_OPA_COVER, area.y2);
+        params[count] = &fade[count];
+        count++;
+    }
+    if (shape->b > 0) {
+        area.y1 = box.y2 - shape->b + 1;
+        area.y2 = box.y2;
+        lv_draw_mask_fade_init(&fade[count], &area, LV_OPA_COVER, area.y1, LV_OPA_TRANSP, area.y2);
+        params[count] = &fade[count];
+        count++;
+    }
+    return lvgl_port_clip_obj_fill(&shape->clip, params, count);
+}
+
+static lvgl_port_clip_obj_shape_t *lvgl_port_clip_obj_get_shape(lvgl_port_clip_obj_kind_t kind, lv_coord_t w, lv_coord_t h,
+        lv_coord_t a, lv_coord_t b)
+{
+    lvgl_port_clip_obj_shape_t *shape;
+
+    for (shape = lvgl_port_clip_obj_shapes; shape; shape = shape->next) {
+        if (shape->kind == kind && shape->clip.w == w && shape->clip.h == h && shape->a == a && shape->b == b) {
+            shape->users++;
+            return shape;
+        }
+    }
+
+    shape = calloc(1, sizeof(lvgl_port_clip_obj_shape_t));
+    if (shape == NULL) {
+        return NULL;
+    }
+    shape->kind = kind;
+    shape->a = a;
+    shape->b = b;
+    if (!lvgl_port_clip_init(&shape->clip, w, h) || !lvgl_port_clip_obj_build(shape)) {
+        lvgl_port_clip_deinit(&shape->clip);
+        free(shape);
+        return NULL;
+    }
+    shape->users = 1;
+    shape->next = lvgl_port_clip_obj_shapes;
+    lvgl_port_clip_obj_shapes = shape;
+    return shape;
+}
+
+static void lvgl_port_clip_obj_put_shape(lvgl_port_clip_obj_shape_t *shape)
+{
+    if (shape == NULL || --shape->users > 0) {
+        return;
+    }
+    for (lvgl_port_clip_obj_shape_t **p = &lvgl_port_clip_obj_shapes; *p; p = &(*p)->next) {
+        if (*p == shape) {
+            *p = shape->next;
+            break;
+        }
+    }
+    lvgl_port_clip_deinit(&shape->clip);
+    free(shape);
+}
+
+static lv_draw_mask_res_t lvgl_port_clip_obj_mask_cb(lv_opa_t *mask_buf, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len, void *p)
+{
+    const lvgl_port_clip_obj_t *clip_obj = p;
+
+    switch (lvgl_port_clip_apply(&clip_obj->shape->clip, mask_buf, abs_x - clip_obj->x, abs_y - clip_obj->y, len)) {
+    case LVGL_PORT_CLIP_TRANSP:
+        return LV_DRAW_MASK_RES_TRANSP;
+    case LVGL_PORT_CLIP_FULL_COVER:
+        return LV_DRAW_MASK_RES_FULL_COVER;
+    default:
+        return LV_DRAW_MASK_RES_CHANGED;
+    }
+}
+
+/* Mask of the box, NULL when its shape can't be built */
+static void *lvgl_port_clip_obj_mask(lvgl_port_clip_obj_t *clip_obj, lv_obj_t *obj)
+{
+    lv_area_t box;
+
+    lv_obj_get_coords(clip_obj->box ? clip_obj->box : obj, &box);
+    const lv_coord_t w = lv_area_get_width(&box);
+    const lv_coord_t h = lv_area_get_height(&box);
+    if (w <= 0 || h <= 0) {
+        return NULL;
+    }
+    const lv_coord_t a = (clip_obj->kind == LVGL_PORT_CLIP_OBJ_RADIUS) ? lvgl_port_clip_obj_radius(clip_obj->a, w, h) : clip_obj->a;
+
+    lvgl_port_clip_obj_shape_t *shape = clip_obj->shape;
+    if (shape == NULL || shape->clip.w != w || shape->clip.h != h || shape->a != a) {
+        shape = lvgl_port_clip_obj_get_shape(clip_obj->kind, w, h, a, clip_obj->b);
+        lvgl_port_clip_obj_put_shape(clip_obj->shape);
+        clip_obj->shape = shape;
+        if (shape == NULL) {
+            return NULL;
+        }
+    }
+    clip_obj->x = box.x1;
+    clip_obj->y = box.y1;
+
+    /* LVGL skips the masks for drawings inside the rounded rectangle, the covered rows of a fade */
+    lv_draw_mask_radius_param_t *param = &clip_obj->param;
+    memset(param, 0, sizeof(*param));
+    param->dsc.cb = lvgl_port_clip_obj_mask_cb;
+    param->dsc.type = LV_DRAW_MASK_TYPE_RADIUS;
+    param->cfg.rect = box;
+    if (clip_obj->kind == LVGL_PORT_CLIP_OBJ_RADIUS) {
+        param->cfg.radius = a;
+    } else {
+        param->cfg.rect.y1 += clip_obj->a;
+        param->cfg.rect.y2 -= clip_obj->b;
+    }
+    return param;
+}
+
+static void lvgl_port_clip_obj_event_cb(lv_event_t *e)
+{
+    lvgl_port_clip_obj_t *clip_obj = lv_event_get_user_data(e);
+    lv_obj_t *obj = lv_event_get_target(e);
+    const lv_event_code_t code = lv_event_get_code(e);
+
+    if (code == LV_EVENT_COVER_CHECK) {
+        lv_event_set_cover_res(e, LV_COVER_RES_MASKED);
+    } else if (code == LV_EVENT_DRAW_MAIN_BEGIN) {
+        void *param = lvgl_port_clip_obj_mask(clip_obj, obj);
+        clip_obj->id = param ? lv_draw_mask_add(param, clip_obj) : LV_MASK_ID_INV;
+    } else if (code == LV_EVENT_DRAW_POST_END) {
+        lv_draw_mask_remove_id(clip_obj->id);
+        clip_obj->id = LV_MASK_ID_INV;
+    } else if (code == LV_EVENT_DELETE) {
+        lvgl_port_clip_obj_put_shape(clip_obj->shape);
+        free(clip_obj);
+    }
+}
+
+static bool lvgl_port_clip_obj_add(lv_obj_t *obj, const lv_obj_t *box, lvgl_port_clip_obj_kind_t kind, lv_coord_t a, lv_coord_t b)
+{
+    lvgl_port_clip_obj_t *clip_obj = calloc(1, sizeof(lvgl_port_clip_obj_t));
+    if (clip_obj == NULL) {
+        return false;
+    }
+    clip_obj->box = box;
+    clip_obj->kind = kind;
+    clip_obj->a = a;
+    clip_obj->b = b;
+    clip_obj->id = LV_MASK_ID_INV;
+    lv_obj_add_event_cb(obj, lvgl_port_clip_obj_event_cb, LV_EVENT_ALL, clip_obj);
+    return true;
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+bool lvgl_port_clip_obj_add_radius(lv_obj_t *obj, const lv_obj_t *box, lv_coord_t radius)
+{
+    return lvgl_port_clip_obj_add(obj, box, LVGL_PORT_CLIP_OBJ_RADIUS, radius, 0);
+}
+
+bool lvgl_port_clip_obj_add_fade(lv_obj_t *obj, lv_coord_t top, lv_coord_t bottom)
+{
+    return lvgl_port_clip_obj_add(obj, NULL, LVGL_PORT_CLIP_OBJ_FADE, LV_MAX(top, 0), LV_MAX(bottom, 0));
+}
@@ -0,0 +1,148 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl_port_diff.h"
+
+#define LVGL_PORT_DIFF_FNV_OFFSET   (2166136261u)
+#define LVGL_PORT_DIFF_FNV_PRIME    (16777619u)
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* FNV-1a over pixels, 0 is reserved for unknown tiles */
+static inline uint32_t lvgl_port_diff_hash(const uint16_t *px, int count)
+{
+    uint32_t hash = LVGL_PORT_DIFF_FNV_OFFSET;
+
+    for (int i = 0; i < count; i++) {
+        hash = (hash ^ px[i]) * LVGL_PORT_DIFF_FNV_PRIME;
+    }
+    return hash ? hash : 1;
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+bool lvgl_port_diff_init(lvgl_port_diff_t *diff, uint16_t hres, uint16_t vres, uint16_t tile_w)
+{
+    if (diff == NULL || hres == 0 || vres == 0 || tile_w == 0) {
+        return false;
+    }
+
+    memset(diff, 0, sizeof(lvgl_port_diff_t));
+    diff->hres = hres;
+    diff->vres = vres;
+    diff->tile_w = tile_w;
+    diff->tiles = (hres + tile_w - 1) / tile_w;
+    diff->hash = calloc((size_t)vres * diff->tiles, sizeof(uint32_t));
+    diff->span_x1 = malloc(vres * sizeof(uint16_t));
+    diff->span_x2 = malloc(vres * sizeof(uint16_t));
+    if (diff->hash == NULL || diff->span_x1 == NULL || diff->span_x2 == NULL) {
+        lvgl_port_diff_deinit(diff);
+        return false;
+    }
+
+    return true;
+}
+
+void lvgl_port_diff_deinit(lvgl_port_diff_t *diff)
+{
+    if (diff == NULL) {
+        return;
+    }
+
+    free(diff->hash);
+    free(diff->span_x1);
+    free(diff->span_x2);
+    diff->hash = NULL;
+    diff->span_x1 = NULL;
+    diff->span_x2 = NULL;
+}
+
+void lvgl_port_diff_reset(lvgl_port_diff_t *diff)
+{
+    if (diff->hash == NULL) {
+        return;
+    }
+    memset(diff->hash, 0, (size_t)diff->vres * diff->tiles * sizeof(uint32_t));
+}
+
+size_t lvgl_port_diff_mem(const lvgl_port_diff_t *diff)
+{
+    return (size_t)diff->vres * diff->tiles * sizeof(uint32_t) + 2 * diff->vres * sizeof(uint16_t);
+}
+
+void lvgl_port_diff_align(const lvgl_port_diff_t *diff, int *x1, int *x2)
+{
+    *x1 -= *x1 % diff->tile_w;
+    *x2 += diff->tile_w - 1 - *x2 % diff->tile_w;
+    if (*x2 >= diff->hres) {
+        *x2 = diff->hres - 1;
+    }
+}
+
+uint32_t lvgl_port_diff_area(lvgl_port_diff_t *diff, int x1, int y1, int x2, int y2, const uint16_t *pixels,
+                             const uint16_t *vis_x1, const uint16_t *vis_x2)
+{
+    const int w = x2 - x1 + 1;
+    const int t1 = x1 / diff->tile_w;
+    const int t2 = x2 / diff->tile_w;
+    uint32_t visible = 0;
+
+    for (int y = y1; y <= y2; y++) {
+        const uint16_t *row = pixels + (size_t)(y - y1) * w;
+        uint32_t *hash = diff->hash + (size_t)y * diff->tiles;
+        int a = x2 + 1;
+        int b = x1 - 1;
+
+        for (int t = t1; t <= t2; t++) {
+            const int tx1 = t * diff->tile_w;
+            int tx2 = tx1 + diff->tile_w - 1;
+            if (tx2 >= diff->hres) {
+                tx2 = diff->hres - 1;
+            }
+
+            /* Part of the tile is outside of the area, its new content is not known */
+            if (tx1 < x1 || tx2 > x2) {
+                hash[t] = 0;
+            } else {
+                const uint32_t h = lvgl_port_diff_hash(row + (tx1 - x1), tx2 - tx1 + 1);
+                if (h == hash[t]) {
+                    continue;
+                }
+                hash[t] = h;
+            }
+            a = (a <= x2) ? a : ((tx1 > x1) ? tx1 : x1);
+            b = (tx2 < x2) ? tx2 : x2;
+        }
+
+        /* Only the visible part of the row is sent */
+        int va = x1;
+        int vb = x2;
+        if (vis_x1) {
+            va = (vis_x1[y] > x1) ? vis_x1[y] : x1;
+            vb = (vis_x2[y] < x2) ? vis_x2[y] : x2;
+        }
+        if (va <= vb) {
+            visible += vb - va + 1;
+        }
+        a = (a > va) ? a : va;
+        b = (b < vb) ? b : vb;
+        if (a <= b) {
+            diff->span_x1[y] = a;
+            diff->span_x2[y] = b;
+        } else {
+            diff->span_x1[y] = 1;
+            diff->span_x2[y] = 0;
+        }
+    }
+
+    return visible;
+}
@@ -0,0 +1,198 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "lvgl.h"
+#include "src/draw/sw/lv_draw_sw.h"
+#include "lvgl_port_blend.h"
+#include "lvgl_port_cache.h"
+#include "lvgl_port_glyph.h"
+#include "lvgl_port_font.h"
+
+/* Accessed by the LVGL task only */
+static struct {
+    lvgl_port_cache_t cache;
+    bool ready;
+} lvgl_port_font_cached;
+
+static struct {
+    lvgl_port_cache_t cache;    /* Coverage masks of glyphs */
+} lvgl_port_font_glyphs;
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* draw_letter of the software renderer, drawing from the cached mask of the glyph */
+static void lvgl_port_font_draw_letter(lv_draw_ctx_t *draw_ctx, const lv_draw_label_dsc_t *dsc, const lv_point_t *pos_p,
+                                       uint32_t letter)
+{
+    const lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+    lvgl_port_cache_key_t key;
+    lv_font_glyph_dsc_t g;
+    lv_area_t box;
+
+    /* Missing glyphs (warned about, maybe drawn as placeholders), sub-pixel and image fonts are left to LVGL */
+    if (!lv_font_get_glyph_dsc(dsc->font, &g, letter, '\0') || g.resolved_font->subpx || !lvgl_port_glyph_bpp_valid(g.bpp) ||
+            disp == NULL || !disp->driver->antialiasing) {
+        lv_draw_sw_letter(draw_ctx, dsc, pos_p, letter);
+        return;
+    }
+    if (g.box_w == 0 || g.box_h == 0) {
+        return;
+    }
+    box.x1 = pos_p->x + g.ofs_x;
+    box.y1 = pos_p->y + (dsc->font->line_height - dsc->font->base_line) - g.box_h - g.ofs_y;
+    box.x2 = box.x1 + g.box_w - 1;
+    box.y2 = box.y1 + g.box_h - 1;
+    if (!_lv_area_is_on(&box, draw_ctx->clip_area)) {
+        return;
+    }
+
+    /* The color is applied while blending, translucent letters have masks scaled by their opacity */
+    const lv_opa_t opa = dsc->opa >= LV_OPA_MAX ? LV_OPA_COVER : dsc->opa;
+    if (g.bpp == 8 && opa == LV_OPA_COVER) {
+        /* A covering 8 bpp glyph is its own mask (scalable fonts cache their glyphs already) */
+        const uint8_t *bitmap = lv_font_get_glyph_bitmap(g.resolved_font, letter);
+        if (bitmap == NULL) {
+            LV_LOG_WARN("character's bitmap not found");
+            return;
+        }
+        lvgl_port_blend_mask(draw_ctx, &box, bitmap, dsc->color, dsc->opa, dsc->blend_mode);
+        return;
+    }
+    memset(&key, 0, sizeof(key));
+    key.src = g.resolved_font;
+    key.frame_id = letter;
+    key.recolor_opa = opa;
+    lvgl_port_cache_entry_t *entry = lvgl_port_cache_find(&lvgl_port_font_glyphs.cache, &key);
+    if (entry) {
+        lvgl_port_blend_mask(draw_ctx, &box, entry->data, dsc->color, dsc->opa, dsc->blend_mode);
+        return;
+    }
+
+    const uint8_t *bitmap = lv_font_get_glyph_bitmap(g.resolved_font, letter);
+    if (bitmap == NULL) {
+        LV_LOG_WARN("character's bitmap not found");
+        return;
+    }
+    /* Fading letters are drawn with a new opacity every frame, they are added when drawn twice with one */
+    const size_t size = (size_t)g.box_w * g.box_h;
+    if (opa == LV_OPA_COVER || lvgl_port_cache_admit(&lvgl_port_font_glyphs.cache, &key)) {
+        entry = lvgl_port_cache_add(&lvgl_port_font_glyphs.cache, &key, size);
+    }
+    lv_opa_t *mask = entry ? entry->data : lv_mem_buf_get(size);
+    if (mask == NULL) {
+        return;
+    }
+    if (entry) {
+        entry->w = g.box_w;
+        entry->h = g.box_h;
+    }
+    lvgl_port_glyph_mask(bitmap, g.bpp, g.box_w, g.box_h, opa, mask);
+    lvgl_port_blend_mask(draw_ctx, &box, mask, dsc->color, dsc->opa, dsc->blend_mode);
+    if (entry == NULL) {
+        lv_mem_buf_release(mask);
+    }
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+bool lvgl_port_font_cache_init(size_t budget)
+{
+    if (!lvgl_port_font_cached.ready) {
+        lvgl_port_cache_init(&lvgl_port_font_cached.cache, budget);
+        lvgl_port_font_cached.ready = true;
+    }
+    return true;
+}
+
+void lvgl_port_font_cache_deinit(void)
+{
+    lvgl_port_cache_deinit(&lvgl_port_font_cached.cache);
+    memset(&lvgl_port_font_cached, 0, sizeof(lvgl_port_font_cached));
+}
+
+void lvgl_port_font_cache_get_stats(lvgl_port_cache_layer_t *stats)
+{
+    *stats = lvgl_port_font_cached.cache.stats[0];
+}
+
+const uint8_t *lvgl_port_font_get_bitmap(const lv_font_t *font, uint32_t letter)
+{
+    lvgl_port_cache_key_t key;
+    lv_font_glyph_dsc_t glyph;
+
+    if (!lvgl_port_font_cached.ready) {
+        return lv_font_get_bitmap_fmt_txt(font, letter);
+    }
+    /* Drawn like a space by LVGL */
+    if (letter == '\t') {
+        letter = ' ';
+    }
+
+    memset(&key, 0, sizeof(key));
+    key.src = font;
+    key.frame_id = letter;
+    lvgl_port_cache_entry_t *entry = lvgl_port_cache_find(&lvgl_port_font_cached.cache, &key);
+    if (entry) {
+        return entry->data;
+    }
+
+    const uint8_t *bitmap = lv_font_get_bitmap_fmt_txt(font, letter);
+    if (bitmap == NULL || !font->get_glyph_dsc(font, &glyph, letter, 0)) {
+        return bitmap;
+    }
+    /* Decoded glyphs of 3 bpp fonts have 4 bpp */
+    const uint8_t bpp = glyph.bpp == 3 ? 4 : glyph.bpp;
+    const size_t size = ((size_t)glyph.box_w * glyph.box_h * bpp + 7) / 8;
+    entry = lvgl_port_cache_add(&lvgl_port_font_cached.cache, &key, size);
+    if (entry) {
+        memcpy(entry->data, bitmap, size);
+        entry->w = glyph.box_w;
+        entry->h = glyph.box_h;
+    }
+    return bitmap;
+}
+
+bool lvgl_port_font_glyph_init(lv_disp_t *disp, size_t budget)
+{
+    lv_draw_ctx_t *draw_ctx = disp->driver->draw_ctx;
+
+    /* Only letters of LVGL's software renderer are drawn through the cache */
+    if (draw_ctx == NULL || (draw_ctx->draw_letter != lv_draw_sw_letter && draw_ctx->draw_letter != lvgl_port_font_draw_letter)) {
+        return false;
+    }
+    if (draw_ctx->draw_letter == lv_draw_sw_letter) {
+        /* The first display sets the budget, all displays share the cache */
+        if (lvgl_port_font_glyphs.cache.budget == 0) {
+            lvgl_port_cache_init(&lvgl_port_font_glyphs.cache, budget);
+        }
+        draw_ctx->draw_letter = lvgl_port_font_draw_letter;
+    }
+
+    return true;
+}
+
+void lvgl_port_font_glyph_deinit(void)
+{
+    lv_disp_t *disp = NULL;
+
+    while ((disp = lv_disp_get_next(disp)) != NULL) {
+        if (disp->driver->draw_ctx && disp->driver->draw_ctx->draw_letter == lvgl_port_font_draw_letter) {
+            disp->driver->draw_ctx->draw_letter = lv_draw_sw_letter;
+        }
+    }
+    lvgl_port_cache_deinit(&lvgl_port_font_glyphs.cache);
+    memset(&lvgl_port_font_glyphs, 0, sizeof(lvgl_port_font_glyphs));
+}
+
+void lvgl_port_font_glyph_get_stats(lvgl_port_cache_layer_t *stats)
+{
+    *stats = lvgl_port_font_glyphs.cache.stats[0];
+}
@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "lvgl_port_glyph.h"
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+bool lvgl_port_glyph_bpp_valid(uint8_t bpp)
+{
+    return bpp == 1 || bpp == 2 || bpp == 3 || bpp == 4 || bpp == 8;
+}
+
+bool lvgl_port_glyph_mask(const uint8_t *bitmap, uint8_t bpp, uint16_t w, uint16_t h, uint8_t opa, uint8_t *mask)
+{
+    uint8_t table[256];
+
+    if (!lvgl_port_glyph_bpp_valid(bpp)) {
+        return false;
+    }
+    if (bpp == 3) {
+        bpp = 4;
+    }
+
+    /* Shades of LVGL's opacity tables (0, 17, 34 ... for 4 bpp), the full one stays the opacity */
+    const uint32_t shades = 1u << bpp;
+    for (uint32_t i = 0; i < shades; i++) {
+        const uint32_t v = i * 255 / (shades - 1);
+        if (opa >= LVGL_PORT_GLYPH_OPA_MAX) {
+            table[i] = v;
+        } else {
+            table[i] = (v == 255) ? opa : (v * opa) >> 8;
+        }
+    }
+
+    const uint32_t count = (uint32_t)w * h;
+    uint32_t i = 0;
+    switch (bpp) {
+    case 1:
+        for (; i + 8 <= count; i += 8) {
+            const uint8_t b = *bitmap++;
+            for (int k = 0; k < 8; k++) {
+                mask[i + k] = table[(b >> (7 - k)) & 0x01];
+            }
+        }
+        break;
+    case 2:
+        for (; i + 4 <= count; i += 4) {
+            const uint8_t b = *bitmap++;
+            mask[i] = table[b >> 6];
+            mask[i + 1] = table[(b >> 4) & 0x03];
+            mask[i + 2] = table[(b >> 2) & 0x03];
+            mask[i + 3] = table[b & 0x03];
+        }
+        break;
+    case 4:
+        for (; i + 2 <= count; i += 2) {
+            const uint8_t b = *bitmap++;
+            mask[i] = table[b >> 4];
+            mask[i + 1] = table[b & 0x0F];
+        }
+        break;
+    default:
+        for (; i < count; i++) {
+            mask[i] = table[*bitmap++];
+        }
+        break;
+    }
+
+    /* Pixels of the last, partial byte */
+    for (uint32_t shift = 8 - bpp; i < count; i++, shift -= bpp) {
+        mask[i] = table[(*bitmap >> shift) & (shades - 1)];
+    }
+    return true;
+}
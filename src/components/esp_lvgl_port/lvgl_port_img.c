@@ -0,0 +1,707 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl.h"
+#include "src/draw/sw/lv_draw_sw.h"
+#include "lvgl_port_blend.h"
+#include "lvgl_port_rle.h"
+#include "lvgl_port_assets.h"
+#include "lvgl_port_index.h"
+#include "lvgl_port_cache.h"
+#include "lvgl_port_img.h"
+
+/* Accessed by the LVGL task only */
+static struct {
+    lv_img_decoder_t *decoder;
+    lvgl_port_rle_cache_t cache;
+    uint32_t opened;
+    uint32_t lines;
+} lvgl_port_img_rle;
+
+static struct {
+    lv_img_decoder_t *decoder;
+    lvgl_port_assets_t table;
+    lvgl_port_index_palette_t palette;  /* Of the indexed image drawn last */
+} lvgl_port_img_assets;
+
+static struct {
+    lvgl_port_cache_t cache;
+    const char *layers[LVGL_PORT_CACHE_LAYERS]; /* Names of the layers, the default one has none */
+} lvgl_port_img_cached;
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* Decoded pixels are read by LVGL in the layout of their color format */
+static bool lvgl_port_img_rle_check(const lvgl_port_rle_img_t *img)
+{
+    switch (img->cf) {
+    case LV_IMG_CF_TRUE_COLOR:
+    case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+        return img->px_size == LV_COLOR_SIZE / 8;
+    case LV_IMG_CF_TRUE_COLOR_ALPHA:
+        return img->px_size == LV_IMG_PX_SIZE_ALPHA_BYTE;
+    default:
+        return false;
+    }
+}
+
+static bool lvgl_port_img_rle_src(const void *src, lvgl_port_rle_img_t *img)
+{
+    if (lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) {
+        return false;
+    }
+    const lv_img_dsc_t *dsc = (const lv_img_dsc_t *)src;
+    if (dsc->header.cf != LV_IMG_CF_USER_ENCODED_0) {
+        return false;
+    }
+
+    return lvgl_port_rle_open(img, dsc->data, dsc->data_size, dsc->header.w, dsc->header.h) && lvgl_port_img_rle_check(img);
+}
+
+static lv_res_t lvgl_port_img_rle_info(lv_img_decoder_t *decoder, const void *src, lv_img_header_t *header)
+{
+    lvgl_port_rle_img_t img;
+
+    if (!lvgl_port_img_rle_src(src, &img)) {
+        return LV_RES_INV;
+    }
+    header->cf = img.cf;
+    header->w = img.w;
+    header->h = img.h;
+    header->always_zero = 0;
+
+    return LV_RES_OK;
+}
+
+static lv_res_t lvgl_port_img_rle_open(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+    /* No decoded image, LVGL reads the lines it draws */
+    dsc->img_data = NULL;
+    lvgl_port_img_rle.opened++;
+
+    return LV_RES_OK;
+}
+
+static lv_res_t lvgl_port_img_rle_read_line(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc,
+        lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t *buf)
+{
+    lvgl_port_rle_img_t img;
+
+    if (x < 0 || y < 0 || len < 0 || !lvgl_port_img_rle_src(dsc->src, &img)) {
+        return LV_RES_INV;
+    }
+    lvgl_port_img_rle.lines++;
+
+    return lvgl_port_rle_cache_read(&lvgl_port_img_rle.cache, &img, x, y, len, buf) ? LV_RES_OK : LV_RES_INV;
+}
+
+static void lvgl_port_img_rle_close(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+}
+
+static bool lvgl_port_img_asset_src(const void *src, lvgl_port_asset_t *asset)
+{
+    if (lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) {
+        return false;
+    }
+    const lv_img_dsc_t *dsc = (const lv_img_dsc_t *)src;
+    if (dsc->header.cf != LV_IMG_CF_USER_ENCODED_1 || dsc->data_size != LVGL_PORT_ASSETS_REF_SIZE) {
+        return false;
+    }
+    const uint32_t *ref = (const uint32_t *)dsc->data;
+    if (ref[0] != LVGL_PORT_ASSETS_REF_MAGIC) {
+        return false;
+    }
+
+    return lvgl_port_assets_get(&lvgl_port_img_assets.table, ref[1], ref[2], asset) && asset->encoding != LVGL_PORT_ASSET_FONT;
+}
+
+static bool lvgl_port_img_asset_rle(const lvgl_port_asset_t *asset, lvgl_port_rle_img_t *img)
+{
+    return asset->encoding == LVGL_PORT_ASSET_RLE && lvgl_port_rle_open(img, asset->data, asset->size, asset->w, asset->h) &&
+           lvgl_port_img_rle_check(img) && img->cf == asset->cf;
+}
+
+/* Expanded to native RGB565, the palette is converted once for all lines of the image */
+static bool lvgl_port_img_asset_index(const lvgl_port_asset_t *asset, lvgl_port_index_img_t *img)
+{
+    uint8_t bpp;
+
+    switch (asset->cf) {
+    case LV_IMG_CF_INDEXED_1BIT:
+        bpp = 1;
+        break;
+    case LV_IMG_CF_INDEXED_2BIT:
+        bpp = 2;
+        break;
+    case LV_IMG_CF_INDEXED_4BIT:
+        bpp = 4;
+        break;
+    case LV_IMG_CF_INDEXED_8BIT:
+        bpp = 8;
+        break;
+    default:
+        return false;
+    }
+    if (LV_COLOR_DEPTH != 16 || LV_COLOR_16_SWAP || asset->encoding != LVGL_PORT_ASSET_RAW ||
+            !lvgl_port_index_open(img, asset->data, asset->size, asset->w, asset->h, bpp)) {
+        return false;
+    }
+    lvgl_port_index_palette(&lvgl_port_img_assets.palette, img);
+    return true;
+}
+
+static lv_res_t lvgl_port_img_asset_info(lv_img_decoder_t *decoder, const void *src, lv_img_header_t *header)
+{
+    lvgl_port_asset_t asset;
+
+    lvgl_port_index_img_t index;
+
+    if (!lvgl_port_img_asset_src(src, &asset)) {
+        return LV_RES_INV;
+    }
+    header->cf = asset.cf;
+    if (lvgl_port_img_asset_index(&asset, &index)) {
+        /* Opaque images are blended without a mask */
+        header->cf = lvgl_port_img_assets.palette.opaque ? LV_IMG_CF_TRUE_COLOR : LV_IMG_CF_TRUE_COLOR_ALPHA;
+    }
+    header->w = asset.w;
+    header->h = asset.h;
+    header->always_zero = 0;
+
+    return LV_RES_OK;
+}
+
+static lv_res_t lvgl_port_img_asset_open(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+    lvgl_port_asset_t asset;
+    lvgl_port_rle_img_t img;
+    lvgl_port_index_img_t index;
+
+    if (!lvgl_port_img_asset_src(dsc->src, &asset)) {
+        return LV_RES_INV;
+    }
+    if (lvgl_port_img_asset_index(&asset, &index)) {
+        dsc->img_data = NULL;
+        return LV_RES_OK;
+    }
+    if (asset.encoding == LVGL_PORT_ASSET_RAW) {
+        /* Drawn straight from the mapped flash, like an image compiled into the application */
+        if (asset.size < lv_img_buf_get_img_size(asset.w, asset.h, asset.cf)) {
+            return LV_RES_INV;
+        }
+        dsc->img_data = asset.data;
+        return LV_RES_OK;
+    }
+    if (!lvgl_port_img_asset_rle(&asset, &img)) {
+        return LV_RES_INV;
+    }
+    dsc->img_data = NULL;
+    lvgl_port_img_rle.opened++;
+
+    return LV_RES_OK;
+}
+
+static lv_res_t lvgl_port_img_asset_read_line(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc,
+        lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t *buf)
+{
+    lvgl_port_asset_t asset;
+    lvgl_port_rle_img_t img;
+    lvgl_port_index_img_t index;
+
+    if (x < 0 || y < 0 || len < 0 || !lvgl_port_img_asset_src(dsc->src, &asset)) {
+        return LV_RES_INV;
+    }
+    if (lvgl_port_img_asset_index(&asset, &index)) {
+        const lvgl_port_index_palette_t *pal = &lvgl_port_img_assets.palette;
+        return lvgl_port_index_read(&index, pal, x, y, len, !pal->opaque, buf) ? LV_RES_OK : LV_RES_INV;
+    }
+    if (!lvgl_port_img_asset_rle(&asset, &img)) {
+        return LV_RES_INV;
+    }
+    lvgl_port_img_rle.lines++;
+
+    return lvgl_port_rle_cache_read(&lvgl_port_img_rle.cache, &img, x, y, len, buf) ? LV_RES_OK : LV_RES_INV;
+}
+
+/* Images LVGL can't blend from their own pixels, it reads them line by line */
+static bool lvgl_port_img_cache_lines(const lv_img_dsc_t *img)
+{
+    lvgl_port_asset_t asset;
+
+    switch (img->header.cf) {
+    case LV_IMG_CF_USER_ENCODED_0:
+    case LV_IMG_CF_INDEXED_1BIT:
+    case LV_IMG_CF_INDEXED_2BIT:
+    case LV_IMG_CF_INDEXED_4BIT:
+    case LV_IMG_CF_INDEXED_8BIT:
+        return true;
+    case LV_IMG_CF_USER_ENCODED_1:
+        return lvgl_port_img_asset_src(img, &asset) && (asset.encoding != LVGL_PORT_ASSET_RAW || asset.cf >= LV_IMG_CF_INDEXED_1BIT);
+    default:
+        return false;
+    }
+}
+
+/* Split pixels of a true color format into the planes of LV_IMG_CF_RGB565A8 */
+static void lvgl_port_img_cache_split(const uint8_t *src, lv_img_cf_t cf, uint32_t len, lv_color_t *color, lv_opa_t *alpha)
+{
+    switch (cf) {
+    case LV_IMG_CF_TRUE_COLOR_ALPHA:
+        for (uint32_t i = 0; i < len; i++) {
+            color[i].full = src[3 * i] | (src[3 * i + 1] << 8);
+            alpha[i] = src[3 * i + 2];
+        }
+        break;
+    case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+        memcpy(color, src, len * sizeof(lv_color_t));
+        for (uint32_t i = 0; i < len; i++) {
+            alpha[i] = (color[i].full == LV_COLOR_CHROMA_KEY.full) ? LV_OPA_TRANSP : LV_OPA_COVER;
+        }
+        break;
+    default:
+        memcpy(color, src, len * sizeof(lv_color_t));
+        memset(alpha, LV_OPA_COVER, len);
+        break;
+    }
+}
+
+/* Decode, transform and recolor the image into the entry, like lv_draw_sw_img_decoded() does for each draw */
+static bool lvgl_port_img_cache_fill(lv_draw_ctx_t *draw_ctx, const lv_draw_img_dsc_t *dsc, lv_img_decoder_dsc_t *dec,
+                                     lv_img_cf_t cf, const lv_area_t *area, lvgl_port_cache_entry_t *entry)
+{
+    const lv_coord_t w = dec->header.w;
+    const lv_coord_t h = dec->header.h;
+    const uint32_t px_size = (cf == LV_IMG_CF_TRUE_COLOR_ALPHA) ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    const uint32_t count = entry->w * entry->h;
+    lv_color_t *color = (lv_color_t *)entry->data;
+    lv_opa_t *alpha = entry->data + count * sizeof(lv_color_t);
+    const uint8_t *src = dec->img_data;
+    uint8_t *buf = NULL;
+
+    if (dsc->angle || dsc->zoom != LV_IMG_ZOOM_NONE) {
+        /* The whole image is sampled, read it first when LVGL would read it line by line */
+        if (src == NULL) {
+            buf = malloc(w * h * px_size);
+            if (buf == NULL) {
+                return false;
+            }
+            for (lv_coord_t y = 0; y < h; y++) {
+                if (lv_img_decoder_read_line(dec, 0, y, w, buf + y * w * px_size) != LV_RES_OK) {
+                    free(buf);
+                    return false;
+                }
+            }
+            src = buf;
+        }
+        lv_draw_transform(draw_ctx, area, src, w, h, w, dsc, cf, color, alpha);
+        free(buf);
+    } else {
+        if (src == NULL) {
+            buf = lv_mem_buf_get(w * px_size);
+            if (buf == NULL) {
+                return false;
+            }
+        }
+        for (lv_coord_t y = 0; y < h; y++) {
+            const uint8_t *row = src ? src + y * w * px_size : buf;
+            if (src == NULL && lv_img_decoder_read_line(dec, 0, y, w, buf) != LV_RES_OK) {
+                lv_mem_buf_release(buf);
+                return false;
+            }
+            lvgl_port_img_cache_split(row, cf, w, color + y * w, alpha + y * w);
+        }
+        if (buf) {
+            lv_mem_buf_release(buf);
+        }
+    }
+
+    if (dsc->recolor_opa > LV_OPA_MIN) {
+        uint16_t premult[3];
+        lv_color_premult(dsc->recolor, dsc->recolor_opa, premult);
+        const lv_opa_t opa = 255 - dsc->recolor_opa;
+        for (uint32_t i = 0; i < count; i++) {
+            color[i] = lv_color_mix_premult(premult, color[i], opa);
+        }
+    }
+
+    entry->opaque = true;
+    for (uint32_t i = 0; i < count && entry->opaque; i++) {
+        entry->opaque = (alpha[i] == LV_OPA_COVER);
+    }
+    return true;
+}
+
+static void lvgl_port_img_cache_blend(lv_draw_ctx_t *draw_ctx, const lv_draw_img_dsc_t *dsc, const lv_area_t *coords,
+                                      const lvgl_port_cache_entry_t *entry)
+{
+    lv_draw_img_dsc_t plain = *dsc;
+    lv_area_t area;
+    lv_area_t clip;
+
+    /* Already transformed and recolored, blended like an image without these */
+    plain.angle = 0;
+    plain.zoom = LV_IMG_ZOOM_NONE;
+    plain.recolor_opa = LV_OPA_TRANSP;
+    area.x1 = coords->x1 + entry->x;
+    area.y1 = coords->y1 + entry->y;
+    area.x2 = area.x1 + entry->w - 1;
+    area.y2 = area.y1 + entry->h - 1;
+    if (!_lv_area_intersect(&clip, draw_ctx->clip_area, &area)) {
+        return;
+    }
+
+    const lv_area_t *clip_ori = draw_ctx->clip_area;
+    draw_ctx->clip_area = &clip;
+    lv_draw_img_decoded(draw_ctx, &plain, &area, entry->data, entry->opaque ? LV_IMG_CF_TRUE_COLOR : LV_IMG_CF_RGB565A8);
+    draw_ctx->clip_area = clip_ori;
+}
+
+/* Drawn before LVGL decodes the image, LV_RES_INV leaves the image to LVGL */
+static lv_res_t lvgl_port_img_cache_draw(lv_draw_ctx_t *draw_ctx, const lv_draw_img_dsc_t *dsc, const lv_area_t *coords, const void *src)
+{
+    const bool transform = dsc->angle || dsc->zoom != LV_IMG_ZOOM_NONE;
+    const bool recolor = dsc->recolor_opa > LV_OPA_MIN;
+    lvgl_port_cache_key_t key;
+    lv_img_decoder_dsc_t dec;
+    lv_area_t area;
+    lv_img_cf_t cf;
+
+    /* Plain images are blended straight from their pixels anyway */
+    if (lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE || (!transform && !recolor && !lvgl_port_img_cache_lines(src))) {
+        return LV_RES_INV;
+    }
+    if (!transform && ((const lv_img_dsc_t *)src)->header.cf == LV_IMG_CF_ALPHA_8BIT) {
+        /* Alpha only images are filled with their recolor, also under draw masks (LVGL 8 reads no pixels of them there) */
+        lvgl_port_blend_mask(draw_ctx, coords, ((const lv_img_dsc_t *)src)->data, dsc->recolor, dsc->opa, dsc->blend_mode);
+        return LV_RES_OK;
+    }
+
+    memset(&key, 0, sizeof(key));
+    key.src = src;
+    key.frame_id = dsc->frame_id;
+    if (transform) {
+        key.angle = dsc->angle;
+        key.zoom = dsc->zoom;
+        key.pivot_x = dsc->pivot.x;
+        key.pivot_y = dsc->pivot.y;
+        key.antialias = dsc->antialias;
+    } else {
+        key.zoom = LV_IMG_ZOOM_NONE;
+    }
+    if (recolor) {
+        key.recolor = dsc->recolor.full;
+        key.recolor_opa = dsc->recolor_opa;
+    }
+    lvgl_port_cache_entry_t *entry = lvgl_port_cache_find(&lvgl_port_img_cached.cache, &key);
+    if (entry) {
+        lvgl_port_img_cache_blend(draw_ctx, dsc, coords, entry);
+        return LV_RES_OK;
+    }
+
+    if (!lvgl_port_cache_admit(&lvgl_port_img_cached.cache, &key) ||
+            lv_img_decoder_open(&dec, src, dsc->recolor, dsc->frame_id) != LV_RES_OK) {
+        return LV_RES_INV;
+    }
+    switch (dec.header.cf) {
+    case LV_IMG_CF_TRUE_COLOR:
+    case LV_IMG_CF_TRUE_COLOR_ALPHA:
+    case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+        cf = dec.header.cf;
+        break;
+    default:
+        /* Alpha only images are colored while blended */
+        lv_img_decoder_close(&dec);
+        return LV_RES_INV;
+    }
+
+    area.x1 = 0;
+    area.y1 = 0;
+    area.x2 = dec.header.w - 1;
+    area.y2 = dec.header.h - 1;
+    if (transform) {
+        _lv_img_buf_get_transformed_area(&area, dec.header.w, dec.header.h, dsc->angle, dsc->zoom, &dsc->pivot);
+    }
+    const size_t count = lv_area_get_size(&area);
+    entry = lvgl_port_cache_add(&lvgl_port_img_cached.cache, &key, count * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    if (entry == NULL) {
+        lv_img_decoder_close(&dec);
+        return LV_RES_INV;
+    }
+    entry->x = area.x1;
+    entry->y = area.y1;
+    entry->w = lv_area_get_width(&area);
+    entry->h = lv_area_get_height(&area);
+    const bool filled = lvgl_port_img_cache_fill(draw_ctx, dsc, &dec, cf, &area, entry);
+    lv_img_decoder_close(&dec);
+    if (!filled) {
+        lvgl_port_cache_remove(&lvgl_port_img_cached.cache, entry);
+        return LV_RES_INV;
+    }
+    if (entry->opaque) {
+        entry = lvgl_port_cache_shrink(&lvgl_port_img_cached.cache, entry, count * sizeof(lv_color_t));
+    }
+
+    lvgl_port_img_cache_blend(draw_ctx, dsc, coords, entry);
+    return LV_RES_OK;
+}
+
+/* Render one step like a miss of the cache renders it, into pixels of their own */
+static bool lvgl_port_img_steps_fill(lv_draw_ctx_t *draw_ctx, lv_img_decoder_dsc_t *dec, lv_img_cf_t cf, uint16_t zoom,
+                                     bool mask, lv_img_dsc_t *img)
+{
+    lvgl_port_cache_entry_t entry;
+    lv_draw_img_dsc_t dsc;
+    lv_area_t area;
+
+    lv_draw_img_dsc_init(&dsc);
+    dsc.zoom = zoom;
+    dsc.pivot.x = dec->header.w / 2;
+    dsc.pivot.y = dec->header.h / 2;
+    dsc.antialias = LV_COLOR_DEPTH > 8;
+    area.x1 = 0;
+    area.y1 = 0;
+    area.x2 = dec->header.w - 1;
+    area.y2 = dec->header.h - 1;
+    if (zoom != LV_IMG_ZOOM_NONE) {
+        _lv_img_buf_get_transformed_area(&area, dec->header.w, dec->header.h, 0, zoom, &dsc.pivot);
+    }
+
+    memset(&entry, 0, sizeof(entry));
+    const uint32_t count = lv_area_get_size(&area);
+    entry.w = lv_area_get_width(&area);
+    entry.h = lv_area_get_height(&area);
+    entry.data = malloc(count * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    if (entry.data == NULL) {
+        return false;
+    }
+    if (!lvgl_port_img_cache_fill(draw_ctx, &dsc, dec, cf, &area, &entry)) {
+        free(entry.data);
+        return false;
+    }
+
+    memset(img, 0, sizeof(*img));
+    img->header.w = entry.w;
+    img->header.h = entry.h;
+    if (mask) {
+        /* The alpha plane only, LVGL blends it in the recolor of the image */
+        memmove(entry.data, entry.data + count * sizeof(lv_color_t), count);
+        img->header.cf = LV_IMG_CF_ALPHA_8BIT;
+        img->data_size = count;
+    } else if (entry.opaque) {
+        img->header.cf = LV_IMG_CF_TRUE_COLOR;
+        img->data_size = count * sizeof(lv_color_t);
+    } else {
+        img->header.cf = LV_IMG_CF_RGB565A8;
+        img->data_size = count * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    }
+    uint8_t *data = realloc(entry.data, img->data_size);
+    img->data = data ? data : entry.data;
+    return true;
+}
+
+/* Index of a named layer, added when new, the default one when the table is full */
+static uint8_t lvgl_port_img_cache_layer_index(const char *layer)
+{
+    if (layer == NULL) {
+        return 0;
+    }
+    for (uint8_t i = 1; i < LVGL_PORT_CACHE_LAYERS; i++) {
+        if (lvgl_port_img_cached.layers[i] == NULL) {
+            lvgl_port_img_cached.layers[i] = layer;
+            return i;
+        }
+        if (strcmp(lvgl_port_img_cached.layers[i], layer) == 0) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+bool lvgl_port_img_rle_init(size_t cache_size)
+{
+    if (lvgl_port_img_rle.decoder) {
+        return true;
+    }
+
+    memset(&lvgl_port_img_rle, 0, sizeof(lvgl_port_img_rle));
+    if (!lvgl_port_rle_cache_init(&lvgl_port_img_rle.cache, cache_size)) {
+        return false;
+    }
+    /* New decoders are tried first, the built-in one rejects encoded images anyway */
+    lvgl_port_img_rle.decoder = lv_img_decoder_create();
+    if (lvgl_port_img_rle.decoder == NULL) {
+        lvgl_port_rle_cache_deinit(&lvgl_port_img_rle.cache);
+        return false;
+    }
+    lv_img_decoder_set_info_cb(lvgl_port_img_rle.decoder, lvgl_port_img_rle_info);
+    lv_img_decoder_set_open_cb(lvgl_port_img_rle.decoder, lvgl_port_img_rle_open);
+    lv_img_decoder_set_read_line_cb(lvgl_port_img_rle.decoder, lvgl_port_img_rle_read_line);
+    lv_img_decoder_set_close_cb(lvgl_port_img_rle.decoder, lvgl_port_img_rle_close);
+
+    return true;
+}
+
+void lvgl_port_img_rle_deinit(void)
+{
+    if (lvgl_port_img_rle.decoder) {
+        lv_img_decoder_delete(lvgl_port_img_rle.decoder);
+    }
+    lvgl_port_rle_cache_deinit(&lvgl_port_img_rle.cache);
+    memset(&lvgl_port_img_rle, 0, sizeof(lvgl_port_img_rle));
+}
+
+void lvgl_port_img_rle_get_stats(lvgl_port_img_rle_stats_t *stats)
+{
+    stats->opened = lvgl_port_img_rle.opened;
+    stats->lines = lvgl_port_img_rle.lines;
+    stats->px_decoded = lvgl_port_img_rle.cache.px_decoded;
+    stats->cache_hits = lvgl_port_img_rle.cache.hits;
+    stats->cache_misses = lvgl_port_img_rle.cache.misses;
+    stats->cache_size = lvgl_port_img_rle.cache.size;
+}
+
+bool lvgl_port_img_assets_init(const void *data, size_t size)
+{
+    if (lvgl_port_img_assets.decoder) {
+        return false;
+    }
+    if (!lvgl_port_assets_open(&lvgl_port_img_assets.table, data, size)) {
+        return false;
+    }
+    lvgl_port_img_assets.decoder = lv_img_decoder_create();
+    if (lvgl_port_img_assets.decoder == NULL) {
+        memset(&lvgl_port_img_assets, 0, sizeof(lvgl_port_img_assets));
+        return false;
+    }
+    lv_img_decoder_set_info_cb(lvgl_port_img_assets.decoder, lvgl_port_img_asset_info);
+    lv_img_decoder_set_open_cb(lvgl_port_img_assets.decoder, lvgl_port_img_asset_open);
+    lv_img_decoder_set_read_line_cb(lvgl_port_img_assets.decoder, lvgl_port_img_asset_read_line);
+    lv_img_decoder_set_close_cb(lvgl_port_img_assets.decoder, lvgl_port_img_rle_close);
+
+    return true;
+}
+
+void lvgl_port_img_assets_deinit(void)
+{
+    if (lvgl_port_img_assets.decoder) {
+        lv_img_decoder_delete(lvgl_port_img_assets.decoder);
+    }
+    memset(&lvgl_port_img_assets, 0, sizeof(lvgl_port_img_assets));
+}
+
+uint32_t lvgl_port_img_assets_count(void)
+{
+    return lvgl_port_img_assets.table.count;
+}
+
+const lvgl_port_assets_t *lvgl_port_img_assets_table(void)
+{
+    return lvgl_port_img_assets.decoder ? &lvgl_port_img_assets.table : NULL;
+}
+
+bool lvgl_port_img_cache_init(lv_disp_t *disp, size_t budget)
+{
+    lv_draw_ctx_t *draw_ctx = disp->driver->draw_ctx;
+
+    /* Only drawing with LVGL's software renderer in native RGB565 is supported */
+    if (LV_COLOR_DEPTH != 16 || LV_COLOR_16_SWAP || draw_ctx == NULL ||
+            (draw_ctx->draw_img != NULL && draw_ctx->draw_img != lvgl_port_img_cache_draw)) {
+        return false;
+    }
+    if (draw_ctx->draw_img == NULL) {
+        /* The first display sets the budget, all displays share the cache */
+        if (lvgl_port_img_cached.cache.budget == 0) {
+            lvgl_port_cache_init(&lvgl_port_img_cached.cache, budget);
+        }
+        draw_ctx->draw_img = lvgl_port_img_cache_draw;
+    }
+
+    return true;
+}
+
+void lvgl_port_img_cache_deinit(void)
+{
+    lv_disp_t *disp = NULL;
+
+    while ((disp = lv_disp_get_next(disp)) != NULL) {
+        if (disp->driver->draw_ctx && disp->driver->draw_ctx->draw_img == lvgl_port_img_cache_draw) {
+            disp->driver->draw_ctx->draw_img = NULL;
+        }
+    }
+    lvgl_port_cache_deinit(&lvgl_port_img_cached.cache);
+    memset(&lvgl_port_img_cached, 0, sizeof(lvgl_port_img_cached));
+}
+
+void lvgl_port_img_cache_set_layer(const char *layer)
+{
+    lvgl_port_cache_set_layer(&lvgl_port_img_cached.cache, lvgl_port_img_cache_layer_index(layer));
+}
+
+bool lvgl_port_img_cache_pin(const void *src, bool pin)
+{
+    return lvgl_port_cache_pin(&lvgl_port_img_cached.cache, src, pin);
+}
+
+bool lvgl_port_img_steps_create(const void *src, uint16_t zoom_min, uint16_t zoom_max, bool mask, lv_img_dsc_t *steps, uint8_t count)
+{
+    lv_disp_t *disp = lv_disp_get_default();
+    lv_img_decoder_dsc_t dec;
+    bool ok = true;
+    uint8_t i;
+
+    memset(steps, 0, count * sizeof(lv_img_dsc_t));
+    if (disp == NULL || disp->driver->draw_ctx == NULL || count == 0 || zoom_min == 0 || zoom_min > zoom_max ||
+            lv_img_decoder_open(&dec, src, lv_color_black(), 0) != LV_RES_OK) {
+        return false;
+    }
+    switch (dec.header.cf) {
+    case LV_IMG_CF_TRUE_COLOR:
+    case LV_IMG_CF_TRUE_COLOR_ALPHA:
+    case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+        for (i = 0; i < count && ok; i++) {
+            const uint16_t zoom = (count == 1) ? zoom_min : zoom_min + (uint32_t)(zoom_max - zoom_min) * i / (count - 1);
+            ok = lvgl_port_img_steps_fill(disp->driver->draw_ctx, &dec, dec.header.cf, zoom, mask, &steps[i]);
+        }
+        break;
+    default:
+        ok = false;
+        break;
+    }
+    lv_img_decoder_close(&dec);
+
+    if (!ok) {
+        lvgl_port_img_steps_delete(steps, count);
+    }
+    return ok;
+}
+
+void lvgl_port_img_steps_delete(lv_img_dsc_t *steps, uint8_t count)
+{
+    for (uint8_t i = 0; i < count; i++) {
+        free((void *)steps[i].data);
+        memset(&steps[i], 0, sizeof(lv_img_dsc_t));
+    }
+}
+
+bool lvgl_port_img_cache_get_stats(uint8_t index, const char **layer, lvgl_port_cache_layer_t *stats)
+{
+    if (index >= LVGL_PORT_CACHE_LAYERS || (index > 0 && lvgl_port_img_cached.layers[index] == NULL)) {
+        return false;
+    }
+    *layer = lvgl_port_img_cached.layers[index];
+    *stats = lvgl_port_img_cached.cache.stats[index];
+
+    return true;
+}
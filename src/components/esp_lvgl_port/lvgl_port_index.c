@@ -0,0 +1,140 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "lvgl_port_index.h"
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static inline uint8_t lvgl_port_index_get(const uint8_t *row, uint32_t x, uint8_t bpp)
+{
+    switch (bpp) {
+    case 1:
+        return (row[x >> 3] >> (7 - (x & 7))) & 0x01;
+    case 2:
+        return (row[x >> 2] >> (6 - 2 * (x & 3))) & 0x03;
+    case 4:
+        return (row[x >> 1] >> ((x & 1) ? 0 : 4)) & 0x0F;
+    default:
+        return row[x];
+    }
+}
+
+static inline uint8_t *lvgl_port_index_put(const lvgl_port_index_palette_t *pal, uint8_t i, bool alpha, uint8_t *out)
+{
+    out[0] = pal->color[i][0];
+    out[1] = pal->color[i][1];
+    if (alpha) {
+        out[2] = pal->alpha[i];
+        return out + 3;
+    }
+    return out + 2;
+}
+
+/* Unaligned head and tail pixel by pixel, whole bytes of indices in between */
+static inline void lvgl_port_index_expand(const lvgl_port_index_img_t *img, const lvgl_port_index_palette_t *pal,
+                                          const uint8_t *row, uint32_t x, uint32_t len, bool alpha, uint8_t *out)
+{
+    const uint8_t bpp = img->bpp;
+    const uint32_t per_byte = 8 / bpp;
+    const uint32_t end = x + len;
+
+    while (x < end && (x % per_byte) != 0) {
+        out = lvgl_port_index_put(pal, lvgl_port_index_get(row, x++, bpp), alpha, out);
+    }
+    const uint8_t *p = row + x / per_byte;
+    for (; x + per_byte <= end; x += per_byte) {
+        const uint8_t b = *p++;
+        switch (bpp) {
+        case 1:
+            for (int shift = 7; shift >= 0; shift--) {
+                out = lvgl_port_index_put(pal, (b >> shift) & 0x01, alpha, out);
+            }
+            break;
+        case 2:
+            out = lvgl_port_index_put(pal, b >> 6, alpha, out);
+            out = lvgl_port_index_put(pal, (b >> 4) & 0x03, alpha, out);
+            out = lvgl_port_index_put(pal, (b >> 2) & 0x03, alpha, out);
+            out = lvgl_port_index_put(pal, b & 0x03, alpha, out);
+            break;
+        case 4:
+            out = lvgl_port_index_put(pal, b >> 4, alpha, out);
+            out = lvgl_port_index_put(pal, b & 0x0F, alpha, out);
+            break;
+        default:
+            out = lvgl_port_index_put(pal, b, alpha, out);
+            break;
+        }
+    }
+    while (x < end) {
+        out = lvgl_port_index_put(pal, lvgl_port_index_get(row, x++, bpp), alpha, out);
+    }
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+bool lvgl_port_index_open(lvgl_port_index_img_t *img, const void *data, size_t size, uint32_t w, uint32_t h, uint8_t bpp)
+{
+    if (img == NULL || data == NULL || w == 0 || h == 0 || w > UINT16_MAX || h > UINT16_MAX) {
+        return false;
+    }
+    if (bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8) {
+        return false;
+    }
+    const size_t palette_size = (size_t)4 << bpp;
+    const uint32_t stride = (w * bpp + 7) / 8;
+    if (size < palette_size + (size_t)stride * h) {
+        return false;
+    }
+
+    img->palette = (const uint8_t *)data;
+    img->indices = img->palette + palette_size;
+    img->stride = stride;
+    img->w = w;
+    img->h = h;
+    img->bpp = bpp;
+    return true;
+}
+
+void lvgl_port_index_palette(lvgl_port_index_palette_t *pal, const lvgl_port_index_img_t *img)
+{
+    if (pal->key == img->palette) {
+        return;
+    }
+
+    const uint32_t count = 1u << img->bpp;
+    const uint8_t *c = img->palette;
+    pal->opaque = true;
+    for (uint32_t i = 0; i < count; i++, c += 4) {
+        /* lv_color32_t is blue, green, red, alpha; truncated like lv_color_make() */
+        const uint16_t px = ((c[2] >> 3) << 11) | ((c[1] >> 2) << 5) | (c[0] >> 3);
+        pal->color[i][0] = px & 0xFF;
+        pal->color[i][1] = px >> 8;
+        pal->alpha[i] = c[3];
+        pal->opaque &= c[3] == 0xFF;
+    }
+    pal->key = img->palette;
+}
+
+bool lvgl_port_index_read(const lvgl_port_index_img_t *img, const lvgl_port_index_palette_t *pal,
+                          uint32_t x, uint32_t y, uint32_t len, bool alpha, uint8_t *out)
+{
+    if (y >= img->h || x > img->w || len > img->w - x || pal->key != img->palette) {
+        return false;
+    }
+
+    const uint8_t *row = img->indices + y * img->stride;
+    /* Expanded separately, so the loops don't test the output format per pixel */
+    if (alpha) {
+        lvgl_port_index_expand(img, pal, row, x, len, true, out);
+    } else {
+        lvgl_port_index_expand(img, pal, row, x, len, false, out);
+    }
+    return true;
+}
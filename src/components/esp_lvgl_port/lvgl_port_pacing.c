@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "lvgl_port_pacing.h"
+
+/* TE edges further apart are not used for measuring the scan period (missed edges) */
+#define LVGL_PORT_PACING_MAX_MISSED     (4)
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void lvgl_port_pacing_init(lvgl_port_pacing_t *pacing, uint32_t scan_us, int64_t now_us)
+{
+    memset(pacing, 0, sizeof(lvgl_port_pacing_t));
+    pacing->scan_us = scan_us ? scan_us : 1;
+    pacing->vsync_us = now_us;
+}
+
+void lvgl_port_pacing_vsync(lvgl_port_pacing_t *pacing, int64_t now_us)
+{
+    if (pacing->te_locked) {
+        /* Average the scan period, some edges could be missed */
+        const int64_t interval = now_us - pacing->vsync_us;
+        const int64_t scans = (interval + pacing->scan_us / 2) / pacing->scan_us;
+        if (scans >= 1 && scans <= LVGL_PORT_PACING_MAX_MISSED) {
+            const int32_t measured = interval / scans;
+            pacing->scan_us += (measured - (int32_t)pacing->scan_us) / 8;
+        }
+    }
+    pacing->vsync_us = now_us;
+    pacing->te_locked = true;
+    pacing->te_count++;
+}
+
+int64_t lvgl_port_pacing_next_vsync(const lvgl_port_pacing_t *pacing, int64_t time_us)
+{
+    const int64_t diff = time_us - pacing->vsync_us;
+    int64_t scans;
+
+    if (diff > 0) {
+        scans = (diff + pacing->scan_us - 1) / pacing->scan_us;
+    } else {
+        scans = diff / pacing->scan_us;
+    }
+
+    return pacing->vsync_us + scans * pacing->scan_us;
+}
+
+uint32_t lvgl_port_pacing_period(const lvgl_port_pacing_t *pacing, uint32_t period_ms)
+{
+    uint32_t scans = ((uint64_t)period_ms * 1000 + pacing->scan_us - 1) / pacing->scan_us;
+    if (scans == 0) {
+        scans = 1;
+    }
+
+    return ((uint64_t)scans * pacing->scan_us + 999) / 1000;
+}
+
+int64_t lvgl_port_pacing_start(const lvgl_port_pacing_t *pacing, int64_t now_us)
+{
+    return lvgl_port_pacing_next_vsync(pacing, now_us + pacing->lead_us) - pacing->lead_us;
+}
+
+void lvgl_port_pacing_frame(lvgl_port_pacing_t *pacing, int64_t start_us, int64_t flush_us, int64_t end_us, uint32_t target_scans)
+{
+    if (flush_us != 0) {
+        const int32_t lead = flush_us - start_us;
+        if (pacing->lead_us == 0) {
+            pacing->lead_us = lead;
+        } else {
+            pacing->lead_us += (lead - (int32_t)pacing->lead_us) / 4;
+        }
+    }
+
+    if (pacing->frames > 0) {
+        /* The previous frame is shown whole only when a vsync comes before this frame is written */
+        if (end_us < lvgl_port_pacing_next_vsync(pacing, pacing->last_end_us)) {
+            pacing->wasted++;
+        }
+        if (target_scans > 0) {
+            const int64_t scans = (end_us - pacing->last_end_us + pacing->scan_us / 2) / pacing->scan_us;
+            if (scans > target_scans) {
+                pacing->dropped += scans - target_scans;
+            }
+        }
+    }
+
+    pacing->last_end_us = end_us;
+    pacing->frames++;
+}
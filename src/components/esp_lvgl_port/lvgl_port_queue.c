@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include "lvgl_port_queue.h"
+
+#define LVGL_PORT_QUEUE_MASK    (LVGL_PORT_QUEUE_LEN - 1)
+
+_Static_assert((LVGL_PORT_QUEUE_LEN & LVGL_PORT_QUEUE_MASK) == 0, "LVGL_PORT_QUEUE_LEN must be a power of two");
+
+void lvgl_port_queue_init(lvgl_port_queue_t *queue)
+{
+    for (uint32_t i = 0; i < LVGL_PORT_QUEUE_LEN; i++) {
+        atomic_init(&queue->cell[i].seq, i);
+        queue->cell[i].cmd.cb = NULL;
+        queue->cell[i].cmd.arg = NULL;
+    }
+    atomic_init(&queue->push_pos, 0);
+    atomic_init(&queue->pop_pos, 0);
+    atomic_init(&queue->pushed, 0);
+    atomic_init(&queue->dropped, 0);
+}
+
+bool lvgl_port_queue_push(lvgl_port_queue_t *queue, const lvgl_port_queue_cmd_t *cmd)
+{
+    uint32_t pos = atomic_load_explicit(&queue->push_pos, memory_order_relaxed);
+    lvgl_port_queue_cell_t *cell;
+
+    for (;;) {
+        cell = &queue->cell[pos & LVGL_PORT_QUEUE_MASK];
+        const uint32_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        const int32_t diff = (int32_t)(seq - pos);
+        if (diff == 0) {
+            /* Cell is free for this position, claim the position */
+            if (atomic_compare_exchange_weak_explicit(&queue->push_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* Cell still holds the command of the previous round */
+            atomic_fetch_add_explicit(&queue->dropped, 1, memory_order_relaxed);
+            return false;
+        } else {
+            /* Other producer claimed the position */
+            pos = atomic_load_explicit(&queue->push_pos, memory_order_relaxed);
+        }
+    }
+
+    cell->cmd = *cmd;
+    atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+    atomic_fetch_add_explicit(&queue->pushed, 1, memory_order_relaxed);
+    return true;
+}
+
+bool lvgl_port_queue_pop(lvgl_port_queue_t *queue, lvgl_port_queue_cmd_t *cmd)
+{
+    uint32_t pos = atomic_load_explicit(&queue->pop_pos, memory_order_relaxed);
+    lvgl_port_queue_cell_t *cell;
+
+    for (;;) {
+        cell = &queue->cell[pos & LVGL_PORT_QUEUE_MASK];
+        const uint32_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        const int32_t diff = (int32_t)(seq - (pos + 1));
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->pop_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* Empty, or the command of this position is still being written */
+            return false;
+        } else {
+            pos = atomic_load_explicit(&queue->pop_pos, memory_order_relaxed);
+        }
+    }
+
+    *cmd = cell->cmd;
+    /* Free the cell for the push of the next round */
+    atomic_store_explicit(&cell->seq, pos + LVGL_PORT_QUEUE_LEN, memory_order_release);
+    return true;
+}
@@ -0,0 +1,192 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl_port_rle.h"
+
+#define LVGL_PORT_RLE_RUN           (0x80)
+#define LVGL_PORT_RLE_COUNT_MASK    (0x7F)
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* Encoded data in flash doesn't have to be aligned */
+static inline uint32_t lvgl_port_rle_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void lvgl_port_rle_fill(uint8_t *out, const uint8_t *px, uint32_t count, uint8_t px_size)
+{
+    if (px_size == 2) {
+        const uint8_t b0 = px[0];
+        const uint8_t b1 = px[1];
+        for (uint32_t i = 0; i < count; i++) {
+            out[0] = b0;
+            out[1] = b1;
+            out += 2;
+        }
+    } else {
+        const uint8_t b0 = px[0];
+        const uint8_t b1 = px[1];
+        const uint8_t b2 = px[2];
+        for (uint32_t i = 0; i < count; i++) {
+            out[0] = b0;
+            out[1] = b1;
+            out[2] = b2;
+            out += 3;
+        }
+    }
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+bool lvgl_port_rle_open(lvgl_port_rle_img_t *img, const void *data, size_t size, uint32_t w, uint32_t h)
+{
+    const uint8_t *p = (const uint8_t *)data;
+
+    if (img == NULL || p == NULL || w == 0 || h == 0 || w > UINT16_MAX || h > UINT16_MAX) {
+        return false;
+    }
+    if (size < LVGL_PORT_RLE_HEADER_SIZE + (size_t)h * 4 || lvgl_port_rle_u32(p) != LVGL_PORT_RLE_MAGIC) {
+        return false;
+    }
+    if (p[5] != 2 && p[5] != 3) {
+        return false;
+    }
+
+    img->data = p;
+    img->size = size;
+    img->w = w;
+    img->h = h;
+    img->cf = p[4];
+    img->px_size = p[5];
+    return true;
+}
+
+bool lvgl_port_rle_read(const lvgl_port_rle_img_t *img, uint32_t x, uint32_t y, uint32_t len, uint8_t *out)
+{
+    if (y >= img->h || x + len > img->w) {
+        return false;
+    }
+
+    const uint32_t offset = lvgl_port_rle_u32(img->data + LVGL_PORT_RLE_HEADER_SIZE + y * 4);
+    if (offset > img->size) {
+        return false;
+    }
+    const uint8_t px_size = img->px_size;
+    const uint8_t *p = img->data + offset;
+    const uint8_t *end = img->data + img->size;
+
+    /* Packets before the first column are only skipped */
+    while (len > 0) {
+        if (p >= end) {
+            return false;
+        }
+        const uint8_t ctrl = *p++;
+        const uint32_t count = (ctrl & LVGL_PORT_RLE_COUNT_MASK) + 1;
+        const bool run = (ctrl & LVGL_PORT_RLE_RUN) != 0;
+        const size_t packet = run ? px_size : count * px_size;
+        if ((size_t)(end - p) < packet) {
+            return false;
+        }
+
+        if (x >= count) {
+            x -= count;
+        } else {
+            uint32_t n = count - x;
+            if (n > len) {
+                n = len;
+            }
+            if (run) {
+                lvgl_port_rle_fill(out, p, n, px_size);
+            } else {
+                memcpy(out, p + x * px_size, n * px_size);
+            }
+            out += n * px_size;
+            len -= n;
+            x = 0;
+        }
+        p += packet;
+    }
+
+    return true;
+}
+
+bool lvgl_port_rle_cache_init(lvgl_port_rle_cache_t *cache, size_t size)
+{
+    if (cache == NULL) {
+        return false;
+    }
+
+    memset(cache, 0, sizeof(lvgl_port_rle_cache_t));
+    if (size == 0) {
+        return true;
+    }
+    cache->mem = malloc(size);
+    if (cache->mem == NULL) {
+        return false;
+    }
+    cache->size = size;
+
+    return true;
+}
+
+void lvgl_port_rle_cache_deinit(lvgl_port_rle_cache_t *cache)
+{
+    if (cache == NULL) {
+        return;
+    }
+
+    free(cache->mem);
+    memset(cache, 0, sizeof(lvgl_port_rle_cache_t));
+}
+
+bool lvgl_port_rle_cache_read(lvgl_port_rle_cache_t *cache, const lvgl_port_rle_img_t *img,
+                              uint32_t x, uint32_t y, uint32_t len, uint8_t *out)
+{
+    const size_t row_size = (size_t)img->w * img->px_size;
+
+    /* Slots grow to the widest row, all cached rows are dropped then */
+    if (row_size > cache->row_size && row_size <= cache->size) {
+        cache->row_size = row_size;
+        cache->slots = cache->size / row_size;
+        if (cache->slots > LVGL_PORT_RLE_CACHE_SLOTS) {
+            cache->slots = LVGL_PORT_RLE_CACHE_SLOTS;
+        }
+        memset(cache->key_data, 0, sizeof(cache->key_data));
+    }
+    if (cache->slots == 0 || row_size > cache->row_size || y >= img->h) {
+        cache->px_decoded += len;
+        return lvgl_port_rle_read(img, x, y, len, out);
+    }
+
+    /* Rows of different images at the same position go to different slots */
+    const uint32_t slot = (y + ((uint32_t)((uintptr_t)img->data >> 4) * 0x9E3779B1u >> 24)) % cache->slots;
+    uint8_t *row = cache->mem + slot * cache->row_size;
+    if (cache->key_data[slot] == img->data && cache->key_y[slot] == y) {
+        cache->hits++;
+    } else {
+        cache->key_data[slot] = NULL;
+        if (!lvgl_port_rle_read(img, 0, y, img->w, row)) {
+            return false;
+        }
+        cache->key_data[slot] = img->data;
+        cache->key_y[slot] = y;
+        cache->misses++;
+        cache->px_decoded += img->w;
+    }
+    if (x + len > img->w) {
+        return false;
+    }
+    memcpy(out, row + x * img->px_size, len * img->px_size);
+
+    return true;
+}
@@ -0,0 +1,444 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl.h"
+#include "src/draw/sw/lv_draw_sw.h"
+#include "lvgl_port_blend.h"
+#include "lvgl_port_roller_obj.h"
+
+enum {
+    LVGL_PORT_ROLLER_OBJ_ROWS,          /* Text in the font of LV_PART_MAIN */
+    LVGL_PORT_ROLLER_OBJ_SELECTED,      /* Text in the font of LV_PART_SELECTED */
+    LVGL_PORT_ROLLER_OBJ_BANDS,
+};
+
+#define LVGL_PORT_ROLLER_OBJ_CHUNK_ROWS (32)   /* Rows of a text rendered at once */
+
+/* Run of rows with coverage, the rows between the lines of a text are not stored */
+typedef struct {
+    lv_coord_t y1;                      /* First row, from the top of the text */
+    lv_coord_t y2;
+    uint32_t ofs;                       /* Of the first row in the buffer */
+} lvgl_port_roller_obj_strip_t;
+
+typedef struct {
+    lv_opa_t *buf;                      /* Coverage of the text, the rows of the strips one after the other */
+    lvgl_port_roller_obj_strip_t *strips;   /* Runs of rows with coverage */
+    uint16_t count;
+    lv_coord_t x1;                      /* Columns with coverage, from the left of the text */
+    lv_coord_t x2;
+} lvgl_port_roller_obj_band_t;
+
+typedef struct {
+    lvgl_port_roller_obj_band_t band[LVGL_PORT_ROLLER_OBJ_BANDS];
+    lv_draw_label_dsc_t dsc[LVGL_PORT_ROLLER_OBJ_BANDS];    /* Text styles, opaque */
+    lv_opa_t opa[LVGL_PORT_ROLLER_OBJ_BANDS];               /* Text opacities of the styles */
+    lv_coord_t sel_h;                   /* Height of the selected text, as measured by LVGL */
+    char *text;                         /* Options the bands were rendered from */
+    bool stale;                         /* Bands to render again once the roller is laid out */
+} lvgl_port_roller_obj_t;
+
+static const lv_style_selector_t lvgl_port_roller_obj_parts[LVGL_PORT_ROLLER_OBJ_BANDS] = {
+    LV_PART_MAIN, LV_PART_SELECTED,
+};
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* blend of the software renderer drawing into a band: coverage added to the coverage of the letters before */
+static void lvgl_port_roller_obj_band_blend(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc)
+{
+    lv_area_t area;
+
+    if (!_lv_area_intersect(&area, dsc->blend_area, draw_ctx->clip_area)) {
+        return;
+    }
+    const lv_opa_t *mask = (dsc->mask_res == LV_DRAW_MASK_RES_FULL_COVER) ? NULL : dsc->mask_buf;
+    const lv_coord_t buf_w = lv_area_get_width(draw_ctx->buf_area);
+    const lv_coord_t mask_w = mask ? lv_area_get_width(dsc->mask_area) : 0;
+    lv_opa_t *buf = draw_ctx->buf;
+
+    for (lv_coord_t y = area.y1; y <= area.y2; y++) {
+        lv_opa_t *dst = buf + (y - draw_ctx->buf_area->y1) * buf_w + (area.x1 - draw_ctx->buf_area->x1);
+        const lv_opa_t *src = mask ? mask + (y - dsc->mask_area->y1) * mask_w + (area.x1 - dsc->mask_area->x1) : NULL;
+        for (lv_coord_t x = 0; x < lv_area_get_width(&area); x++) {
+            lv_opa_t a = src ? src[x] : LV_OPA_COVER;
+            if (dsc->opa < LV_OPA_MAX) {
+                a = (a * dsc->opa) >> 8;
+            }
+            dst[x] += ((LV_OPA_COVER - dst[x]) * a + 127) / 255;
+        }
+    }
+}
+
+static void lvgl_port_roller_obj_band_free(lvgl_port_roller_obj_band_t *band)
+{
+    free(band->buf);
+    free(band->strips);
+    memset(band, 0, sizeof(lvgl_port_roller_obj_band_t));
+}
+
+/* Render the rows of a text from y on, like lv_draw_label() would draw it in the area */
+static lv_coord_t lvgl_port_roller_obj_chunk_render(lv_opa_t *chunk, const lv_draw_label_dsc_t *dsc, const lv_area_t *coords,
+        const char *text, lv_coord_t y)
+{
+    lv_draw_sw_ctx_t ctx;
+    lv_area_t area;
+
+    lv_area_set(&area, coords->x1, y, coords->x2, LV_MIN(y + LVGL_PORT_ROLLER_OBJ_CHUNK_ROWS - 1, coords->y2));
+    memset(chunk, 0, lv_area_get_size(&area));
+    lv_draw_sw_init_ctx(NULL, &ctx.base_draw);
+    ctx.blend = lvgl_port_roller_obj_band_blend;
+    ctx.base_draw.buf = chunk;
+    ctx.base_draw.buf_area = &area;
+    ctx.base_draw.clip_area = &area;
+    lv_draw_label(&ctx.base_draw, dsc, coords, text, NULL);
+    return lv_area_get_height(&area);
+}
+
+static bool lvgl_port_roller_obj_row_used(const lv_opa_t *row, lv_coord_t w)
+{
+    for (lv_coord_t x = 0; x < w; x++) {
+        if (row[x]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Render a text into a band, in chunks of rows: the first pass finds the rows and columns with
+ * coverage, the second one stores them, so no buffer of the whole text is needed.
+ */
+static bool lvgl_port_roller_obj_band_render(lvgl_port_roller_obj_band_t *band, const lv_draw_label_dsc_t *dsc,
+        const lv_area_t *coords, const char *text)
+{
+    const lv_coord_t w = lv_area_get_width(coords);
+    uint32_t rows = 0;
+    uint16_t count = 0;
+    bool used_before = false;
+
+    lvgl_port_roller_obj_band_free(band);
+    lv_opa_t *chunk = malloc((size_t)w * LVGL_PORT_ROLLER_OBJ_CHUNK_ROWS);
+    if (chunk == NULL) {
+        return false;
+    }
+    band->x1 = w;
+    band->x2 = -1;
+    for (lv_coord_t y = coords->y1; y <= coords->y2;) {
+        const lv_coord_t h = lvgl_port_roller_obj_chunk_render(chunk, dsc, coords, text, y);
+        for (lv_coord_t i = 0; i < h; i++) {
+            const lv_opa_t *row = chunk + i * w;
+            const bool used = lvgl_port_roller_obj_row_used(row, w);
+            if (used) {
+                for (lv_coord_t x = 0; x < w; x++) {
+                    if (row[x]) {
+                        band->x1 = LV_MIN(band->x1, x);
+                        band->x2 = LV_MAX(band->x2, x);
+                    }
+                }
+                rows++;
+                count += !used_before;
+            }
+            used_before = used;
+        }
+        y += h;
+    }
+    if (rows == 0) {
+        free(chunk);
+        return true;
+    }
+
+    const lv_coord_t band_w = band->x2 - band->x1 + 1;
+    band->buf = malloc(rows * band_w);
+    band->strips = malloc(count * sizeof(lvgl_port_roller_obj_strip_t));
+    if (band->buf == NULL || band->strips == NULL) {
+        free(chunk);
+        lvgl_port_roller_obj_band_free(band);
+        return false;
+    }
+    uint32_t ofs = 0;
+    lvgl_port_roller_obj_strip_t *strip = NULL;
+    for (lv_coord_t y = coords->y1; y <= coords->y2;) {
+        const lv_coord_t h = lvgl_port_roller_obj_chunk_render(chunk, dsc, coords, text, y);
+        for (lv_coord_t i = 0; i < h; i++) {
+            const lv_opa_t *row = chunk + i * w;
+            if (!lvgl_port_roller_obj_row_used(row, w)) {
+                strip = NULL;
+                continue;
+            }
+            if (strip == NULL) {
+                strip = &band->strips[band->count++];
+                strip->y1 = y + i - coords->y1;
+                strip->ofs = ofs;
+            }
+            strip->y2 = y + i - coords->y1;
+            memcpy(band->buf + ofs, row + band->x1, band_w);
+            ofs += band_w;
+        }
+        y += h;
+    }
+    free(chunk);
+    return true;
+}
+
+/* Render both texts, outside of drawing (the draw masks of the roller would apply) */
+static bool lvgl_port_roller_obj_render(lv_obj_t *roller, lvgl_port_roller_obj_t *roller_obj)
+{
+    const lv_obj_t *label = lv_obj_get_child(roller, 0);
+    const char *text = lv_label_get_text(label);
+    const lv_draw_label_dsc_t *dsc = &roller_obj->dsc[LVGL_PORT_ROLLER_OBJ_SELECTED];
+    lv_area_t coords;
+    lv_point_t size;
+
+    /* The rows at the coordinates of the label */
+    lv_area_set(&coords, 0, 0, lv_obj_get_width(label) - 1, lv_obj_get_height(label) - 1);
+    if (!lvgl_port_roller_obj_band_render(&roller_obj->band[LVGL_PORT_ROLLER_OBJ_ROWS],
+                                          &roller_obj->dsc[LVGL_PORT_ROLLER_OBJ_ROWS], &coords, text)) {
+        return false;
+    }
+
+    /* The selected text over the width of the roller, expanded */
+    const lv_coord_t border = lv_obj_get_style_border_width(roller, LV_PART_MAIN);
+    const lv_coord_t w = lv_obj_get_width(roller) - lv_obj_get_style_pad_left(roller, LV_PART_MAIN) -
+                         lv_obj_get_style_pad_right(roller, LV_PART_MAIN) - 2 * border;
+    lv_txt_get_size(&size, text, dsc->font, dsc->letter_space, dsc->line_space, lv_obj_get_width(roller), LV_TEXT_FLAG_EXPAND);
+    roller_obj->sel_h = size.y;
+    lv_area_set(&coords, 0, 0, w - 1, size.y - 1);
+    if (!lvgl_port_roller_obj_band_render(&roller_obj->band[LVGL_PORT_ROLLER_OBJ_SELECTED], dsc, &coords, text)) {
+        return false;
+    }
+
+    /* Kept to tell new options from a label laid out again */
+    const size_t len = strlen(text) + 1;
+    char *copy = realloc(roller_obj->text, len);
+    if (copy == NULL) {
+        return false;
+    }
+    roller_obj->text = memcpy(copy, text, len);
+    return true;
+}
+
+/* Text styles of the roller, as lv_obj_init_draw_label_dsc() reads them, true when they changed */
+static bool lvgl_port_roller_obj_read_styles(lv_obj_t *roller, lvgl_port_roller_obj_t *roller_obj)
+{
+    bool changed = false;
+
+    for (int i = 0; i < LVGL_PORT_ROLLER_OBJ_BANDS; i++) {
+        const lv_style_selector_t part = lvgl_port_roller_obj_parts[i];
+        lv_draw_label_dsc_t dsc;
+        lv_draw_label_dsc_init(&dsc);
+        dsc.letter_space = lv_obj_get_style_text_letter_space(roller, part);
+        dsc.line_space = lv_obj_get_style_text_line_space(roller, part);
+        dsc.font = lv_obj_get_style_text_font(roller, part);
+        dsc.align = lv_obj_get_style_text_align(roller, part);
+#if LV_DRAW_COMPLEX
+        if (part != LV_PART_MAIN) {
+            dsc.blend_mode = lv_obj_get_style_blend_mode(roller, part);
+        }
+#endif
+#if LV_USE_BIDI
+        dsc.bidi_dir = lv_obj_get_style_base_dir(roller, LV_PART_MAIN);
+#endif
+        if (part == LV_PART_SELECTED) {
+            dsc.flag |= LV_TEXT_FLAG_EXPAND;
+        }
+        /* Both initialized by lv_draw_label_dsc_init(), padding included */
+        if (memcmp(&dsc, &roller_obj->dsc[i], sizeof(dsc)) != 0) {
+            memcpy(&roller_obj->dsc[i], &dsc, sizeof(dsc));
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+/* Render the bands once the roller is laid out again, a label sized anew renders them during the layout */
+static void lvgl_port_roller_obj_update(lv_obj_t *roller, lvgl_port_roller_obj_t *roller_obj)
+{
+    roller_obj->stale = true;
+    lv_obj_update_layout(roller);
+    if (roller_obj->stale) {
+        roller_obj->stale = false;
+        if (!lvgl_port_roller_obj_render(roller, roller_obj)) {
+            LV_LOG_WARN("Not enough memory for the text of the roller");
+        }
+    }
+}
+
+/* Fill the strips of a band in the clip area with the color, the text placed at pos */
+static void lvgl_port_roller_obj_band_draw(lv_draw_ctx_t *draw_ctx, const lvgl_port_roller_obj_band_t *band,
+        const lv_point_t *pos, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode, const lv_area_t *clip)
+{
+    const lv_area_t *clip_area_ori = draw_ctx->clip_area;
+    lv_area_t clip_area;
+    lv_area_t box;
+
+    if (!_lv_area_intersect(&clip_area, clip, clip_area_ori)) {
+        return;
+    }
+    draw_ctx->clip_area = &clip_area;
+    box.x1 = pos->x + band->x1;
+    box.x2 = pos->x + band->x2;
+    for (uint16_t i = 0; i < band->count; i++) {
+        const lvgl_port_roller_obj_strip_t *strip = &band->strips[i];
+        box.y1 = pos->y + strip->y1;
+        box.y2 = pos->y + strip->y2;
+        if (box.y1 > clip_area.y2) {
+            break;
+        }
+        lvgl_port_blend_mask(draw_ctx, &box, band->buf + strip->ofs, color, opa, blend_mode);
+    }
+    draw_ctx->clip_area = clip_area_ori;
+}
+
+/* Opacity of a text, as lv_obj_init_draw_label_dsc() would set it */
+static lv_opa_t lvgl_port_roller_obj_opa(lv_obj_t *roller, const lvgl_port_roller_obj_t *roller_obj, int i)
+{
+    const lv_opa_t opa = lv_obj_get_style_opa_recursive(roller, lvgl_port_roller_obj_parts[i]);
+    if (opa <= LV_OPA_MIN) {
+        return LV_OPA_TRANSP;
+    }
+    return (opa < LV_OPA_MAX) ? (opa * roller_obj->opa[i]) >> 8 : roller_obj->opa[i];
+}
+
+/* The texts where lv_roller draws them: the rows above and below the selected area, the selected text in it */
+static void lvgl_port_roller_obj_draw(lv_obj_t *roller, const lvgl_port_roller_obj_t *roller_obj, lv_draw_ctx_t *draw_ctx)
+{
+    const lv_obj_t *label = lv_obj_get_child(roller, 0);
+    const lv_draw_label_dsc_t *dsc = roller_obj->dsc;
+    lv_area_t clip;
+    lv_area_t part;
+    lv_point_t pos;
+
+    if (!_lv_area_intersect(&clip, draw_ctx->clip_area, &roller->coords)) {
+        return;
+    }
+
+    /* Selected area of get_sel_area() */
+    const lv_coord_t font_h = lv_font_get_line_height(dsc[LVGL_PORT_ROLLER_OBJ_ROWS].font);
+    const lv_coord_t sel_font_h = lv_font_get_line_height(dsc[LVGL_PORT_ROLLER_OBJ_SELECTED].font);
+    const lv_coord_t d = (sel_font_h + font_h) / 2 + dsc[LVGL_PORT_ROLLER_OBJ_ROWS].line_space;
+    const lv_coord_t roller_h = lv_obj_get_height(roller);
+    const lv_coord_t sel_y1 = roller->coords.y1 + roller_h / 2 - d / 2;
+    const lv_coord_t sel_y2 = sel_y1 + d;
+
+    lv_opa_t opa = lvgl_port_roller_obj_opa(roller, roller_obj, LVGL_PORT_ROLLER_OBJ_ROWS);
+    if (opa > LV_OPA_MIN && _lv_area_intersect(&part, &clip, &label->coords)) {
+        const lv_color_t color = lv_obj_get_style_text_color_filtered(roller, LV_PART_MAIN);
+        const lv_coord_t y2 = part.y2;
+        pos.x = label->coords.x1;
+        pos.y = label->coords.y1;
+        part.y2 = LV_MIN(y2, sel_y1);
+        if (part.y1 <= part.y2) {
+            lvgl_port_roller_obj_band_draw(draw_ctx, &roller_obj->band[LVGL_PORT_ROLLER_OBJ_ROWS], &pos, color, opa,
+                                           dsc[LVGL_PORT_ROLLER_OBJ_ROWS].blend_mode, &part);
+        }
+        part.y1 = LV_MAX(part.y1, sel_y2);
+        part.y2 = y2;
+        if (part.y1 <= part.y2) {
+            lvgl_port_roller_obj_band_draw(draw_ctx, &roller_obj->band[LVGL_PORT_ROLLER_OBJ_ROWS], &pos, color, opa,
+                                           dsc[LVGL_PORT_ROLLER_OBJ_ROWS].blend_mode, &part);
+        }
+    }
+
+    /* The selected text moves proportionally with the label, as in draw_main() of lv_roller */
+    opa = lvgl_port_roller_obj_opa(roller, roller_obj, LVGL_PORT_ROLLER_OBJ_SELECTED);
+    part.x1 = roller->coords.x1;
+    part.x2 = roller->coords.x2;
+    part.y1 = sel_y1;
+    part.y2 = sel_y2;
+    if (opa > LV_OPA_MIN && _lv_area_intersect(&part, &part, draw_ctx->clip_area)) {
+        const lv_coord_t corr = (dsc[LVGL_PORT_ROLLER_OBJ_SELECTED].font->line_height -
+                                 dsc[LVGL_PORT_ROLLER_OBJ_ROWS].font->line_height) / 2;
+        int32_t label_y_prop = label->coords.y1 - (roller_h / 2 + roller->coords.y1);
+        label_y_prop = (label_y_prop * 16384) / lv_obj_get_height(label);
+        pos.x = roller->coords.x1 + lv_obj_get_style_pad_left(roller, LV_PART_MAIN) +
+                lv_obj_get_style_border_width(roller, LV_PART_MAIN);
+        pos.y = roller_h / 2 + roller->coords.y1 + ((label_y_prop * (roller_obj->sel_h - corr)) >> 14) - corr;
+        lvgl_port_roller_obj_band_draw(draw_ctx, &roller_obj->band[LVGL_PORT_ROLLER_OBJ_SELECTED], &pos,
+                                       lv_obj_get_style_text_color_filtered(roller, LV_PART_SELECTED), opa,
+                                       dsc[LVGL_PORT_ROLLER_OBJ_SELECTED].blend_mode, &part);
+    }
+}
+
+static void lvgl_port_roller_obj_free(lvgl_port_roller_obj_t *roller_obj)
+{
+    for (int i = 0; i < LVGL_PORT_ROLLER_OBJ_BANDS; i++) {
+        lvgl_port_roller_obj_band_free(&roller_obj->band[i]);
+    }
+    free(roller_obj->text);
+    free(roller_obj);
+}
+
+static void lvgl_port_roller_obj_event_cb(lv_event_t *e)
+{
+    lvgl_port_roller_obj_t *roller_obj = lv_event_get_user_data(e);
+    lv_obj_t *obj = lv_event_get_current_target(e);
+    const lv_event_code_t code = lv_event_get_code(e);
+
+    const bool is_roller = lv_obj_check_type(obj, &lv_roller_class);
+    lv_obj_t *roller = is_roller ? obj : lv_obj_get_parent(obj);
+
+    /* Called for the label too, sized by its text. None of these is sent while drawing */
+    if (code == LV_EVENT_SIZE_CHANGED) {
+        roller_obj->stale = false;
+        if (!lvgl_port_roller_obj_render(roller, roller_obj)) {
+            LV_LOG_WARN("Not enough memory for the text of the roller");
+        }
+    } else if (code == LV_EVENT_REFR_EXT_DRAW_SIZE && !is_roller) {
+        /* Sent to the label by lv_roller_set_options(), also for options of the same size */
+        if (roller_obj->text == NULL || strcmp(roller_obj->text, lv_label_get_text(obj)) != 0) {
+            lvgl_port_roller_obj_update(roller, roller_obj);
+        }
+    } else if ((code == LV_EVENT_STYLE_CHANGED || code == LV_EVENT_REFR_EXT_DRAW_SIZE) && is_roller) {
+        /* Sent when a font or a spacing changes, of the rows or of the selected row */
+        if (lvgl_port_roller_obj_read_styles(obj, roller_obj)) {
+            lvgl_port_roller_obj_update(obj, roller_obj);
+        }
+    } else if (code == LV_EVENT_DRAW_POST && is_roller) {
+        lvgl_port_roller_obj_draw(obj, roller_obj, lv_event_get_draw_ctx(e));
+    } else if (code == LV_EVENT_DELETE && is_roller) {
+        lvgl_port_roller_obj_free(roller_obj);
+    }
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+bool lvgl_port_roller_obj_add_band(lv_obj_t *roller)
+{
+    if (!roller || !lv_obj_check_type(roller, &lv_roller_class)) {
+        return false;
+    }
+    lvgl_port_roller_obj_t *roller_obj = calloc(1, sizeof(lvgl_port_roller_obj_t));
+    if (roller_obj == NULL) {
+        return false;
+    }
+    lvgl_port_roller_obj_read_styles(roller, roller_obj);
+    for (int i = 0; i < LVGL_PORT_ROLLER_OBJ_BANDS; i++) {
+        roller_obj->opa[i] = lv_obj_get_style_text_opa(roller, lvgl_port_roller_obj_parts[i]);
+    }
+
+    lv_obj_update_layout(roller);
+    if (!lvgl_port_roller_obj_render(roller, roller_obj)) {
+        lvgl_port_roller_obj_free(roller_obj);
+        return false;
+    }
+
+    /* LVGL keeps laying out the texts and scrolling the label, but draws no letters */
+    for (int i = 0; i < LVGL_PORT_ROLLER_OBJ_BANDS; i++) {
+        lv_obj_set_style_text_opa(roller, LV_OPA_TRANSP, lvgl_port_roller_obj_parts[i]);
+    }
+    lv_obj_add_event_cb(roller, lvgl_port_roller_obj_event_cb, LV_EVENT_ALL, roller_obj);
+    lv_obj_add_event_cb(lv_obj_get_child(roller, 0), lvgl_port_roller_obj_event_cb, LV_EVENT_SIZE_CHANGED, roller_obj);
+    lv_obj_add_event_cb(lv_obj_get_child(roller, 0), lvgl_port_roller_obj_event_cb, LV_EVENT_REFR_EXT_DRAW_SIZE, roller_obj);
+    lv_obj_invalidate(roller);
+    return true;
+}
@@ -0,0 +1,182 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl_port_round.h"
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static uint32_t lvgl_port_round_isqrt(uint32_t n)
+{
+    uint32_t res = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > n) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (n >= res + bit) {
+            n -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return res;
+}
+
+/* Part of the row span inside of the area, false when there is none */
+static inline bool lvgl_port_round_span(const uint16_t *span_x1, const uint16_t *span_x2, int y, int x1, int x2, int *a, int *b)
+{
+    *a = (span_x1[y] > x1) ? span_x1[y] : x1;
+    *b = (span_x2[y] < x2) ? span_x2[y] : x2;
+    return (*a <= *b);
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+bool lvgl_port_round_init(lvgl_port_round_t *round, uint16_t hres, uint16_t vres, uint32_t trans_cost)
+{
+    if (round == NULL || hres == 0 || vres == 0) {
+        return false;
+    }
+
+    memset(round, 0, sizeof(lvgl_port_round_t));
+    round->span_x1 = malloc(vres * sizeof(uint16_t));
+    round->span_x2 = malloc(vres * sizeof(uint16_t));
+    if (round->span_x1 == NULL || round->span_x2 == NULL) {
+        lvgl_port_round_deinit(round);
+        return false;
+    }
+    round->hres = hres;
+    round->vres = vres;
+    round->trans_cost = trans_cost;
+
+    /* Coordinates are doubled, so the pixel centers and the circle center are integers */
+    const int32_t diameter = (hres < vres) ? hres : vres;
+    for (int y = 0; y < vres; y++) {
+        const int32_t dy = 2 * y + 1 - vres;
+        if (dy * dy > diameter * diameter) {
+            round->span_x1[y] = 1;
+            round->span_x2[y] = 0;
+            continue;
+        }
+        /* |2x + 1 - hres| <= m */
+        const int32_t m = lvgl_port_round_isqrt(diameter * diameter - dy * dy);
+        round->span_x1[y] = (hres - m) / 2;
+        round->span_x2[y] = (hres + m - 1) / 2;
+    }
+
+    return true;
+}
+
+void lvgl_port_round_deinit(lvgl_port_round_t *round)
+{
+    if (round == NULL) {
+        return;
+    }
+
+    free(round->span_x1);
+    free(round->span_x2);
+    round->span_x1 = NULL;
+    round->span_x2 = NULL;
+}
+
+void lvgl_port_round_clip(const lvgl_port_round_t *round, int *x1, int y1, int *x2, int y2)
+{
+    int min_x = *x2 + 1;
+    int max_x = *x1 - 1;
+    int a, b;
+
+    for (int y = y1; y <= y2; y++) {
+        if (lvgl_port_round_span(round->span_x1, round->span_x2, y, *x1, *x2, &a, &b)) {
+            min_x = (a < min_x) ? a : min_x;
+            max_x = (b > max_x) ? b : max_x;
+        }
+    }
+
+    if (min_x <= max_x) {
+        *x1 = min_x;
+        *x2 = max_x;
+    } else {
+        *x2 = *x1;
+    }
+}
+
+void lvgl_port_round_flush(const lvgl_port_round_t *round, int x1, int y1, int x2, int y2, void *pixels, size_t px_size,
+                           lvgl_port_round_send_cb_t send_cb, void *user_ctx, lvgl_port_round_result_t *result)
+{
+    lvgl_port_round_flush_spans(round->span_x1, round->span_x2, round->trans_cost, x1, y1, x2, y2, pixels, px_size,
+                                send_cb, user_ctx, result);
+}
+
+void lvgl_port_round_flush_spans(const uint16_t *span_x1, const uint16_t *span_x2, uint32_t trans_cost,
+                                 int x1, int y1, int x2, int y2, void *pixels, size_t px_size,
+                                 lvgl_port_round_send_cb_t send_cb, void *user_ctx, lvgl_port_round_result_t *result)
+{
+    const int w = x2 - x1 + 1;
+    uint8_t *src = pixels;
+    uint8_t *dst = pixels;
+    uint32_t trans_count = 0;
+    uint32_t sent = 0;
+    int a, b;
+
+    int y = y1;
+    while (y <= y2) {
+        if (!lvgl_port_round_span(span_x1, span_x2, y, x1, x2, &a, &b)) {
+            y++;
+            continue;
+        }
+
+        /* Grow the window down while the added invisible pixels are cheaper than a new transaction */
+        int win_x1 = a;
+        int win_x2 = b;
+        const int win_y1 = y;
+        uint32_t rows = 1;
+        uint32_t visible = b - a + 1;
+        for (y++; y <= y2 && lvgl_port_round_span(span_x1, span_x2, y, x1, x2, &a, &b); y++) {
+            const int nx1 = (a < win_x1) ? a : win_x1;
+            const int nx2 = (b > win_x2) ? b : win_x2;
+            const uint32_t waste = (uint32_t)(win_x2 - win_x1 + 1) * rows - visible;
+            const uint32_t new_waste = (uint32_t)(nx2 - nx1 + 1) * (rows + 1) - (visible + (b - a + 1));
+            if ((new_waste - waste) * px_size > trans_cost) {
+                break;
+            }
+            win_x1 = nx1;
+            win_x2 = nx2;
+            visible += b - a + 1;
+            rows++;
+        }
+
+        /* Compact the window, destination never overtakes the source */
+        const size_t line_bytes = (win_x2 - win_x1 + 1) * px_size;
+        uint8_t *data = dst;
+        for (uint32_t r = 0; r < rows; r++) {
+            const uint8_t *line = src + ((size_t)(win_y1 + r - y1) * w + (win_x1 - x1)) * px_size;
+            if (line != dst) {
+                memmove(dst, line, line_bytes);
+            }
+            dst += line_bytes;
+        }
+
+        send_cb(user_ctx, win_x1, win_y1, win_x2, win_y1 + rows - 1, data);
+        trans_count++;
+        sent += line_bytes * rows;
+    }
+
+    if (result) {
+        result->trans_count = trans_count;
+        result->bytes_sent = sent;
+        result->bytes_saved = (uint32_t)w * (y2 - y1 + 1) * px_size - sent;
+    }
+}
@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "lvgl.h"
+#include "lvgl_port_scroll_obj.h"
+
+typedef struct {
+    lv_obj_t obj;
+    const void *src;
+    lv_img_header_t header;                 /* Of the texture */
+    lv_coord_t offset;                      /* Shown column at the left, 0 to the width - 1 */
+} lvgl_port_scroll_obj_t;
+
+static void lvgl_port_scroll_obj_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj);
+static void lvgl_port_scroll_obj_event(const lv_obj_class_t *class_p, lv_event_t *e);
+
+static const lv_obj_class_t lvgl_port_scroll_obj_class = {
+    .base_class = &lv_obj_class,
+    .constructor_cb = lvgl_port_scroll_obj_constructor,
+    .event_cb = lvgl_port_scroll_obj_event,
+    .instance_size = sizeof(lvgl_port_scroll_obj_t),
+};
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static lvgl_port_scroll_obj_t *lvgl_port_scroll_obj_of(const lv_obj_t *obj)
+{
+    if (!obj || !lv_obj_check_type(obj, &lvgl_port_scroll_obj_class)) {
+        return NULL;
+    }
+    return (lvgl_port_scroll_obj_t *)obj;
+}
+
+static void lvgl_port_scroll_obj_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj)
+{
+    LV_UNUSED(class_p);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+}
+
+/* Covers its box like lv_img does: opaque pixels, drawn as they are, down to the bottom */
+static void lvgl_port_scroll_obj_cover_check(lv_event_t *e)
+{
+    const lv_obj_t *obj = lv_event_get_target(e);
+    const lvgl_port_scroll_obj_t *scroll_obj = (const lvgl_port_scroll_obj_t *)obj;
+    lv_cover_check_info_t *info = lv_event_get_param(e);
+
+    if (info->res == LV_COVER_RES_MASKED) {
+        return;
+    }
+    if (scroll_obj->header.cf != LV_IMG_CF_TRUE_COLOR && scroll_obj->header.cf != LV_IMG_CF_RAW) {
+        info->res = LV_COVER_RES_NOT_COVER;
+        return;
+    }
+    if (lv_obj_get_style_img_opa(obj, LV_PART_MAIN) != LV_OPA_COVER ||
+            scroll_obj->header.h < lv_obj_get_height(obj) ||
+            !_lv_area_is_in(info->area, &obj->coords, 0)) {
+        info->res = LV_COVER_RES_NOT_COVER;
+        return;
+    }
+    info->res = LV_COVER_RES_COVER;
+}
+
+/* Copies of the texture side by side, the first one placed so that the shown column lies on the left */
+static void lvgl_port_scroll_obj_draw(lv_event_t *e)
+{
+    lv_obj_t *obj = lv_event_get_target(e);
+    const lvgl_port_scroll_obj_t *scroll_obj = (const lvgl_port_scroll_obj_t *)obj;
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+    const lv_area_t *clip_area_ori = draw_ctx->clip_area;
+    lv_draw_img_dsc_t dsc;
+    lv_area_t clip;
+
+    lv_draw_img_dsc_init(&dsc);
+    lv_obj_init_draw_img_dsc(obj, LV_PART_MAIN, &dsc);
+    if (dsc.opa <= LV_OPA_MIN || !_lv_area_intersect(&clip, &obj->coords, clip_area_ori)) {
+        return;
+    }
+
+    const lv_coord_t w = scroll_obj->header.w;
+    lv_area_t tile;
+    tile.y1 = obj->coords.y1;
+    tile.y2 = tile.y1 + scroll_obj->header.h - 1;
+    tile.x1 = obj->coords.x1 - scroll_obj->offset;
+    tile.x1 += (clip.x1 - tile.x1) / w * w;
+    draw_ctx->clip_area = &clip;
+    for (; tile.x1 <= clip.x2; tile.x1 += w) {
+        tile.x2 = tile.x1 + w - 1;
+        lv_draw_img(draw_ctx, &dsc, &tile, scroll_obj->src);
+    }
+    draw_ctx->clip_area = clip_area_ori;
+}
+
+static void lvgl_port_scroll_obj_event(const lv_obj_class_t *class_p, lv_event_t *e)
+{
+    LV_UNUSED(class_p);
+
+    if (lv_obj_event_base(&lvgl_port_scroll_obj_class, e) != LV_RES_OK) {
+        return;
+    }
+    const lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_COVER_CHECK) {
+        lvgl_port_scroll_obj_cover_check(e);
+    } else if (code == LV_EVENT_DRAW_MAIN) {
+        lvgl_port_scroll_obj_draw(e);
+    }
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+lv_obj_t *lvgl_port_scroll_obj_create(lv_obj_t *parent, const void *src)
+{
+    lv_img_header_t header;
+
+    if (lv_img_decoder_get_info(src, &header) != LV_RES_OK || header.w == 0 || header.h == 0) {
+        return NULL;
+    }
+    lv_obj_t *obj = lv_obj_class_create_obj(&lvgl_port_scroll_obj_class, parent);
+    lv_obj_class_init_obj(obj);
+
+    lvgl_port_scroll_obj_t *scroll_obj = (lvgl_port_scroll_obj_t *)obj;
+    scroll_obj->src = src;
+    scroll_obj->header = header;
+    scroll_obj->offset = 0;
+    lv_obj_set_size(obj, header.w, header.h);
+
+    return obj;
+}
+
+bool lvgl_port_scroll_obj_set_offset(lv_obj_t *obj, lv_coord_t x)
+{
+    lvgl_port_scroll_obj_t *scroll_obj = lvgl_port_scroll_obj_of(obj);
+    if (!scroll_obj) {
+        return false;
+    }
+    const lv_coord_t w = scroll_obj->header.w;
+    const lv_coord_t offset = ((x % w) + w) % w;
+    if (offset != scroll_obj->offset) {
+        scroll_obj->offset = offset;
+        lv_obj_invalidate(obj);
+    }
+    return true;
+}
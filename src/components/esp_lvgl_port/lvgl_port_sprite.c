@@ -0,0 +1,193 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "lvgl_port_sprite.h"
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static inline bool lvgl_port_sprite_area_empty(const lvgl_port_sprite_area_t *a)
+{
+    return a->x2 < a->x1 || a->y2 < a->y1;
+}
+
+static inline bool lvgl_port_sprite_area_in(const lvgl_port_sprite_area_t *in, const lvgl_port_sprite_area_t *a)
+{
+    return a->x1 >= in->x1 && a->y1 >= in->y1 && a->x2 <= in->x2 && a->y2 <= in->y2;
+}
+
+/* The cell lies inside of the atlas and the frame */
+static bool lvgl_port_sprite_cell_check(const lvgl_port_sprite_t *sprite, const lvgl_port_sprite_cell_t *cell)
+{
+    const lvgl_port_sprite_area_t frame = {0, 0, sprite->w - 1, sprite->h - 1};
+    const lvgl_port_sprite_area_t *a = &cell->area;
+
+    if (lvgl_port_sprite_area_empty(a)) {
+        return true;
+    }
+    return lvgl_port_sprite_area_in(&frame, a) &&
+           cell->atlas_x + (a->x2 - a->x1) < sprite->atlas_w && cell->atlas_y + (a->y2 - a->y1) < sprite->atlas_h;
+}
+
+/* Part of a cell, the atlas position follows the area */
+static void lvgl_port_sprite_cell_part(const lvgl_port_sprite_cell_t *cell, int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+                                       lvgl_port_sprite_cell_t *part)
+{
+    part->atlas_x = cell->atlas_x + (x1 - cell->area.x1);
+    part->atlas_y = cell->atlas_y + (y1 - cell->area.y1);
+    part->area.x1 = x1;
+    part->area.y1 = y1;
+    part->area.x2 = x2;
+    part->area.y2 = y2;
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+bool lvgl_port_sprite_check(const lvgl_port_sprite_t *sprite)
+{
+    if (!sprite || !sprite->atlas || !sprite->frames || sprite->frame_count == 0 || sprite->w == 0 || sprite->h == 0) {
+        return false;
+    }
+    if (!lvgl_port_sprite_cell_check(sprite, &sprite->key) || !lvgl_port_sprite_area_empty(&sprite->frames[0].patch.area)) {
+        return false;
+    }
+    for (uint8_t i = 1; i < sprite->frame_count; i++) {
+        if (!lvgl_port_sprite_cell_check(sprite, &sprite->frames[i].patch)) {
+            return false;
+        }
+    }
+    for (uint8_t i = 0; i < sprite->anim_count; i++) {
+        const lvgl_port_sprite_anim_t *anim = &sprite->anims[i];
+        if (!anim->keys || anim->key_count == 0) {
+            return false;
+        }
+        for (uint8_t k = 0; k < anim->key_count; k++) {
+            if (anim->keys[k].frame >= sprite->frame_count) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int lvgl_port_sprite_find_frame(const lvgl_port_sprite_t *sprite, const char *name)
+{
+    for (uint8_t i = 0; name && i < sprite->frame_count; i++) {
+        if (sprite->frames[i].name && strcmp(sprite->frames[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const lvgl_port_sprite_anim_t *lvgl_port_sprite_find_anim(const lvgl_port_sprite_t *sprite, const char *name)
+{
+    for (uint8_t i = 0; name && i < sprite->anim_count; i++) {
+        if (sprite->anims[i].name && strcmp(sprite->anims[i].name, name) == 0) {
+            return &sprite->anims[i];
+        }
+    }
+    return NULL;
+}
+
+uint32_t lvgl_port_sprite_anim_time(const lvgl_port_sprite_anim_t *anim)
+{
+    const uint8_t count = anim->loop ? anim->key_count : anim->key_count - 1;
+    uint32_t time = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        time += anim->keys[i].time;
+    }
+    return time;
+}
+
+uint8_t lvgl_port_sprite_anim_frame(const lvgl_port_sprite_anim_t *anim, uint32_t t)
+{
+    const uint32_t time = lvgl_port_sprite_anim_time(anim);
+
+    if (anim->loop && time > 0) {
+        t %= time;
+    }
+    for (uint8_t i = 0; i + 1 < anim->key_count; i++) {
+        if (t < anim->keys[i].time) {
+            return anim->keys[i].frame;
+        }
+        t -= anim->keys[i].time;
+    }
+    return anim->keys[anim->key_count - 1].frame;
+}
+
+size_t lvgl_port_sprite_parts(const lvgl_port_sprite_t *sprite, uint8_t frame, lvgl_port_sprite_cell_t parts[5])
+{
+    const lvgl_port_sprite_cell_t *key = &sprite->key;
+    const lvgl_port_sprite_area_t *k = &key->area;
+    size_t count = 0;
+
+    if (frame >= sprite->frame_count || lvgl_port_sprite_area_empty(&sprite->frames[frame].patch.area)) {
+        if (!lvgl_port_sprite_area_empty(k)) {
+            parts[count++] = *key;
+        }
+        return count;
+    }
+
+    const lvgl_port_sprite_cell_t *patch = &sprite->frames[frame].patch;
+    const lvgl_port_sprite_area_t i = {
+        .x1 = k->x1 > patch->area.x1 ? k->x1 : patch->area.x1,
+        .y1 = k->y1 > patch->area.y1 ? k->y1 : patch->area.y1,
+        .x2 = k->x2 < patch->area.x2 ? k->x2 : patch->area.x2,
+        .y2 = k->y2 < patch->area.y2 ? k->y2 : patch->area.y2,
+    };
+    if (lvgl_port_sprite_area_empty(&i)) {
+        if (!lvgl_port_sprite_area_empty(k)) {
+            parts[count++] = *key;
+        }
+    } else {
+        /* Bands of the key frame above and below the patch, then left and right of it */
+        if (i.y1 > k->y1) {
+            lvgl_port_sprite_cell_part(key, k->x1, k->y1, k->x2, i.y1 - 1, &parts[count++]);
+        }
+        if (i.y2 < k->y2) {
+            lvgl_port_sprite_cell_part(key, k->x1, i.y2 + 1, k->x2, k->y2, &parts[count++]);
+        }
+        if (i.x1 > k->x1) {
+            lvgl_port_sprite_cell_part(key, k->x1, i.y1, i.x1 - 1, i.y2, &parts[count++]);
+        }
+        if (i.x2 < k->x2) {
+            lvgl_port_sprite_cell_part(key, i.x2 + 1, i.y1, k->x2, i.y2, &parts[count++]);
+        }
+    }
+    parts[count++] = *patch;
+    return count;
+}
+
+size_t lvgl_port_sprite_changed(const lvgl_port_sprite_t *sprite, uint8_t from, uint8_t to, lvgl_port_sprite_area_t areas[2])
+{
+    static const lvgl_port_sprite_area_t none = {0, 0, -1, -1};
+    const lvgl_port_sprite_area_t *a = from < sprite->frame_count ? &sprite->frames[from].patch.area : &none;
+    const lvgl_port_sprite_area_t *b = to < sprite->frame_count ? &sprite->frames[to].patch.area : &none;
+    const bool a_empty = lvgl_port_sprite_area_empty(a);
+    const bool b_empty = lvgl_port_sprite_area_empty(b);
+
+    /* Both frames equal the key frame outside of their patches */
+    if (from == to || (a_empty && b_empty)) {
+        return 0;
+    }
+    if (b_empty || (!a_empty && lvgl_port_sprite_area_in(a, b))) {
+        areas[0] = *a;
+        return 1;
+    }
+    if (a_empty || lvgl_port_sprite_area_in(b, a)) {
+        areas[0] = *b;
+        return 1;
+    }
+    areas[0] = *a;
+    areas[1] = *b;
+    return 2;
+}
@@ -0,0 +1,218 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "lvgl.h"
+#include "lvgl_port_sprite.h"
+#include "lvgl_port_sprite_obj.h"
+
+typedef struct {
+    lv_obj_t obj;
+    const lvgl_port_sprite_t *sprite;
+    const lvgl_port_sprite_anim_t *anim;    /* Played animation, NULL when stopped */
+    uint8_t frame;                          /* Shown frame */
+} lvgl_port_sprite_obj_t;
+
+static void lvgl_port_sprite_obj_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj);
+static void lvgl_port_sprite_obj_destructor(const lv_obj_class_t *class_p, lv_obj_t *obj);
+static void lvgl_port_sprite_obj_event(const lv_obj_class_t *class_p, lv_event_t *e);
+static void lvgl_port_sprite_obj_anim_cb(void *var, int32_t v);
+
+static const lv_obj_class_t lvgl_port_sprite_obj_class = {
+    .base_class = &lv_obj_class,
+    .constructor_cb = lvgl_port_sprite_obj_constructor,
+    .destructor_cb = lvgl_port_sprite_obj_destructor,
+    .event_cb = lvgl_port_sprite_obj_event,
+    .instance_size = sizeof(lvgl_port_sprite_obj_t),
+};
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static lvgl_port_sprite_obj_t *lvgl_port_sprite_obj_of(const lv_obj_t *obj)
+{
+    if (!obj || !lv_obj_check_type(obj, &lvgl_port_sprite_obj_class)) {
+        return NULL;
+    }
+    return (lvgl_port_sprite_obj_t *)obj;
+}
+
+static void lvgl_port_sprite_obj_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj)
+{
+    LV_UNUSED(class_p);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+}
+
+static void lvgl_port_sprite_obj_destructor(const lv_obj_class_t *class_p, lv_obj_t *obj)
+{
+    LV_UNUSED(class_p);
+    lv_anim_del(obj, lvgl_port_sprite_obj_anim_cb);
+}
+
+static void lvgl_port_sprite_obj_show(lvgl_port_sprite_obj_t *sprite_obj, uint8_t frame)
+{
+    lv_obj_t *obj = &sprite_obj->obj;
+    lvgl_port_sprite_area_t changed[2];
+
+    if (frame == sprite_obj->frame) {
+        return;
+    }
+    const size_t count = lvgl_port_sprite_changed(sprite_obj->sprite, sprite_obj->frame, frame, changed);
+    for (size_t i = 0; i < count; i++) {
+        const lv_area_t area = {
+            .x1 = obj->coords.x1 + changed[i].x1,
+            .y1 = obj->coords.y1 + changed[i].y1,
+            .x2 = obj->coords.x1 + changed[i].x2,
+            .y2 = obj->coords.y1 + changed[i].y2,
+        };
+        lv_obj_invalidate_area(obj, &area);
+    }
+    sprite_obj->frame = frame;
+    lv_event_send(obj, LV_EVENT_VALUE_CHANGED, NULL);
+}
+
+static void lvgl_port_sprite_obj_anim_cb(void *var, int32_t v)
+{
+    lvgl_port_sprite_obj_t *sprite_obj = var;
+
+    if (sprite_obj->anim) {
+        lvgl_port_sprite_obj_show(sprite_obj, lvgl_port_sprite_anim_frame(sprite_obj->anim, v));
+    }
+}
+
+static void lvgl_port_sprite_obj_stop(lvgl_port_sprite_obj_t *sprite_obj)
+{
+    lv_anim_del(sprite_obj, lvgl_port_sprite_obj_anim_cb);
+    sprite_obj->anim = NULL;
+}
+
+/* Each part of the frame is drawn from the atlas placed so, that the part lies on its area, clipped to it */
+static void lvgl_port_sprite_obj_draw(lv_event_t *e)
+{
+    lv_obj_t *obj = lv_event_get_target(e);
+    const lvgl_port_sprite_obj_t *sprite_obj = (const lvgl_port_sprite_obj_t *)obj;
+    const lvgl_port_sprite_t *sprite = sprite_obj->sprite;
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+    const lv_area_t *clip_area_ori = draw_ctx->clip_area;
+    lvgl_port_sprite_cell_t parts[5];
+    lv_draw_img_dsc_t dsc;
+
+    lv_draw_img_dsc_init(&dsc);
+    lv_obj_init_draw_img_dsc(obj, LV_PART_MAIN, &dsc);
+    if (dsc.opa <= LV_OPA_MIN) {
+        return;
+    }
+
+    const size_t count = lvgl_port_sprite_parts(sprite, sprite_obj->frame, parts);
+    for (size_t i = 0; i < count; i++) {
+        const lv_area_t area = {
+            .x1 = obj->coords.x1 + parts[i].area.x1,
+            .y1 = obj->coords.y1 + parts[i].area.y1,
+            .x2 = obj->coords.x1 + parts[i].area.x2,
+            .y2 = obj->coords.y1 + parts[i].area.y2,
+        };
+        lv_area_t clip;
+        if (!_lv_area_intersect(&clip, &area, clip_area_ori)) {
+            continue;
+        }
+        lv_area_t atlas;
+        atlas.x1 = area.x1 - parts[i].atlas_x;
+        atlas.y1 = area.y1 - parts[i].atlas_y;
+        atlas.x2 = atlas.x1 + sprite->atlas_w - 1;
+        atlas.y2 = atlas.y1 + sprite->atlas_h - 1;
+
+        draw_ctx->clip_area = &clip;
+        lv_draw_img(draw_ctx, &dsc, &atlas, sprite->atlas);
+    }
+    draw_ctx->clip_area = clip_area_ori;
+}
+
+static void lvgl_port_sprite_obj_event(const lv_obj_class_t *class_p, lv_event_t *e)
+{
+    LV_UNUSED(class_p);
+
+    if (lv_obj_event_base(&lvgl_port_sprite_obj_class, e) != LV_RES_OK) {
+        return;
+    }
+    if (lv_event_get_code(e) == LV_EVENT_DRAW_MAIN) {
+        lvgl_port_sprite_obj_draw(e);
+    }
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+lv_obj_t *lvgl_port_sprite_obj_create(lv_obj_t *parent, const lvgl_port_sprite_t *sprite)
+{
+    if (!lvgl_port_sprite_check(sprite)) {
+        return NULL;
+    }
+    lv_obj_t *obj = lv_obj_class_create_obj(&lvgl_port_sprite_obj_class, parent);
+    lv_obj_class_init_obj(obj);
+
+    lvgl_port_sprite_obj_t *sprite_obj = (lvgl_port_sprite_obj_t *)obj;
+    sprite_obj->sprite = sprite;
+    sprite_obj->anim = NULL;
+    sprite_obj->frame = 0;
+    lv_obj_set_size(obj, sprite->w, sprite->h);
+
+    return obj;
+}
+
+bool lvgl_port_sprite_obj_play(lv_obj_t *obj, const char *anim)
+{
+    lvgl_port_sprite_obj_t *sprite_obj = lvgl_port_sprite_obj_of(obj);
+    if (!sprite_obj) {
+        return false;
+    }
+    const lvgl_port_sprite_anim_t *found = lvgl_port_sprite_find_anim(sprite_obj->sprite, anim);
+    if (!found) {
+        return false;
+    }
+
+    lvgl_port_sprite_obj_stop(sprite_obj);
+    sprite_obj->anim = found;
+    lvgl_port_sprite_obj_show(sprite_obj, lvgl_port_sprite_anim_frame(found, 0));
+
+    const uint32_t time = lvgl_port_sprite_anim_time(found);
+    if (time > 0) {
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, sprite_obj);
+        lv_anim_set_exec_cb(&a, lvgl_port_sprite_obj_anim_cb);
+        lv_anim_set_values(&a, 0, time);
+        lv_anim_set_time(&a, time);
+        if (found->loop) {
+            lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+        }
+        lv_anim_start(&a);
+    }
+    return true;
+}
+
+bool lvgl_port_sprite_obj_set_frame(lv_obj_t *obj, const char *frame)
+{
+    lvgl_port_sprite_obj_t *sprite_obj = lvgl_port_sprite_obj_of(obj);
+    if (!sprite_obj) {
+        return false;
+    }
+    const int index = lvgl_port_sprite_find_frame(sprite_obj->sprite, frame);
+    if (index < 0) {
+        return false;
+    }
+
+    lvgl_port_sprite_obj_stop(sprite_obj);
+    lvgl_port_sprite_obj_show(sprite_obj, index);
+    return true;
+}
+
+const char *lvgl_port_sprite_obj_get_frame(const lv_obj_t *obj)
+{
+    const lvgl_port_sprite_obj_t *sprite_obj = lvgl_port_sprite_obj_of(obj);
+
+    return sprite_obj ? sprite_obj->sprite->frames[sprite_obj->frame].name : NULL;
+}
@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "lvgl_port_stats.h"
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* Insertion sort, the window is small */
+static void lvgl_port_stats_sort(uint32_t *values, size_t count)
+{
+    for (size_t i = 1; i < count; i++) {
+        const uint32_t v = values[i];
+        size_t j = i;
+        while (j > 0 && values[j - 1] > v) {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = v;
+    }
+}
+
+static inline uint32_t lvgl_port_stats_rank(const uint32_t *sorted, size_t count, uint32_t percent)
+{
+    const size_t rank = (count * percent + 99) / 100;
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void lvgl_port_stats_init(lvgl_port_stats_t *stats)
+{
+    memset(stats, 0, sizeof(lvgl_port_stats_t));
+}
+
+void lvgl_port_stats_add(lvgl_port_stats_t *stats, const lvgl_port_stats_sample_t *sample)
+{
+    for (int m = 0; m < LVGL_PORT_STATS_METRICS; m++) {
+        stats->ring[m][stats->head] = sample->value[m];
+    }
+    stats->head = (stats->head + 1) % LVGL_PORT_STATS_WINDOW;
+    if (stats->count < LVGL_PORT_STATS_WINDOW) {
+        stats->count++;
+    }
+    stats->frames++;
+}
+
+size_t lvgl_port_stats_copy(const lvgl_port_stats_t *stats, lvgl_port_stats_metric_t metric, uint32_t *values)
+{
+    memcpy(values, stats->ring[metric], stats->count * sizeof(uint32_t));
+    return stats->count;
+}
+
+void lvgl_port_stats_percentiles(uint32_t *values, size_t count, lvgl_port_stats_pct_t *pct)
+{
+    if (count == 0) {
+        memset(pct, 0, sizeof(lvgl_port_stats_pct_t));
+        return;
+    }
+
+    lvgl_port_stats_sort(values, count);
+    pct->p50 = lvgl_port_stats_rank(values, count, 50);
+    pct->p95 = lvgl_port_stats_rank(values, count, 95);
+    pct->p99 = lvgl_port_stats_rank(values, count, 99);
+    pct->max = values[count - 1];
+}
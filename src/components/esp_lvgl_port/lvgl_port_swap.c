@@ -0,0 +1,55 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "lvgl_port_swap.h"
+
+/* Draw buffers are accessed as pixels by LVGL */
+typedef uint16_t __attribute__((__may_alias__)) lvgl_port_px_t;
+typedef uint32_t __attribute__((__may_alias__)) lvgl_port_word_t;
+
+static inline uint32_t lvgl_port_swap_word(uint32_t w)
+{
+    return ((w & 0xFF00FF00) >> 8) | ((w & 0x00FF00FF) << 8);
+}
+
+void lvgl_port_swap_rgb565(void *pixels, size_t count)
+{
+    lvgl_port_px_t *px = (lvgl_port_px_t *)pixels;
+
+    /* Head pixel up to the word alignment */
+    if (count > 0 && ((uintptr_t)px & 0x3) != 0) {
+        *px = (uint16_t)((*px >> 8) | (*px << 8));
+        px++;
+        count--;
+    }
+
+    /* Eight pixels per iteration, loads and stores of the words are independent */
+    lvgl_port_word_t *words = (lvgl_port_word_t *)px;
+    size_t n = count / 2;
+    while (n >= 4) {
+        const uint32_t w0 = words[0];
+        const uint32_t w1 = words[1];
+        const uint32_t w2 = words[2];
+        const uint32_t w3 = words[3];
+        words[0] = lvgl_port_swap_word(w0);
+        words[1] = lvgl_port_swap_word(w1);
+        words[2] = lvgl_port_swap_word(w2);
+        words[3] = lvgl_port_swap_word(w3);
+        words += 4;
+        n -= 4;
+    }
+    while (n > 0) {
+        *words = lvgl_port_swap_word(*words);
+        words++;
+        n--;
+    }
+
+    /* Tail pixel */
+    if (count & 1) {
+        px = (lvgl_port_px_t *)words;
+        *px = (uint16_t)((*px >> 8) | (*px << 8));
+    }
+}
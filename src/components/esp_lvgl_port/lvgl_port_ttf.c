@@ -0,0 +1,230 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "lvgl.h"
+#include "lvgl_port_assets.h"
+#include "lvgl_port_cache.h"
+#include "lvgl_port_img.h"
+#include "lvgl_port_ttf.h"
+
+/* stb_truetype of LVGL's tiny_ttf, private to this file. Its scratch memory comes from the heap (the
+ * LVGL pool is small), in chunks sized for glyphs of a small display, like tiny_ttf does. */
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#define STBTT_HEAP_FACTOR_SIZE_32 50
+#define STBTT_HEAP_FACTOR_SIZE_128 20
+#define STBTT_HEAP_FACTOR_SIZE_DEFAULT 10
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+#include "src/extra/libs/tiny_ttf/stb_truetype_htcw.h"
+#pragma GCC diagnostic pop
+
+typedef struct lvgl_port_ttf_font {
+    lv_font_t font;                     /* Drawn by LVGL, dsc points back here */
+    stbtt_fontinfo info;                /* Family, read from the mapped table */
+    uint32_t family;                    /* Hash of the family name */
+    uint16_t px;                        /* Size of the em square */
+    float scale;                        /* Font units to pixels */
+    struct lvgl_port_ttf_font *next;
+} lvgl_port_ttf_font_t;
+
+/* Accessed by the LVGL task only */
+static struct {
+    lvgl_port_cache_t cache;            /* Glyphs of all fonts */
+    lvgl_port_ttf_font_t *fonts;
+    uint8_t *scratch;                   /* Glyph not fitting the cache */
+    size_t scratch_size;
+} lvgl_port_ttf;
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static bool lvgl_port_ttf_get_glyph_dsc(const lv_font_t *font, lv_font_glyph_dsc_t *dsc, uint32_t letter, uint32_t letter_next)
+{
+    const lvgl_port_ttf_font_t *ttf = font->dsc;
+    int adv, lsb, x1, y1, x2, y2;
+
+    memset(dsc, 0, sizeof(*dsc));
+    /* Control characters, LV_SYMBOL_DUMMY and the zero width non-joiner take no space */
+    if (letter < 0x20 || letter == 0xF8FF || letter == 0x200C) {
+        return true;
+    }
+    const int glyph = stbtt_FindGlyphIndex(&ttf->info, letter);
+    if (glyph == 0) {
+        return false;
+    }
+
+    /* Fonts of scripts/lvgl_port_ttf.py have their kerning in a kern table */
+    stbtt_GetGlyphHMetrics(&ttf->info, glyph, &adv, &lsb);
+    if (letter_next && ttf->info.kern) {
+        adv += stbtt_GetGlyphKernAdvance(&ttf->info, glyph, stbtt_FindGlyphIndex(&ttf->info, letter_next));
+    }
+    stbtt_GetGlyphBitmapBox(&ttf->info, glyph, ttf->scale, ttf->scale, &x1, &y1, &x2, &y2);
+    dsc->adv_w = (uint16_t)lroundf(adv * ttf->scale);
+    dsc->box_w = x2 - x1;
+    dsc->box_h = y2 - y1;
+    dsc->ofs_x = x1;
+    dsc->ofs_y = -y2;
+    dsc->bpp = 8;
+    return true;
+}
+
+static const uint8_t *lvgl_port_ttf_get_glyph_bitmap(const lv_font_t *font, uint32_t letter)
+{
+    const lvgl_port_ttf_font_t *ttf = font->dsc;
+    lvgl_port_cache_key_t key;
+    int x1, y1, x2, y2;
+    uint8_t *bitmap;
+
+    memset(&key, 0, sizeof(key));
+    key.src = font;
+    key.frame_id = letter;
+    lvgl_port_cache_entry_t *entry = lvgl_port_cache_find(&lvgl_port_ttf.cache, &key);
+    if (entry) {
+        return entry->data;
+    }
+
+    const int glyph = stbtt_FindGlyphIndex(&ttf->info, letter);
+    if (glyph == 0) {
+        return NULL;
+    }
+    stbtt_GetGlyphBitmapBox(&ttf->info, glyph, ttf->scale, ttf->scale, &x1, &y1, &x2, &y2);
+    const size_t size = (size_t)(x2 - x1) * (y2 - y1);
+    if (size == 0) {
+        return NULL;
+    }
+    entry = lvgl_port_cache_add(&lvgl_port_ttf.cache, &key, size);
+    if (entry) {
+        entry->w = x2 - x1;
+        entry->h = y2 - y1;
+        bitmap = entry->data;
+    } else {
+        if (size > lvgl_port_ttf.scratch_size) {
+            uint8_t *scratch = realloc(lvgl_port_ttf.scratch, size);
+            if (scratch == NULL) {
+                return NULL;
+            }
+            lvgl_port_ttf.scratch = scratch;
+            lvgl_port_ttf.scratch_size = size;
+        }
+        bitmap = lvgl_port_ttf.scratch;
+    }
+
+    /* Left empty when the rasterizer runs out of memory */
+    memset(bitmap, 0, size);
+    stbtt_MakeGlyphBitmap(&ttf->info, bitmap, x2 - x1, y2 - y1, x2 - x1, ttf->scale, ttf->scale, glyph);
+    return bitmap;
+}
+
+/* Line height where any text fits, from the bounds of the glyphs (subset ones have them in head) */
+static void lvgl_port_ttf_set_metrics(lvgl_port_ttf_font_t *ttf)
+{
+    const stbtt_fontinfo *info = &ttf->info;
+    lv_font_t *font = &ttf->font;
+    int x0, y0, x1, y1;
+
+    ttf->scale = stbtt_ScaleForMappingEmToPixels(info, ttf->px);
+    stbtt_GetFontBoundingBox(info, &x0, &y0, &x1, &y1);
+    font->line_height = (lv_coord_t)(ceilf(y1 * ttf->scale) - floorf(y0 * ttf->scale));
+    font->base_line = (lv_coord_t)(-floorf(y0 * ttf->scale));
+
+    const stbtt_uint32 post = stbtt__find_table(info->data, info->fontstart, "post");
+    if (post) {
+        font->underline_position = (int8_t)lroundf(ttSHORT(info->data, post + 8) * ttf->scale);
+        font->underline_thickness = (int8_t)LV_MAX(lroundf(ttSHORT(info->data, post + 10) * ttf->scale), 1);
+    }
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+bool lvgl_port_ttf_init(size_t budget)
+{
+    if (lvgl_port_ttf.cache.budget == 0) {
+        lvgl_port_cache_init(&lvgl_port_ttf.cache, budget);
+    }
+    return true;
+}
+
+void lvgl_port_ttf_deinit(void)
+{
+    while (lvgl_port_ttf.fonts) {
+        lvgl_port_ttf_font_t *next = lvgl_port_ttf.fonts->next;
+        free(lvgl_port_ttf.fonts);
+        lvgl_port_ttf.fonts = next;
+    }
+    lvgl_port_cache_deinit(&lvgl_port_ttf.cache);
+    free(lvgl_port_ttf.scratch);
+    memset(&lvgl_port_ttf, 0, sizeof(lvgl_port_ttf));
+}
+
+const lv_font_t *lvgl_port_ttf_get(const char *family, uint16_t px)
+{
+    const lvgl_port_assets_t *assets = lvgl_port_img_assets_table();
+    const uint32_t hash = lvgl_port_assets_hash(family);
+    lvgl_port_asset_t asset;
+
+    if (lvgl_port_ttf.cache.budget == 0 || assets == NULL || px == 0) {
+        return NULL;
+    }
+    for (lvgl_port_ttf_font_t *ttf = lvgl_port_ttf.fonts; ttf; ttf = ttf->next) {
+        if (ttf->family == hash && ttf->px == px) {
+            return &ttf->font;
+        }
+    }
+    if (!lvgl_port_assets_find(assets, hash, &asset) || asset.encoding != LVGL_PORT_ASSET_FONT) {
+        return NULL;
+    }
+
+    lvgl_port_ttf_font_t *ttf = calloc(1, sizeof(lvgl_port_ttf_font_t));
+    if (ttf == NULL) {
+        return NULL;
+    }
+    if (!stbtt_InitFont(&ttf->info, asset.data, 0)) {
+        free(ttf);
+        return NULL;
+    }
+    ttf->family = hash;
+    ttf->px = px;
+    ttf->font.get_glyph_dsc = lvgl_port_ttf_get_glyph_dsc;
+    ttf->font.get_glyph_bitmap = lvgl_port_ttf_get_glyph_bitmap;
+    ttf->font.dsc = ttf;
+    lvgl_port_ttf_set_metrics(ttf);
+    ttf->next = lvgl_port_ttf.fonts;
+    lvgl_port_ttf.fonts = ttf;
+
+    return &ttf->font;
+}
+
+int lvgl_port_ttf_prewarm(const lv_font_t *font, const char *text)
+{
+    lv_font_glyph_dsc_t g;
+    uint32_t i = 0;
+
+    if (font == NULL || font->get_glyph_bitmap != lvgl_port_ttf_get_glyph_bitmap) {
+        return -1;
+    }
+    const uint32_t misses = lvgl_port_ttf.cache.stats[0].misses;
+    while (text[i] != '\0') {
+        /* Glyphs LVGL draws, not spaces */
+        const uint32_t letter = _lv_txt_encoded_next(text, &i);
+        if (lvgl_port_ttf_get_glyph_dsc(font, &g, letter, 0) && g.box_w > 0 && g.box_h > 0) {
+            lvgl_port_ttf_get_glyph_bitmap(font, letter);
+        }
+    }
+    return lvgl_port_ttf.cache.stats[0].misses - misses;
+}
+
+void lvgl_port_ttf_get_stats(lvgl_port_cache_layer_t *stats)
+{
+    *stats = lvgl_port_ttf.cache.stats[0];
+}
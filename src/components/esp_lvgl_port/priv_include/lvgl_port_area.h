@@ -0,0 +1,65 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Optimization of invalidated areas
+ *
+ * Every invalidated area is rendered and sent to the LCD as at least one window, which costs the
+ * window commands besides the pixels. Areas are merged, split and dropped to minimize
+ * the sum of (transaction cost + pixel bytes) over all areas, while every invalidated pixel
+ * stays covered.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Invalidated area, coordinates are inclusive
+ */
+typedef struct {
+    int x1; /*!< First column */
+    int y1; /*!< First row */
+    int x2; /*!< Last column */
+    int y2; /*!< Last row */
+} lvgl_port_area_t;
+
+/**
+ * @brief Cost of refreshing the areas
+ *
+ * @param areas         Areas
+ * @param count         Number of areas
+ * @param px_size       Size of one pixel in bytes
+ * @param trans_cost    Cost of one transaction in bytes
+ * @return Sum of the transaction cost and pixel bytes of all areas
+ */
+uint64_t lvgl_port_area_cost(const lvgl_port_area_t *areas, size_t count, uint32_t px_size, uint32_t trans_cost);
+
+/**
+ * @brief Merge, split and drop areas to lower the cost of their refresh
+ *
+ * - areas inside of another area are dropped
+ * - two areas are merged into their bounding box, when the redundant pixels are cheaper than one transaction
+ * - area overlapped by another one is split to the parts outside of it, when the saved pixels pay for the new transactions
+ *
+ * @param areas         Areas, modified in place
+ * @param count         Number of areas
+ * @param max_count     Capacity of `areas`, splitting never exceeds it
+ * @param px_size       Size of one pixel in bytes
+ * @param trans_cost    Cost of one transaction in bytes
+ * @return New number of areas
+ */
+size_t lvgl_port_area_optimize(lvgl_port_area_t *areas, size_t count, size_t max_count, uint32_t px_size, uint32_t trans_cost);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Asset tables
+ *
+ * Bundles of images made by scripts/lvgl_port_assets.py, flashed into their own partition and
+ * memory mapped. The bundle starts with a header and a table of fixed size entries, followed by
+ * the blobs, each 4 bytes aligned:
+ *
+ * | magic "AST1" (4) | count (4) | size (4) | reserved (4) | entries (20 * count) | blobs |
+ *
+ * Entry: | offset (4) | size (4) | name hash (4) | w (2) | h (2) | cf (1) | encoding (1) | reserved (2) |
+ *
+ * Assets are found by their index in the table. The application refers to them by image descriptors
+ * generated with the same indices (`LV_IMG_CF_USER_ENCODED_1`, data is | "AREF" | index | name hash |
+ * as 32-bit words), the FNV-1a hash of the name catches a table of a different build. The table is
+ * checked once when opened, so looking up an asset is O(1).
+ * TrueType fonts follow the images, found by the hash of their family name (w is the units per em,
+ * h the number of glyphs).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LVGL_PORT_ASSETS_MAGIC          (0x31545341)    /* "AST1" */
+#define LVGL_PORT_ASSETS_HEADER_SIZE    (16)
+#define LVGL_PORT_ASSETS_ENTRY_SIZE     (20)
+#define LVGL_PORT_ASSETS_ALIGN          (4)
+#define LVGL_PORT_ASSETS_REF_MAGIC      (0x46455241)    /* "AREF" */
+#define LVGL_PORT_ASSETS_REF_SIZE       (12)
+
+/**
+ * @brief Encoding of an asset blob
+ */
+typedef enum {
+    LVGL_PORT_ASSET_RAW = 0,    /*!< Pixels in the layout of their LVGL color format */
+    LVGL_PORT_ASSET_RLE = 1,    /*!< Run-length encoded image, see lvgl_port_rle.h */
+    LVGL_PORT_ASSET_FONT = 2,   /*!< TrueType font, see scripts/lvgl_port_ttf.py */
+} lvgl_port_asset_encoding_t;
+
+/**
+ * @brief Opened asset table
+ */
+typedef struct {
+    const uint8_t *data;    /*!< Bundle, starting with the header */
+    size_t size;            /*!< Size of the bundle */
+    uint32_t count;         /*!< Number of assets */
+} lvgl_port_assets_t;
+
+/**
+ * @brief Asset
+ */
+typedef struct {
+    const uint8_t *data;    /*!< Blob, points into the bundle */
+    uint32_t size;          /*!< Size of the blob */
+    uint16_t w;             /*!< Width */
+    uint16_t h;             /*!< Height */
+    uint8_t cf;             /*!< LVGL color format of the pixels */
+    uint8_t encoding;       /*!< Encoding of the blob, lvgl_port_asset_encoding_t */
+} lvgl_port_asset_t;
+
+/**
+ * @brief Check the header and the table of a bundle
+ *
+ * @param assets    Table, filled on success
+ * @param data      Bundle, must stay valid while the table is used
+ * @param size      Bytes available at data (e.g. the mapped partition), the bundle may be shorter
+ * @return true when the bundle is valid and all blobs are inside of it
+ */
+bool lvgl_port_assets_open(lvgl_port_assets_t *assets, const void *data, size_t size);
+
+/**
+ * @brief Look up an asset
+ *
+ * @param assets    Table
+ * @param id        Index of the asset
+ * @param name_hash Hash of the asset name, see lvgl_port_assets_hash()
+ * @param asset     Asset, filled on success
+ * @return true when found, false when the index is out of the table or the hash doesn't match
+ */
+bool lvgl_port_assets_get(const lvgl_port_assets_t *assets, uint32_t id, uint32_t name_hash, lvgl_port_asset_t *asset);
+
+/**
+ * @brief Find an asset by its name
+ *
+ * @param assets    Table
+ * @param name_hash Hash of the asset name, see lvgl_port_assets_hash()
+ * @param asset     Asset, filled on success
+ * @return true when found
+ */
+bool lvgl_port_assets_find(const lvgl_port_assets_t *assets, uint32_t name_hash, lvgl_port_asset_t *asset);
+
+/**
+ * @brief FNV-1a hash of an asset name
+ *
+ * @param name  Name, zero terminated
+ * @return Hash
+ */
+uint32_t lvgl_port_assets_hash(const char *name);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Coverage masks blended in a color under the draw masks
+ *
+ * Glyph masks (lvgl_port_font.h), alpha only images (lvgl_port_img.h) and the bands of rollers
+ * (lvgl_port_roller_obj.h) are coverage masks, one opacity byte per pixel, filled with a color by
+ * the software renderer of LVGL. LVGL applies its draw masks (rounded corners, fades) to the mask it
+ * blends, which here is kept for the next draw: the part in the clip area is copied first, the way
+ * lv_draw_sw_letter() does it.
+ * Depends on LVGL only, so the simulator blends the same way.
+ */
+
+#pragma once
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Fill the part of a coverage mask in the clip area of a draw context with a color
+ *
+ * Must be called from a draw callback of the software renderer of LVGL.
+ *
+ * @param draw_ctx      Draw context, blended in its clip area
+ * @param box           Area the mask covers
+ * @param mask          Coverage of the area, row by row, not changed
+ * @param color         Fill color
+ * @param opa           Opacity of the fill
+ * @param blend_mode    Blend mode of the fill
+ */
+void lvgl_port_blend_mask(lv_draw_ctx_t *draw_ctx, const lv_area_t *box, const lv_opa_t *mask, lv_color_t color,
+                          lv_opa_t opa, lv_blend_mode_t blend_mode);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,193 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Cache of prepared images
+ *
+ * Holds images as drawn: decoded, transformed and recolored, keyed by the source and these
+ * parameters. It is bounded by bytes, not by entries, and evicts the least recently used entries
+ * first. The last used entry of a pinned source is never evicted, a layer (screen) pins its hot
+ * images while it is the current one. Entries of the same source drawn with other parameters before
+ * are evicted as usual. An image is only added when it missed before with the same parameters, so
+ * images drawn with new parameters every frame (an animated rotation) don't evict the others.
+ * Hits, misses and held bytes are counted per layer.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LVGL_PORT_CACHE_LAYERS  (8)     /* Layers with their own statistics, 0 is the default one */
+#define LVGL_PORT_CACHE_PINS    (16)    /* Sources pinned at once */
+#define LVGL_PORT_CACHE_GHOSTS  (8)     /* Keys missed once remembered */
+
+/**
+ * @brief Image and the parameters it is drawn with
+ */
+typedef struct {
+    const void *src;        /*!< Image source */
+    uint32_t frame_id;      /*!< Frame of animated images */
+    int16_t angle;          /*!< Rotation in 0.1 degree */
+    uint16_t zoom;          /*!< Zoom, 256 is 1:1 */
+    int16_t pivot_x;        /*!< Center of the rotation and the zoom */
+    int16_t pivot_y;        /*!< Center of the rotation and the zoom */
+    uint16_t recolor;       /*!< Recolor in native RGB565 */
+    uint8_t recolor_opa;    /*!< Recolor opacity, 0 for none */
+    uint8_t antialias;      /*!< Antialiased transformation */
+} lvgl_port_cache_key_t;
+
+/**
+ * @brief Cached image
+ */
+typedef struct lvgl_port_cache_entry {
+    lvgl_port_cache_key_t key;      /*!< Image and its parameters */
+    uint8_t *data;                  /*!< Pixels */
+    size_t size;                    /*!< Bytes of the pixels */
+    int16_t x;                      /*!< Left of the pixels relative to the image */
+    int16_t y;                      /*!< Top of the pixels relative to the image */
+    uint16_t w;                     /*!< Width of the pixels */
+    uint16_t h;                     /*!< Height of the pixels */
+    bool opaque;                    /*!< Pixels have no alpha */
+    bool pinned;                    /*!< Last used entry of a pinned source */
+    uint8_t layer;                  /*!< Layer the entry was added by */
+    struct lvgl_port_cache_entry *prev; /*!< More recently used entry */
+    struct lvgl_port_cache_entry *next; /*!< Less recently used entry */
+} lvgl_port_cache_entry_t;
+
+/**
+ * @brief Statistics of a layer
+ */
+typedef struct {
+    uint32_t hits;          /*!< Draws served from the cache */
+    uint32_t misses;        /*!< Draws not found in the cache */
+    uint32_t evictions;     /*!< Entries of the layer evicted for others */
+    uint32_t entries;       /*!< Entries held */
+    uint32_t bytes;         /*!< Bytes held, with the entries */
+} lvgl_port_cache_layer_t;
+
+/**
+ * @brief Cache
+ */
+typedef struct {
+    lvgl_port_cache_entry_t *head;  /*!< Most recently used entry */
+    lvgl_port_cache_entry_t *tail;  /*!< Least recently used entry */
+    size_t budget;                  /*!< Bytes the entries may hold */
+    size_t used;                    /*!< Bytes the entries hold */
+    uint8_t layer;                  /*!< Current layer */
+    uint32_t pin_count;             /*!< Pinned sources */
+    const void *pins[LVGL_PORT_CACHE_PINS];                 /*!< Pinned sources of the current layer */
+    lvgl_port_cache_key_t ghosts[LVGL_PORT_CACHE_GHOSTS];   /*!< Keys missed once, not added */
+    uint32_t ghost_next;                                    /*!< Oldest of ghosts */
+    lvgl_port_cache_layer_t stats[LVGL_PORT_CACHE_LAYERS];  /*!< Statistics of each layer */
+} lvgl_port_cache_t;
+
+/**
+ * @brief Initialize an empty cache
+ *
+ * @param cache     Cache
+ * @param budget    Bytes of the entries and their pixels, 0 caches nothing
+ */
+void lvgl_port_cache_init(lvgl_port_cache_t *cache, size_t budget);
+
+/**
+ * @brief Free all entries
+ *
+ * @param cache Cache
+ */
+void lvgl_port_cache_deinit(lvgl_port_cache_t *cache);
+
+/**
+ * @brief Find an entry and make it the most recently used one
+ *
+ * Counted as a hit or a miss of the current layer.
+ *
+ * @param cache Cache
+ * @param key   Image and its parameters
+ * @return Entry, NULL when not cached
+ */
+lvgl_port_cache_entry_t *lvgl_port_cache_find(lvgl_port_cache_t *cache, const lvgl_port_cache_key_t *key);
+
+/**
+ * @brief Check if a missed image is worth adding
+ *
+ * The first miss of a key is only remembered, the next one within the last LVGL_PORT_CACHE_GHOSTS
+ * misses admits it.
+ *
+ * @param cache Cache
+ * @param key   Image and its parameters, not cached
+ * @return true when the key missed before
+ */
+bool lvgl_port_cache_admit(lvgl_port_cache_t *cache, const lvgl_port_cache_key_t *key);
+
+/**
+ * @brief Add an entry of the current layer
+ *
+ * Least recently used entries not pinned are evicted until the new one fits.
+ *
+ * @param cache Cache
+ * @param key   Image and its parameters, not cached yet
+ * @param size  Bytes of the pixels
+ * @return Entry with uninitialized pixels, NULL when it doesn't fit or allocation fails
+ */
+lvgl_port_cache_entry_t *lvgl_port_cache_add(lvgl_port_cache_t *cache, const lvgl_port_cache_key_t *key, size_t size);
+
+/**
+ * @brief Give back the end of the pixels of an entry
+ *
+ * @param cache Cache
+ * @param entry Entry
+ * @param size  New bytes of the pixels, at most the current ones
+ * @return The entry, it may have moved
+ */
+lvgl_port_cache_entry_t *lvgl_port_cache_shrink(lvgl_port_cache_t *cache, lvgl_port_cache_entry_t *entry, size_t size);
+
+/**
+ * @brief Free an entry
+ *
+ * @param cache Cache
+ * @param entry Entry
+ */
+void lvgl_port_cache_remove(lvgl_port_cache_t *cache, lvgl_port_cache_entry_t *entry);
+
+/**
+ * @brief Make a layer the current one
+ *
+ * Sources pinned by the previous layer are unpinned, their entries stay cached until evicted.
+ *
+ * @param cache Cache
+ * @param layer Layer, below LVGL_PORT_CACHE_LAYERS
+ */
+void lvgl_port_cache_set_layer(lvgl_port_cache_t *cache, uint8_t layer);
+
+/**
+ * @brief Pin or unpin the entries of a source for the current layer
+ *
+ * @param cache Cache
+ * @param src   Image source, its last used entry is pinned, whatever its parameters
+ * @param pin   Pin or unpin
+ * @return false when LVGL_PORT_CACHE_PINS sources are pinned already
+ */
+bool lvgl_port_cache_pin(lvgl_port_cache_t *cache, const void *src, bool pin);
+
+/**
+ * @brief Check if a source is pinned
+ *
+ * @param cache Cache
+ * @param src   Image source
+ * @return true when pinned
+ */
+bool lvgl_port_cache_pinned(const lvgl_port_cache_t *cache, const void *src);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Clip shapes stored as rows of spans
+ *
+ * LVGL 8 draw masks compute the opacity of every pixel of every drawn row again, on each draw. A
+ * clip shape holds the opacities of its box computed once, row by row: the transparent sides, the
+ * span of one opacity in between (the inside of a circle, a row of a fade) and the opacities of the
+ * edges around the span. Applying a row then only scales the edge pixels and the span, and leaves
+ * the mask untouched where it is fully covered. Opacities are mixed into the mask like LVGL does,
+ * so a shape made from LVGL masks draws the same pixels.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LVGL_PORT_CLIP_OPA_MIN  (2)     /* Opacities up to here are transparent, LV_OPA_MIN */
+#define LVGL_PORT_CLIP_OPA_MAX  (253)   /* Opacities from here on are fully covering, LV_OPA_MAX */
+
+/**
+ * @brief Result of applying a row, like lv_draw_mask_res_t
+ */
+typedef enum {
+    LVGL_PORT_CLIP_TRANSP,              /*!< Nothing of the row is drawn, the mask is not written */
+    LVGL_PORT_CLIP_FULL_COVER,          /*!< The whole row is drawn, the mask is not written */
+    LVGL_PORT_CLIP_CHANGED,             /*!< The mask was scaled */
+} lvgl_port_clip_res_t;
+
+/**
+ * @brief Row of a clip shape, in pixels from the left of the box
+ */
+typedef struct {
+    uint16_t x1;                        /*!< First pixel not transparent */
+    uint16_t span_x1;                   /*!< First pixel of the span */
+    uint16_t span_x2;                   /*!< Pixel after the span */
+    uint16_t x2;                        /*!< Pixel after the last one not transparent */
+    uint32_t edges;                     /*!< Opacities of x1 to span_x1, then of span_x2 to x2, in edges */
+    uint8_t opa;                        /*!< Opacity of the span */
+} lvgl_port_clip_row_t;
+
+/**
+ * @brief Clip shape
+ */
+typedef struct {
+    uint16_t w;                         /*!< Width of the box */
+    uint16_t h;                         /*!< Height of the box */
+    lvgl_port_clip_row_t *rows;         /*!< Rows, h of them */
+    uint8_t *edges;                     /*!< Opacities of the edges of all rows */
+    size_t edges_len;                   /*!< Bytes of edges used */
+    size_t edges_size;                  /*!< Bytes of edges allocated */
+} lvgl_port_clip_t;
+
+/**
+ * @brief Start a clip shape, all transparent
+ *
+ * @param clip  Clip shape
+ * @param w     Width of the box
+ * @param h     Height of the box
+ * @return false when out of memory
+ */
+bool lvgl_port_clip_init(lvgl_port_clip_t *clip, uint16_t w, uint16_t h);
+
+/**
+ * @brief Free the rows of a clip shape
+ *
+ * @param clip  Clip shape
+ */
+void lvgl_port_clip_deinit(lvgl_port_clip_t *clip);
+
+/**
+ * @brief Set the opacities of a row
+ *
+ * Each row is set once. The longest run of one opacity becomes the span. Opacities are stored the
+ * way they are mixed: up to LVGL_PORT_CLIP_OPA_MIN as 0, from LVGL_PORT_CLIP_OPA_MAX on as 255.
+ *
+ * @param clip  Clip shape
+ * @param y     Row in the box
+ * @param opa   Opacities of the w pixels of the row
+ * @return false when y is out of the box or out of memory
+ */
+bool lvgl_port_clip_set_row(lvgl_port_clip_t *clip, uint16_t y, const uint8_t *opa);
+
+/**
+ * @brief Apply a row of the shape to a mask
+ *
+ * Pixels out of the box are transparent.
+ *
+ * @param clip  Clip shape
+ * @param mask  Opacities of len pixels, scaled by the ones of the shape
+ * @param x     Box coordinate of the first pixel of the mask, can be out of the box
+ * @param y     Box coordinate of the row, can be out of the box
+ * @param len   Pixels of the mask
+ * @return Result, the mask is written on LVGL_PORT_CLIP_CHANGED only
+ */
+lvgl_port_clip_res_t lvgl_port_clip_apply(const lvgl_port_clip_t *clip, uint8_t *mask, int32_t x, int32_t y, int32_t len);
+
+#ifdef __cplusplus
+}
+#endif
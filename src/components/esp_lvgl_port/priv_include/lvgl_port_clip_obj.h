@@ -0,0 +1,51 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Clip shapes of LVGL objects
+ *
+ * Clips an object and its children to a shape (see lvgl_port_clip.h) while it is drawn, instead of
+ * a draw mask initialized in every LV_EVENT_DRAW_MAIN_BEGIN. The rows of the shape are computed
+ * once, by the LVGL masks of the shape, and shared by all objects clipped to a shape of the same
+ * size. The mask is added with the area LVGL 8 knows to be fully covered, so drawings inside it
+ * skip the masks altogether, and rows fully covered in the shape leave the mask buffer untouched.
+ * Depends on LVGL only, so the simulator draws with the same shapes.
+ * All functions must be called from the LVGL task or with the LVGL mutex taken.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Clip an object to a rounded rectangle
+ *
+ * @param obj       Clipped object
+ * @param box       Object of the rectangle, NULL for obj; its coordinates are read on every draw
+ * @param radius    Radius of the corners, LV_RADIUS_CIRCLE for a circle
+ * @return false when out of memory
+ */
+bool lvgl_port_clip_obj_add_radius(lv_obj_t *obj, const lv_obj_t *box, lv_coord_t radius);
+
+/**
+ * @brief Fade an object in at its top and out at its bottom
+ *
+ * @param obj       Clipped object
+ * @param top       Rows from transparent to covering at the top
+ * @param bottom    Rows from covering to transparent at the bottom
+ * @return false when out of memory
+ */
+bool lvgl_port_clip_obj_add_fade(lv_obj_t *obj, lv_coord_t top, lv_coord_t bottom);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Changed spans of flushed areas
+ *
+ * Keeps a 32-bit signature of every tile (a few pixels of one row) last sent to the LCD. Rows of a
+ * flushed area are compared tile by tile and only the span from the first to the last changed tile
+ * of each row needs to be sent.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Signatures of the LCD content
+ */
+typedef struct {
+    uint16_t hres;          /*!< Horizontal resolution */
+    uint16_t vres;          /*!< Vertical resolution */
+    uint16_t tile_w;        /*!< Pixels of one tile */
+    uint16_t tiles;         /*!< Tiles of one row */
+    uint32_t *hash;         /*!< Signature of each tile, 0 when unknown */
+    uint16_t *span_x1;      /*!< First changed column of each row of the last compared area */
+    uint16_t *span_x2;      /*!< Last changed column of each row (smaller than span_x1 for unchanged row) */
+} lvgl_port_diff_t;
+
+/**
+ * @brief Allocate the signatures, all tiles are unknown
+ *
+ * @param diff      Signatures
+ * @param hres      Horizontal resolution
+ * @param vres      Vertical resolution
+ * @param tile_w    Pixels of one tile
+ * @return true on success, false when out of memory
+ */
+bool lvgl_port_diff_init(lvgl_port_diff_t *diff, uint16_t hres, uint16_t vres, uint16_t tile_w);
+
+/**
+ * @brief Free the signatures
+ *
+ * @param diff Signatures
+ */
+void lvgl_port_diff_deinit(lvgl_port_diff_t *diff);
+
+/**
+ * @brief Forget the LCD content, next areas are sent whole
+ *
+ * @param diff Signatures
+ */
+void lvgl_port_diff_reset(lvgl_port_diff_t *diff);
+
+/**
+ * @brief Memory used by the signatures and spans in bytes
+ *
+ * @param diff Signatures
+ */
+size_t lvgl_port_diff_mem(const lvgl_port_diff_t *diff);
+
+/**
+ * @brief Round the area out to whole tiles, so all its tiles can be compared
+ *
+ * @param diff  Signatures
+ * @param x1    First column of the area, updated
+ * @param x2    Last column of the area (inclusive), updated
+ */
+void lvgl_port_diff_align(const lvgl_port_diff_t *diff, int *x1, int *x2);
+
+/**
+ * @brief Compare the area with the signatures and update them
+ *
+ * Tiles only partly inside of the area are always changed and their signature becomes unknown.
+ * The changed spans are stored in `span_x1` and `span_x2` of the area rows, limited to the
+ * optional visible spans.
+ *
+ * @param diff      Signatures
+ * @param x1        First column of the area
+ * @param y1        First row of the area
+ * @param x2        Last column of the area (inclusive)
+ * @param y2        Last row of the area (inclusive)
+ * @param pixels    RGB565 pixels of the area
+ * @param vis_x1    First visible column of each screen row, NULL when all are visible
+ * @param vis_x2    Last visible column of each screen row
+ * @return Number of visible pixels in the area
+ */
+uint32_t lvgl_port_diff_area(lvgl_port_diff_t *diff, int x1, int y1, int x2, int y2, const uint16_t *pixels,
+                             const uint16_t *vis_x1, const uint16_t *vis_x2);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Caches of decoded glyphs of compressed fonts and of glyph masks
+ *
+ * LVGL decodes a glyph of a compressed font (`bitmap_format` 1 or 2) into one shared buffer every
+ * time it is drawn. Fonts compressed by scripts/lvgl_port_font.py get their bitmaps from
+ * lvgl_port_font_get_bitmap() instead, which keeps the decoded glyphs in a cache (see
+ * lvgl_port_cache.h) keyed by the font and the letter, so a label redrawn decodes nothing.
+ * The cache is bounded by bytes and evicts the least recently drawn glyphs first.
+ *
+ * Letters of any font are drawn by LVGL's software renderer from a mask it unpacks from the bitmap
+ * pixel by pixel on every draw. With lvgl_port_font_glyph_init() the masks (see lvgl_port_glyph.h)
+ * are kept in a second cache keyed by the font, the letter and the opacity, and blended from there.
+ * The color is applied while blending, so a letter drawn in other colors shares its mask. Covering
+ * letters of 8 bpp fonts (like the scalable ones of lvgl_port_ttf.h) are blended from the bitmap.
+ * Depends on LVGL only, so the simulator draws with the same caches.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "lvgl.h"
+#include "lvgl_port_cache.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Start caching decoded glyphs
+ *
+ * Must be called from the LVGL task or with the LVGL mutex taken.
+ *
+ * @param budget    Bytes of the cached glyphs, with their entries
+ * @return true on success (also when started already, the budget stays)
+ */
+bool lvgl_port_font_cache_init(size_t budget);
+
+/**
+ * @brief Free the cached glyphs, glyphs are decoded on every draw again
+ */
+void lvgl_port_font_cache_deinit(void);
+
+/**
+ * @brief Get the cache statistics
+ *
+ * @param stats Output statistics, misses are glyphs decoded
+ */
+void lvgl_port_font_cache_get_stats(lvgl_port_cache_layer_t *stats);
+
+/**
+ * @brief Get the bitmap of a glyph of a compressed font, `get_glyph_bitmap` of these fonts
+ *
+ * @param font      Font in the LVGL font format (`lv_font_fmt_txt_dsc_t`)
+ * @param letter    Unicode letter
+ * @return Decoded bitmap, valid until the next glyph is drawn, NULL if the font has no such glyph
+ */
+const uint8_t *lvgl_port_font_get_bitmap(const lv_font_t *font, uint32_t letter);
+
+/**
+ * @brief Draw letters of a display from the cache of glyph masks
+ *
+ * Must be called from the LVGL task or with the LVGL mutex taken.
+ *
+ * @param disp      Display, drawn by the software renderer of LVGL
+ * @param budget    Bytes of the cached masks, shared by all displays, set by the first one
+ * @return true on success (also when added already), false when the display draws letters otherwise
+ */
+bool lvgl_port_font_glyph_init(lv_disp_t *disp, size_t budget);
+
+/**
+ * @brief Draw letters by LVGL again and free the cached masks
+ */
+void lvgl_port_font_glyph_deinit(void);
+
+/**
+ * @brief Get the statistics of the cache of glyph masks
+ *
+ * @param stats Output statistics, misses are masks expanded
+ */
+void lvgl_port_font_glyph_get_stats(lvgl_port_cache_layer_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
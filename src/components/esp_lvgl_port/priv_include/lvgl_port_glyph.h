@@ -0,0 +1,55 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Coverage masks of glyphs
+ *
+ * Glyph bitmaps of the LVGL font format hold 1, 2, 3, 4 or 8 bits per pixel, packed from the most
+ * significant bit, rows not aligned. LVGL unpacks them pixel by pixel into a mask of one opacity
+ * byte per pixel each time a letter is drawn. Here a whole glyph is expanded at once into the mask
+ * LVGL would blend, so it can be cached and blended again as it is.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LVGL_PORT_GLYPH_OPA_MAX (253)   /* Opacities from here on are drawn as fully covering, LV_OPA_MAX */
+
+/**
+ * @brief Check if glyphs of a bit depth can be expanded
+ *
+ * @param bpp   Bits per pixel of the font
+ * @return true for 1, 2, 3, 4 and 8
+ */
+bool lvgl_port_glyph_bpp_valid(uint8_t bpp);
+
+/**
+ * @brief Expand a glyph bitmap into a coverage mask
+ *
+ * The mask equals the one LVGL 8 blends: the shades of the bit depth mapped to 0..255, scaled by
+ * the opacity when it is below LVGL_PORT_GLYPH_OPA_MAX. Bitmaps of 3 bpp are read as 4 bpp, like
+ * LVGL does (its decompressor writes them so).
+ *
+ * @param bitmap    Glyph bitmap
+ * @param bpp       Bits per pixel of the font
+ * @param w         Width of the glyph
+ * @param h         Height of the glyph
+ * @param opa       Opacity the glyph is drawn with
+ * @param mask      Output, w * h bytes
+ * @return false when the bit depth is not supported
+ */
+bool lvgl_port_glyph_mask(const uint8_t *bitmap, uint8_t bpp, uint16_t w, uint16_t h, uint8_t opa, uint8_t *mask);
+
+#ifdef __cplusplus
+}
+#endif
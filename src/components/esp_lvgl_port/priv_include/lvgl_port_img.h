@@ -0,0 +1,171 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief LVGL image decoders of the port
+ *
+ * Run-length encoded images (`LV_IMG_CF_USER_ENCODED_0`, see lvgl_port_rle.h) are never decoded
+ * whole. LVGL reads them line by line into its line buffer and blends each line into the draw buffer.
+ * Images of an asset table (`LV_IMG_CF_USER_ENCODED_1`, see lvgl_port_assets.h) are drawn from
+ * the table, raw ones without a copy, run-length encoded ones like above.
+ * Images drawn transformed, recolored or line by line are kept prepared in a cache (see
+ * lvgl_port_cache.h) and blended from there, LVGL only decodes them on a miss.
+ * Images animated through a range of zoom are rendered ahead in steps into images of their own,
+ * which LVGL blends without transforming them.
+ * Depends on LVGL only, so the simulator draws with the same decoder.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "lvgl.h"
+#include "lvgl_port_cache.h"
+#include "lvgl_port_assets.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Decoder statistics
+ */
+typedef struct {
+    uint32_t opened;        /*!< Images opened for drawing */
+    uint32_t lines;         /*!< Lines read by LVGL */
+    uint64_t px_decoded;    /*!< Decoded pixels */
+    uint32_t cache_hits;    /*!< Lines served from the cache */
+    uint32_t cache_misses;  /*!< Rows decoded into the cache */
+    uint32_t cache_size;    /*!< Memory of the cache in bytes */
+} lvgl_port_img_rle_stats_t;
+
+/**
+ * @brief Register the decoder of run-length encoded images
+ *
+ * Must be called from the LVGL task or with the LVGL mutex taken.
+ *
+ * @param cache_size    Bytes of cached decoded rows, 0 for no cache
+ * @return true on success (also when registered already), false when out of memory
+ */
+bool lvgl_port_img_rle_init(size_t cache_size);
+
+/**
+ * @brief Unregister the decoder and free the cache
+ */
+void lvgl_port_img_rle_deinit(void);
+
+/**
+ * @brief Get the decoder statistics
+ *
+ * @param stats Statistics, zeros when the decoder is not registered
+ */
+void lvgl_port_img_rle_get_stats(lvgl_port_img_rle_stats_t *stats);
+
+/**
+ * @brief Register the decoder of images of an asset table
+ *
+ * Run-length encoded assets share the cache of lvgl_port_img_rle_init(), they are decoded without
+ * it when that decoder is not registered. Must be called from the LVGL task or with the LVGL mutex taken.
+ *
+ * @param data  Bundle, must stay valid until lvgl_port_img_assets_deinit()
+ * @param size  Bytes available at data
+ * @return true on success, false when the bundle is invalid, a table is registered already or out of memory
+ */
+bool lvgl_port_img_assets_init(const void *data, size_t size);
+
+/**
+ * @brief Unregister the decoder of asset images
+ */
+void lvgl_port_img_assets_deinit(void);
+
+/**
+ * @brief Get the number of assets of the registered table
+ *
+ * @return Number of assets, 0 when no table is registered
+ */
+uint32_t lvgl_port_img_assets_count(void);
+
+/**
+ * @brief Get the registered asset table, fonts are looked up in it
+ *
+ * @return Table, NULL when no table is registered
+ */
+const lvgl_port_assets_t *lvgl_port_img_assets_table(void);
+
+/**
+ * @brief Draw images of a display through the cache of prepared images
+ *
+ * Must be called from the LVGL task or with the LVGL mutex taken.
+ *
+ * @param disp      Display, drawn by the software renderer of LVGL
+ * @param budget    Bytes of the cache, shared by all displays, set by the first one
+ * @return true on success (also when added already), false when the display can't be drawn through the cache
+ */
+bool lvgl_port_img_cache_init(lv_disp_t *disp, size_t budget);
+
+/**
+ * @brief Draw images without the cache and free it
+ */
+void lvgl_port_img_cache_deinit(void);
+
+/**
+ * @brief Count the next draws for a layer and unpin the images of the previous one
+ *
+ * @param layer Name of the layer, must stay valid, NULL for the default layer
+ */
+void lvgl_port_img_cache_set_layer(const char *layer);
+
+/**
+ * @brief Pin or unpin an image for the current layer
+ *
+ * @param src   Image source, cached with any parameters
+ * @param pin   Pin or unpin
+ * @return false when too many images are pinned
+ */
+bool lvgl_port_img_cache_pin(const void *src, bool pin);
+
+/**
+ * @brief Render an image in steps of zoom
+ *
+ * Each step is transformed like a zoomed image draw, once. Steps are spread evenly from zoom_min to
+ * zoom_max, around the center of the image. Must be called from the LVGL task or with the LVGL
+ * mutex taken, the default display must be drawn by the software renderer.
+ *
+ * @param src       Image source of a true color format
+ * @param zoom_min  Zoom of the first step, 256 is 1:1
+ * @param zoom_max  Zoom of the last step
+ * @param mask      Keep the alpha only (LV_IMG_CF_ALPHA_8BIT), for images always drawn fully recolored
+ * @param steps     Output images, their pixels are allocated
+ * @param count     Number of steps
+ * @return true on success, false when the image can't be rendered or out of memory (steps are cleared)
+ */
+bool lvgl_port_img_steps_create(const void *src, uint16_t zoom_min, uint16_t zoom_max, bool mask, lv_img_dsc_t *steps, uint8_t count);
+
+/**
+ * @brief Free the pixels of the steps
+ *
+ * The steps must not be drawn anymore.
+ *
+ * @param steps Images of lvgl_port_img_steps_create()
+ * @param count Number of steps
+ */
+void lvgl_port_img_steps_delete(lv_img_dsc_t *steps, uint8_t count);
+
+/**
+ * @brief Get the statistics of a layer
+ *
+ * @param index Layer, 0 is the default one, the others in the order they were set first
+ * @param layer Name of the layer, NULL for the default one
+ * @param stats Statistics
+ * @return false past the last layer
+ */
+bool lvgl_port_img_cache_get_stats(uint8_t index, const char **layer, lvgl_port_cache_layer_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Indexed color images
+ *
+ * Images in the layout of `LV_IMG_CF_INDEXED_1/2/4/8BIT`, made by scripts/lvgl_port_img_index.py:
+ * 2^bpp palette entries as `lv_color32_t` (blue, green, red, alpha), then the indices of each row
+ * packed from the most significant bit, rows byte aligned.
+ *
+ * Lines are expanded to native RGB565 through a palette converted once per image, to 2 bytes per
+ * pixel when the palette is opaque, so LVGL blends them without a mask, otherwise to RGB565 and
+ * alpha (`LV_IMG_CF_TRUE_COLOR_ALPHA`).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Indexed image
+ */
+typedef struct {
+    const uint8_t *palette; /*!< Palette entries, followed by the indices */
+    const uint8_t *indices; /*!< Packed indices of the first row */
+    uint32_t stride;        /*!< Bytes of a row of indices */
+    uint16_t w;             /*!< Width */
+    uint16_t h;             /*!< Height */
+    uint8_t bpp;            /*!< Bits of an index: 1, 2, 4 or 8 */
+} lvgl_port_index_img_t;
+
+/**
+ * @brief Palette converted for expanding lines
+ */
+typedef struct {
+    const uint8_t *key;     /*!< Palette entries it was converted from, NULL when empty */
+    uint8_t color[256][2];  /*!< Native RGB565 of each index */
+    uint8_t alpha[256];     /*!< Opacity of each index */
+    bool opaque;            /*!< All entries are opaque */
+} lvgl_port_index_palette_t;
+
+/**
+ * @brief Check the size of an indexed image
+ *
+ * @param img   Image, filled on success
+ * @param data  Palette followed by the indices
+ * @param size  Size of the data
+ * @param w     Width
+ * @param h     Height
+ * @param bpp   Bits of an index
+ * @return true when the data holds the whole image
+ */
+bool lvgl_port_index_open(lvgl_port_index_img_t *img, const void *data, size_t size, uint32_t w, uint32_t h, uint8_t bpp);
+
+/**
+ * @brief Convert the palette of an image, unless it is converted already
+ *
+ * @param pal   Palette
+ * @param img   Image
+ */
+void lvgl_port_index_palette(lvgl_port_index_palette_t *pal, const lvgl_port_index_img_t *img);
+
+/**
+ * @brief Expand part of a row
+ *
+ * @param img   Image
+ * @param pal   Palette of the image, see lvgl_port_index_palette()
+ * @param x     First column
+ * @param y     Row
+ * @param len   Number of pixels
+ * @param alpha Write RGB565 and alpha (3 bytes per pixel) instead of RGB565
+ * @param out   Pixels
+ * @return true on success, false when outside of the image
+ */
+bool lvgl_port_index_read(const lvgl_port_index_img_t *img, const lvgl_port_index_palette_t *pal,
+                          uint32_t x, uint32_t y, uint32_t len, bool alpha, uint8_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Frame pacing against the LCD scan
+ *
+ * Tracks the vertical sync of the LCD, either from its TE output or estimated from the scan period,
+ * and chooses when a frame should be rendered, so its first window is sent right after the vsync.
+ * All times are in microseconds and passed by the caller.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Frame pacing state
+ */
+typedef struct {
+    uint32_t scan_us;       /*!< Scan period of the LCD */
+    int64_t  vsync_us;      /*!< Time of the last known vsync */
+    bool     te_locked;     /*!< vsync_us and scan_us are measured from TE */
+    uint32_t lead_us;       /*!< Averaged time from the start of the refresh to the first flush */
+    int64_t  last_end_us;   /*!< Last flush of the previous frame */
+    uint32_t frames;        /*!< Number of rendered frames */
+    uint32_t dropped;       /*!< Scan periods missed by continuous animation frames */
+    uint32_t wasted;        /*!< Frames overwritten by the next frame in the same scan period (never shown whole) */
+    uint32_t te_count;      /*!< Number of TE edges */
+} lvgl_port_pacing_t;
+
+/**
+ * @brief Initialize frame pacing
+ *
+ * @param pacing    Frame pacing state
+ * @param scan_us   Scan period of the LCD, refined later from TE edges if available
+ * @param now_us    Current time, used as the first estimated vsync
+ */
+void lvgl_port_pacing_init(lvgl_port_pacing_t *pacing, uint32_t scan_us, int64_t now_us);
+
+/**
+ * @brief Vertical sync from the TE output of the LCD
+ *
+ * Short enough to be called from an interrupt, the caller must serialize it with the other functions.
+ *
+ * @param pacing    Frame pacing state
+ * @param now_us    Time of the TE edge
+ */
+void lvgl_port_pacing_vsync(lvgl_port_pacing_t *pacing, int64_t now_us);
+
+/**
+ * @brief Time of the first vsync at or after the given time
+ *
+ * @param pacing    Frame pacing state
+ * @param time_us   Time
+ * @return Time of the vsync
+ */
+int64_t lvgl_port_pacing_next_vsync(const lvgl_port_pacing_t *pacing, int64_t time_us);
+
+/**
+ * @brief Refresh period rounded up to whole scan periods
+ *
+ * @param pacing    Frame pacing state
+ * @param period_ms Requested refresh period
+ * @return Refresh period in ms, at least one scan period
+ */
+uint32_t lvgl_port_pacing_period(const lvgl_port_pacing_t *pacing, uint32_t period_ms);
+
+/**
+ * @brief Time, when the refresh should start
+ *
+ * The first window of the frame is then sent just after a vsync, so the writing
+ * follows the scan instead of crossing it.
+ *
+ * @param pacing    Frame pacing state
+ * @param now_us    Current time
+ * @return Start time of the refresh, never before now_us
+ */
+int64_t lvgl_port_pacing_start(const lvgl_port_pacing_t *pacing, int64_t now_us);
+
+/**
+ * @brief Account a rendered frame
+ *
+ * @param pacing        Frame pacing state
+ * @param start_us      Start of the refresh
+ * @param flush_us      First flush of the frame (0 if nothing was flushed)
+ * @param end_us        Last flush of the frame
+ * @param target_scans  Scan periods between continuous frames, 0 for a single frame (drops are not counted)
+ */
+void lvgl_port_pacing_frame(lvgl_port_pacing_t *pacing, int64_t start_us, int64_t flush_us, int64_t end_us, uint32_t target_scans);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Bounded lock-free command queue into the LVGL task
+ *
+ * Any number of tasks and interrupts push commands, the LVGL task pops them. Every cell has a
+ * sequence number, which tells whether it is free for the push of the given position or holds
+ * the command for the pop of it, so neither side takes a lock (Vyukov's bounded MPMC queue).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Cells of the queue, power of two */
+#define LVGL_PORT_QUEUE_LEN     (32)
+
+/**
+ * @brief Command
+ */
+typedef struct {
+    void (*cb)(void *arg);  /*!< Called in the LVGL task */
+    void *arg;              /*!< Argument of cb */
+} lvgl_port_queue_cmd_t;
+
+/**
+ * @brief One cell of the queue
+ */
+typedef struct {
+    _Atomic uint32_t seq;   /*!< Position the cell is free for (push) or position + 1 when it is full (pop) */
+    lvgl_port_queue_cmd_t cmd;
+} lvgl_port_queue_cell_t;
+
+/**
+ * @brief Queue
+ */
+typedef struct {
+    lvgl_port_queue_cell_t cell[LVGL_PORT_QUEUE_LEN];
+    _Atomic uint32_t push_pos;  /*!< Next position to push */
+    _Atomic uint32_t pop_pos;   /*!< Next position to pop */
+    _Atomic uint32_t pushed;    /*!< Pushed commands */
+    _Atomic uint32_t dropped;   /*!< Commands not pushed, because the queue was full */
+} lvgl_port_queue_t;
+
+/**
+ * @brief Empty the queue
+ *
+ * Not safe against concurrent push or pop.
+ *
+ * @param queue Queue
+ */
+void lvgl_port_queue_init(lvgl_port_queue_t *queue);
+
+/**
+ * @brief Push a command, safe from any task and from an interrupt
+ *
+ * @param queue Queue
+ * @param cmd   Command
+ * @return false if the queue is full
+ */
+bool lvgl_port_queue_push(lvgl_port_queue_t *queue, const lvgl_port_queue_cmd_t *cmd);
+
+/**
+ * @brief Pop the oldest command
+ *
+ * @param queue Queue
+ * @param cmd   Output command
+ * @return false if the queue is empty
+ */
+bool lvgl_port_queue_pop(lvgl_port_queue_t *queue, lvgl_port_queue_cmd_t *cmd);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,121 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Run-length encoded images
+ *
+ * Images made by scripts/lvgl_port_img_rle.py: a header, offsets of the rows and the rows encoded
+ * as packets of literal or repeated pixels. Any part of any row can be decoded without the others,
+ * so the image is drawn line by line and never held decoded. A small cache keeps whole decoded rows
+ * for areas redrawn again and again.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LVGL_PORT_RLE_MAGIC         (0x31454C52)    /* "RLE1" */
+#define LVGL_PORT_RLE_HEADER_SIZE   (8)             /* Without the row offsets */
+#define LVGL_PORT_RLE_CACHE_SLOTS   (64)            /* Maximal number of cached rows */
+
+/**
+ * @brief Encoded image
+ */
+typedef struct {
+    const uint8_t *data;    /*!< Encoded data, starting with the header */
+    size_t size;            /*!< Size of the encoded data */
+    uint16_t w;             /*!< Width */
+    uint16_t h;             /*!< Height */
+    uint8_t cf;             /*!< LVGL color format of the decoded pixels */
+    uint8_t px_size;        /*!< Bytes of one decoded pixel */
+} lvgl_port_rle_img_t;
+
+/**
+ * @brief Decoded rows of recently drawn images
+ *
+ * Direct mapped by row, so the rows of a small area redrawn in every frame stay cached together.
+ */
+typedef struct {
+    uint8_t *mem;           /*!< Rows of all slots */
+    size_t size;            /*!< Size of mem */
+    size_t row_size;        /*!< Bytes of one slot, fits the widest row seen so far */
+    uint32_t slots;         /*!< Slots of row_size in mem */
+    const uint8_t *key_data[LVGL_PORT_RLE_CACHE_SLOTS]; /*!< Image of each slot, NULL when empty */
+    uint16_t key_y[LVGL_PORT_RLE_CACHE_SLOTS];          /*!< Row of each slot */
+    uint32_t hits;          /*!< Reads served from the cache */
+    uint32_t misses;        /*!< Rows decoded into the cache */
+    uint64_t px_decoded;    /*!< All decoded pixels, with the ones not cached */
+} lvgl_port_rle_cache_t;
+
+/**
+ * @brief Check the header of an encoded image
+ *
+ * Rows are checked while they are decoded, so this is cheap enough to be called for each draw.
+ *
+ * @param img   Image, filled on success
+ * @param data  Encoded data
+ * @param size  Size of the data
+ * @param w     Width the image is declared with
+ * @param h     Height the image is declared with
+ * @return true when the data is an encoded image of this size
+ */
+bool lvgl_port_rle_open(lvgl_port_rle_img_t *img, const void *data, size_t size, uint32_t w, uint32_t h);
+
+/**
+ * @brief Decode part of a row
+ *
+ * @param img   Image
+ * @param x     First column
+ * @param y     Row
+ * @param len   Number of pixels
+ * @param out   Decoded pixels, `len * px_size` bytes
+ * @return true on success, false when outside of the image or the row is corrupted
+ */
+bool lvgl_port_rle_read(const lvgl_port_rle_img_t *img, uint32_t x, uint32_t y, uint32_t len, uint8_t *out);
+
+/**
+ * @brief Allocate the cache
+ *
+ * @param cache Cache
+ * @param size  Bytes of decoded rows, 0 for no cache
+ * @return true on success, false when out of memory
+ */
+bool lvgl_port_rle_cache_init(lvgl_port_rle_cache_t *cache, size_t size);
+
+/**
+ * @brief Free the cache
+ *
+ * @param cache Cache
+ */
+void lvgl_port_rle_cache_deinit(lvgl_port_rle_cache_t *cache);
+
+/**
+ * @brief Decode part of a row through the cache
+ *
+ * The whole row is decoded into the cache on a miss. Rows not fitting the cache are decoded
+ * directly into the output.
+ *
+ * @param cache Cache
+ * @param img   Image
+ * @param x     First column
+ * @param y     Row
+ * @param len   Number of pixels
+ * @param out   Decoded pixels, `len * px_size` bytes
+ * @return true on success, false when outside of the image or the row is corrupted
+ */
+bool lvgl_port_rle_cache_read(lvgl_port_rle_cache_t *cache, const lvgl_port_rle_img_t *img,
+                              uint32_t x, uint32_t y, uint32_t len, uint8_t *out);
+
+#ifdef __cplusplus
+}
+#endif
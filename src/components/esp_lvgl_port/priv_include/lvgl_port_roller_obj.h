@@ -0,0 +1,48 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Text of an LVGL roller drawn from bands rendered once
+ *
+ * An LVGL 8 roller lays out and draws its whole text on every draw, once in the font of the rows
+ * and once in the font of the selected row, letter by letter, while it scrolls. Here the two texts
+ * are rendered once into bands of coverage (one opacity byte per pixel), and the roller draws them
+ * as the masks of a fill in its text color, at the positions LVGL would draw the texts at: a roller
+ * scrolling to a new row moves two masks. A band keeps the runs of rows with coverage only, not the
+ * line spacing. The draw masks of the roller (a fade, see lvgl_port_clip_obj.h) are applied to the
+ * rows they cover only.
+ * Depends on LVGL only, so the simulator draws with the same bands.
+ * All functions must be called from the LVGL task or with the LVGL mutex taken.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Draw the text of a roller from bands
+ *
+ * The text opacities of the roller are read now and set transparent so LVGL draws no letters; the
+ * text color is read on every draw. The bands are rendered again when the roller or its label is
+ * sized anew, when lv_roller_set_options() sets other options, and when a font, spacing, alignment
+ * or blend mode of the texts changes and LVGL reports it (a style change of a layout property, or
+ * of one that extends the drawn area). They are freed with the roller. Text opacities set later
+ * are not followed.
+ *
+ * @param roller    Roller object
+ * @return false when obj is no roller or out of memory
+ */
+bool lvgl_port_roller_obj_add_band(lv_obj_t *roller);
+
+#ifdef __cplusplus
+}
+#endif
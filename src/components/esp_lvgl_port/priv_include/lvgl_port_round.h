@@ -0,0 +1,137 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Visible area of a round display
+ *
+ * Splits flushed rectangles into the parts inside the circle inscribed into the screen.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Visible spans of a round display
+ */
+typedef struct {
+    uint16_t hres;          /*!< Horizontal resolution */
+    uint16_t vres;          /*!< Vertical resolution */
+    uint32_t trans_cost;    /*!< Cost of starting one more transaction, in bytes of pixel data */
+    uint16_t *span_x1;      /*!< First visible column of each row */
+    uint16_t *span_x2;      /*!< Last visible column of each row (smaller than span_x1 for invisible row) */
+} lvgl_port_round_t;
+
+/**
+ * @brief Result of one flushed area
+ */
+typedef struct {
+    uint32_t trans_count;   /*!< Number of sent windows */
+    uint32_t bytes_sent;    /*!< Pixel bytes sent, including merged invisible pixels */
+    uint32_t bytes_saved;   /*!< Pixel bytes of the area, which were not sent */
+} lvgl_port_round_result_t;
+
+/**
+ * @brief Send one window of compacted pixels
+ *
+ * @param user_ctx  User context passed to lvgl_port_round_flush()
+ * @param x1        First column of the window
+ * @param y1        First row of the window
+ * @param x2        Last column of the window (inclusive)
+ * @param y2        Last row of the window (inclusive)
+ * @param data      Pixels of the window, (x2 - x1 + 1) * (y2 - y1 + 1) of them without any gaps
+ */
+typedef void (*lvgl_port_round_send_cb_t)(void *user_ctx, int x1, int y1, int x2, int y2, const void *data);
+
+/**
+ * @brief Compute visible spans of the circle inscribed into the screen
+ *
+ * Pixel is visible, when its center lies inside the circle.
+ *
+ * @param round         Round display
+ * @param hres          Horizontal resolution
+ * @param vres          Vertical resolution
+ * @param trans_cost    Cost of one transaction in bytes, more invisible bytes are sent instead of splitting a window when cheaper
+ * @return true on success, false when out of memory
+ */
+bool lvgl_port_round_init(lvgl_port_round_t *round, uint16_t hres, uint16_t vres, uint32_t trans_cost);
+
+/**
+ * @brief Free the spans
+ *
+ * @param round Round display
+ */
+void lvgl_port_round_deinit(lvgl_port_round_t *round);
+
+/**
+ * @brief Shrink the columns of the area to the visible part
+ *
+ * Rows are never changed, so the height of the area stays the same. Area without any visible
+ * pixel is shrunk to its first column.
+ *
+ * @param round Round display
+ * @param x1    First column of the area, updated
+ * @param y1    First row of the area
+ * @param x2    Last column of the area (inclusive), updated
+ * @param y2    Last row of the area (inclusive)
+ */
+void lvgl_port_round_clip(const lvgl_port_round_t *round, int *x1, int y1, int *x2, int y2);
+
+/**
+ * @brief Send only the visible part of the area
+ *
+ * Visible spans of following rows are merged into windows, when sending the invisible pixels
+ * in between is cheaper than another transaction. Pixels of each window are compacted in place
+ * to the beginning of the buffer before `send_cb` is called, so the already sent data are never
+ * overwritten while the next window is prepared.
+ *
+ * @param round     Round display
+ * @param x1        First column of the area
+ * @param y1        First row of the area
+ * @param x2        Last column of the area (inclusive)
+ * @param y2        Last row of the area (inclusive)
+ * @param pixels    Pixels of the area, modified
+ * @param px_size   Size of one pixel in bytes
+ * @param send_cb   Called for every window
+ * @param user_ctx  Passed to `send_cb`
+ * @param result    Filled with the number of windows and bytes, can be NULL
+ */
+void lvgl_port_round_flush(const lvgl_port_round_t *round, int x1, int y1, int x2, int y2, void *pixels, size_t px_size,
+                           lvgl_port_round_send_cb_t send_cb, void *user_ctx, lvgl_port_round_result_t *result);
+
+/**
+ * @brief Send the given spans of the area rows
+ *
+ * Same as lvgl_port_round_flush() with spans other than the visible circle, e.g. the changed part
+ * of each row.
+ *
+ * @param span_x1       First column to send of each screen row
+ * @param span_x2       Last column to send of each screen row (smaller than span_x1 for row not sent)
+ * @param trans_cost    Cost of one transaction in bytes
+ * @param x1            First column of the area
+ * @param y1            First row of the area
+ * @param x2            Last column of the area (inclusive)
+ * @param y2            Last row of the area (inclusive)
+ * @param pixels        Pixels of the area, modified
+ * @param px_size       Size of one pixel in bytes
+ * @param send_cb       Called for every window
+ * @param user_ctx      Passed to `send_cb`
+ * @param result        Filled with the number of windows and bytes, can be NULL
+ */
+void lvgl_port_round_flush_spans(const uint16_t *span_x1, const uint16_t *span_x2, uint32_t trans_cost,
+                                 int x1, int y1, int x2, int y2, void *pixels, size_t px_size,
+                                 lvgl_port_round_send_cb_t send_cb, void *user_ctx, lvgl_port_round_result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
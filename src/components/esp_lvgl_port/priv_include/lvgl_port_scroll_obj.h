@@ -0,0 +1,51 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief LVGL object of a scrolling texture
+ *
+ * Shows an image repeated horizontally in a fixed box, from a column of the image (its offset).
+ * Looping animations of a texture (waves, clouds, a moving background) change the offset instead
+ * of moving an image object, so only the box is invalidated, not the old and the new area of the
+ * image, and the objects under an opaque texture are not drawn at all. The copies of the image are
+ * drawn as plain images, opaque ones are copied row by row.
+ * Depends on LVGL only, so the simulator draws with the same object.
+ * All functions must be called from the LVGL task or with the LVGL mutex taken.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Create an object scrolling a texture
+ *
+ * @param parent    Parent object
+ * @param src       Image source of the texture, must stay valid while the object exists
+ * @return Object of the size of the texture, NULL when the image can't be opened
+ */
+lv_obj_t *lvgl_port_scroll_obj_create(lv_obj_t *parent, const void *src);
+
+/**
+ * @brief Set the column of the texture shown at the left of the box
+ *
+ * Redraws the box when the shown column changes.
+ *
+ * @param obj   Scroll object
+ * @param x     Column of the texture, any value, wrapped by the width of the texture
+ * @return false when obj is no scroll object
+ */
+bool lvgl_port_scroll_obj_set_offset(lv_obj_t *obj, lv_coord_t x);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,66 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief LVGL object of a sprite
+ *
+ * Draws the shown frame of a sprite (see lvgl_port_sprite.h) from the parts of its atlas, so the
+ * atlas is never copied and images compressed line by line decode the drawn rows only. A change of
+ * the frame invalidates the areas where the two frames differ, and sends LV_EVENT_VALUE_CHANGED.
+ * Animations run on the LVGL animations of the object.
+ * Depends on LVGL only, so the simulator draws with the same object.
+ * All functions must be called from the LVGL task or with the LVGL mutex taken.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include "lvgl.h"
+#include "lvgl_port_sprite.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Create an object showing the key frame of a sprite
+ *
+ * @param parent    Parent object
+ * @param sprite    Sprite, must stay valid while the object exists
+ * @return Object of the size of the frames, NULL when the sprite is invalid
+ */
+lv_obj_t *lvgl_port_sprite_obj_create(lv_obj_t *parent, const lvgl_port_sprite_t *sprite);
+
+/**
+ * @brief Play an animation from its start
+ *
+ * @param obj   Sprite object
+ * @param anim  Name of the animation
+ * @return false when obj is no sprite object or the sprite has no such animation
+ */
+bool lvgl_port_sprite_obj_play(lv_obj_t *obj, const char *anim);
+
+/**
+ * @brief Stop the animation and show a frame
+ *
+ * @param obj   Sprite object
+ * @param frame Name of the frame
+ * @return false when obj is no sprite object or the sprite has no such frame
+ */
+bool lvgl_port_sprite_obj_set_frame(lv_obj_t *obj, const char *frame);
+
+/**
+ * @brief Get the shown frame
+ *
+ * @param obj   Sprite object
+ * @return Name of the frame, NULL when obj is no sprite object
+ */
+const char *lvgl_port_sprite_obj_get_frame(const lv_obj_t *obj);
+
+#ifdef __cplusplus
+}
+#endif
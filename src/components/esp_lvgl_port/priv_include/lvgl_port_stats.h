@@ -0,0 +1,104 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Rolling frame statistics
+ *
+ * Keeps the metrics of the last frames in a ring and computes their percentiles.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of the last frames in the percentiles */
+#define LVGL_PORT_STATS_WINDOW  (64)
+
+/**
+ * @brief Frame metrics
+ */
+typedef enum {
+    LVGL_PORT_STATS_RENDER_US,      /*!< Refresh time without waiting for a free draw buffer */
+    LVGL_PORT_STATS_FLUSH_US,       /*!< Time from the first flush to the end of the last transfer */
+    LVGL_PORT_STATS_BYTES,          /*!< Pixel bytes sent */
+    LVGL_PORT_STATS_AREAS,          /*!< Refreshed areas */
+    LVGL_PORT_STATS_LOCK_WAIT_US,   /*!< Time the LVGL task waited for the LVGL mutex */
+    LVGL_PORT_STATS_HANDLER_US,     /*!< Time in lv_timer_handler() without the refresh */
+    LVGL_PORT_STATS_METRICS,
+} lvgl_port_stats_metric_t;
+
+/**
+ * @brief Metrics of one frame
+ */
+typedef struct {
+    uint32_t value[LVGL_PORT_STATS_METRICS];
+} lvgl_port_stats_sample_t;
+
+/**
+ * @brief Percentiles of one metric
+ */
+typedef struct {
+    uint32_t p50;
+    uint32_t p95;
+    uint32_t p99;
+    uint32_t max;
+} lvgl_port_stats_pct_t;
+
+/**
+ * @brief Statistics of the last frames
+ */
+typedef struct {
+    uint32_t ring[LVGL_PORT_STATS_METRICS][LVGL_PORT_STATS_WINDOW];
+    uint32_t head;      /*!< Next position in the ring */
+    uint32_t count;     /*!< Frames in the ring */
+    uint32_t frames;    /*!< All added frames */
+} lvgl_port_stats_t;
+
+/**
+ * @brief Clear the statistics
+ *
+ * @param stats Statistics
+ */
+void lvgl_port_stats_init(lvgl_port_stats_t *stats);
+
+/**
+ * @brief Add a frame, the oldest one is dropped when the ring is full
+ *
+ * Short enough to be called from an interrupt, the caller must serialize it with the other functions.
+ *
+ * @param stats     Statistics
+ * @param sample    Metrics of the frame
+ */
+void lvgl_port_stats_add(lvgl_port_stats_t *stats, const lvgl_port_stats_sample_t *sample);
+
+/**
+ * @brief Copy the values of one metric from the ring
+ *
+ * @param stats     Statistics
+ * @param metric    Metric
+ * @param values    Output buffer for LVGL_PORT_STATS_WINDOW values
+ * @return Number of copied values
+ */
+size_t lvgl_port_stats_copy(const lvgl_port_stats_t *stats, lvgl_port_stats_metric_t metric, uint32_t *values);
+
+/**
+ * @brief Percentiles (nearest rank) of the values
+ *
+ * @param values    Values, sorted in place
+ * @param count     Number of values, all percentiles are 0 when there is none
+ * @param pct       Output percentiles
+ */
+void lvgl_port_stats_percentiles(uint32_t *values, size_t count, lvgl_port_stats_pct_t *pct);
+
+#ifdef __cplusplus
+}
+#endif
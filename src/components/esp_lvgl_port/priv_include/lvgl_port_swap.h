@@ -0,0 +1,36 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Byte swap of RGB565 pixels
+ *
+ * LVGL renders in the native (little-endian) order and LCDs with SPI interface take big-endian
+ * colors, so the bytes are swapped just before a window is sent.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Swap bytes of RGB565 pixels in place
+ *
+ * Two pixels are swapped per 32-bit word, the buffer needs 2-byte alignment only.
+ *
+ * @param pixels    Pixels
+ * @param count     Number of pixels
+ */
+void lvgl_port_swap_rgb565(void *pixels, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Scalable fonts of the asset table
+ *
+ * One TrueType font per family is stored in the asset table (see lvgl_port_assets.h), subset by
+ * scripts/lvgl_port_ttf.py. Screens get an LVGL font of the family in any pixel size, its glyphs are
+ * rasterized by stb_truetype (of LVGL's tiny_ttf, used here without it) straight from the mapped
+ * table when first drawn. The 8 bpp glyphs of all families and sizes share one cache (see
+ * lvgl_port_cache.h) keyed by the font and the letter, bounded by bytes and evicting the least
+ * recently drawn glyphs first. Glyphs a screen will draw can be rasterized ahead, when it is created.
+ * A glyph not fitting the cache is rasterized into a buffer of its own on every draw.
+ * Depends on LVGL only, so the simulator draws with the same fonts.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "lvgl.h"
+#include "lvgl_port_cache.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Start the cache of rasterized glyphs
+ *
+ * Must be called from the LVGL task or with the LVGL mutex taken.
+ *
+ * @param budget    Bytes of the cached glyphs, with their entries
+ * @return true on success (also when started already, the budget stays)
+ */
+bool lvgl_port_ttf_init(size_t budget);
+
+/**
+ * @brief Free the fonts and the cached glyphs
+ *
+ * The fonts must not be drawn anymore.
+ */
+void lvgl_port_ttf_deinit(void);
+
+/**
+ * @brief Get a font of a family of the registered asset table
+ *
+ * Fonts are created once per family and size, all users of a size share it. Must be called from the
+ * LVGL task or with the LVGL mutex taken.
+ *
+ * @param family    Family, the name of the font file without the extension
+ * @param px        Size of the em square in pixels, like of the fonts of lv_font_conv
+ * @return Font, NULL when the table has no such family, the cache is not started or out of memory
+ */
+const lv_font_t *lvgl_port_ttf_get(const char *family, uint16_t px);
+
+/**
+ * @brief Rasterize the glyphs of a text into the cache
+ *
+ * @param font  Font of lvgl_port_ttf_get()
+ * @param text  UTF-8 text
+ * @return Number of glyphs rasterized, -1 when the font is not one of lvgl_port_ttf_get()
+ */
+int lvgl_port_ttf_prewarm(const lv_font_t *font, const char *text);
+
+/**
+ * @brief Get the statistics of the cache of rasterized glyphs
+ *
+ * @param stats Output statistics, misses are glyphs rasterized
+ */
+void lvgl_port_ttf_get_stats(lvgl_port_cache_layer_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,231 @@
+# Build time compression of LVGL images to the run-length encoding of the port
+#
+# lvgl_port_rle_images(<target> <image sources...>)
+#
+# Image sources made by the LVGL image converter are compressed by scripts/lvgl_port_img_rle.py
+# and the compressed sources are built into <target> instead of them, the originals must be left out
+# of its sources. The images are drawn by the decoder added with lvgl_port_add_rle_decoder().
+# Flash savings are printed and written to <binary dir>/lvgl_port_rle_images.csv.
+
+set(LVGL_PORT_RLE_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/scripts/lvgl_port_img_rle.py)
+
+function(lvgl_port_rle_images target)
+    if(COMMAND idf_build_get_property)
+        idf_build_get_property(python PYTHON)
+    else()
+        find_package(Python3 REQUIRED COMPONENTS Interpreter)
+        set(python ${Python3_EXECUTABLE})
+    endif()
+
+    set(out_dir ${CMAKE_CURRENT_BINARY_DIR}/rle_images)
+    set(report ${CMAKE_CURRENT_BINARY_DIR}/lvgl_port_rle_images.csv)
+    set(sources)
+    set(outputs)
+    foreach(source ${ARGN})
+        get_filename_component(source ${source} ABSOLUTE)
+        get_filename_component(name ${source} NAME)
+        list(APPEND sources ${source})
+        list(APPEND outputs ${out_dir}/${name})
+    endforeach()
+
+    add_custom_command(OUTPUT ${outputs}
+                       COMMAND ${python} ${LVGL_PORT_RLE_SCRIPT} --out-dir ${out_dir} --report ${report} ${sources}
+                       DEPENDS ${sources} ${LVGL_PORT_RLE_SCRIPT}
+                       COMMENT "Compressing ${target} images"
+                       VERBATIM)
+    target_sources(${target} PRIVATE ${outputs})
+endfunction()
+
+# Asset partition of LVGL images
+#
+# lvgl_port_assets_partition(<target> <partition> IMAGES <image sources...> [COMPRESS <image sources...>]
+#                            [MIN_PSNR <dB>] [FONTS <TrueType fonts...>] [FONT_CHARS <characters>]
+#                            [FLASH_IN_PROJECT])
+#
+# The images are built by scripts/lvgl_port_assets.py into an asset table <build dir>/<partition>.bin
+# and flashed by `idf.py <partition>-flash` (and `idf.py flash` with
+# FLASH_IN_PROJECT). <target> gets descriptors of the same names instead of the image sources, which
+# must be left out of its sources. They depend on the names only, so changed art rebuilds and
+# reflashes only the partition. COMPRESS images are never zoomed or rotated, they are stored raw,
+# run-length encoded or indexed (quantized to at least MIN_PSNR, 42 dB by default), whichever is
+# the smallest. The images are drawn after lvgl_port_add_assets(<partition>). FONTS are subset by
+# scripts/lvgl_port_ttf.py to printable ASCII and FONT_CHARS and drawn in any size by
+# lvgl_port_get_ttf_font(<family>, <px>), the family is the name of the file without the extension.
+# Sizes are printed and written to <binary dir>/<partition>_assets.csv.
+
+set(LVGL_PORT_ASSETS_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/scripts/lvgl_port_assets.py)
+set(LVGL_PORT_INDEX_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/scripts/lvgl_port_img_index.py)
+set(LVGL_PORT_TTF_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/scripts/lvgl_port_ttf.py)
+
+function(lvgl_port_assets_partition target partition)
+    cmake_parse_arguments(arg "FLASH_IN_PROJECT" "MIN_PSNR;FONT_CHARS" "IMAGES;COMPRESS;FONTS" ${ARGN})
+    if(COMMAND idf_build_get_property)
+        idf_build_get_property(python PYTHON)
+    else()
+        find_package(Python3 REQUIRED COMPONENTS Interpreter)
+        set(python ${Python3_EXECUTABLE})
+    endif()
+
+    set(image_file ${CMAKE_BINARY_DIR}/${partition}.bin)
+    set(stubs ${CMAKE_CURRENT_BINARY_DIR}/${partition}_assets.c)
+    set(report ${CMAKE_CURRENT_BINARY_DIR}/${partition}_assets.csv)
+    set(images)
+    set(compress_args)
+    foreach(source ${arg_IMAGES})
+        get_filename_component(source ${source} ABSOLUTE)
+        list(APPEND images ${source})
+    endforeach()
+    foreach(source ${arg_COMPRESS})
+        get_filename_component(source ${source} ABSOLUTE)
+        list(APPEND compress_args --compress ${source})
+    endforeach()
+    if(arg_MIN_PSNR)
+        list(APPEND compress_args --min-psnr ${arg_MIN_PSNR})
+    endif()
+    set(fonts)
+    foreach(font ${arg_FONTS})
+        get_filename_component(font ${font} ABSOLUTE)
+        list(APPEND fonts ${font})
+        list(APPEND compress_args --font ${font})
+    endforeach()
+    if(arg_FONT_CHARS)
+        list(APPEND compress_args --font-chars ${arg_FONT_CHARS})
+    endif()
+
+    # Written at configure time and only when the list of names changes
+    execute_process(COMMAND ${python} ${LVGL_PORT_ASSETS_SCRIPT} --stubs ${stubs} ${images}
+                    RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Generating image descriptors of partition ${partition} failed")
+    endif()
+    target_sources(${target} PRIVATE ${stubs})
+
+    set(size_args)
+    if(COMMAND partition_table_get_partition_info)
+        partition_table_get_partition_info(size "--partition-name ${partition}" "size")
+        partition_table_get_partition_info(offset "--partition-name ${partition}" "offset")
+        if(NOT "${size}" OR NOT "${offset}")
+            fail_at_build_time(${partition}_assets_bin "Failed to create asset table for partition '${partition}'. "
+                               "Check project configuration if using the correct partition table file.")
+            return()
+        endif()
+        set(size_args --max-size ${size})
+    endif()
+
+    add_custom_command(OUTPUT ${image_file}
+                       COMMAND ${python} ${LVGL_PORT_ASSETS_SCRIPT} --bin ${image_file} --report ${report} ${size_args} ${compress_args} ${images}
+                       DEPENDS ${images} ${fonts} ${LVGL_PORT_ASSETS_SCRIPT} ${LVGL_PORT_RLE_SCRIPT} ${LVGL_PORT_INDEX_SCRIPT} ${LVGL_PORT_TTF_SCRIPT}
+                       COMMENT "Building asset table of partition ${partition}"
+                       VERBATIM)
+    add_custom_target(${partition}_assets_bin ALL DEPENDS ${image_file})
+
+    if(COMMAND esptool_py_flash_to_partition)
+        idf_component_get_property(main_args esptool_py FLASH_ARGS)
+        idf_component_get_property(sub_args esptool_py FLASH_SUB_ARGS)
+        esptool_py_flash_target(${partition}-flash "${main_args}" "${sub_args}" ALWAYS_PLAINTEXT)
+        esptool_py_flash_to_partition(${partition}-flash "${partition}" "${image_file}")
+        add_dependencies(${partition}-flash ${partition}_assets_bin)
+        if(arg_FLASH_IN_PROJECT)
+            esptool_py_flash_to_partition(flash "${partition}" "${image_file}")
+            add_dependencies(flash ${partition}_assets_bin)
+        endif()
+    endif()
+endfunction()
+
+# Sprite atlases
+#
+# lvgl_port_sprites(<target> <images var> <sprite descriptions...>)
+#
+# Each description <name>.sprite is built by scripts/lvgl_port_sprite.py into the sprite `<name>`,
+# which is added to <target>, and its atlas image `<name>_atlas`. The atlas sources are returned in
+# <images var>, to be built like the other images of <target> (compressed with
+# lvgl_port_rle_images() or into lvgl_port_assets_partition()). They are written at configure time
+# and only when they change, editing a description or its images reruns the configuration.
+# Sprites are drawn by lvgl_port_create_sprite().
+
+set(LVGL_PORT_SPRITE_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/scripts/lvgl_port_sprite.py)
+
+function(lvgl_port_sprites target images_var)
+    if(COMMAND idf_build_get_property)
+        idf_build_get_property(python PYTHON)
+    else()
+        find_package(Python3 REQUIRED COMPONENTS Interpreter)
+        set(python ${Python3_EXECUTABLE})
+    endif()
+
+    set(out_dir ${CMAKE_CURRENT_BINARY_DIR}/sprites)
+    set(images)
+    foreach(sprite ${ARGN})
+        get_filename_component(sprite ${sprite} ABSOLUTE)
+        get_filename_component(name ${sprite} NAME_WE)
+        execute_process(COMMAND ${python} ${LVGL_PORT_SPRITE_SCRIPT} --images ${sprite}
+                        OUTPUT_VARIABLE inputs RESULT_VARIABLE result)
+        if(NOT result EQUAL 0)
+            message(FATAL_ERROR "Reading sprite ${sprite} failed")
+        endif()
+        string(STRIP "${inputs}" inputs)
+        string(REPLACE "\n" ";" inputs "${inputs}")
+        execute_process(COMMAND ${python} ${LVGL_PORT_SPRITE_SCRIPT} --out-dir ${out_dir} ${sprite}
+                        RESULT_VARIABLE result)
+        if(NOT result EQUAL 0)
+            message(FATAL_ERROR "Building sprite ${sprite} failed")
+        endif()
+        set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${sprite} ${inputs} ${LVGL_PORT_SPRITE_SCRIPT})
+        target_sources(${target} PRIVATE ${out_dir}/${name}.c)
+        list(APPEND images ${out_dir}/${name}_atlas.c)
+    endforeach()
+    set(${images_var} ${images} PARENT_SCOPE)
+endfunction()
+
+# Fonts subset to the UI texts
+#
+# lvgl_port_subset_fonts(<target> FONTS <font sources...> TEXT <sources...> [CHARS <characters>] [COMPRESS])
+#
+# Font sources made by lv_font_conv are rebuilt by scripts/lvgl_port_font.py with only the glyphs of
+# the characters in string literals of the TEXT sources and in CHARS (characters of texts formatted
+# at run time, like digits), and built into <target> instead of them. The originals must be left
+# out of its sources. COMPRESS stores the glyphs compressed (needs LV_USE_FONT_COMPRESSED), they are
+# decoded into the cache added with lvgl_port_add_font_cache().
+# Flash savings are printed and written to <binary dir>/lvgl_port_fonts.csv.
+
+set(LVGL_PORT_FONT_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/scripts/lvgl_port_font.py)
+
+function(lvgl_port_subset_fonts target)
+    cmake_parse_arguments(arg "COMPRESS" "CHARS" "FONTS;TEXT" ${ARGN})
+    if(COMMAND idf_build_get_property)
+        idf_build_get_property(python PYTHON)
+    else()
+        find_package(Python3 REQUIRED COMPONENTS Interpreter)
+        set(python ${Python3_EXECUTABLE})
+    endif()
+
+    set(out_dir ${CMAKE_CURRENT_BINARY_DIR}/fonts)
+    set(report ${CMAKE_CURRENT_BINARY_DIR}/lvgl_port_fonts.csv)
+    set(fonts)
+    set(texts)
+    set(outputs)
+    foreach(source ${arg_FONTS})
+        get_filename_component(source ${source} ABSOLUTE)
+        get_filename_component(name ${source} NAME)
+        list(APPEND fonts ${source})
+        list(APPEND outputs ${out_dir}/${name})
+    endforeach()
+    foreach(source ${arg_TEXT})
+        get_filename_component(source ${source} ABSOLUTE)
+        list(APPEND texts ${source})
+    endforeach()
+    set(args)
+    if(arg_CHARS)
+        list(APPEND args --chars ${arg_CHARS})
+    endif()
+    if(arg_COMPRESS)
+        list(APPEND args --compress)
+    endif()
+
+    add_custom_command(OUTPUT ${outputs}
+                       COMMAND ${python} ${LVGL_PORT_FONT_SCRIPT} --out-dir ${out_dir} --report ${report} ${args} ${fonts} --text ${texts}
+                       DEPENDS ${fonts} ${texts} ${LVGL_PORT_FONT_SCRIPT}
+                       COMMENT "Subsetting ${target} fonts"
+                       VERBATIM)
+    target_sources(${target} PRIVATE ${outputs})
+endfunction()
@@ -0,0 +1,180 @@
+#!/usr/bin/env python
+#
+# SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Build an asset table of LVGL images and TrueType fonts for a data partition.
+
+The images are read from image sources of the LVGL image converter, named as the image descriptors.
+`--bin` writes the table (see lvgl_port_assets.h). Images given with `--compress` are drawn line by
+line, so they are stored in the smallest of: raw, run-length encoded like by lvgl_port_img_rle.py
+and indexed like by lvgl_port_img_index.py with a quality of at least `--min-psnr`.
+`--stubs` writes a source with a descriptor of each image
+referring to its asset by the index and the name, which depend only on the list of names. Changed
+art rebuilds only the table, not the application.
+Fonts given with `--font` follow the images, subset by lvgl_port_ttf.py to printable ASCII and
+`--font-chars`. They are found by their family, the name of the file without the extension.
+"""
+
+import argparse
+import math
+import os
+import struct
+import sys
+
+sys.dont_write_bytecode = True  # Runs from the component directory
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import lvgl_port_img_index as index  # noqa: E402
+import lvgl_port_img_rle as rle  # noqa: E402
+import lvgl_port_ttf as ttf  # noqa: E402
+
+MAGIC = 0x31545341
+REF_MAGIC = 0x46455241
+HEADER_SIZE = 16
+ENTRY_SIZE = 20
+ALIGN = 4
+RAW = 0
+RLE = 1
+FONT = 2
+
+
+def name_of(source):
+    return os.path.splitext(os.path.basename(source))[0]
+
+
+def fnv1a(name):
+    h = 2166136261
+    for c in name.encode():
+        h = ((h ^ c) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def write_if_changed(path, data):
+    """Keep the timestamp of unchanged outputs, so nothing depending on them is rebuilt"""
+    mode = 'b' if isinstance(data, bytes) else ''
+    if os.path.exists(path):
+        with open(path, 'r' + mode) as f:
+            if f.read() == data:
+                return
+    with open(path, 'w' + mode) as f:
+        f.write(data)
+
+
+def smallest(img, compress, min_psnr):
+    """(blob, cf, encoding, format, psnr) of the smallest format"""
+    best = (img.data, img.cf, RAW, 'raw', float('inf'))
+    if not compress:
+        return best
+    blob = rle.encode(img)
+    if len(blob) < len(best[0]):
+        best = (blob, img.cf, RLE, 'rle', float('inf'))
+    indexed = index.convert(img, min_psnr, max_size=len(best[0]))
+    if indexed:
+        bpp, quality, blob = indexed
+        best = (blob, index.CF_INDEXED[bpp], RAW, 'i{}'.format(bpp), quality)
+    return best
+
+
+def build_table(sources, compress_sources, min_psnr, fonts=(), font_chars=''):
+    compress_names = set(name_of(s) for s in compress_sources)
+    if not compress_names <= set(name_of(s) for s in sources):
+        raise ValueError('Compressed images {} are not assets'.format(', '.join(sorted(compress_names - set(name_of(s) for s in sources)))))
+    entries = []
+    blobs = bytearray()
+    offset = HEADER_SIZE + ENTRY_SIZE * (len(sources) + len(fonts))
+    report = []
+
+    for source in sources:
+        img = rle.Image(source)
+        if img.name != name_of(source):
+            raise ValueError('{}: image {} must be named as its source'.format(source, img.name))
+        blob, cf, encoding, fmt, quality = smallest(img, img.name in compress_names, min_psnr)
+        pad = -(offset + len(blobs)) % ALIGN
+        blobs.extend(b'\0' * pad)
+        entries.append(struct.pack('<IIIHHBBH', offset + len(blobs), len(blob), fnv1a(img.name), img.w, img.h, cf, encoding, 0))
+        blobs.extend(blob)
+        report.append((img.name, img.w, img.h, fmt, len(img.data), len(blob), quality))
+
+    for source in fonts:
+        with open(source, 'rb') as f:
+            data = f.read()
+        try:
+            blob, glyphs, _ = ttf.subset(data, ttf.ASCII + font_chars)
+        except (ValueError, struct.error) as e:
+            raise ValueError('{}: {}'.format(source, e))
+        units_per_em = struct.unpack_from('>H', blob, ttf.Font(blob).tables['head'][0] + 18)[0]
+        pad = -(offset + len(blobs)) % ALIGN
+        blobs.extend(b'\0' * pad)
+        entries.append(struct.pack('<IIIHHBBH', offset + len(blobs), len(blob), fnv1a(name_of(source)), units_per_em, glyphs, 0, FONT, 0))
+        blobs.extend(blob)
+        report.append((name_of(source), units_per_em, glyphs, 'ttf', len(data), len(blob), float('inf')))
+
+    size = offset + len(blobs)
+    return struct.pack('<IIII', MAGIC, len(sources) + len(fonts), size, 0) + b''.join(entries) + bytes(blobs), report
+
+
+def stubs(sources):
+    out = ['/* Generated by lvgl_port_assets.py, do not edit */\n',
+           '#if defined(LV_LVGL_H_INCLUDE_SIMPLE)\n#include "lvgl.h"\n#else\n#include "lvgl/lvgl.h"\n#endif\n',
+           '/* Images of the asset partition, drawn by the decoder added with lvgl_port_add_assets() */']
+    for i, source in enumerate(sources):
+        name = name_of(source)
+        out.append('static const uint32_t {0}_ref[] = {{0x{1:08x}, {2}, 0x{3:08x}}};\n'
+                   'const lv_img_dsc_t {0} = {{\n'
+                   '  .header.cf = LV_IMG_CF_USER_ENCODED_1,\n'
+                   '  .data_size = sizeof({0}_ref),\n'
+                   '  .data = (const uint8_t *){0}_ref,\n'
+                   '}};'.format(name, REF_MAGIC, i, fnv1a(name)))
+    return '\n'.join(out) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('sources', nargs='+', help='LVGL image C sources, in the order of the table')
+    parser.add_argument('-b', '--bin', help='Write the asset table to this file')
+    parser.add_argument('-s', '--stubs', help='Write the image descriptors to this C source')
+    parser.add_argument('--compress', action='append', default=[], help='Source of an image drawn line by line, which may be stored compressed, repeated for each')
+    parser.add_argument('--min-psnr', type=float, default=42.0, help='Lowest quality of indexed images in dB (default 42)')
+    parser.add_argument('--font', action='append', default=[], help='TrueType font, repeated for each family')
+    parser.add_argument('--font-chars', default='', help='Characters kept in the fonts in addition to printable ASCII')
+    parser.add_argument('--max-size', type=lambda v: int(v, 0), help='Size of the partition, fail when the table does not fit')
+    parser.add_argument('-r', '--report', help='Write the sizes as CSV to this file')
+    args = parser.parse_args()
+
+    names = [name_of(s) for s in args.sources + args.font]
+    if len(set(names)) != len(names):
+        sys.exit('Image and font names must be unique')
+
+    if args.stubs:
+        write_if_changed(args.stubs, stubs(args.sources))
+    if not args.bin:
+        return
+
+    try:
+        table, report = build_table(args.sources, args.compress, args.min_psnr, args.font, args.font_chars)
+    except ValueError as e:
+        sys.exit(str(e))
+
+    for name, w, h, fmt, raw, stored, quality in report:
+        if fmt == 'ttf':
+            print('{:<24} {:>4} glyphs ttf {:>7} -> {:>7} bytes'.format(name, h, raw, stored))
+            continue
+        print('{:<24} {:>3}x{:<3} {:<3} {:>7} -> {:>7} bytes{}'.format(name, w, h, fmt, raw, stored, '' if math.isinf(quality) else ', {:.1f} dB'.format(quality)))
+    raw = sum(r[4] for r in report)
+    print('{} assets, {} bytes of pixels and fonts stored in {} bytes{}'.format(
+        len(report), raw, len(table), ' of {} ({:.0f}% used)'.format(args.max_size, 100.0 * len(table) / args.max_size) if args.max_size else ''))
+    if args.max_size and len(table) > args.max_size:
+        sys.exit('Asset table of {} bytes does not fit the partition of {} bytes'.format(len(table), args.max_size))
+
+    write_if_changed(args.bin, table)
+    if args.report:
+        with open(args.report, 'w') as f:
+            f.write('image,width,height,format,raw_bytes,stored_bytes,psnr_db\n')
+            for r in report:
+                f.write('{},{},{},{},{},{},{}\n'.format(*(r[:6] + ('lossless' if math.isinf(r[6]) else '{:.1f}'.format(r[6]),))))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,622 @@
+#!/usr/bin/env python
+#
+# SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Subset LVGL fonts to the characters of the UI texts and compress their glyphs.
+
+Takes font sources made by lv_font_conv and writes sources of the same fonts with only the glyphs of
+the characters found in string literals of the text sources (literals of log and print calls and of
+preprocessor lines are left out) and given by --chars, for texts formatted at run time. Glyph ids,
+character maps and kerning are rebuilt for the kept glyphs, kerning classes no kept glyph uses are
+dropped.
+
+With --compress the glyph bitmaps are stored in the compressed format of LVGL (`bitmap_format` 1 or
+2, with or without the line prefilter, whichever is smaller), which needs LV_USE_FONT_COMPRESSED.
+Such fonts get their bitmaps from lvgl_port_font_get_bitmap() of esp_lvgl_port, which keeps the
+decoded glyphs in the cache added by lvgl_port_add_font_cache(), so a glyph is decoded once and not
+on every draw.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+LOG_CALLS = re.compile(r'^(ESP_LOG[EWIDV]|ESP_EARLY_LOG[EWIDV]|ESP_DRAM_LOG[EWIDV]|ESP_RETURN_ON_\w+|ESP_GOTO_ON_\w+|'
+                       r'ESP_ERROR_CHECK\w*|BSP_\w+CHECK\w*|LV_LOG\w*|printf|fprintf|snprintf|sprintf|puts)$')
+
+GLYPH_DSC = re.compile(r'\{\s*\.bitmap_index\s*=\s*(\d+),\s*\.adv_w\s*=\s*(\d+),\s*\.box_w\s*=\s*(\d+),\s*'
+                       r'\.box_h\s*=\s*(\d+),\s*\.ofs_x\s*=\s*(-?\d+),\s*\.ofs_y\s*=\s*(-?\d+)\s*\}')
+CMAP = re.compile(r'\.range_start\s*=\s*(\d+),\s*\.range_length\s*=\s*(\d+),\s*\.glyph_id_start\s*=\s*(\d+),\s*'
+                  r'\.unicode_list\s*=\s*(\w+),\s*\.glyph_id_ofs_list\s*=\s*(\w+),\s*\.list_length\s*=\s*(\d+),\s*'
+                  r'\.type\s*=\s*(\w+)')
+
+# Bytes of the structures on a 32-bit target
+GLYPH_DSC_SIZE = 8
+CMAP_SIZE = 20
+
+# Runs of consecutive characters at least this long get a cmap of their own (FORMAT0_TINY)
+MIN_RANGE = 8
+
+
+def strip_comments(text):
+    text = re.sub(r'/\*.*?\*/', ' ', text, flags=re.S)
+    return re.sub(r'//[^\n]*', ' ', text)
+
+
+def field(text, name, default=None):
+    m = re.search(r'\.' + name + r'\s*=\s*([^,\s]+)', text)
+    if not m:
+        if default is None:
+            raise ValueError('no .{} in font'.format(name))
+        return default
+    return m.group(1)
+
+
+def array(text, name):
+    m = re.search(r'\b' + name + r'\[\]\s*=\s*\{(.*?)\};', text, flags=re.S)
+    if not m:
+        raise ValueError('no array {} in font'.format(name))
+    return [int(v, 0) for v in re.findall(r'-?(?:0x[0-9a-fA-F]+|\d+)', m.group(1))]
+
+
+class Font:
+    def __init__(self, path):
+        with open(path, 'r', encoding='utf-8') as f:
+            raw = f.read()
+        self.path = path
+        m = re.search(r'\*\s*Size:\s*(\d+)\s*px', raw)
+        self.size = int(m.group(1)) if m else 0
+        m = re.search(r'\*\s*Opts:([^\n]*)', raw)
+        self.opts = m.group(1).strip() if m else ''
+        m = re.search(r'#ifndef\s+(\w+)\s*\n\s*#define\s+\1\s+1', raw)
+        if not m:
+            raise ValueError('{}: no lv_font_conv font'.format(path))
+        self.guard = m.group(1)
+
+        text = strip_comments(raw)
+        m = re.search(r'lv_font_t\s+(\w+)\s*=\s*\{(.*?)\};', text, flags=re.S)
+        if not m:
+            raise ValueError('{}: no public font'.format(path))
+        self.name = m.group(1)
+        public = m.group(2)
+        self.line_height = int(field(public, 'line_height'))
+        self.base_line = int(field(public, 'base_line'))
+        self.subpx = field(public, 'subpx', 'LV_FONT_SUBPX_NONE')
+        self.underline_position = int(field(public, 'underline_position', '0'))
+        self.underline_thickness = int(field(public, 'underline_thickness', '0'))
+
+        m = re.search(r'lv_font_fmt_txt_dsc_t\s+font_dsc\s*=\s*\{(.*?)\};', text, flags=re.S)
+        dsc = m.group(1)
+        self.bpp = int(field(dsc, 'bpp'))
+        self.kern_scale = int(field(dsc, 'kern_scale'))
+        if int(field(dsc, 'bitmap_format')) != 0:
+            raise ValueError('{}: font is compressed already'.format(path))
+
+        bitmap = bytes(array(text, 'glyph_bitmap'))
+        dscs = [tuple(int(v) for v in g) for g in GLYPH_DSC.findall(text)]
+        # Glyph ids index the lists below, 0 is reserved
+        self.dsc = [None]
+        self.px = [None]
+        for index, adv_w, w, h, ofs_x, ofs_y in dscs[1:]:
+            size = (w * h * self.bpp + 7) // 8
+            self.dsc.append((adv_w, w, h, ofs_x, ofs_y))
+            self.px.append(unpack(bitmap[index:index + size], w * h, self.bpp))
+
+        self.glyphs = {}
+        self.cmap_size = 0
+        for start, length, gid_start, ulist, ofs_list, count, kind in CMAP.findall(text):
+            start, length, gid_start, count = int(start), int(length), int(gid_start), int(count)
+            self.cmap_size += CMAP_SIZE + 2 * count
+            if kind == 'LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL':
+                self.cmap_size += length
+            elif kind == 'LV_FONT_FMT_TXT_CMAP_SPARSE_FULL':
+                self.cmap_size += 2 * count
+            if kind == 'LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY':
+                for i in range(length):
+                    self.glyphs[start + i] = gid_start + i
+            elif kind == 'LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL':
+                ofs = array(text, ofs_list)
+                for i in range(length):
+                    if i == 0 or ofs[i] != 0:
+                        self.glyphs[start + i] = gid_start + ofs[i]
+            elif kind == 'LV_FONT_FMT_TXT_CMAP_SPARSE_TINY':
+                for i, u in enumerate(array(text, ulist)[:count]):
+                    self.glyphs[start + u] = gid_start + i
+            elif kind == 'LV_FONT_FMT_TXT_CMAP_SPARSE_FULL':
+                ofs = array(text, ofs_list)
+                for i, u in enumerate(array(text, ulist)[:count]):
+                    self.glyphs[start + u] = gid_start + ofs[i]
+            else:
+                raise ValueError('{}: unknown cmap type {}'.format(path, kind))
+
+        # Kerning as a function of two glyph ids
+        self.kern_classes = None
+        self.kern_pairs = {}
+        if field(dsc, 'kern_dsc') == 'NULL':
+            pass
+        elif int(field(dsc, 'kern_classes')) == 1:
+            m = re.search(r'kern_classes\s*=\s*\{(.*?)\};', text, flags=re.S)
+            self.kern_classes = (array(text, 'kern_left_class_mapping'), array(text, 'kern_right_class_mapping'),
+                                 array(text, 'kern_class_values'),
+                                 int(field(m.group(1), 'left_class_cnt')), int(field(m.group(1), 'right_class_cnt')))
+        else:
+            ids = array(text, 'kern_pair_glyph_ids')
+            values = array(text, 'kern_pair_values')
+            for i, v in enumerate(values):
+                self.kern_pairs[(ids[2 * i], ids[2 * i + 1])] = v
+
+    def data_size(self):
+        """Bytes of the glyphs, character maps and kerning, as built by the original source"""
+        bitmap = sum((len(px) * self.bpp + 7) // 8 for px in self.px[1:])
+        size = bitmap + GLYPH_DSC_SIZE * len(self.dsc) + self.cmap_size
+        if self.kern_classes:
+            left, right, values, _, _ = self.kern_classes
+            size += len(left) + len(right) + len(values)
+        size += 3 * len(self.kern_pairs)
+        return size
+
+
+def unpack(data, count, bpp):
+    """Pixels of a glyph, packed MSB first without row padding"""
+    px = []
+    mask = (1 << bpp) - 1
+    for i in range(count):
+        bit = i * bpp
+        v = (data[bit // 8] << 8 | (data[bit // 8 + 1] if bit // 8 + 1 < len(data) else 0)) >> (16 - bit % 8 - bpp)
+        px.append(v & mask)
+    return px
+
+
+class Bits:
+    def __init__(self):
+        self.data = bytearray()
+        self.len = 0
+
+    def put(self, v, n):
+        for i in range(n - 1, -1, -1):
+            if self.len % 8 == 0:
+                self.data.append(0)
+            if (v >> i) & 1:
+                self.data[-1] |= 0x80 >> (self.len % 8)
+            self.len += 1
+
+
+def pack(px, bpp):
+    bits = Bits()
+    for v in px:
+        bits.put(v, bpp)
+    return bytes(bits.data)
+
+
+def prefilter(px, w):
+    return [v ^ px[i - w] if i >= w else v for i, v in enumerate(px)]
+
+
+def compress(px, bpp):
+    """Encode pixels for rle_next() of LVGL (lv_font_fmt_txt.c)
+
+    A value equal to the previous one switches to repeat mode: each further pixel is a bit, 1 for
+    the previous value, 0 followed by a new value. The 11th 1 bit in a row is followed by a 6 bit
+    count c: 0 when the pixel is a new value, else the pixel and the next c - 1 ones repeat and a
+    new value follows.
+    """
+    bits = Bits()
+    n = len(px)
+    i = 0
+    prev = None
+    while i < n:
+        # Single mode
+        v = px[i]
+        bits.put(v, bpp)
+        i += 1
+        if v != prev:
+            prev = v
+            continue
+        # Repeat mode
+        ones = 0
+        while i < n:
+            if px[i] != prev:
+                bits.put(0, 1)
+                bits.put(px[i], bpp)
+                prev = px[i]
+                i += 1
+                break
+            bits.put(1, 1)
+            ones += 1
+            if ones < 11:
+                i += 1
+                continue
+            run = 1
+            while i + run < n and px[i + run] == prev and run < 63:
+                run += 1
+            bits.put(run, 6)
+            i += run
+            if i < n:
+                bits.put(px[i], bpp)
+                prev = px[i]
+                i += 1
+            break
+    return bytes(bits.data)
+
+
+def decompress(data, count, bpp):
+    """Reference decoder, the same as rle_next() of LVGL"""
+    def get(pos, n):
+        v = 0
+        for k in range(n):
+            byte = data[(pos + k) // 8] if (pos + k) // 8 < len(data) else 0
+            v = v << 1 | (byte >> (7 - (pos + k) % 8)) & 1
+        return v
+
+    out = []
+    rdp = 0
+    state = 'single'
+    prev = 0
+    cnt = 0
+    for _ in range(count):
+        if state == 'single':
+            ret = get(rdp, bpp)
+            if rdp != 0 and prev == ret:
+                cnt = 0
+                state = 'repeat'
+            prev = ret
+            rdp += bpp
+        elif state == 'repeat':
+            v = get(rdp, 1)
+            cnt += 1
+            rdp += 1
+            if v == 1:
+                ret = prev
+                if cnt == 11:
+                    cnt = get(rdp, 6)
+                    rdp += 6
+                    if cnt != 0:
+                        state = 'counter'
+                    else:
+                        ret = get(rdp, bpp)
+                        prev = ret
+                        rdp += bpp
+                        state = 'single'
+            else:
+                ret = get(rdp, bpp)
+                prev = ret
+                rdp += bpp
+                state = 'single'
+        else:
+            ret = prev
+            cnt -= 1
+            if cnt == 0:
+                ret = get(rdp, bpp)
+                prev = ret
+                rdp += bpp
+                state = 'single'
+        out.append(ret)
+    return out
+
+
+def text_chars(path):
+    """Characters of the string literals of a C source"""
+    with open(path, 'r', encoding='utf-8') as f:
+        src = f.read()
+    chars = set()
+    calls = []          # Function of each open parenthesis
+    ident = ''
+    line_start = True
+    i = 0
+    n = len(src)
+    while i < n:
+        c = src[i]
+        if src.startswith('/*', i):
+            i = src.find('*/', i + 2)
+            i = n if i < 0 else i + 2
+            continue
+        if src.startswith('//', i) or (c == '#' and line_start):
+            # Comments and preprocessor lines (with their continuations)
+            while i < n and src[i] != '\n':
+                i += 2 if src[i] == '\\' else 1
+            continue
+        if c == '"' or c == "'":
+            j = i + 1
+            literal = []
+            while j < n and src[j] != c:
+                if src[j] == '\\' and j + 1 < n:
+                    j += 1
+                    literal.append({'n': '\n', 't': '\t', 'r': '\r'}.get(src[j], src[j]))
+                else:
+                    literal.append(src[j])
+                j += 1
+            if c == '"' and not any(LOG_CALLS.match(f) for f in calls):
+                chars.update(ord(ch) for ch in literal)
+            i = j + 1
+            ident = ''
+            line_start = False
+            continue
+        if c.isalnum() or c == '_':
+            ident = ident + c if ident or not c.isdigit() else ''
+        elif c == '(':
+            calls.append(ident)
+            ident = ''
+        elif c == ')':
+            if calls:
+                calls.pop()
+            ident = ''
+        elif not c.isspace():
+            ident = ''
+        if c == '\n':
+            line_start = True
+        elif not c.isspace():
+            line_start = False
+        i += 1
+    return chars
+
+
+def cmap_ranges(cps):
+    """Character maps of sorted code points: (start, FORMAT0_TINY or SPARSE_TINY, code points)"""
+    runs = []
+    for cp in cps:
+        if runs and cp == runs[-1][-1] + 1:
+            runs[-1].append(cp)
+        else:
+            runs.append([cp])
+    cmaps = []
+    sparse = []
+    for run in runs:
+        if len(run) >= MIN_RANGE:
+            if sparse:
+                cmaps.append(('LV_FONT_FMT_TXT_CMAP_SPARSE_TINY', sparse))
+                sparse = []
+            cmaps.append(('LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY', run))
+            continue
+        for cp in run:
+            if sparse and cp - sparse[0] > 0xFFFF:
+                cmaps.append(('LV_FONT_FMT_TXT_CMAP_SPARSE_TINY', sparse))
+                sparse = []
+            sparse.append(cp)
+    if sparse:
+        cmaps.append(('LV_FONT_FMT_TXT_CMAP_SPARSE_TINY', sparse))
+    return [(run[0], kind, run) for kind, run in cmaps]
+
+
+class Subset:
+    def __init__(self, font, chars, compressed):
+        self.font = font
+        self.cps = sorted(cp for cp in font.glyphs if cp in chars)
+        self.old_ids = [None] + [font.glyphs[cp] for cp in self.cps]
+        self.cmaps = cmap_ranges(self.cps)
+
+        bpp = font.bpp
+        plain = [pack(font.px[g], bpp) for g in self.old_ids[1:]]
+        self.format = 0
+        self.bitmaps = plain
+        if compressed:
+            best = sum(len(b) for b in plain)
+            for fmt, filtered in ((1, True), (2, False)):
+                data = []
+                for g in self.old_ids[1:]:
+                    px = font.px[g]
+                    w = font.dsc[g][1]
+                    src = prefilter(px, w) if filtered and w else px
+                    enc = compress(src, bpp) if px else b''
+                    if decompress(enc, len(src), bpp) != src:
+                        raise AssertionError('glyph {} of {} does not decode'.format(g, font.name))
+                    data.append(enc)
+                size = sum(len(b) for b in data)
+                if size < best:
+                    best = size
+                    self.format = fmt
+                    self.bitmaps = data
+
+        # Kerning classes of the kept glyphs, renumbered
+        self.kern = None
+        self.kern_pairs = []
+        if font.kern_classes:
+            left, right, values, left_cnt, right_cnt = font.kern_classes
+            used_left = sorted(set(left[g] for g in self.old_ids[1:]) - {0})
+            used_right = sorted(set(right[g] for g in self.old_ids[1:]) - {0})
+            new_left = {c: i + 1 for i, c in enumerate(used_left)}
+            new_right = {c: i + 1 for i, c in enumerate(used_right)}
+            class_values = [values[(lc - 1) * right_cnt + (rc - 1)] for lc in used_left for rc in used_right]
+            if any(class_values):
+                self.kern = ([0] + [new_left.get(left[g], 0) for g in self.old_ids[1:]],
+                             [0] + [new_right.get(right[g], 0) for g in self.old_ids[1:]],
+                             class_values, len(used_left), len(used_right))
+        elif font.kern_pairs:
+            new_id = {g: i for i, g in enumerate(self.old_ids) if g}
+            self.kern_pairs = sorted((new_id[a], new_id[b], v) for (a, b), v in font.kern_pairs.items()
+                                     if a in new_id and b in new_id)
+
+    def data_size(self):
+        size = sum(len(b) for b in self.bitmaps) + GLYPH_DSC_SIZE * len(self.old_ids)
+        size += sum(CMAP_SIZE + 2 * len(c[2]) for c in self.cmaps if c[1] == 'LV_FONT_FMT_TXT_CMAP_SPARSE_TINY')
+        size += sum(CMAP_SIZE for c in self.cmaps if c[1] != 'LV_FONT_FMT_TXT_CMAP_SPARSE_TINY')
+        if self.kern:
+            size += len(self.kern[0]) + len(self.kern[1]) + len(self.kern[2])
+        size += (3 if len(self.old_ids) < 256 else 5) * len(self.kern_pairs)
+        return size
+
+
+def c_array(values, per_line=8, fmt='0x{:x}'):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(fmt.format(v) for v in values[i:i + per_line]))
+    return ',\n'.join(lines)
+
+
+def char_comment(cp):
+    c = chr(cp)
+    if cp < 32:
+        c = {10: '\\n', 9: '\\t', 13: '\\r'}.get(cp, '')
+    elif c in '"\\':
+        c = '\\' + c
+    return 'U+{:04X} "{}"'.format(cp, c)
+
+
+def write_source(path, subset, source_name):
+    font = subset.font
+    out = []
+    w = out.append
+    w('/*******************************************************************************\n')
+    w(' * Size: {} px\n'.format(font.size))
+    w(' * Bpp: {}\n'.format(font.bpp))
+    w(' * Opts: {}\n'.format(font.opts))
+    w(' * Subset of {} by lvgl_port_font.py: {} of {} glyphs{}\n'.format(
+        source_name, len(subset.cps), len(font.glyphs), ', compressed' if subset.format else ''))
+    w(' ******************************************************************************/\n\n')
+    w('#ifdef LV_LVGL_H_INCLUDE_SIMPLE\n#include "lvgl.h"\n#else\n#include "lvgl/lvgl.h"\n#endif\n\n')
+    w('#ifndef {0}\n#define {0} 1\n#endif\n\n#if {0}\n\n'.format(font.guard))
+
+    w('/*-----------------\n *    BITMAPS\n *----------------*/\n\n')
+    w('/*Store the image of the glyphs*/\n')
+    w('static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {\n')
+    index = []
+    pos = 0
+    blocks = []
+    for cp, data in zip(subset.cps, subset.bitmaps):
+        index.append(pos)
+        pos += len(data)
+        block = '    /* {} */\n'.format(char_comment(cp))
+        if data:
+            block += c_array(list(data)) + ',\n'
+        blocks.append(block)
+    w('\n'.join(blocks))
+    # The decoder of compressed glyphs may read one byte past the last one
+    w('\n    0x0\n};\n\n\n')
+
+    w('/*---------------------\n *  GLYPH DESCRIPTION\n *--------------------*/\n\n')
+    w('static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {\n')
+    dsc = ['    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */']
+    for i, g in zip(index, subset.old_ids[1:]):
+        adv_w, bw, bh, ofs_x, ofs_y = font.dsc[g]
+        dsc.append('    {{.bitmap_index = {}, .adv_w = {}, .box_w = {}, .box_h = {}, .ofs_x = {}, .ofs_y = {}}}'.format(
+            i, adv_w, bw, bh, ofs_x, ofs_y))
+    w(',\n'.join(dsc) + '\n};\n\n')
+
+    w('/*---------------------\n *  CHARACTER MAPPING\n *--------------------*/\n\n')
+    for n, (start, kind, cps) in enumerate(subset.cmaps):
+        if kind == 'LV_FONT_FMT_TXT_CMAP_SPARSE_TINY':
+            w('static const uint16_t unicode_list_{}[] = {{\n{}\n}};\n\n'.format(n, c_array([cp - start for cp in cps])))
+    w('/*Collect the unicode lists and glyph_id offsets*/\n')
+    w('static const lv_font_fmt_txt_cmap_t cmaps[] =\n{\n')
+    entries = []
+    gid = 1
+    for n, (start, kind, cps) in enumerate(subset.cmaps):
+        sparse = kind == 'LV_FONT_FMT_TXT_CMAP_SPARSE_TINY'
+        entries.append('    {{\n        .range_start = {}, .range_length = {}, .glyph_id_start = {},\n'
+                       '        .unicode_list = {}, .glyph_id_ofs_list = NULL, .list_length = {}, .type = {}\n    }}'.format(
+                           start, cps[-1] - start + 1, gid, 'unicode_list_{}'.format(n) if sparse else 'NULL',
+                           len(cps) if sparse else 0, kind))
+        gid += len(cps)
+    w(',\n'.join(entries) + '\n};\n\n')
+
+    kern_dsc = 'NULL'
+    kern_classes = 0
+    if subset.kern:
+        left, right, values, left_cnt, right_cnt = subset.kern
+        w('/*-----------------\n *    KERNING\n *----------------*/\n\n')
+        w('/*Map glyph_ids to kern left classes*/\nstatic const uint8_t kern_left_class_mapping[] =\n{{\n{}\n}};\n\n'.format(
+            c_array(left, fmt='{}')))
+        w('/*Map glyph_ids to kern right classes*/\nstatic const uint8_t kern_right_class_mapping[] =\n{{\n{}\n}};\n\n'.format(
+            c_array(right, fmt='{}')))
+        w('/*Kern values between classes*/\nstatic const int8_t kern_class_values[] =\n{{\n{}\n}};\n\n'.format(
+            c_array(values, fmt='{}')))
+        w('/*Collect the kern class\' data in one place*/\n')
+        w('static const lv_font_fmt_txt_kern_classes_t kern_classes =\n{\n')
+        w('    .class_pair_values   = kern_class_values,\n')
+        w('    .left_class_mapping  = kern_left_class_mapping,\n')
+        w('    .right_class_mapping = kern_right_class_mapping,\n')
+        w('    .left_class_cnt      = {},\n    .right_class_cnt     = {},\n}};\n\n'.format(left_cnt, right_cnt))
+        kern_dsc = '&kern_classes'
+        kern_classes = 1
+    elif subset.kern_pairs:
+        wide = len(subset.old_ids) >= 256
+        ids = [v for a, b, _ in subset.kern_pairs for v in (a, b)]
+        w('/*-----------------\n *    KERNING\n *----------------*/\n\n')
+        w('/*Pair left and right glyphs for kerning*/\nstatic const {} kern_pair_glyph_ids[] =\n{{\n{}\n}};\n\n'.format(
+            'uint16_t' if wide else 'uint8_t', c_array(ids, per_line=2, fmt='{}')))
+        w('/* Kerning between the respective left and right glyphs\n * 4.4 format which needs to scaled with `kern_scale`*/\n')
+        w('static const int8_t kern_pair_values[] =\n{{\n{}\n}};\n\n'.format(
+            c_array([v for _, _, v in subset.kern_pairs], fmt='{}')))
+        w('/*Collect the kern pair\'s data in one place*/\n')
+        w('static const lv_font_fmt_txt_kern_pair_t kern_pairs =\n{\n')
+        w('    .glyph_ids = kern_pair_glyph_ids,\n    .values = kern_pair_values,\n')
+        w('    .pair_cnt = {},\n    .glyph_ids_size = {}\n}};\n\n'.format(len(subset.kern_pairs), 1 if wide else 0))
+        kern_dsc = '&kern_pairs'
+
+    w('/*--------------------\n *  ALL CUSTOM DATA\n *--------------------*/\n\n')
+    w('/*Store all the custom data of the font*/\n')
+    w('static lv_font_fmt_txt_glyph_cache_t cache;\n')
+    w('static const lv_font_fmt_txt_dsc_t font_dsc = {\n')
+    w('    .glyph_bitmap = glyph_bitmap,\n    .glyph_dsc = glyph_dsc,\n    .cmaps = cmaps,\n')
+    w('    .kern_dsc = {},\n    .kern_scale = {},\n    .cmap_num = {},\n    .bpp = {},\n'.format(
+        kern_dsc, font.kern_scale if kern_dsc != 'NULL' else 0, len(subset.cmaps), font.bpp))
+    w('    .kern_classes = {},\n    .bitmap_format = {},\n    .cache = &cache\n}};\n\n'.format(kern_classes, subset.format))
+
+    w('/*-----------------\n *  PUBLIC FONT\n *----------------*/\n\n')
+    get_bitmap = 'lv_font_get_bitmap_fmt_txt'
+    if subset.format:
+        w('#if !LV_USE_FONT_COMPRESSED\n#error "{} is compressed, enable LV_USE_FONT_COMPRESSED"\n#endif\n\n'.format(font.name))
+        w('/*Decodes through the font cache of esp_lvgl_port*/\n')
+        w('const uint8_t *lvgl_port_font_get_bitmap(const lv_font_t *font, uint32_t letter);\n\n')
+        get_bitmap = 'lvgl_port_font_get_bitmap'
+    w('/*Initialize a public general font descriptor*/\n')
+    w('const lv_font_t {} = {{\n'.format(font.name))
+    w('    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,    /*Function pointer to get glyph\'s data*/\n')
+    w('    .get_glyph_bitmap = {},    /*Function pointer to get glyph\'s bitmap*/\n'.format(get_bitmap))
+    w('    .line_height = {},          /*The maximum line height required by the font*/\n'.format(font.line_height))
+    w('    .base_line = {},             /*Baseline measured from the bottom of the line*/\n'.format(font.base_line))
+    w('    .subpx = {},\n'.format(font.subpx))
+    w('    .underline_position = {},\n    .underline_thickness = {},\n'.format(font.underline_position, font.underline_thickness))
+    w('    .dsc = &font_dsc           /*The custom font data. Will be accessed by `get_glyph_bitmap/dsc` */\n};\n\n')
+    w('#endif /*#if {}*/\n'.format(font.guard))
+
+    with open(path, 'w', encoding='utf-8') as f:
+        f.write(''.join(out))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('fonts', nargs='+', help='Font C sources made by lv_font_conv')
+    parser.add_argument('-t', '--text', nargs='+', default=[], help='C sources with the texts drawn in these fonts')
+    parser.add_argument('-c', '--chars', default='', help='Characters kept in addition (of texts formatted at run time)')
+    parser.add_argument('-z', '--compress', action='store_true', help='Compress the glyph bitmaps')
+    parser.add_argument('-o', '--out-dir', help='Directory of the subset sources, named as the originals (only the sizes are printed without it)')
+    parser.add_argument('-r', '--report', help='Write the sizes as CSV to this file')
+    args = parser.parse_args()
+
+    chars = set(ord(c) for c in args.chars)
+    for source in args.text:
+        chars |= text_chars(source)
+
+    report = []
+    for source in args.fonts:
+        try:
+            font = Font(source)
+        except ValueError as e:
+            sys.exit(str(e))
+        subset = Subset(font, chars, args.compress)
+        report.append((font.name, len(font.glyphs), len(subset.cps), font.data_size(), subset.data_size()))
+        if args.out_dir:
+            os.makedirs(args.out_dir, exist_ok=True)
+            write_source(os.path.join(args.out_dir, os.path.basename(source)), subset, os.path.basename(source))
+
+    for name, glyphs, kept, size, subset_size in report:
+        print('{:<32} {:>4} -> {:>4} glyphs {:>7} -> {:>7} bytes ({:3.0f}% saved)'.format(
+            name, glyphs, kept, size, subset_size, 100.0 * (size - subset_size) / size))
+    if len(report) > 1:
+        size = sum(r[3] for r in report)
+        subset_size = sum(r[4] for r in report)
+        print('{:<52} {:>7} -> {:>7} bytes ({:3.0f}% saved)'.format('total', size, subset_size, 100.0 * (size - subset_size) / size))
+
+    if args.report:
+        with open(args.report, 'w') as f:
+            f.write('font,glyphs,kept_glyphs,bytes,subset_bytes\n')
+            for r in report:
+                f.write('{},{},{},{},{}\n'.format(*r))
+
+
+if __name__ == '__main__':
+    main()
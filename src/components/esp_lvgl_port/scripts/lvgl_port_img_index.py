@@ -0,0 +1,200 @@
+#!/usr/bin/env python
+#
+# SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Convert LVGL image C sources to indexed color formats.
+
+Takes the native RGB565 pixels of an image source made by the LVGL image converter (see
+lvgl_port_img_rle.py) and reduces them to a palette of 2, 4, 16 or 256 colors with alpha, in the
+layout of `LV_IMG_CF_INDEXED_1/2/4/8BIT`: 2^bpp palette entries as `lv_color32_t`, then the indices
+of each row packed from the most significant bit, rows byte aligned. Images of a single color with
+varying opacity (alpha masks) become palettes of that color with alpha levels, so they need no
+recoloring. Images with more colors are quantized by median cut refined by k-means, the quality is
+the PSNR of the colors premultiplied by alpha, and the alpha.
+"""
+
+import argparse
+import math
+import sys
+
+sys.dont_write_bytecode = True  # Runs from the component directory
+import lvgl_port_img_rle as rle  # noqa: E402
+
+CF_INDEXED = {1: 7, 2: 8, 4: 9, 8: 10}
+KMEANS_ITERATIONS = 4
+
+
+def rgba(px):
+    """Native RGB565 (and alpha) bytes to 8-bit channels whose truncation gives the same RGB565"""
+    c = px[0] | (px[1] << 8)
+    r5, g6, b5 = c >> 11, (c >> 5) & 0x3F, c & 0x1F
+    a = px[2] if len(px) == 3 else 255
+    return ((r5 << 3) | (r5 >> 2), (g6 << 2) | (g6 >> 4), (b5 << 3) | (b5 >> 2), a)
+
+
+def histogram(img):
+    hist = {}
+    for y in range(img.h):
+        for px in img.pixels(y):
+            hist[px] = hist.get(px, 0) + 1
+    return dict((rgba(px), n) for px, n in hist.items())
+
+
+def premultiplied(c):
+    a = c[3]
+    return (c[0] * a / 255.0, c[1] * a / 255.0, c[2] * a / 255.0, float(a))
+
+
+def distance(p, q):
+    return (p[0] - q[0]) ** 2 + (p[1] - q[1]) ** 2 + (p[2] - q[2]) ** 2 + (p[3] - q[3]) ** 2
+
+
+def median_cut(colors, count):
+    """colors: [(premultiplied, weight)], returns up to count boxes"""
+    boxes = [colors]
+    while len(boxes) < count:
+        # Split the box of the largest weighted spread along its widest channel
+        best = None
+        for i, box in enumerate(boxes):
+            if len(box) < 2:
+                continue
+            spans = [max(c[0][ch] for c in box) - min(c[0][ch] for c in box) for ch in range(4)]
+            ch = spans.index(max(spans))
+            score = spans[ch] * sum(c[1] for c in box)
+            if best is None or score > best[0]:
+                best = (score, i, ch)
+        if best is None or best[0] == 0:
+            break
+        _, i, ch = best
+        box = sorted(boxes.pop(i), key=lambda c: c[0][ch])
+        total = sum(c[1] for c in box)
+        acc = 0
+        for split in range(1, len(box)):
+            acc += box[split - 1][1]
+            if acc * 2 >= total:
+                break
+        boxes += [box[:split], box[split:]]
+    return boxes
+
+
+def centroid(box):
+    total = float(sum(c[1] for c in box))
+    return tuple(sum(c[0][ch] * c[1] for c in box) / total for ch in range(4))
+
+
+def to_color(p):
+    """Premultiplied centroid to a palette entry (r, g, b, a)"""
+    a = int(round(min(max(p[3], 0), 255)))
+    if a == 0:
+        return (0, 0, 0, 0)
+    return tuple(int(round(min(max(p[ch] * 255.0 / a, 0), 255))) for ch in range(3)) + (a,)
+
+
+def nearest(p, centers):
+    best = 0
+    best_d = None
+    for i, c in enumerate(centers):
+        d = distance(p, c)
+        if best_d is None or d < best_d:
+            best, best_d = i, d
+    return best
+
+
+def quantize(hist, count):
+    """Returns the palette and the index of each color of the histogram"""
+    if len(hist) <= count:
+        palette = list(hist)
+        return palette, dict((c, i) for i, c in enumerate(palette))
+
+    colors = [(premultiplied(c), n) for c, n in hist.items()]
+    centers = [centroid(box) for box in median_cut(colors, count)]
+    for _ in range(KMEANS_ITERATIONS):
+        sums = [[0.0] * 5 for _ in centers]
+        for p, n in colors:
+            s = sums[nearest(p, centers)]
+            for ch in range(4):
+                s[ch] += p[ch] * n
+            s[4] += n
+        centers = [tuple(s[ch] / s[4] for ch in range(4)) if s[4] else c for s, c in zip(sums, centers)]
+
+    palette = [to_color(c) for c in centers]
+    pm = [premultiplied(c) for c in palette]
+    return palette, dict((c, nearest(premultiplied(c), pm)) for c in hist)
+
+
+def psnr(hist, palette, index):
+    """PSNR of the premultiplied colors and the alpha, inf when lossless"""
+    err = 0.0
+    total = 0
+    for c, n in hist.items():
+        err += distance(premultiplied(c), premultiplied(palette[index[c]])) * n
+        total += n
+    mse = err / (total * 4)
+    return float('inf') if mse == 0 else 10 * math.log10(255.0 ** 2 / mse)
+
+
+def encode(img, bpp, palette, index):
+    """Blob in the layout of LV_IMG_CF_INDEXED_<bpp>BIT"""
+    out = bytearray()
+    for i in range(1 << bpp):
+        # Unused entries repeat the first, so opaque palettes stay opaque
+        r, g, b, a = palette[i] if i < len(palette) else palette[0]
+        out += bytes((b, g, r, a))
+    for y in range(img.h):
+        acc = 0
+        bits = 0
+        for px in img.pixels(y):
+            acc = (acc << bpp) | index[rgba(px)]
+            bits += bpp
+            if bits == 8:
+                out.append(acc)
+                acc = bits = 0
+        if bits:
+            out.append(acc << (8 - bits))
+    return bytes(out)
+
+
+def size(img, bpp):
+    return 4 * (1 << bpp) + (img.w * bpp + 7) // 8 * img.h
+
+
+def convert(img, min_psnr, max_size=None, hist=None):
+    """Smallest indexed format of at least min_psnr and below max_size: (bpp, psnr, blob), None when none fits"""
+    hist = hist or histogram(img)
+    for bpp in (1, 2, 4, 8):
+        if max_size is not None and size(img, bpp) >= max_size:
+            break
+        palette, index = quantize(hist, 1 << bpp)
+        quality = psnr(hist, palette, index)
+        if quality >= min_psnr:
+            return bpp, quality, encode(img, bpp, palette, index)
+    return None
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('sources', nargs='+', help='LVGL image C sources')
+    parser.add_argument('--min-psnr', type=float, default=42.0, help='Lowest accepted quality in dB (default 42)')
+    args = parser.parse_args()
+
+    for source in args.sources:
+        try:
+            img = rle.Image(source)
+        except ValueError as e:
+            sys.exit(str(e))
+        hist = histogram(img)
+        result = convert(img, args.min_psnr, hist=hist)
+        raw = len(img.data)
+        if result:
+            bpp, quality, blob = result
+            print('{:<24} {:>3}x{:<3} {:>5} colors {:>7} -> {:>7} bytes {}-bit, {:.1f} dB'.format(
+                img.name, img.w, img.h, len(hist), raw, len(blob), bpp, quality))
+        else:
+            print('{:<24} {:>3}x{:<3} {:>5} colors {:>7} bytes, no indexed format of {} dB'.format(img.name, img.w, img.h, len(hist), raw, args.min_psnr))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,179 @@
+#!/usr/bin/env python
+#
+# SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Compress LVGL image C sources with the run-length encoding of the port.
+
+Takes the native RGB565 pixels (LV_COLOR_DEPTH 16, LV_COLOR_16_SWAP 0) of an image source made by
+the LVGL image converter and writes a source of the same image descriptor with `LV_IMG_CF_USER_ENCODED_0`.
+It is decoded line by line while drawn, see lvgl_port_rle.h.
+
+Format (little-endian):
+| magic 'RLE1' (4) | decoded cf (1) | pixel size (1) | reserved (2) | row offsets (4 * h) | rows |
+
+Each row is a sequence of packets. A control byte c < 0x80 is followed by c + 1 literal pixels,
+c >= 0x80 by one pixel repeated (c & 0x7F) + 1 times. Colors of fully transparent pixels are cleared
+before encoding, so they compress with their neighbours.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+MAGIC = 0x31454C52
+MAX_PACKET = 128
+
+CF = {
+    'LV_IMG_CF_TRUE_COLOR': (4, 2),
+    'LV_IMG_CF_TRUE_COLOR_ALPHA': (5, 3),
+    'LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED': (6, 2),
+}
+
+
+class Image:
+    def __init__(self, path):
+        with open(path, 'r') as f:
+            text = f.read()
+
+        dsc = re.search(r'const\s+lv_img_dsc_t\s+(\w+)\s*=\s*\{(.*?)\};', text, re.S)
+        if not dsc:
+            raise ValueError('{}: no lv_img_dsc_t found'.format(path))
+        self.name = dsc.group(1)
+        fields = dict(re.findall(r'\.([\w.]+)\s*=\s*([^,\n]+)', dsc.group(2)))
+        cf = fields.get('header.cf', '').strip()
+        if cf not in CF:
+            raise ValueError('{}: color format {} is not supported'.format(path, cf))
+        self.cf, self.px_size = CF[cf]
+        self.w = int(fields['header.w'])
+        self.h = int(fields['header.h'])
+
+        pixels = re.search(r'uint8_t\s+' + self.name + r'_map\[\]\s*=\s*\{(.*?)\n\};', text, re.S)
+        if not pixels:
+            raise ValueError('{}: no pixel map of {} found'.format(path, self.name))
+        body = pixels.group(1)
+        # Sources of the LVGL converter have a section per color depth, native ones only RGB565
+        native = re.search(r'#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0(.*?)#endif', body, re.S)
+        if native:
+            body = native.group(1)
+        elif '#if' in body:
+            raise ValueError('{}: no native RGB565 pixels found'.format(path))
+        body = re.sub(r'/\*.*?\*/', '', body, flags=re.S)
+        self.data = bytes(int(v, 16) for v in re.findall(r'0x[0-9a-fA-F]{2}', body))
+
+        if len(self.data) != self.w * self.h * self.px_size:
+            raise ValueError('{}: {} bytes of pixels, {} expected'.format(path, len(self.data), self.w * self.h * self.px_size))
+
+    def pixels(self, y):
+        row = self.data[y * self.w * self.px_size:(y + 1) * self.w * self.px_size]
+        px = [row[i:i + self.px_size] for i in range(0, len(row), self.px_size)]
+        if self.px_size == 3:
+            px = [p if p[2] != 0 else b'\x00\x00\x00' for p in px]
+        return px
+
+
+def encode_row(px):
+    out = bytearray()
+    literal = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:MAX_PACKET]
+            del literal[:MAX_PACKET]
+            out.append(len(chunk) - 1)
+            for p in chunk:
+                out.extend(p)
+
+    i = 0
+    while i < len(px):
+        run = 1
+        while i + run < len(px) and run < MAX_PACKET and px[i + run] == px[i]:
+            run += 1
+        if run >= 2:
+            flush_literal()
+            out.append(0x80 | (run - 1))
+            out.extend(px[i])
+        else:
+            literal.append(px[i])
+        i += run
+    flush_literal()
+    return bytes(out)
+
+
+def encode(img):
+    header_size = 8 + 4 * img.h
+    rows = bytearray()
+    offsets = []
+    for y in range(img.h):
+        offsets.append(header_size + len(rows))
+        rows.extend(encode_row(img.pixels(y)))
+    return struct.pack('<IBBH', MAGIC, img.cf, img.px_size, 0) + struct.pack('<{}I'.format(img.h), *offsets) + bytes(rows)
+
+
+def write_source(path, img, data):
+    attr = 'LV_ATTRIBUTE_IMG_' + img.name.upper()
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append('  ' + ' '.join('0x{:02x},'.format(b) for b in data[i:i + 16]))
+
+    with open(path, 'w') as f:
+        f.write('/* Generated by lvgl_port_img_rle.py, do not edit */\n\n')
+        f.write('#if defined(LV_LVGL_H_INCLUDE_SIMPLE)\n#include "lvgl.h"\n#else\n#include "lvgl/lvgl.h"\n#endif\n\n')
+        f.write('#if LV_COLOR_DEPTH != 16 || LV_COLOR_16_SWAP != 0\n')
+        f.write('#error "{} is compressed from native RGB565 pixels"\n#endif\n\n'.format(img.name))
+        f.write('#ifndef LV_ATTRIBUTE_MEM_ALIGN\n#define LV_ATTRIBUTE_MEM_ALIGN\n#endif\n\n')
+        f.write('#ifndef {0}\n#define {0}\n#endif\n\n'.format(attr))
+        f.write('const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST {} uint8_t {}_map[] = {{\n'.format(attr, img.name))
+        f.write('\n'.join(lines))
+        f.write('\n};\n\n')
+        f.write('const lv_img_dsc_t {} = {{\n'.format(img.name))
+        f.write('  .header.cf = LV_IMG_CF_USER_ENCODED_0,\n')
+        f.write('  .header.always_zero = 0,\n')
+        f.write('  .header.reserved = 0,\n')
+        f.write('  .header.w = {},\n'.format(img.w))
+        f.write('  .header.h = {},\n'.format(img.h))
+        f.write('  .data_size = {},\n'.format(len(data)))
+        f.write('  .data = {}_map,\n'.format(img.name))
+        f.write('};\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('sources', nargs='+', help='LVGL image C sources')
+    parser.add_argument('-o', '--out-dir', help='Directory of the compressed sources, named as the originals (only the sizes are printed without it)')
+    parser.add_argument('-r', '--report', help='Write the sizes as CSV to this file')
+    args = parser.parse_args()
+
+    report = []
+    for source in args.sources:
+        try:
+            img = Image(source)
+        except ValueError as e:
+            sys.exit(str(e))
+        data = encode(img)
+        raw = len(img.data)
+        report.append((img.name, img.w, img.h, raw, len(data)))
+        if args.out_dir:
+            os.makedirs(args.out_dir, exist_ok=True)
+            write_source(os.path.join(args.out_dir, os.path.basename(source)), img, data)
+
+    for name, w, h, raw, rle in report:
+        print('{:<24} {:>3}x{:<3} {:>7} -> {:>7} bytes ({:3.0f}% saved)'.format(name, w, h, raw, rle, 100.0 * (raw - rle) / raw))
+    if len(report) > 1:
+        raw = sum(r[3] for r in report)
+        rle = sum(r[4] for r in report)
+        print('{:<32} {:>7} -> {:>7} bytes ({:3.0f}% saved)'.format('total', raw, rle, 100.0 * (raw - rle) / raw))
+
+    if args.report:
+        with open(args.report, 'w') as f:
+            f.write('image,width,height,raw_bytes,rle_bytes\n')
+            for r in report:
+                f.write('{},{},{},{},{}\n'.format(*r))
+
+
+if __name__ == '__main__':
+    main()
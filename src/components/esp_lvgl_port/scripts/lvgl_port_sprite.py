@@ -0,0 +1,301 @@
+#!/usr/bin/env python
+#
+# SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Build the atlas and the frame table of a sprite from a sprite description.
+
+A description <name>.sprite has one statement per line, `#` starts a comment:
+
+    size <w> <h>                                    size of the frames
+    frame <frame> <image>[@<x>,<y>] ...             frame composed of images (LVGL image C sources,
+                                                    relative to the description), drawn in this order
+                                                    with their top left corner at x, y (0, 0 by default)
+    anim <anim> [loop] <frame> <ms> ... <frame> [<ms>]
+                                                    animation showing each frame for the time, the last
+                                                    one stays unless it loops
+
+The first frame is the key frame. The other frames are stored as a patch, the rectangle where they
+differ from the key frame. The key frame and the patches are packed into the atlas `<name>_atlas`,
+an image source of native RGB565 pixels with alpha, to be built like the other images. The sprite
+`<name>` (see lvgl_port_sprite.h) is written to a source of its own.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+sys.dont_write_bytecode = True  # Runs from the component directory
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import lvgl_port_img_rle as rle  # noqa: E402
+
+CLEAR = b'\x00\x00\x00'
+
+
+class Sprite:
+    def __init__(self, path):
+        self.name = os.path.splitext(os.path.basename(path))[0]
+        self.w = self.h = None
+        self.frames = []    # (name, [(image path, x, y)])
+        self.anims = []     # (name, loop, [(frame index, ms)])
+        base = os.path.dirname(os.path.abspath(path))
+
+        with open(path, 'r') as f:
+            for n, line in enumerate(f, 1):
+                words = line.split('#', 1)[0].split()
+                if not words:
+                    continue
+                where = '{}:{}'.format(path, n)
+                try:
+                    if words[0] == 'size' and len(words) == 3:
+                        self.w, self.h = int(words[1]), int(words[2])
+                    elif words[0] == 'frame' and len(words) >= 3:
+                        layers = []
+                        for word in words[2:]:
+                            m = re.fullmatch(r'([^@]+)(?:@(-?\d+),(-?\d+))?', word)
+                            layers.append((os.path.join(base, m.group(1)), int(m.group(2) or 0), int(m.group(3) or 0)))
+                        self.frames.append((words[1], layers))
+                    elif words[0] == 'anim' and len(words) >= 3:
+                        loop = words[2] == 'loop'
+                        args = words[3:] if loop else words[2:]
+                        names = [f[0] for f in self.frames]
+                        keys = []
+                        for i in range(0, len(args), 2):
+                            if args[i] not in names:
+                                raise ValueError('unknown frame {}'.format(args[i]))
+                            if i + 1 < len(args):
+                                ms = int(args[i + 1])
+                            elif not loop:
+                                ms = 0
+                            else:
+                                raise ValueError('no time of the last frame of a loop')
+                            if not 0 <= ms <= 0xFFFF:
+                                raise ValueError('time {} out of range'.format(ms))
+                            keys.append((names.index(args[i]), ms))
+                        self.anims.append((words[1], loop, keys))
+                    else:
+                        raise ValueError('invalid statement')
+                except (ValueError, AttributeError) as e:
+                    raise ValueError('{}: {}'.format(where, e))
+
+        if not self.w or not self.h:
+            raise ValueError('{}: no size'.format(path))
+        if not self.frames:
+            raise ValueError('{}: no frames'.format(path))
+        if len(self.frames) > 255 or any(len(a[2]) > 255 for a in self.anims):
+            raise ValueError('{}: too many frames or keys'.format(path))
+
+    def images(self):
+        return sorted({layer[0] for _, layers in self.frames for layer in layers})
+
+
+def blend(dst, src):
+    """Source over destination, RGB565 pixels with alpha (little-endian color, alpha)"""
+    sa = src[2]
+    if sa == 0:
+        return dst
+    if sa == 255 or dst[2] == 0:
+        return src
+    da = dst[2] * (255 - sa) // 255
+    out_a = sa + da
+
+    def rgb(p):
+        c = p[0] | (p[1] << 8)
+        return ((c >> 11) & 0x1F, (c >> 5) & 0x3F, c & 0x1F)
+
+    s, d = rgb(src), rgb(dst)
+    r, g, b = ((s[i] * sa + d[i] * da + out_a // 2) // out_a for i in range(3))
+    c = (r << 11) | (g << 5) | b
+    return bytes((c & 0xFF, c >> 8, out_a))
+
+
+def compose(sprite, layers, images):
+    canvas = [[CLEAR] * sprite.w for _ in range(sprite.h)]
+    for path, x0, y0 in layers:
+        img = images[path]
+        for y in range(img.h):
+            if not 0 <= y0 + y < sprite.h:
+                continue
+            row = canvas[y0 + y]
+            for x, p in enumerate(img.pixels(y)):
+                if 0 <= x0 + x < sprite.w:
+                    row[x0 + x] = blend(row[x0 + x], p)
+    return canvas
+
+
+def bounds(frame, ref=None):
+    """Bounding box (x1, y1, x2, y2) of the visible pixels or of the ones differing from ref, None if none"""
+    xs, ys = [], []
+    for y, row in enumerate(frame):
+        for x, p in enumerate(row):
+            if (p != ref[y][x]) if ref else (p != CLEAR):
+                xs.append(x)
+                ys.append(y)
+    return (min(xs), min(ys), max(xs), max(ys)) if xs else None
+
+
+def pack(sizes):
+    """Shelves of the cells from the tallest, returns the positions and the size of the atlas"""
+    width = max(w for w, _ in sizes)
+    pos = [None] * len(sizes)
+    x = y = shelf = 0
+    for i in sorted(range(len(sizes)), key=lambda i: (-sizes[i][1], -sizes[i][0])):
+        w, h = sizes[i]
+        if x + w > width:
+            x, y, shelf = 0, y + shelf, 0
+        pos[i] = (x, y)
+        x += w
+        shelf = max(shelf, h)
+    return pos, width, y + shelf
+
+
+def build(sprite):
+    images = {}
+    for path in sprite.images():
+        img = rle.Image(path)
+        if img.px_size != 3:
+            raise ValueError('{}: images of sprites need an alpha channel'.format(path))
+        images[path] = img
+    frames = [compose(sprite, layers, images) for _, layers in sprite.frames]
+
+    key = bounds(frames[0])
+    if key is None:
+        raise ValueError('{}: key frame {} is empty'.format(sprite.name, sprite.frames[0][0]))
+    areas = [key] + [bounds(f, frames[0]) for f in frames[1:]]
+
+    # Frames of the same patch share it
+    cells = []
+    cell_of = []
+    for i, area in enumerate(areas):
+        if area is None:
+            cell_of.append(None)
+            continue
+        x1, y1, x2, y2 = area
+        px = [frames[i][y][x1:x2 + 1] for y in range(y1, y2 + 1)]
+        cell = next((c for c, (a, p) in enumerate(cells) if a == area and p == px), None)
+        if cell is None:
+            cell = len(cells)
+            cells.append((area, px))
+        cell_of.append(cell)
+
+    pos, atlas_w, atlas_h = pack([(a[2] - a[0] + 1, a[3] - a[1] + 1) for a, _ in cells])
+    atlas = [[CLEAR] * atlas_w for _ in range(atlas_h)]
+    for (area, px), (ax, ay) in zip(cells, pos):
+        for y, row in enumerate(px):
+            atlas[ay + y][ax:ax + len(row)] = row
+
+    table = []
+    for area, cell in zip(areas, cell_of):
+        table.append((pos[cell], area) if cell is not None else None)
+    return images, atlas, atlas_w, atlas_h, table
+
+
+def atlas_source(name, atlas, w, h):
+    data = b''.join(p for row in atlas for p in row)
+    attr = 'LV_ATTRIBUTE_IMG_' + name.upper()
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append('  ' + ' '.join('0x{:02x},'.format(b) for b in data[i:i + 16]))
+    return ''.join([
+        '/* Generated by lvgl_port_sprite.py, do not edit */\n\n',
+        '#if defined(LV_LVGL_H_INCLUDE_SIMPLE)\n#include "lvgl.h"\n#else\n#include "lvgl/lvgl.h"\n#endif\n\n',
+        '#if LV_COLOR_DEPTH != 16 || LV_COLOR_16_SWAP != 0\n',
+        '#error "{} is made from native RGB565 pixels"\n#endif\n\n'.format(name),
+        '#ifndef LV_ATTRIBUTE_MEM_ALIGN\n#define LV_ATTRIBUTE_MEM_ALIGN\n#endif\n\n',
+        '#ifndef {0}\n#define {0}\n#endif\n\n'.format(attr),
+        'const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST {} uint8_t {}_map[] = {{\n'.format(attr, name),
+        '\n'.join(lines),
+        '\n};\n\n',
+        'const lv_img_dsc_t {} = {{\n'.format(name),
+        '  .header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA,\n',
+        '  .header.always_zero = 0,\n',
+        '  .header.reserved = 0,\n',
+        '  .header.w = {},\n'.format(w),
+        '  .header.h = {},\n'.format(h),
+        '  .data_size = {},\n'.format(len(data)),
+        '  .data = {}_map,\n'.format(name),
+        '};\n',
+    ])
+
+
+def cell(pos_area):
+    if pos_area is None:
+        return '{.area = {0, 0, -1, -1}}'
+    (ax, ay), (x1, y1, x2, y2) = pos_area
+    return '{{.atlas_x = {}, .atlas_y = {}, .area = {{{}, {}, {}, {}}}}}'.format(ax, ay, x1, y1, x2, y2)
+
+
+def sprite_source(sprite, atlas_name, atlas_w, atlas_h, table):
+    out = ['/* Generated by lvgl_port_sprite.py, do not edit */\n\n',
+           '#if defined(LV_LVGL_H_INCLUDE_SIMPLE)\n#include "lvgl.h"\n#else\n#include "lvgl/lvgl.h"\n#endif\n',
+           '#include "lvgl_port_sprite.h"\n\n',
+           'LV_IMG_DECLARE({})\n\n'.format(atlas_name),
+           'static const lvgl_port_sprite_frame_t {}_frames[] = {{\n'.format(sprite.name)]
+    for i, (name, _) in enumerate(sprite.frames):
+        out.append('    {{.name = "{}", .patch = {}}},\n'.format(name, cell(table[i] if i else None)))
+    out.append('};\n')
+    for name, loop, keys in sprite.anims:
+        out.append('\nstatic const lvgl_port_sprite_key_t {}_{}_keys[] = {{\n'.format(sprite.name, name))
+        for frame, ms in keys:
+            out.append('    {{.frame = {}, .time = {}}},\n'.format(frame, ms))
+        out.append('};\n')
+    if sprite.anims:
+        out.append('\nstatic const lvgl_port_sprite_anim_t {}_anims[] = {{\n'.format(sprite.name))
+        for name, loop, keys in sprite.anims:
+            out.append('    {{.name = "{0}", .keys = {1}_{0}_keys, .key_count = {2}, .loop = {3}}},\n'.format(
+                name, sprite.name, len(keys), 'true' if loop else 'false'))
+        out.append('};\n')
+    out.append('\nconst lvgl_port_sprite_t {} = {{\n'.format(sprite.name))
+    out.append('    .atlas = &{},\n'.format(atlas_name))
+    out.append('    .atlas_w = {},\n    .atlas_h = {},\n'.format(atlas_w, atlas_h))
+    out.append('    .w = {},\n    .h = {},\n'.format(sprite.w, sprite.h))
+    out.append('    .key = {},\n'.format(cell(table[0])))
+    out.append('    .frames = {}_frames,\n    .frame_count = {},\n'.format(sprite.name, len(sprite.frames)))
+    if sprite.anims:
+        out.append('    .anims = {}_anims,\n    .anim_count = {},\n'.format(sprite.name, len(sprite.anims)))
+    out.append('};\n')
+    return ''.join(out)
+
+
+def write_if_changed(path, text):
+    """Keep the timestamp of unchanged outputs, so nothing depending on them is rebuilt"""
+    if os.path.exists(path):
+        with open(path, 'r') as f:
+            if f.read() == text:
+                return
+    with open(path, 'w') as f:
+        f.write(text)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('sprites', nargs='+', help='Sprite descriptions')
+    parser.add_argument('-o', '--out-dir', help='Directory of the sources <name>_atlas.c and <name>.c (only the sizes are printed without it)')
+    parser.add_argument('--images', action='store_true', help='Only print the images the sprites are made of')
+    args = parser.parse_args()
+
+    try:
+        sprites = [Sprite(path) for path in args.sprites]
+        if args.images:
+            for sprite in sprites:
+                print('\n'.join(sprite.images()))
+            return
+        for sprite in sprites:
+            images, atlas, atlas_w, atlas_h, table = build(sprite)
+            atlas_name = sprite.name + '_atlas'
+            if args.out_dir:
+                os.makedirs(args.out_dir, exist_ok=True)
+                write_if_changed(os.path.join(args.out_dir, atlas_name + '.c'), atlas_source(atlas_name, atlas, atlas_w, atlas_h))
+                write_if_changed(os.path.join(args.out_dir, sprite.name + '.c'), sprite_source(sprite, atlas_name, atlas_w, atlas_h, table))
+            separate = sum(img.w * img.h for img in images.values())
+            print('{:<24} {} frames {}x{}, atlas {}x{}: {} -> {} bytes of images'.format(
+                sprite.name, len(sprite.frames), sprite.w, sprite.h, atlas_w, atlas_h, separate * 3, atlas_w * atlas_h * 3))
+    except (ValueError, OSError) as e:
+        sys.exit(str(e))
+
+
+if __name__ == '__main__':
+    main()
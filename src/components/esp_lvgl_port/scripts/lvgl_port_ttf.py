@@ -0,0 +1,389 @@
+#!/usr/bin/env python
+#
+# SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Subset a TrueType font to the tables and glyphs the rasterizer of the port reads.
+
+Fonts drawn by lvgl_port_get_ttf_font() of esp_lvgl_port are rasterized by stb_truetype (shipped with
+LVGL's tiny_ttf), which reads only cmap, head, hhea, hmtx, maxp, loca, glyf and kerning. The subset
+keeps the glyphs of printable ASCII and of --chars (with the glyphs composite ones are built of),
+renumbered in the order of the characters, without hinting instructions. GSUB, GDEF and the hinting
+tables are dropped. OS/2, name (with the copyright and license) and the metrics of post stay, the
+bounding box of head is the one of the kept glyphs. The glyphs are drawn exactly like the ones of
+the original.
+
+Pair kerning of GPOS (x advances of pair adjustment lookups, the first one covering a pair wins, like
+stb_truetype picks it) is stored as a `kern` table of the kept pairs. The stb_truetype of LVGL 8
+reads GPOS at a wrong offset and would draw the original font without kerning.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+ASCII = ''.join(chr(c) for c in range(0x20, 0x7F))
+
+# Tables copied as they are, next to the rebuilt ones
+KEPT_TABLES = ('OS/2', 'name')
+
+# Composite glyph flags
+ARG_1_AND_2_ARE_WORDS = 0x0001
+WE_HAVE_A_SCALE = 0x0008
+MORE_COMPONENTS = 0x0020
+WE_HAVE_AN_X_AND_Y_SCALE = 0x0040
+WE_HAVE_A_TWO_BY_TWO = 0x0080
+WE_HAVE_INSTRUCTIONS = 0x0100
+
+
+def u16(data, offset):
+    return struct.unpack_from('>H', data, offset)[0]
+
+
+def s16(data, offset):
+    return struct.unpack_from('>h', data, offset)[0]
+
+
+def u32(data, offset):
+    return struct.unpack_from('>I', data, offset)[0]
+
+
+def checksum(data):
+    data = data + b'\0' * (-len(data) % 4)
+    return sum(struct.unpack('>{}I'.format(len(data) // 4), data)) & 0xFFFFFFFF
+
+
+class Font:
+    def __init__(self, data):
+        self.data = data
+        if u32(data, 0) not in (0x00010000, 0x74727565):
+            raise ValueError('not a TrueType font (CFF outlines and collections are not supported)')
+        self.tables = {}
+        for i in range(u16(data, 4)):
+            tag, _, offset, length = struct.unpack_from('>4sIII', data, 12 + 16 * i)
+            self.tables[tag.decode('latin-1')] = (offset, length)
+        for tag in ('cmap', 'head', 'hhea', 'hmtx', 'maxp', 'loca', 'glyf'):
+            if tag not in self.tables:
+                raise ValueError('font has no {} table'.format(tag))
+        self.long_loca = s16(data, self.tables['head'][0] + 50) == 1
+        self.hmetrics_count = u16(data, self.tables['hhea'][0] + 34)
+        self.cmap = self.read_cmap()
+
+    def table(self, tag):
+        offset, length = self.tables[tag]
+        return self.data[offset:offset + length]
+
+    def read_cmap(self):
+        """Code point -> glyph of the Unicode subtable (format 4 or 12, like stb_truetype picks it)"""
+        base = self.tables['cmap'][0]
+        found = None
+        for i in range(u16(self.data, base + 2)):
+            platform, encoding, offset = struct.unpack_from('>HHI', self.data, base + 4 + 8 * i)
+            if (platform == 3 and encoding in (1, 10)) or platform == 0:
+                found = base + offset
+                break
+        if found is None:
+            raise ValueError('font has no Unicode character map')
+        fmt = u16(self.data, found)
+        cmap = {}
+        if fmt == 4:
+            segs = u16(self.data, found + 6) // 2
+            ends = found + 14
+            starts = ends + 2 * segs + 2
+            deltas = starts + 2 * segs
+            range_offsets = deltas + 2 * segs
+            for s in range(segs):
+                end = u16(self.data, ends + 2 * s)
+                start = u16(self.data, starts + 2 * s)
+                delta = u16(self.data, deltas + 2 * s)
+                ro = u16(self.data, range_offsets + 2 * s)
+                for cp in range(start, min(end, 0xFFFE) + 1):
+                    if ro == 0:
+                        glyph = (cp + delta) & 0xFFFF
+                    else:
+                        glyph = u16(self.data, range_offsets + 2 * s + ro + 2 * (cp - start))
+                        glyph = (glyph + delta) & 0xFFFF if glyph else 0
+                    if glyph:
+                        cmap[cp] = glyph
+        elif fmt == 12:
+            for g in range(u32(self.data, found + 12)):
+                start, end, glyph = struct.unpack_from('>III', self.data, found + 16 + 12 * g)
+                for cp in range(start, end + 1):
+                    cmap[cp] = glyph + cp - start
+        else:
+            raise ValueError('character map format {} is not supported'.format(fmt))
+        return cmap
+
+    def glyph(self, glyph):
+        loca = self.tables['loca'][0]
+        if self.long_loca:
+            start, end = u32(self.data, loca + 4 * glyph), u32(self.data, loca + 4 * glyph + 4)
+        else:
+            start, end = 2 * u16(self.data, loca + 2 * glyph), 2 * u16(self.data, loca + 2 * glyph + 2)
+        glyf = self.tables['glyf'][0]
+        return self.data[glyf + start:glyf + end]
+
+    def hmetrics(self, glyph):
+        hmtx = self.tables['hmtx'][0]
+        if glyph < self.hmetrics_count:
+            return u16(self.data, hmtx + 4 * glyph), s16(self.data, hmtx + 4 * glyph + 2)
+        return (u16(self.data, hmtx + 4 * (self.hmetrics_count - 1)),
+                s16(self.data, hmtx + 4 * self.hmetrics_count + 2 * (glyph - self.hmetrics_count)))
+
+    def kern(self, g1, g2):
+        """Kerning of a pair: GPOS when there is one, kern otherwise"""
+        if 'GPOS' in self.tables:
+            return self.gpos_kern(g1, g2)
+        if 'kern' in self.tables:
+            return self.kern_kern(g1, g2)
+        return 0
+
+    def kern_kern(self, g1, g2):
+        kern = self.tables['kern'][0]
+        if u16(self.data, kern + 2) < 1 or u16(self.data, kern + 8) != 1:
+            return 0
+        needle = g1 << 16 | g2
+        for m in range(u16(self.data, kern + 10)):
+            if u32(self.data, kern + 18 + 6 * m) == needle:
+                return s16(self.data, kern + 22 + 6 * m)
+        return 0
+
+    def coverage(self, table, glyph):
+        fmt = u16(self.data, table)
+        if fmt == 1:
+            for i in range(u16(self.data, table + 2)):
+                if u16(self.data, table + 4 + 2 * i) == glyph:
+                    return i
+        elif fmt == 2:
+            for i in range(u16(self.data, table + 2)):
+                start, end, index = struct.unpack_from('>HHH', self.data, table + 4 + 6 * i)
+                if start <= glyph <= end:
+                    return index + glyph - start
+        return -1
+
+    def glyph_class(self, table, glyph):
+        fmt = u16(self.data, table)
+        if fmt == 1:
+            start, count = u16(self.data, table + 2), u16(self.data, table + 4)
+            if start <= glyph < start + count:
+                return u16(self.data, table + 6 + 2 * (glyph - start))
+        elif fmt == 2:
+            for i in range(u16(self.data, table + 2)):
+                start, end, cls = struct.unpack_from('>HHH', self.data, table + 4 + 6 * i)
+                if start <= glyph <= end:
+                    return cls
+        else:
+            return -1
+        return 0
+
+    def gpos_kern(self, g1, g2):
+        """The first pair adjustment of the x advance covering the pair, of any lookup"""
+        gpos = self.tables['GPOS'][0]
+        data = self.data
+        if u16(data, gpos) != 1:
+            return 0
+        lookup_list = gpos + u16(data, gpos + 8)
+        for i in range(u16(data, lookup_list)):
+            lookup = lookup_list + u16(data, lookup_list + 2 + 2 * i)
+            lookup_type = u16(data, lookup)
+            for s in range(u16(data, lookup + 4)):
+                table = lookup + u16(data, lookup + 6 + 2 * s)
+                if lookup_type == 9 and u16(data, table + 2) == 2:
+                    table += u32(data, table + 4)
+                elif lookup_type != 2:
+                    break
+                fmt = u16(data, table)
+                index = self.coverage(table + u16(data, table + 2), g1)
+                if index < 0:
+                    continue
+                if u16(data, table + 4) != 4 or u16(data, table + 6) != 0 or fmt not in (1, 2):
+                    return 0
+                if fmt == 1:
+                    if index >= u16(data, table + 8):
+                        return 0
+                    pairs = table + u16(data, table + 10 + 2 * index)
+                    for p in range(u16(data, pairs)):
+                        if u16(data, pairs + 2 + 4 * p) == g2:
+                            return s16(data, pairs + 4 + 4 * p)
+                    continue
+                c1 = self.glyph_class(table + u16(data, table + 8), g1)
+                c2 = self.glyph_class(table + u16(data, table + 10), g2)
+                count1, count2 = u16(data, table + 12), u16(data, table + 14)
+                if not 0 <= c1 < count1 or not 0 <= c2 < count2:
+                    return 0
+                return s16(data, table + 16 + 2 * (c1 * count2 + c2))
+        return 0
+
+
+def components(glyph):
+    """Offsets of the component glyph indices of a composite glyph and the end of its components"""
+    offsets = []
+    p = 10
+    while True:
+        flags = u16(glyph, p)
+        offsets.append(p + 2)
+        p += 4 + (4 if flags & ARG_1_AND_2_ARE_WORDS else 2)
+        if flags & WE_HAVE_A_SCALE:
+            p += 2
+        elif flags & WE_HAVE_AN_X_AND_Y_SCALE:
+            p += 4
+        elif flags & WE_HAVE_A_TWO_BY_TWO:
+            p += 8
+        if not flags & MORE_COMPONENTS:
+            return offsets, p, flags
+
+
+def strip_glyph(glyph, new_ids):
+    """Glyph without instructions, components renumbered"""
+    if not glyph:
+        return b''
+    contours = s16(glyph, 0)
+    if contours >= 0:
+        p = 10 + 2 * contours
+        length = u16(glyph, p)
+        return glyph[:p] + b'\0\0' + glyph[p + 2 + length:]
+    offsets, end, last_flags = components(glyph)
+    out = bytearray(glyph[:end])
+    for offset in offsets:
+        struct.pack_into('>H', out, offset, new_ids[u16(glyph, offset)])
+    struct.pack_into('>H', out, offsets[-1] - 2, last_flags & ~WE_HAVE_INSTRUCTIONS)
+    return bytes(out)
+
+
+def cmap_format4(cps, new_ids):
+    """Character map of the kept code points, one segment per run of consecutive characters and glyphs"""
+    segments = []
+    for cp in cps:
+        glyph = new_ids[cp]
+        if segments and segments[-1][1] == cp - 1 and (segments[-1][2] + cp) & 0xFFFF == glyph:
+            segments[-1][1] = cp
+        else:
+            segments.append([cp, cp, (glyph - cp) & 0xFFFF])
+    segments.append([0xFFFF, 0xFFFF, 1])
+    n = len(segments)
+    search = 2 ** (n.bit_length() - 1)
+    sub = struct.pack('>HHHHHHH', 4, 16 + 8 * n, 0, 2 * n, 2 * search, search.bit_length() - 1, 2 * n - 2 * search)
+    sub += b''.join(struct.pack('>H', s[1]) for s in segments) + b'\0\0'
+    sub += b''.join(struct.pack('>H', s[0]) for s in segments)
+    sub += b''.join(struct.pack('>H', s[2]) for s in segments)
+    sub += b'\0\0' * n
+    return struct.pack('>HHHHI', 0, 1, 3, 1, 12) + sub
+
+
+def kern_format0(pairs):
+    n = len(pairs)
+    if n > (0xFFFF - 14) // 6:
+        raise ValueError('{} kerning pairs do not fit a kern table'.format(n))
+    search = 2 ** (n.bit_length() - 1) if n else 0
+    sub = struct.pack('>HHHHHHH', 0, 14 + 6 * n, 0x0001, n, 6 * search, max(search.bit_length() - 1, 0), 6 * (n - search))
+    sub += b''.join(struct.pack('>HHh', a, b, v) for (a, b), v in sorted(pairs.items()))
+    return struct.pack('>HH', 0, 1) + sub
+
+
+def subset(data, chars):
+    """(subset font, kept glyphs, kerning pairs) of the characters"""
+    font = Font(data)
+    cps = sorted(cp for cp in set(ord(c) for c in chars) if cp in font.cmap)
+
+    # .notdef, the glyphs of the characters in their order, then components
+    old_ids = [0]
+    for cp in cps:
+        if font.cmap[cp] not in old_ids:
+            old_ids.append(font.cmap[cp])
+    i = 0
+    while i < len(old_ids):
+        glyph = font.glyph(old_ids[i])
+        if glyph and s16(glyph, 0) < 0:
+            for offset in components(glyph)[0]:
+                if u16(glyph, offset) not in old_ids:
+                    old_ids.append(u16(glyph, offset))
+        i += 1
+    new_ids = {old: new for new, old in enumerate(old_ids)}
+    cmap_ids = {cp: new_ids[font.cmap[cp]] for cp in cps}
+
+    glyf = bytearray()
+    loca = []
+    for old in old_ids:
+        loca.append(len(glyf))
+        glyf += strip_glyph(font.glyph(old), new_ids)
+        glyf += b'\0' * (-len(glyf) % 4)
+    loca.append(len(glyf))
+
+    pairs = {}
+    char_glyphs = sorted(set(cmap_ids.values()))
+    for a in char_glyphs:
+        for b in char_glyphs:
+            v = font.kern(old_ids[a], old_ids[b])
+            if v:
+                pairs[(a, b)] = v
+
+    # Bounds of the kept glyphs, the line height of the fonts (where any text fits) is taken from them
+    bounds = [struct.unpack_from('>hhhh', g, 2) for g in (font.glyph(old) for old in old_ids) if g]
+    head = bytearray(font.table('head'))
+    struct.pack_into('>I', head, 8, 0)
+    if bounds:
+        struct.pack_into('>hhhh', head, 36, min(b[0] for b in bounds), min(b[1] for b in bounds),
+                         max(b[2] for b in bounds), max(b[3] for b in bounds))
+    struct.pack_into('>h', head, 50, 1)
+    hhea = bytearray(font.table('hhea'))
+    struct.pack_into('>H', hhea, 34, len(old_ids))
+    maxp = bytearray(font.table('maxp'))
+    struct.pack_into('>H', maxp, 4, len(old_ids))
+    tables = {
+        'head': bytes(head),
+        'hhea': bytes(hhea),
+        'maxp': bytes(maxp),
+        'hmtx': b''.join(struct.pack('>Hh', *font.hmetrics(old)) for old in old_ids),
+        'cmap': cmap_format4(cps, cmap_ids),
+        'loca': b''.join(struct.pack('>I', o) for o in loca),
+        'glyf': bytes(glyf),
+    }
+    if pairs:
+        tables['kern'] = kern_format0(pairs)
+    if 'post' in font.tables:
+        tables['post'] = struct.pack('>I', 0x00030000) + font.table('post')[4:32]
+    for tag in KEPT_TABLES:
+        if tag in font.tables:
+            tables[tag] = font.table(tag)
+
+    tags = sorted(tables)
+    n = len(tags)
+    search = 2 ** (n.bit_length() - 1)
+    out = bytearray(struct.pack('>IHHHH', 0x00010000, n, 16 * search, search.bit_length() - 1, 16 * (n - search)))
+    offset = 12 + 16 * n
+    body = bytearray()
+    for tag in tags:
+        table = tables[tag]
+        out += struct.pack('>4sIII', tag.encode('latin-1'), checksum(table), offset + len(body), len(table))
+        body += table + b'\0' * (-len(table) % 4)
+    out += body
+    head_offset = u32(out, 12 + 16 * tags.index('head') + 8)
+    struct.pack_into('>I', out, head_offset + 8, (0xB1B0AFBA - checksum(bytes(out))) & 0xFFFFFFFF)
+    return bytes(out), len(old_ids), len(pairs)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('font', help='TrueType font')
+    parser.add_argument('-c', '--chars', default='', help='Characters kept in addition to printable ASCII')
+    parser.add_argument('-o', '--out', help='Write the subset font to this file (only the sizes are printed without it)')
+    args = parser.parse_args()
+
+    with open(args.font, 'rb') as f:
+        data = f.read()
+    try:
+        font, glyphs, pairs = subset(data, ASCII + args.chars)
+    except (ValueError, struct.error) as e:
+        sys.exit('{}: {}'.format(args.font, e))
+    print('{:<32} {:>4} glyphs, {:>4} kerning pairs {:>7} -> {:>7} bytes ({:3.0f}% saved)'.format(
+        os.path.basename(args.font), glyphs, pairs, len(data), len(font), 100.0 * (len(data) - len(font)) / len(data)))
+    if args.out:
+        with open(args.out, 'wb') as f:
+            f.write(font)
+
+
+if __name__ == '__main__':
+    main()
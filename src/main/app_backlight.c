@@ -0,0 +1,180 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_log.h"
+#include "bsp/esp-bsp.h"
+#include "lv_example_pub.h"
+#include "app_backlight.h"
+
+static const char *TAG = "backlight";
+
+#define BACKLIGHT_STAGES            3
+#define BACKLIGHT_START_DELAY_MS    500
+#define BACKLIGHT_START_FADE_MS     500
+#define BACKLIGHT_WAKE_FADE_MS      200
+
+typedef struct {
+    uint32_t idle_ms;       /* Knob idle time the stage starts at */
+    uint8_t percent;        /* Brightness relative to the active level */
+    uint16_t fade_ms;
+} backlight_stage_t;
+
+/* First dimming halfway to the clock screen, the second one together with it */
+static const backlight_stage_t backlight_profiles[BACKLIGHT_PROFILE_MAX][BACKLIGHT_STAGES] = {
+    [BACKLIGHT_PROFILE_DAY] = {
+        {TIME_ENTER_CLOCK_2MIN / 2, 50, 1000},
+        {TIME_ENTER_CLOCK_2MIN, 30, 1500},
+        {5 * 60 * 1000, 10, 3000},
+    },
+    [BACKLIGHT_PROFILE_NIGHT] = {
+        {TIME_ENTER_CLOCK_2MIN / 2, 25, 1000},
+        {TIME_ENTER_CLOCK_2MIN, 10, 1500},
+        {5 * 60 * 1000, 0, 3000},
+    },
+};
+
+/* Accessed by the LVGL task only */
+static struct {
+    lv_timer_t *timer;
+    bool on;                /* Faded in once the first screen had time to draw */
+    BACKLIGHT_PROFILE profile;
+    uint8_t level;
+    uint8_t stage;          /* 0 while active, n after the n-th idle stage started */
+    void (*feedback_cb)(lv_indev_drv_t *, uint8_t);
+} backlight = {
+    .profile = BACKLIGHT_PROFILE_DAY,
+    .level = 100,
+};
+
+static void backlight_apply(uint32_t fade_ms)
+{
+    uint32_t percent = backlight.level;
+    if (backlight.stage > 0) {
+        percent = percent * backlight_profiles[backlight.profile][backlight.stage - 1].percent / 100;
+    }
+    ESP_ERROR_CHECK_WITHOUT_ABORT(bsp_display_brightness_fade(percent, fade_ms));
+}
+
+/* Run the timer when the next stage is due, nothing runs after the last one */
+static void backlight_schedule(void)
+{
+    if (backlight.stage == BACKLIGHT_STAGES) {
+        lv_timer_pause(backlight.timer);
+        return;
+    }
+
+    const uint32_t idle_ms = lv_disp_get_inactive_time(NULL);
+    const uint32_t next_ms = backlight_profiles[backlight.profile][backlight.stage].idle_ms;
+    lv_timer_set_period(backlight.timer, (next_ms > idle_ms) ? (next_ms - idle_ms) : 1);
+    lv_timer_reset(backlight.timer);
+    lv_timer_resume(backlight.timer);
+}
+
+static void backlight_timer_cb(lv_timer_t *timer)
+{
+    if (!backlight.on) {
+        backlight.on = true;
+        backlight_apply(BACKLIGHT_START_FADE_MS);
+        backlight_schedule();
+        return;
+    }
+
+    const backlight_stage_t *stages = backlight_profiles[backlight.profile];
+    const uint32_t idle_ms = lv_disp_get_inactive_time(NULL);
+    uint8_t stage = 0;
+
+    while (stage < BACKLIGHT_STAGES && stages[stage].idle_ms <= idle_ms) {
+        stage++;
+    }
+    if (stage != backlight.stage) {
+        const uint32_t fade_ms = (stage > backlight.stage) ? stages[stage - 1].fade_ms : BACKLIGHT_WAKE_FADE_MS;
+        backlight.stage = stage;
+        backlight_apply(fade_ms);
+
+        bsp_display_brightness_stats_t stats;
+        if (bsp_display_brightness_get_stats(&stats) == ESP_OK && stats.total_us > 0) {
+            ESP_LOGI(TAG, "Idle stage %d, backlight %d%%, average power %d%% of full brightness",
+                     stage, bsp_display_brightness_get(), (int)(stats.duty_us * 100 / stats.total_us));
+        }
+    }
+    backlight_schedule();
+}
+
+/* Called for each event sent by the knob, so waking up needs no polling */
+static void backlight_feedback_cb(lv_indev_drv_t *drv, uint8_t code)
+{
+    if (backlight.feedback_cb) {
+        backlight.feedback_cb(drv, code);
+    }
+    if (backlight.on && backlight.stage != 0) {
+        backlight.stage = 0;
+        backlight_apply(BACKLIGHT_WAKE_FADE_MS);
+        backlight_schedule();
+    }
+}
+
+/*
+ * Runs before the screens are created: a layer change deletes the LVGL timers created after the
+ * first screen, so the backlight timer has to be older. It fades the display in on its first run.
+ */
+static void backlight_start_cmd(void *arg)
+{
+    backlight.timer = lv_timer_create(backlight_timer_cb, BACKLIGHT_START_DELAY_MS, NULL);
+    if (!backlight.timer) {
+        ESP_LOGE(TAG, "Timer create failed");
+        return;
+    }
+
+    lv_indev_t *indev = bsp_display_get_input_dev();
+    if (indev) {
+        backlight.feedback_cb = indev->driver->feedback_cb;
+        indev->driver->feedback_cb = backlight_feedback_cb;
+    }
+
+    backlight.stage = 0;
+}
+
+static void backlight_set_level_cmd(void *arg)
+{
+    backlight.level = (uint8_t)(uintptr_t)arg;
+    if (backlight.on) {
+        backlight_apply(BACKLIGHT_WAKE_FADE_MS);
+    }
+}
+
+static void backlight_set_profile_cmd(void *arg)
+{
+    backlight.profile = (BACKLIGHT_PROFILE)(uintptr_t)arg;
+    if (backlight.on) {
+        backlight_apply(BACKLIGHT_WAKE_FADE_MS);
+        /* Stages are re-evaluated with the new idle times right away */
+        lv_timer_ready(backlight.timer);
+        lv_timer_resume(backlight.timer);
+    }
+}
+
+esp_err_t backlight_start(void)
+{
+    return lvgl_port_post(backlight_start_cmd, NULL);
+}
+
+esp_err_t backlight_set_level(uint8_t percent)
+{
+    if (percent > 100) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return lvgl_port_post(backlight_set_level_cmd, (void *)(uintptr_t)percent);
+}
+
+esp_err_t backlight_set_profile(BACKLIGHT_PROFILE profile)
+{
+    if (profile >= BACKLIGHT_PROFILE_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return lvgl_port_post(backlight_set_profile_cmd, (void *)(uintptr_t)profile);
+}
@@ -0,0 +1,38 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef enum {
+    BACKLIGHT_PROFILE_DAY,      /* Dim to half, then a readable clock */
+    BACKLIGHT_PROFILE_NIGHT,    /* Dim deeper and switch off after a while */
+    BACKLIGHT_PROFILE_MAX,
+} BACKLIGHT_PROFILE;
+
+/**
+ * @brief Start the backlight service and fade the display in
+ *
+ * The backlight is dimmed in stages while the knob is idle and fades back in on the next
+ * knob event. Call before the screens are created, the display fades in shortly after them.
+ */
+esp_err_t backlight_start(void);
+
+/**
+ * @brief Set the brightness of an active display, idle stages are relative to it
+ *
+ * Does not block, the request is applied by the LVGL task.
+ */
+esp_err_t backlight_set_level(uint8_t percent);
+
+/**
+ * @brief Select the idle dimming stages
+ *
+ * Does not block, the request is applied by the LVGL task.
+ */
+esp_err_t backlight_set_profile(BACKLIGHT_PROFILE profile);
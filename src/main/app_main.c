@@ -5,6 +5,7 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include "freertos/FreeRTOS.h"
@@ -16,6 +17,7 @@
 #include "esp_log.h"
 
 #include "app_audio.h"
+#include "app_backlight.h"
 #include "settings.h"
 #include "lv_example_pub.h"
 #include "bsp/esp-bsp.h"
@@ -176,6 +178,14 @@ static void sys_monitor_start(void)
 #endif
 
 
+/* Runs in the LVGL task, app_main() does not wait for the LVGL mutex */
+static void app_ui_create(void* arg)
+{
+    ui_obj_to_encoder_init();
+    lv_create_home(&boot_Layer);
+    lv_create_clock(&clock_screen_layer, TIME_ENTER_CLOCK_2MIN);
+}
+
 esp_err_t bsp_board_init(void)
 {
     ESP_ERROR_CHECK(bsp_led_init());
@@ -196,15 +206,23 @@ void app_main(void)
     ESP_ERROR_CHECK(settings_read_parameter_from_nvs());
 
     bsp_display_start();
+#if CONFIG_UI_ASSETS_PARTITION
+    /* The images and the Montserrat texts have no built in fallback, stop before drawing without them */
+    err = lvgl_port_add_assets("assets");
+    if (err != ESP_OK || !lvgl_port_get_ttf_font("Montserrat-Medium", 16) || !lvgl_port_get_ttf_font("Montserrat-Medium", 48)) {
+        ESP_LOGE(TAG, "No images or fonts in the \"assets\" partition (%s), flash it with 'idf.py assets-flash'",
+                 esp_err_to_name(err));
+        abort();
+    }
+#endif
 
     ESP_LOGI(TAG, "Display LVGL demo");
-    ui_obj_to_encoder_init();
-    lv_create_home(&boot_Layer);
-    lv_create_clock(&clock_screen_layer, TIME_ENTER_CLOCK_2MIN);
-    bsp_display_unlock();
-
-    vTaskDelay(pdMS_TO_TICKS(500));
-    bsp_display_backlight_on();
+    /* The backlight timer has to be older than the screens, it fades the display in after them */
+    ESP_ERROR_CHECK(backlight_start());
+    sys_param_t *param = settings_get_parameter();
+    ESP_ERROR_CHECK_WITHOUT_ABORT(backlight_set_level(param->backlight_level));
+    ESP_ERROR_CHECK_WITHOUT_ABORT(backlight_set_profile((BACKLIGHT_PROFILE)param->backlight_profile));
+    ESP_ERROR_CHECK(lvgl_port_post(app_ui_create, NULL));
 
     bsp_board_init();
     audio_play_start();
@@ -0,0 +1,251 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Washing cycles in accelerated time: whole programs updated at random moments, pauses keeping
+ * the rest of a tick, demos, late updates and transitions that are not allowed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "washing_cycle.h"
+#include "test_common.h"
+
+#define TICK_MS         (1000U)
+
+typedef struct {
+    uint32_t calls;
+    uint32_t ticks;             /* Calls reporting a tick */
+    uint32_t times;             /* Calls reporting a new shown time */
+    uint32_t states;
+    washing_cycle_state_t state;
+    uint32_t shown;             /* Last shown time in minutes */
+} events_t;
+
+static void events_cb(const washing_cycle_t *cycle, uint32_t changed, void *user_data)
+{
+    events_t *events = user_data;
+    uint32_t hours, minutes;
+
+    events->calls++;
+    if (changed & WASHING_CYCLE_CHANGED_TICK) {
+        events->ticks++;
+    }
+    if (changed & WASHING_CYCLE_CHANGED_TIME) {
+        washing_cycle_get_time(cycle, &hours, &minutes);
+        TEST_ASSERT(minutes < 60);
+        /* The shown time only goes down, after the start */
+        const bool start = (changed & WASHING_CYCLE_CHANGED_STATE) && cycle->state == WASHING_CYCLE_RUN;
+        TEST_ASSERT(start || hours * 60 + minutes < events->shown);
+        events->shown = hours * 60 + minutes;
+        events->times++;
+    }
+    if (changed & WASHING_CYCLE_CHANGED_STATE) {
+        events->states++;
+    }
+    events->state = cycle->state;
+}
+
+static void cycle_init(washing_cycle_t *cycle, events_t *events, uint32_t demo_ticks)
+{
+    const washing_cycle_config_t config = {
+        .tick_ms = TICK_MS,
+        .demo_ticks = demo_ticks,
+        .cb = events_cb,
+        .user_data = events,
+    };
+    memset(events, 0, sizeof(*events));
+    washing_cycle_init(cycle, &config);
+}
+
+/* Updates at random moments, some of them late by several ticks; returns the time of the end */
+static uint32_t run_program(uint32_t minutes, uint32_t start_ms)
+{
+    washing_cycle_t cycle;
+    events_t events;
+    uint32_t now = start_ms;
+
+    cycle_init(&cycle, &events, 0);
+    TEST_ASSERT(washing_cycle_start(&cycle, minutes, now));
+    TEST_ASSERT(events.state == WASHING_CYCLE_RUN && events.times == 1 && events.shown == minutes);
+    uint32_t next = washing_cycle_update(&cycle, now);
+    TEST_ASSERT(next == TICK_MS);
+
+    while (cycle.state == WASHING_CYCLE_RUN) {
+        /* Mostly on time, like a timer armed with the returned delay */
+        const uint32_t step = (rand() % 8) ? next : 1 + rand() % (3 * TICK_MS);
+        now += step;
+        const uint32_t elapsed = now - start_ms;
+        const uint32_t due = elapsed / TICK_MS;
+        next = washing_cycle_update(&cycle, now);
+        TEST_ASSERT(cycle.ticks == ((due < minutes * 60) ? due : minutes * 60));
+        if (cycle.state == WASHING_CYCLE_RUN) {
+            TEST_ASSERT(next >= 1 && next <= TICK_MS);
+            TEST_ASSERT(next == TICK_MS - elapsed % TICK_MS);
+        }
+    }
+    TEST_ASSERT(next == WASHING_CYCLE_IDLE);
+    TEST_ASSERT(events.state == WASHING_CYCLE_END);
+    TEST_ASSERT(cycle.seconds_left == 0 && cycle.ticks == minutes * 60);
+    /* Every minute shown, updates are late by less than one */
+    TEST_ASSERT(events.times == minutes + 1 && events.shown == 0);
+    TEST_ASSERT(events.states == 2);
+    TEST_ASSERT(events.ticks <= minutes * 60 && events.ticks == events.calls - 1);
+
+    /* Ended cycles stay idle until reset */
+    TEST_ASSERT(washing_cycle_update(&cycle, now + 10 * TICK_MS) == WASHING_CYCLE_IDLE);
+    TEST_ASSERT(cycle.ticks == minutes * 60);
+    TEST_ASSERT(washing_cycle_reset(&cycle) && events.state == WASHING_CYCLE_STANDBY);
+    return now;
+}
+
+static void test_programs(void)
+{
+    static const uint32_t programs[] = {58, 68, 28};
+    struct timespec start, end;
+    uint32_t ticks = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (size_t i = 0; i < sizeof(programs) / sizeof(programs[0]); i++) {
+        /* Also across the wrap of the tick counter */
+        run_program(programs[i], 12345);
+        run_program(programs[i], UINT32_MAX - 30 * 60 * TICK_MS);
+        ticks += 2 * programs[i] * 60;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    printf("washing cycles: %u ticks of 6 programs in %.2f ms\n", (unsigned)ticks,
+           (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6);
+}
+
+static void test_hours(void)
+{
+    washing_cycle_t cycle;
+    events_t events;
+    uint32_t hours, minutes;
+
+    cycle_init(&cycle, &events, 0);
+    TEST_ASSERT(washing_cycle_start(&cycle, 68, 0));
+    washing_cycle_get_time(&cycle, &hours, &minutes);
+    TEST_ASSERT(hours == 1 && minutes == 8);
+
+    /* Rounded up: 1:08 until 8 minutes have passed entirely */
+    washing_cycle_update(&cycle, 59 * TICK_MS);
+    washing_cycle_get_time(&cycle, &hours, &minutes);
+    TEST_ASSERT(hours == 1 && minutes == 8 && events.times == 1);
+    washing_cycle_update(&cycle, 60 * TICK_MS);
+    washing_cycle_get_time(&cycle, &hours, &minutes);
+    TEST_ASSERT(hours == 1 && minutes == 7 && events.times == 2);
+    washing_cycle_update(&cycle, 8 * 60 * TICK_MS);
+    washing_cycle_get_time(&cycle, &hours, &minutes);
+    TEST_ASSERT(hours == 1 && minutes == 0);
+    washing_cycle_update(&cycle, 8 * 60 * TICK_MS + 1);
+    washing_cycle_get_time(&cycle, &hours, &minutes);
+    TEST_ASSERT(hours == 1 && minutes == 0);
+    washing_cycle_update(&cycle, 9 * 60 * TICK_MS);
+    washing_cycle_get_time(&cycle, &hours, &minutes);
+    TEST_ASSERT(hours == 0 && minutes == 59);
+}
+
+static void test_pause(void)
+{
+    washing_cycle_t cycle;
+    events_t events;
+
+    cycle_init(&cycle, &events, 0);
+    TEST_ASSERT(washing_cycle_start(&cycle, 28, 0));
+    TEST_ASSERT(washing_cycle_update(&cycle, 1300) == 700 && cycle.ticks == 1);
+
+    /* The rest of the tick is kept over the pause, the time does not run */
+    TEST_ASSERT(washing_cycle_pause(&cycle, 1700));
+    TEST_ASSERT(events.state == WASHING_CYCLE_PAUSE && events.states == 2);
+    TEST_ASSERT(washing_cycle_update(&cycle, 60000) == WASHING_CYCLE_IDLE && cycle.ticks == 1);
+    TEST_ASSERT(!washing_cycle_pause(&cycle, 60000));
+    TEST_ASSERT(washing_cycle_resume(&cycle, 60000));
+    TEST_ASSERT(events.state == WASHING_CYCLE_RUN && events.states == 3);
+    TEST_ASSERT(washing_cycle_update(&cycle, 60000) == 300);
+    TEST_ASSERT(washing_cycle_update(&cycle, 60299) == 1 && cycle.ticks == 1);
+    TEST_ASSERT(washing_cycle_update(&cycle, 60300) == TICK_MS && cycle.ticks == 2);
+
+    /* Paused past the due time, the tick comes on the resume */
+    TEST_ASSERT(washing_cycle_pause(&cycle, 61500));
+    TEST_ASSERT(washing_cycle_resume(&cycle, 70000));
+    TEST_ASSERT(washing_cycle_update(&cycle, 70000) == TICK_MS && cycle.ticks == 3);
+
+    /* Stopped while paused */
+    TEST_ASSERT(washing_cycle_pause(&cycle, 70400));
+    TEST_ASSERT(washing_cycle_stop(&cycle) && events.state == WASHING_CYCLE_END);
+    TEST_ASSERT(cycle.seconds_left == 28 * 60 - 3);
+}
+
+static void test_demo(void)
+{
+    washing_cycle_t cycle;
+    events_t events;
+
+    cycle_init(&cycle, &events, 8);
+    TEST_ASSERT(washing_cycle_start(&cycle, 58, 500));
+    for (uint32_t i = 1; i < 8; i++) {
+        TEST_ASSERT(washing_cycle_update(&cycle, 500 + i * TICK_MS) == TICK_MS);
+        TEST_ASSERT(events.ticks == i && events.state == WASHING_CYCLE_RUN);
+    }
+    TEST_ASSERT(washing_cycle_update(&cycle, 500 + 8 * TICK_MS) == WASHING_CYCLE_IDLE);
+    TEST_ASSERT(events.ticks == 8 && events.state == WASHING_CYCLE_END);
+    TEST_ASSERT(cycle.seconds_left == 58 * 60 - 8);
+
+    /* A late update ends the demo on its last tick */
+    TEST_ASSERT(washing_cycle_reset(&cycle));
+    TEST_ASSERT(washing_cycle_start(&cycle, 58, 0));
+    TEST_ASSERT(washing_cycle_update(&cycle, 100 * TICK_MS) == WASHING_CYCLE_IDLE);
+    TEST_ASSERT(cycle.ticks == 8 && cycle.seconds_left == 58 * 60 - 8);
+}
+
+static void test_transitions(void)
+{
+    washing_cycle_t cycle;
+    events_t events;
+
+    /* Commands not allowed in a state are ignored without any event */
+    cycle_init(&cycle, &events, 0);
+    TEST_ASSERT(!washing_cycle_pause(&cycle, 0));
+    TEST_ASSERT(!washing_cycle_resume(&cycle, 0));
+    TEST_ASSERT(!washing_cycle_stop(&cycle));
+    TEST_ASSERT(!washing_cycle_reset(&cycle));
+    TEST_ASSERT(!washing_cycle_start(&cycle, 0, 0));
+    TEST_ASSERT(washing_cycle_update(&cycle, 5 * TICK_MS) == WASHING_CYCLE_IDLE);
+    TEST_ASSERT(events.calls == 0);
+
+    TEST_ASSERT(washing_cycle_start(&cycle, 28, 0));
+    TEST_ASSERT(!washing_cycle_start(&cycle, 28, 0));
+    TEST_ASSERT(!washing_cycle_resume(&cycle, 0));
+    TEST_ASSERT(!washing_cycle_reset(&cycle));
+    TEST_ASSERT(washing_cycle_stop(&cycle));
+    TEST_ASSERT(!washing_cycle_stop(&cycle));
+    TEST_ASSERT(!washing_cycle_pause(&cycle, 0));
+    TEST_ASSERT(events.calls == 2 && events.state == WASHING_CYCLE_END);
+
+    /* Without a callback */
+    const washing_cycle_config_t config = {0};
+    washing_cycle_init(&cycle, &config);
+    TEST_ASSERT(cycle.config.tick_ms == TICK_MS);
+    TEST_ASSERT(washing_cycle_start(&cycle, 1, 0));
+    TEST_ASSERT(washing_cycle_update(&cycle, 60 * TICK_MS) == WASHING_CYCLE_IDLE);
+    TEST_ASSERT(cycle.state == WASHING_CYCLE_END);
+}
+
+int main(void)
+{
+    srand(1);
+    test_transitions();
+    test_hours();
+    test_pause();
+    test_demo();
+    test_programs();
+
+    printf("All washing cycle tests passed\n");
+    return 0;
+}
@@ -12,6 +12,7 @@
 #include "nvs_flash.h"
 #include "nvs.h"
 #include "bsp/esp-bsp.h"
+#include "app_backlight.h"
 #include "settings.h"
 
 static const char* TAG = "settings";
@@ -26,6 +27,8 @@ static const sys_param_t g_default_sys_param = {
     .magic = MAGIC_HEAD,
     .need_hint = 1,
     .language = LANGUAGE_EN,
+    .backlight_level = 100,
+    .backlight_profile = BACKLIGHT_PROFILE_DAY,
 };
 
 static esp_err_t settings_check(sys_param_t* param)
@@ -33,6 +36,8 @@ static esp_err_t settings_check(sys_param_t* param)
     esp_err_t ret;
     ESP_GOTO_ON_FALSE(param->magic == MAGIC_HEAD, ESP_ERR_INVALID_ARG, reset, TAG, "magic incorrect");
     ESP_GOTO_ON_FALSE(param->language < LANGUAGE_MAX, ESP_ERR_INVALID_ARG, reset, TAG, "language incorrect");
+    ESP_GOTO_ON_FALSE(param->backlight_level > 0 && param->backlight_level <= 100, ESP_ERR_INVALID_ARG, reset, TAG, "backlight level incorrect");
+    ESP_GOTO_ON_FALSE(param->backlight_profile < BACKLIGHT_PROFILE_MAX, ESP_ERR_INVALID_ARG, reset, TAG, "backlight profile incorrect");
     return ret;
 reset:
     ESP_LOGW(TAG, "Set to default");
@@ -53,6 +58,8 @@ esp_err_t settings_read_parameter_from_nvs(void)
 
     ESP_GOTO_ON_FALSE(ESP_OK == ret, ret, err, TAG, "nvs open failed (0x%x)", ret);
 
+    /* A blob saved before the backlight fields existed is shorter and keeps their defaults */
+    memcpy(&g_sys_param, &g_default_sys_param, sizeof(sys_param_t));
     size_t len = sizeof(sys_param_t);
     ret = nvs_get_blob(my_handle, KEY, &g_sys_param, &len);
     ESP_GOTO_ON_FALSE(ESP_OK == ret, ret, err, TAG, "can't read param");
@@ -18,6 +18,8 @@ typedef struct {
     uint8_t magic;
     bool need_hint;
     uint8_t language;
+    uint8_t backlight_level;        /* Brightness of the active display in [%] */
+    uint8_t backlight_profile;      /* BACKLIGHT_PROFILE of the idle dimming */
 } sys_param_t;
 
 esp_err_t settings_read_parameter_from_nvs(void);
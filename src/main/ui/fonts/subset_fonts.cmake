@@ -0,0 +1,16 @@
+# Fonts built by lvgl_port_subset_fonts() of esp_lvgl_port with only the glyphs of the UI texts,
+# relative to main/
+#
+# The texts are the string literals of the UI sources, UI_TEXT_CHARS adds the characters of texts
+# formatted at run time (the version of the factory screen). A text using a new character needs no
+# new export of the font, only a rebuild, as long as the exported font has the glyph.
+
+set(UI_SUBSET_FONTS
+    ui/fonts/font_SourceHanSansCN_20.c
+    ui/fonts/font_SourceHanSansCN_Medium_22.c)
+
+file(GLOB UI_TEXT_SOURCES CONFIGURE_DEPENDS RELATIVE ${CMAKE_CURRENT_LIST_DIR}/../..
+     ${CMAKE_CURRENT_LIST_DIR}/../*.c
+     ${CMAKE_CURRENT_LIST_DIR}/../layer_manage/*.c)
+
+set(UI_TEXT_CHARS "0123456789")
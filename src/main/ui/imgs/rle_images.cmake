@@ -0,0 +1,45 @@
+# Images compressed at build time by esp_lvgl_port, in the application by lvgl_port_rle_images()
+# or in the asset partition by lvgl_port_assets_partition() (which may also index their colors),
+# relative to main/
+#
+# They are drawn line by line, so images rotated or zoomed by the UI must stay out of this list
+# (wash_*, img_washing_stand/shirt/underwear, img_washing_wave1/2 and standby_mouth_*), as well as
+# images compressing badly (language_bg_dither).
+
+set(UI_RLE_IMAGES
+    ui/imgs/AC_BG.c
+    ui/imgs/AC_temper.c
+    ui/imgs/AC_unit.c
+    ui/imgs/espressif_logo.c
+    ui/imgs/icon_light.c
+    ui/imgs/icon_light_ns.c
+    ui/imgs/icon_thermostat.c
+    ui/imgs/icon_thermostat_ns.c
+    ui/imgs/icon_washing.c
+    ui/imgs/icon_washing_ns.c
+    ui/imgs/image_language/language_select.c
+    ui/imgs/image_language/language_unselect.c
+    ui/imgs/image_light/light_close_bg.c
+    ui/imgs/image_light/light_close_status.c
+    ui/imgs/image_light/light_cool_100.c
+    ui/imgs/image_light/light_cool_25.c
+    ui/imgs/image_light/light_cool_50.c
+    ui/imgs/image_light/light_cool_75.c
+    ui/imgs/image_light/light_cool_bg.c
+    ui/imgs/image_light/light_warm_100.c
+    ui/imgs/image_light/light_warm_25.c
+    ui/imgs/image_light/light_warm_50.c
+    ui/imgs/image_light/light_warm_75.c
+    ui/imgs/image_light/light_warm_bg.c
+    ui/imgs/image_standby/standby_eye_left.c
+    ui/imgs/image_standby/standby_eye_right.c
+    ui/imgs/image_standby/standby_face.c
+    ui/imgs/image_wash/img_washing_bg.c
+    ui/imgs/image_wash/img_washing_bubble1.c
+    ui/imgs/image_wash/img_washing_bubble2.c)
+
+# Sprites built by lvgl_port_sprites(), relative to main/. Their atlases are compressed like the
+# images above, the frame images (in a directory of the sprite name) are not built themselves.
+
+set(UI_SPRITES
+    ui/imgs/image_standby/standby_eye.sprite)
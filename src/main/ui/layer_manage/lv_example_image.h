@@ -77,13 +77,8 @@ LV_IMG_DECLARE(AC_unit)
 LV_IMG_DECLARE(standby_eye_left)
 LV_IMG_DECLARE(standby_eye_right)
 LV_IMG_DECLARE(standby_eye_1)
-LV_IMG_DECLARE(standby_eye_2)
-LV_IMG_DECLARE(standby_eye_close)
 LV_IMG_DECLARE(standby_face)
 LV_IMG_DECLARE(standby_mouth_2)
-LV_IMG_DECLARE(standby_eye_1_fade)
-LV_IMG_DECLARE(standby_eye_3)
-LV_IMG_DECLARE(standby_eye_open)
 LV_IMG_DECLARE(standby_mouth_1)
 
 LV_IMG_DECLARE(language_bg)
@@ -7,6 +7,7 @@
 #include "esp_check.h"
 #include "esp_err.h"
 #include "esp_log.h"
+#include "bsp/esp-bsp.h"
 
 #include "lv_schedule_basic.h"
 
@@ -129,6 +130,8 @@ void lv_func_goto_layer(lv_layer_t *dst_layer)
     }
 
     if (dst_layer) {
+        /* Images are cached for the new screen, it pins its own ones while created */
+        lvgl_port_set_img_cache_layer(dst_layer->lv_obj_name);
         if (NULL == dst_layer->lv_obj_layer) {
             lv_func_create_layer(dst_layer);
         } else {
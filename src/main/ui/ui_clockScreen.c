@@ -6,6 +6,7 @@
 
 #include "lvgl.h"
 #include <stdio.h>
+#include <string.h>
 
 #include "settings.h"
 #include "app_audio.h"
@@ -17,6 +18,8 @@
 #define MIN_MOUTH_ZOOM      128
 #define MAX_MOUTH_ZOOM      365
 
+LVGL_PORT_SPRITE_DECLARE(standby_eye)
+
 static bool clock_screen_layer_enter_cb(void* layer);
 static bool clock_screen_layer_exit_cb(void* layer);
 static void clock_screen_layer_timer_cb(lv_timer_t* tmr);
@@ -29,15 +32,12 @@ lv_layer_t clock_screen_layer = {
     .timer_cb = clock_screen_layer_timer_cb,
 };
 
-static uint16_t flash_sub_step = 0;
-static uint8_t flash_main_step = 0;
+static bool face_asleep;
 
 static lv_obj_t* page;
-static lv_obj_t* img_face, * img_eye_bg, * img_eye, * img_mouth, * img_eye_fade;
+static lv_obj_t* img_face, * sprite_eye, * img_mouth;
 static lv_obj_t* img_eye_left, * img_eye_right;
 
-static time_out_count time_50ms;
-
 static void wakeup_event_cb(lv_event_t* e)
 {
     lv_event_code_t code = lv_event_get_code(e);
@@ -55,7 +55,7 @@ static void wakeup_event_cb(lv_event_t* e)
 
 static void set_mouth_zoom(void* img, int32_t v)
 {
-    if (2 == flash_main_step) {
+    if (face_asleep) {
         lv_img_set_zoom(img, v);
         if (MIN_MOUTH_ZOOM == v) {
             // audio_continue_next();
@@ -63,6 +63,30 @@ static void set_mouth_zoom(void* img, int32_t v)
     }
 }
 
+static void set_anim_eye(void* obj, int32_t v)
+{
+    if (!lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) {
+        lv_obj_set_x(obj, v);
+    }
+}
+
+/* The pupils look around while the eyes are open, the mouth breathes while asleep */
+static void eye_frame_event_cb(lv_event_t* e)
+{
+    const char* frame = lvgl_port_get_sprite_frame(lv_event_get_target(e));
+    bool awake = (0 == strcmp(frame, "open")) || (0 == strcmp(frame, "fade"));
+
+    if (awake) {
+        lv_obj_clear_flag(img_eye_left, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_clear_flag(img_eye_right, LV_OBJ_FLAG_HIDDEN);
+    }
+    else {
+        lv_obj_add_flag(img_eye_left, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_flag(img_eye_right, LV_OBJ_FLAG_HIDDEN);
+    }
+    face_asleep = (0 == strcmp(frame, "sleep"));
+}
+
 void ui_flash_face_init(lv_obj_t* parent)
 {
     page = lv_obj_create(parent);
@@ -76,26 +100,18 @@ void ui_flash_face_init(lv_obj_t* parent)
     lv_img_set_src(img_face, &standby_face);
     lv_obj_align(img_face, LV_ALIGN_CENTER, 0, 0);
 
-    img_eye_bg = lv_img_create(page);
-    lv_img_set_src(img_eye_bg, &standby_eye_close);
-    lv_obj_align(img_eye_bg, LV_ALIGN_CENTER, 0, 0);
-
-    img_eye_fade = lv_img_create(page);
-    lv_img_set_src(img_eye_fade, &standby_eye_1_fade);
-    lv_obj_align(img_eye_fade, LV_ALIGN_CENTER, 0, 40);
-
-    img_eye = lv_img_create(page);
-    lv_img_set_src(img_eye, &standby_eye_3);
-    lv_obj_align(img_eye, LV_ALIGN_CENTER, 0, 0);
-    lv_obj_add_flag(img_eye, LV_OBJ_FLAG_HIDDEN);
+    /* Eyes open, fade, look ahead and close, see imgs/image_standby/standby_eye.sprite */
+    sprite_eye = lvgl_port_create_sprite(page, &standby_eye);
+    lv_obj_align(sprite_eye, LV_ALIGN_CENTER, 0, 14);
+    lv_obj_add_event_cb(sprite_eye, eye_frame_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
 
     img_eye_left = lv_img_create(page);
     lv_img_set_src(img_eye_left, &standby_eye_left);
-    lv_obj_align(img_eye_left, LV_ALIGN_TOP_LEFT, 70, 105);
+    lv_obj_align(img_eye_left, LV_ALIGN_TOP_LEFT, 75, 100);
 
     img_eye_right = lv_img_create(page);
     lv_img_set_src(img_eye_right, &standby_eye_right);
-    lv_obj_align(img_eye_right, LV_ALIGN_TOP_RIGHT, 163, 105);
+    lv_obj_align(img_eye_right, LV_ALIGN_TOP_LEFT, 115, 100);
 
     img_mouth = lv_img_create(page);
     lv_img_set_src(img_mouth, &standby_mouth_2);
@@ -111,6 +127,22 @@ void ui_flash_face_init(lv_obj_t* parent)
     lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
     lv_anim_start(&a);
 
+    lv_anim_t anim_eye;
+    lv_anim_init(&anim_eye);
+    lv_anim_set_path_cb(&anim_eye, lv_anim_path_ease_in_out);
+    lv_anim_set_time(&anim_eye, 2000);
+    lv_anim_set_playback_time(&anim_eye, 1000);
+    lv_anim_set_repeat_count(&anim_eye, LV_ANIM_REPEAT_INFINITE);
+
+    lv_anim_set_var(&anim_eye, img_eye_left);
+    lv_anim_set_values(&anim_eye, lv_obj_get_x_aligned(img_eye_left) + 0, lv_obj_get_x_aligned(img_eye_left) - 50);
+    lv_anim_set_exec_cb(&anim_eye, set_anim_eye);
+    lv_anim_start(&anim_eye);
+
+    lv_anim_set_var(&anim_eye, img_eye_right);
+    lv_anim_set_values(&anim_eye, lv_obj_get_x_aligned(img_eye_right) + 0, lv_obj_get_x_aligned(img_eye_right) + 50);
+    lv_anim_start(&anim_eye);
+
     lv_obj_add_event_cb(page, wakeup_event_cb, LV_EVENT_FOCUSED, NULL);
     lv_obj_add_event_cb(page, wakeup_event_cb, LV_EVENT_KEY, NULL);
     lv_obj_add_event_cb(page, wakeup_event_cb, LV_EVENT_CLICKED, NULL);
@@ -131,11 +163,9 @@ static bool clock_screen_layer_enter_cb(void* layer)
         lv_obj_remove_style_all(create_layer->lv_obj_layer);
         lv_obj_set_size(create_layer->lv_obj_layer, LV_HOR_RES, LV_VER_RES);
 
+        face_asleep = false;
         ui_flash_face_init(create_layer->lv_obj_layer);
-        set_time_out(&time_50ms, 50);
-
-        flash_sub_step = 0;
-        flash_main_step = 0;
+        lvgl_port_play_sprite(sprite_eye, "standby");
     }
     audio_force_quite(false);
 
@@ -149,97 +179,7 @@ static bool clock_screen_layer_exit_cb(void* layer)
     return true;
 }
 
-static void set_anim_left_eye(void* obj, int32_t v)
-{
-    if (0 == flash_main_step) {
-        lv_obj_set_x(img_eye_left, v);
-    }
-}
-
-static void set_anim_right_eye(void* obj, int32_t v)
-{
-    if (0 == flash_main_step) {
-        lv_obj_set_x(img_eye_right, v);
-    }
-}
-
 static void clock_screen_layer_timer_cb(lv_timer_t* tmr)
 {
-    static lv_anim_t anim_eye;
     feed_clock_time();
-    if (is_time_out(&time_50ms)) {
-
-        switch (flash_main_step) {
-        case 0:
-            if (0 == flash_sub_step) {
-                lv_img_set_src(img_eye_bg, &standby_eye_open);
-                lv_obj_align(img_eye_bg, LV_ALIGN_CENTER, 0, 0);
-
-                lv_obj_align(img_eye_left, LV_ALIGN_TOP_LEFT, 75, 100);
-                lv_obj_align(img_eye_right, LV_ALIGN_TOP_LEFT, 115, 100);
-
-                lv_obj_clear_flag(img_eye_left, LV_OBJ_FLAG_HIDDEN);
-                lv_obj_clear_flag(img_eye_right, LV_OBJ_FLAG_HIDDEN);
-                lv_obj_add_flag(img_eye, LV_OBJ_FLAG_HIDDEN);
-
-                lv_anim_init(&anim_eye);
-                lv_anim_set_var(&anim_eye, img_eye_left);
-                lv_anim_set_delay(&anim_eye, 0);
-                lv_anim_set_path_cb(&anim_eye, lv_anim_path_ease_in_out);
-                lv_anim_set_time(&anim_eye, 2000);
-                lv_anim_set_playback_time(&anim_eye, 1000);
-                lv_anim_set_repeat_count(&anim_eye, LV_ANIM_REPEAT_INFINITE);
-
-                lv_anim_set_values(&anim_eye, lv_obj_get_x_aligned(img_eye_left) + 0, lv_obj_get_x_aligned(img_eye_left) - 50);
-                lv_anim_set_exec_cb(&anim_eye, set_anim_left_eye);
-                lv_anim_start(&anim_eye);
-
-                lv_anim_set_values(&anim_eye, lv_obj_get_x_aligned(img_eye_right) + 0, lv_obj_get_x_aligned(img_eye_right) + 50);
-                lv_anim_set_exec_cb(&anim_eye, set_anim_right_eye);
-                lv_anim_start(&anim_eye);
-                flash_sub_step += 1;
-            }
-            else {
-                if (flash_sub_step++ < 80) { //0-400
-                    if ((flash_sub_step / 50) % 2) {
-                        lv_obj_clear_flag(img_eye_fade, LV_OBJ_FLAG_HIDDEN);
-                    }
-                    else {
-                        lv_obj_add_flag(img_eye_fade, LV_OBJ_FLAG_HIDDEN);
-                    }
-                }
-                else {
-                    flash_sub_step = 0;
-                    flash_main_step += 1;
-                }
-            }
-            break;
-        case 1:
-            if (0 == flash_sub_step) {
-                lv_img_set_src(img_eye_bg, &standby_eye_open);
-                lv_img_set_src(img_eye, &standby_eye_2);
-                lv_obj_align(img_eye_bg, LV_ALIGN_CENTER, 0, 0);
-                lv_obj_align(img_eye, LV_ALIGN_CENTER, 0, 0);
-
-                lv_obj_add_flag(img_eye_fade, LV_OBJ_FLAG_HIDDEN);
-                lv_obj_add_flag(img_eye_left, LV_OBJ_FLAG_HIDDEN);
-                lv_obj_add_flag(img_eye_right, LV_OBJ_FLAG_HIDDEN);
-                lv_obj_clear_flag(img_eye, LV_OBJ_FLAG_HIDDEN);
-            }
-            if (flash_sub_step++ > 40) { //0-4000
-                flash_sub_step = 0;
-                flash_main_step += 1;
-                // audio_handle_info(SOUND_TYPE_SNORE);
-            }
-            break;
-        case 2:
-            if (0 == flash_sub_step) {
-                lv_img_set_src(img_eye_bg, &standby_eye_close);
-                lv_img_set_src(img_eye, &standby_eye_3);
-                lv_obj_align(img_eye_bg, LV_ALIGN_CENTER, 0, 0);
-                lv_obj_align(img_eye, LV_ALIGN_CENTER, 0, 0 + 5);
-            }
-            break;
-        }
-    }
 }
@@ -37,6 +37,9 @@ typedef struct {
     const lv_img_dsc_t* img_pwm_100[2];
 } ui_light_img_t;
 
+static void light_2color_show_pwm(uint8_t light_pwm, LIGHT_CCK_TYPE cck_set);
+static void light_2color_play_pwm(uint8_t light_pwm);
+
 static lv_obj_t* page;
 static time_out_count time_20ms, time_500ms;
 
@@ -184,8 +187,6 @@ static bool light_2color_layer_exit_cb(void* layer)
     bsp_led_rgb_set(0x00, 0x00, 0x00);
     return true;
 }
-void lightTask(void* params);
-void audioTask(void* params);
 static void light_2color_layer_timer_cb(lv_timer_t* tmr) {
     uint32_t RGB_color = 0xFF; // Default RGB color value for initialization
     feed_clock_time(); // Update the clock to ensure the timer callback operates in real-time
@@ -227,70 +228,32 @@ static void light_2color_layer_timer_cb(lv_timer_t* tmr) {
                 lv_label_set_text(label_pwm_set, "--");
             }
 
-            uint8_t cck_set = (uint8_t)light_xor.light_cck; // Current color temperature setting
-
-            // Create an event group for synchronizing light and audio tasks
-            EventGroupHandle_t lightAndAudioTaskBits = xEventGroupCreate();
-            const TickType_t lightAndAudioWaitTime = pdMS_TO_TICKS(100); // Timeout for task synchronization
-
-            EventBits_t lightAndAudioBits = 0; // Initialize event group bits
-
-            // Parameters for the light task
-            void* lightTaskParams[3] = { (void*)(&lightAndAudioBits), (void*)(&light_xor.light_pwm), (void*)(&cck_set) };
-            TaskHandle_t lightTaskHandle = 0; // Handle for the light task
-            xTaskCreate(lightTask, "LightTask", 4 * 1024, &lightTaskParams, 1, &lightTaskHandle);
-
-            // Parameters for the audio task
-            void* audioTaskParams[2] = { (void*)(&lightAndAudioBits), (void*)(&light_xor.light_pwm) };
-            TaskHandle_t audioTaskHandle = 0; // Handle for the audio task
-            xTaskCreate(audioTask, "AudioTask", 4 * 1024, &audioTaskParams, 1, &audioTaskHandle);
-
-            // Wait for both tasks to complete their operations
-            lightAndAudioBits = xEventGroupWaitBits(
-                lightAndAudioTaskBits,    // Event group handle
-                (1 << 0) | (1 << 1),     // Bits to monitor (light and audio tasks)
-                pdTRUE,                  // Clear bits after waiting
-                pdTRUE,                  // Wait for all bits to be set
-                lightAndAudioWaitTime    // Maximum wait time
-            );
-
-            // Check if both tasks completed successfully
-            if ((lightAndAudioBits & ((1 << 0) | (1 << 1))) == ((1 << 0) | (1 << 1))) {
-                printf("Both tasks completed successfully.\n");
-            }
-            else {
-                printf("One or both tasks did not complete in time.\n");
-            }
-
-            // Clean up the event group
-            vEventGroupDelete(lightAndAudioTaskBits);
+            // The timer runs in the LVGL task, the icon and the sound are updated right here
+            light_2color_show_pwm(light_xor.light_pwm, light_xor.light_cck);
+            light_2color_play_pwm(light_xor.light_pwm);
         }
     }
 }
 
-// Task to update the light intensity and associated UI
-void lightTask(void* paramsList) {
-    EventBits_t* eventBits = ((EventBits_t**)paramsList)[0];
-    uint8_t* lightLevel = ((uint8_t**)paramsList)[1];
-    uint8_t* cck_set = ((uint8_t**)paramsList)[2];
-
-    // Update the UI based on the current light intensity
-    switch (*lightLevel) {
+// Show the icon of the light intensity
+static void light_2color_show_pwm(uint8_t light_pwm, LIGHT_CCK_TYPE cck_set)
+{
+    switch (light_pwm) {
     case 100:
         lv_obj_clear_flag(img_light_pwm_100, LV_OBJ_FLAG_HIDDEN);
-        lv_img_set_src(img_light_pwm_100, light_image.img_pwm_100[*cck_set]);
+        lv_img_set_src(img_light_pwm_100, light_image.img_pwm_100[cck_set]);
         break;
     case 75:
         lv_obj_clear_flag(img_light_pwm_75, LV_OBJ_FLAG_HIDDEN);
-        lv_img_set_src(img_light_pwm_75, light_image.img_pwm_75[*cck_set]);
+        lv_img_set_src(img_light_pwm_75, light_image.img_pwm_75[cck_set]);
         break;
     case 50:
         lv_obj_clear_flag(img_light_pwm_50, LV_OBJ_FLAG_HIDDEN);
-        lv_img_set_src(img_light_pwm_50, light_image.img_pwm_50[*cck_set]);
+        lv_img_set_src(img_light_pwm_50, light_image.img_pwm_50[cck_set]);
         break;
     case 25:
         lv_obj_clear_flag(img_light_pwm_25, LV_OBJ_FLAG_HIDDEN);
-        lv_img_set_src(img_light_pwm_25, light_image.img_pwm_25[*cck_set]);
+        lv_img_set_src(img_light_pwm_25, light_image.img_pwm_25[cck_set]);
         break;
     case 0:
         lv_obj_clear_flag(img_light_pwm_0, LV_OBJ_FLAG_HIDDEN);
@@ -299,18 +262,12 @@ void lightTask(void* paramsList) {
     default:
         break;
     }
-
-    *eventBits |= (1 << 0); // Signal completion of the light task
-    vTaskDelete(NULL); // Self-delete the task
 }
 
-// Task to play audio corresponding to the current light intensity
-void audioTask(void* paramsList) {
-    EventBits_t* eventBits = ((EventBits_t**)paramsList)[0];
-    uint8_t* lightLevel = ((uint8_t**)paramsList)[1];
-
-    // Play the appropriate audio file based on the light intensity
-    switch (*lightLevel) {
+// Play the sound of the light intensity
+static void light_2color_play_pwm(uint8_t light_pwm)
+{
+    switch (light_pwm) {
     case 100:
         audio_handle_info(0);
         break;
@@ -329,7 +286,4 @@ void audioTask(void* paramsList) {
     default:
         break;
     }
-
-    *eventBits |= (1 << 1); // Signal completion of the audio task
-    vTaskDelete(NULL); // Self-delete the task
 }
@@ -10,6 +10,7 @@
 
 #include "lv_example_pub.h"
 #include "lv_example_image.h"
+#include "bsp/esp-bsp.h"
 
 static lv_obj_t* temp_arc;
 static lv_obj_t* page;
@@ -66,63 +67,20 @@ static void thermostat_event_cb(lv_event_t* e)
     }
 }
 
-static void mask_event_cb(lv_event_t* e)
+static void roller_event_cb(lv_event_t* e)
 {
     lv_event_code_t code = lv_event_get_code(e);
     lv_obj_t* obj = lv_event_get_target(e);
 
-    static int16_t mask_top_id = -1;
-    static int16_t mask_bottom_id = -1;
-
-    if (code == LV_EVENT_COVER_CHECK) {
-        lv_event_set_cover_res(e, LV_COVER_RES_MASKED);
-    }
-    else if (code == LV_EVENT_VALUE_CHANGED) {
+    if (code == LV_EVENT_VALUE_CHANGED) {
         char buf[32];
         lv_roller_get_selected_str(obj, buf, sizeof(buf));
         LV_LOG_USER("Selected value: %s", buf);
     }
-    else if (code == LV_EVENT_DRAW_MAIN_BEGIN) {
-        /* add mask */
-        const lv_font_t* font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
-        lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
-        lv_coord_t font_h = lv_font_get_line_height(font);
-
-        lv_area_t roller_coords;
-        lv_obj_get_coords(obj, &roller_coords);
-
-        lv_area_t rect_area;
-        rect_area.x1 = roller_coords.x1;
-        rect_area.x2 = roller_coords.x2;
-        rect_area.y1 = roller_coords.y1;
-        rect_area.y2 = roller_coords.y1 + (lv_obj_get_height(obj) - font_h - line_space) / 2;
-
-        lv_draw_mask_fade_param_t* fade_mask_top = lv_mem_buf_get(sizeof(lv_draw_mask_fade_param_t));
-        lv_draw_mask_fade_init(fade_mask_top, &rect_area, LV_OPA_TRANSP, rect_area.y1, LV_OPA_COVER, rect_area.y2);
-        mask_top_id = lv_draw_mask_add(fade_mask_top, NULL);
-
-        rect_area.y1 = rect_area.y2 + font_h + line_space - 1;
-        rect_area.y2 = roller_coords.y2;
-
-        lv_draw_mask_fade_param_t* fade_mask_bottom = lv_mem_buf_get(sizeof(lv_draw_mask_fade_param_t));
-        lv_draw_mask_fade_init(fade_mask_bottom, &rect_area, LV_OPA_COVER, rect_area.y1, LV_OPA_TRANSP, rect_area.y2);
-        mask_bottom_id = lv_draw_mask_add(fade_mask_bottom, NULL);
-
-    }
-    else if (code == LV_EVENT_DRAW_POST_END) {
-        lv_draw_mask_fade_param_t* fade_mask_top = lv_draw_mask_remove_id(mask_top_id);
-        lv_draw_mask_fade_param_t* fade_mask_bottom = lv_draw_mask_remove_id(mask_bottom_id);
-        lv_draw_mask_free_param(fade_mask_top);
-        lv_draw_mask_free_param(fade_mask_bottom);
-        lv_mem_buf_release(fade_mask_top);
-        lv_mem_buf_release(fade_mask_bottom);
-        mask_top_id = -1;
-        mask_bottom_id = -1;
-    }
 }
 
 /**
- * Add a fade mask to roller.
+ * Add a fade mask to roller, its digits drawn from bands rendered once.
  */
 void lv_create_obj_roller(lv_obj_t* parent)
 {
@@ -142,8 +100,16 @@ void lv_create_obj_roller(lv_obj_t* parent)
     //lv_obj_set_style_border_width(temp_wheel, 10, LV_PART_MAIN);
     lv_obj_set_style_bg_opa(temp_wheel, LV_OPA_TRANSP, LV_PART_SELECTED);
 
+    /* Scalable font of the asset partition, the digits are rasterized before the first frame */
+    const lv_font_t *font_temp = lvgl_port_get_ttf_font("Montserrat-Medium", 48);
+    if (font_temp) {
+        lvgl_port_prewarm_ttf_font(font_temp, "0123456789");
+        lv_obj_set_style_text_font(temp_wheel, font_temp, LV_PART_SELECTED);
+    }
 #if LV_FONT_MONTSERRAT_48
-    lv_obj_set_style_text_font(temp_wheel, &lv_font_montserrat_48, LV_PART_SELECTED);
+    else {
+        lv_obj_set_style_text_font(temp_wheel, &lv_font_montserrat_48, LV_PART_SELECTED);
+    }
 #endif
     lv_roller_set_options(temp_wheel,
         "19\n"
@@ -162,7 +128,18 @@ void lv_create_obj_roller(lv_obj_t* parent)
 
     lv_obj_align(temp_wheel, LV_ALIGN_CENTER, 5, 10);
     lv_roller_set_visible_row_count(temp_wheel, 3);
-    lv_obj_add_event_cb(temp_wheel, mask_event_cb, LV_EVENT_ALL, NULL);
+    lv_obj_add_event_cb(temp_wheel, roller_event_cb, LV_EVENT_ALL, NULL);
+
+    /* Rows above and below the selected one fade out, the rows of the fade are computed once */
+    const lv_font_t* font = lv_obj_get_style_text_font(temp_wheel, LV_PART_MAIN);
+    lv_coord_t row_h = lv_font_get_line_height(font) + lv_obj_get_style_text_line_space(temp_wheel, LV_PART_MAIN);
+    lv_obj_update_layout(temp_wheel);
+    lv_coord_t roller_h = lv_obj_get_height(temp_wheel);
+    lv_coord_t fade_top = (roller_h - row_h) / 2 + 1;
+    lvgl_port_add_clip_fade(temp_wheel, fade_top, roller_h - fade_top - row_h + 2);
+
+    /* The digits are rendered once, scrolling to a new temperature moves them */
+    lvgl_port_add_roller_band(temp_wheel);
 }
 
 void ui_thermostat_init(lv_obj_t* parent)
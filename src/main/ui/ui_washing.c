@@ -7,11 +7,13 @@
 #include <stdio.h>
 #include <time.h>
 #include "lvgl.h"
+#include "bsp/esp-bsp.h"
 #include "ui_washing.h"
 #include "src/misc/lv_math.h"
 
 #include "settings.h"
 #include "app_audio.h"
+#include "washing_cycle.h"
 #include "lv_example_pub.h"
 #include "lv_example_image.h"
 
@@ -36,14 +38,6 @@ typedef struct {
     uint8_t wash_time;
 } wash_cycle_t;
 
-typedef enum {
-    WASH_MODE_STANDBY,
-    WASH_MODE_RUN,
-    WASH_MODE_PAUSE,
-    WASH_MODE_EOC,
-    WASH_MODE_MAX,
-} WASH_MODE_T;
-
 static const wash_cycle_t wash_cycle[FUNC_NUM] = {
     {&img_washing_stand, &wash_basic, 58},
     {&img_washing_shirt, &wash_blouse, 68},
@@ -53,6 +47,19 @@ static const wash_cycle_t wash_cycle[FUNC_NUM] = {
 static lv_coord_t cycle_init_y_axis[FUNC_NUM];
 static lv_coord_t cycle_init_x_axis[FUNC_NUM];
 
+/* Program names rendered ahead in steps of zoom, from the sides (abs_t 33) to the center */
+#define FUNC_ZOOM(abs_t)    (256 * (100 - (abs_t)) / 70)
+#define FUNC_ZOOM_MIN       FUNC_ZOOM(33)
+#define FUNC_ZOOM_MAX       FUNC_ZOOM(0)
+#if CONFIG_UI_WASHING_ZOOM_STEPS > 1
+static lv_img_dsc_t func_steps[FUNC_NUM][CONFIG_UI_WASHING_ZOOM_STEPS];
+#endif
+static bool func_stepped;
+
+/* Waves of the running cycle, zoomed once into the textures of their bands */
+#define RUN_WAVE_ZOOM       (256 * (240 - 0) / 162)
+static lv_img_dsc_t run_wave_steps[2];
+
 static lv_anim_t anmi_run_wave;
 static lv_obj_t* label_wash_time;
 static lv_obj_t* img_funcs[FUNC_NUM];
@@ -65,10 +72,12 @@ static lv_coord_t img_wave1_x, img_wave2_x, img_run_wave1_x, img_run_wave2_x;
 static lv_obj_t* img_anmi_shirt, * img_anmi_underwear1, * img_anmi_underwear2;
 static lv_obj_t* label_leftTimeH, * label_leftTimeL, * label_leftTime_unit;
 
-static WASH_MODE_T wash_mode, wash_mode_xor;
 static uint8_t item_central;
-static uint32_t wash_time_left, wash_demo_left;
-static time_out_count time_1000ms;
+
+/* Seconds of a demo cycle, the whole program runs without */
+#define WASH_DEMO_TICKS     8
+static washing_cycle_t wash;
+static lv_timer_t* wash_timer;
 
 static uint32_t get_cycle_position(uint32_t num, int32_t max, int32_t offset)
 {
@@ -94,6 +103,27 @@ static uint32_t get_next_cycle_position(int8_t offset)
     return get_cycle_position(item_central, 3, offset);
 }
 
+/* Size and tint of a program name by its distance from the center */
+static void func_set_scale(int i, int32_t abs_t)
+{
+#if CONFIG_UI_WASHING_ZOOM_STEPS > 1
+    if (func_stepped) {
+        const int32_t zoom = LV_CLAMP(FUNC_ZOOM_MIN, FUNC_ZOOM(abs_t), FUNC_ZOOM_MAX);
+        const int32_t step = ((zoom - FUNC_ZOOM_MIN) * (CONFIG_UI_WASHING_ZOOM_STEPS - 1) + (FUNC_ZOOM_MAX - FUNC_ZOOM_MIN) / 2) /
+                             (FUNC_ZOOM_MAX - FUNC_ZOOM_MIN);
+        if (lv_img_get_src(img_funcs[i]) != &func_steps[i][step]) {
+            lv_img_set_src(img_funcs[i], &func_steps[i][step]);
+        }
+    }
+    else
+#endif
+    {
+        lv_img_set_zoom(img_funcs[i], FUNC_ZOOM(abs_t));
+    }
+    lv_obj_set_style_img_recolor_opa(img_funcs[i], LV_OPA_COVER, 0);
+    lv_obj_set_style_img_recolor(img_funcs[i], lv_color_hsv_to_rgb(200, (40 - abs_t) * 60 / 40, 100), 0);
+}
+
 static void menu_position_reset()
 {
     int32_t abs_t, x_axis, y_axis;
@@ -119,9 +149,7 @@ static void menu_position_reset()
             y_axis = (0 + 80);
         }
 
-        lv_img_set_zoom(img_funcs[i], 256 * (100 - abs_t) / 70);
-        lv_obj_set_style_img_recolor_opa(img_funcs[i], LV_OPA_COVER, 0);
-        lv_obj_set_style_img_recolor(img_funcs[i], lv_color_hsv_to_rgb(200, (40 - abs_t) * 60 / 40, 100), 0);
+        func_set_scale(i, abs_t);
         lv_obj_align(img_funcs[i], LV_ALIGN_CENTER, x_axis, y_axis);
         lv_label_set_text_fmt(label_wash_time, "- %02d min -", wash_cycle[item_central].wash_time);
 
@@ -173,9 +201,7 @@ static void func_anim_cb(void* args, int32_t v)
 
         int32_t abs_t = LV_ABS(lv_obj_get_y_aligned(img_funcs[i]));
         if (abs_t <= 40) {
-            lv_img_set_zoom(img_funcs[i], 256 * (100 - abs_t) / 70);
-            lv_obj_set_style_img_recolor_opa(img_funcs[i], LV_OPA_COVER, 0);
-            lv_obj_set_style_img_recolor(img_funcs[i], lv_color_hsv_to_rgb(200, (40 - abs_t) * 60 / 40, 100), 0);
+            func_set_scale(i, abs_t);
         }
     }
 }
@@ -189,6 +215,77 @@ static void func_anim_ready_cb(lv_anim_t* a)
     menu_position_reset();
 }
 
+/* Redraws what the cycle changed, nothing runs between its ticks */
+static void wash_cycle_cb(const washing_cycle_t* cycle, uint32_t changed, void* user_data)
+{
+    if (changed & WASHING_CYCLE_CHANGED_STATE) {
+        switch (cycle->state) {
+        case WASHING_CYCLE_STANDBY: {
+            lv_obj_add_flag(page_run, LV_OBJ_FLAG_HIDDEN);
+            lv_obj_clear_flag(page_standby, LV_OBJ_FLAG_HIDDEN);
+        }
+                                  break;
+        case WASHING_CYCLE_RUN: {
+            lv_obj_clear_flag(page_run, LV_OBJ_FLAG_HIDDEN);
+            lv_obj_add_flag(page_standby, LV_OBJ_FLAG_HIDDEN);
+        }
+                              break;
+        case WASHING_CYCLE_PAUSE: {
+            lv_obj_clear_flag(label_leftTime_unit, LV_OBJ_FLAG_HIDDEN);
+        }
+                                break;
+        case WASHING_CYCLE_END: {
+            sys_param_t* param = settings_get_parameter();
+            lv_obj_add_flag(label_leftTime_unit, LV_OBJ_FLAG_HIDDEN);
+            lv_label_set_text(label_leftTimeH, "-");
+            lv_label_set_text(label_leftTimeL, "-");
+            audio_handle_info((LANGUAGE_CN == param->language) ? SOUND_TYPE_WASH_END_CN : SOUND_TYPE_WASH_END_EN);
+        }
+                              break;
+        default:
+            break;
+        }
+    }
+    if (WASHING_CYCLE_END == cycle->state) {
+        return;
+    }
+
+    if (changed & WASHING_CYCLE_CHANGED_TICK) {
+        /* The colon blinks with the seconds */
+        if (cycle->seconds_left % 2) {
+            lv_obj_clear_flag(label_leftTime_unit, LV_OBJ_FLAG_HIDDEN);
+        }
+        else {
+            lv_obj_add_flag(label_leftTime_unit, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+    if (changed & WASHING_CYCLE_CHANGED_TIME) {
+        uint32_t hours, minutes;
+        washing_cycle_get_time(cycle, &hours, &minutes);
+        lv_label_set_text_fmt(label_leftTimeH, "%d", (int)hours);
+        lv_label_set_text_fmt(label_leftTimeL, "%02d", (int)minutes);
+    }
+}
+
+/* Counts the ticks due and runs the timer when the next one is */
+static void wash_timer_schedule(void)
+{
+    const uint32_t next = washing_cycle_update(&wash, lv_tick_get());
+    if (WASHING_CYCLE_IDLE == next) {
+        lv_timer_pause(wash_timer);
+    }
+    else {
+        lv_timer_set_period(wash_timer, next);
+        lv_timer_reset(wash_timer);
+        lv_timer_resume(wash_timer);
+    }
+}
+
+static void wash_timer_cb(lv_timer_t* tmr)
+{
+    wash_timer_schedule();
+}
+
 static void washing_event_cb(lv_event_t* e)
 {
     static uint8_t forbidden_sec_trigger = false;
@@ -235,29 +332,28 @@ static void washing_event_cb(lv_event_t* e)
     }
     else if (LV_EVENT_LONG_PRESSED == code) {
         forbidden_sec_trigger = true;
-        if (WASH_MODE_STANDBY == wash_mode) {
+        if (WASHING_CYCLE_STANDBY == wash.state) {
             lv_indev_wait_release(lv_indev_get_next(NULL));
             ui_remove_all_objs_from_encoder_group();
             lv_func_goto_layer(&menu_layer);
         }
-        else if ((WASH_MODE_RUN == wash_mode) || (WASH_MODE_PAUSE == wash_mode)) {
-            wash_mode = WASH_MODE_EOC;
-        }
-        else if (WASH_MODE_EOC == wash_mode) {
-            wash_mode = WASH_MODE_STANDBY;
+        else if (!washing_cycle_stop(&wash)) {
+            washing_cycle_reset(&wash);
         }
+        wash_timer_schedule();
     }
     else if (LV_EVENT_CLICKED == code) {
         if (false == forbidden_sec_trigger) {
-            if (WASH_MODE_STANDBY == wash_mode) {
-                wash_mode = WASH_MODE_RUN;
+            if (WASHING_CYCLE_STANDBY == wash.state) {
+                washing_cycle_start(&wash, wash_cycle[item_central].wash_time, lv_tick_get());
             }
-            else if (WASH_MODE_RUN == wash_mode) {
-                wash_mode = WASH_MODE_PAUSE;
+            else if (WASHING_CYCLE_RUN == wash.state) {
+                washing_cycle_pause(&wash, lv_tick_get());
             }
-            else if (WASH_MODE_PAUSE == wash_mode) {
-                wash_mode = WASH_MODE_RUN;
+            else if (WASHING_CYCLE_PAUSE == wash.state) {
+                washing_cycle_resume(&wash, lv_tick_get());
             }
+            wash_timer_schedule();
         }
         else {
             forbidden_sec_trigger = false;
@@ -279,18 +375,36 @@ static void bub1_anim_cb(void* args, int32_t v)
 
 static void wave_anim_cb(void* args, int32_t v)
 {
-    lv_obj_set_x(img_wave1, img_wave1_x + LV_ABS(v));
-    lv_obj_set_x(img_wave2, img_wave2_x - LV_ABS(v));
+    /* The texture moves right in the band by scrolling it left */
+    lvgl_port_set_scroll_offset(img_wave1, -(img_wave1_x + LV_ABS(v)));
+    lvgl_port_set_scroll_offset(img_wave2, -(img_wave2_x - LV_ABS(v)));
 }
 
 static void wave_run_anim_cb(void* args, int32_t v)
 {
-    if (WASH_MODE_RUN == wash_mode) {
-        lv_obj_set_x(img_run_wave1, img_run_wave1_x + LV_ABS(v));
-        lv_obj_set_x(img_run_wave2, img_run_wave2_x - LV_ABS(v));
+    if (WASHING_CYCLE_RUN == wash.state) {
+        lvgl_port_set_scroll_offset(img_run_wave1, -(img_run_wave1_x + LV_ABS(v)));
+        lvgl_port_set_scroll_offset(img_run_wave2, -(img_run_wave2_x - LV_ABS(v)));
     }
 }
 
+/* Band at the bottom of the page, its texture centered where the image was aligned (bottom mid, x_ofs, 10) */
+static lv_obj_t* run_wave_create(lv_obj_t* parent, const void* img, const void* tex, lv_coord_t x_ofs, lv_coord_t* tex_x)
+{
+    lv_img_header_t img_info, tex_info;
+    lv_img_decoder_get_info(img, &img_info);
+    lv_img_decoder_get_info(tex, &tex_info);
+    const lv_coord_t img_w = img_info.w, img_h = img_info.h;
+    const lv_coord_t tex_w = tex_info.w, tex_h = tex_info.h;
+    const lv_coord_t tex_y = LV_VER_RES - img_h + 10 + (img_h - tex_h) / 2;
+
+    *tex_x = (LV_HOR_RES - img_w) / 2 + x_ofs + (img_w - tex_w) / 2;
+    lv_obj_t* wave = lvgl_port_create_scroll(parent, tex);
+    lv_obj_set_pos(wave, 0, tex_y);
+    lv_obj_set_size(wave, LV_HOR_RES, LV_VER_RES - tex_y);
+    return wave;
+}
+
 static void shirt_anim_cb(void* args, int32_t v)
 {
     lv_obj_t* img_shirt = (lv_obj_t*)args;
@@ -304,31 +418,6 @@ static void underwear_anim_cb(void* args, int32_t v)
     lv_img_set_angle(img_anmi_underwear2, -v);
 }
 
-static void mask_event_cb(lv_event_t* e)
-{
-    lv_event_code_t code = lv_event_get_code(e);
-
-    static int16_t mask_id = -1;
-
-    if (code == LV_EVENT_COVER_CHECK) {
-        lv_event_set_cover_res(e, LV_COVER_RES_MASKED);
-    }
-    else if (code == LV_EVENT_DRAW_MAIN_BEGIN) {
-        /* add mask */
-        lv_area_t win_area;
-        lv_obj_get_coords(img_bg_wash, &win_area);
-        lv_draw_mask_radius_param_t* mask_out_param = lv_mem_buf_get(sizeof(lv_draw_mask_radius_param_t));
-        lv_draw_mask_radius_init(mask_out_param, &win_area, LV_RADIUS_CIRCLE, 0);
-        mask_id = lv_draw_mask_add(mask_out_param, NULL);
-    }
-    else if (code == LV_EVENT_DRAW_POST_END) {
-        lv_draw_mask_radius_param_t* mask = lv_draw_mask_remove_id(mask_id);
-        lv_draw_mask_free_param(mask);
-        lv_mem_buf_release(mask);
-        mask_id = -1;
-    }
-}
-
 void ui_washing_init(lv_obj_t* parent)
 {
     sys_param_t* param = settings_get_parameter();
@@ -385,19 +474,16 @@ void ui_washing_init(lv_obj_t* parent)
     }
     lv_obj_align(label_info, LV_ALIGN_CENTER, 0, 40);
 
-    img_run_wave1 = lv_img_create(page_run);
-    lv_img_set_src(img_run_wave1, &img_washing_wave1);
-    lv_obj_align(img_run_wave1, LV_ALIGN_BOTTOM_MID, -15, 10);
-    lv_img_set_zoom(img_run_wave1, 256 * (240 - 0) / 162);
-    img_run_wave2 = lv_img_create(page_run);
-    lv_img_set_src(img_run_wave2, &img_washing_wave2);
-    lv_obj_align(img_run_wave2, LV_ALIGN_BOTTOM_MID, 20, 10);
-    lv_img_set_zoom(img_run_wave2, 256 * (240 - 0) / 162);
-    // lv_obj_add_event_cb(img_run_wave1, mask_event_cb, LV_EVENT_ALL, NULL);
-    // lv_obj_add_event_cb(img_run_wave2, mask_event_cb, LV_EVENT_ALL, NULL);
-
-    img_run_wave1_x = lv_obj_get_x_aligned(img_run_wave1);
-    img_run_wave2_x = lv_obj_get_x_aligned(img_run_wave2);
+    /* Scrolled instead of zoomed on every frame, unzoomed when there is no memory for the textures */
+    const lv_img_dsc_t* run_wave_tex[2] = { &img_washing_wave1, &img_washing_wave2 };
+    lvgl_port_delete_img_steps(run_wave_steps, 2);
+    for (size_t i = 0; i < 2; i++) {
+        if (ESP_OK == lvgl_port_create_img_steps(run_wave_tex[i], RUN_WAVE_ZOOM, RUN_WAVE_ZOOM, false, &run_wave_steps[i], 1)) {
+            run_wave_tex[i] = &run_wave_steps[i];
+        }
+    }
+    img_run_wave1 = run_wave_create(page_run, &img_washing_wave1, run_wave_tex[0], -15, &img_run_wave1_x);
+    img_run_wave2 = run_wave_create(page_run, &img_washing_wave2, run_wave_tex[1], 20, &img_run_wave2_x);
     lv_anim_init(&anmi_run_wave);
     lv_anim_set_var(&anmi_run_wave, img_run_wave1);
     lv_anim_set_delay(&anmi_run_wave, 0);
@@ -417,14 +503,21 @@ void ui_washing_init(lv_obj_t* parent)
     lv_img_set_src(img_bg_wash, &img_washing_bg);
     lv_obj_align(img_bg_wash, LV_ALIGN_LEFT_MID, 7, 0);
 
-    img_wave1 = lv_img_create(img_bg_wash);
-    lv_img_set_src(img_wave1, &img_washing_wave1);
-    lv_obj_align(img_wave1, LV_ALIGN_BOTTOM_MID, -15, 10);
-    img_wave2 = lv_img_create(img_bg_wash);
-    lv_img_set_src(img_wave2, &img_washing_wave2);
-    lv_obj_align(img_wave2, LV_ALIGN_BOTTOM_MID, 20, 10);
-    lv_obj_add_event_cb(img_wave1, mask_event_cb, LV_EVENT_ALL, NULL);
-    lv_obj_add_event_cb(img_wave2, mask_event_cb, LV_EVENT_ALL, NULL);
+    /* The waves loop in a band at the bottom of the background, the rows of the old images inside it */
+    lv_obj_update_layout(img_bg_wash);
+    const lv_coord_t bg_w = lv_obj_get_width(img_bg_wash);
+    img_wave1 = lvgl_port_create_scroll(img_bg_wash, &img_washing_wave1);
+    img_wave2 = lvgl_port_create_scroll(img_bg_wash, &img_washing_wave2);
+    lv_obj_update_layout(img_bg_wash);
+    img_wave1_x = (bg_w - lv_obj_get_width(img_wave1)) / 2 - 15;
+    img_wave2_x = (bg_w - lv_obj_get_width(img_wave2)) / 2 + 20;
+    lv_obj_set_size(img_wave1, bg_w, lv_obj_get_height(img_wave1) - 10);
+    lv_obj_align(img_wave1, LV_ALIGN_BOTTOM_MID, 0, 0);
+    lv_obj_set_size(img_wave2, bg_w, lv_obj_get_height(img_wave2) - 10);
+    lv_obj_align(img_wave2, LV_ALIGN_BOTTOM_MID, 0, 0);
+    /* Both waves share one circle of the background, its rows are computed once */
+    lvgl_port_add_clip_radius(img_wave1, img_bg_wash, LV_RADIUS_CIRCLE);
+    lvgl_port_add_clip_radius(img_wave2, img_bg_wash, LV_RADIUS_CIRCLE);
 
     lv_obj_t* img_bub1 = lv_img_create(img_bg_wash);
     lv_img_set_src(img_bub1, &img_washing_bubble1);
@@ -444,7 +537,16 @@ void ui_washing_init(lv_obj_t* parent)
     lv_obj_align(img_anmi_underwear2, LV_ALIGN_TOP_MID, 0, 15 + 28 + 8);
 
     label_wash_time = lv_label_create(page_standby);
-    lv_obj_set_style_text_font(label_wash_time, &lv_font_montserrat_16, 0);
+    const lv_font_t *font_time = lvgl_port_get_ttf_font("Montserrat-Medium", 16);
+    if (font_time) {
+        lvgl_port_prewarm_ttf_font(font_time, "- 0123456789min");
+        lv_obj_set_style_text_font(label_wash_time, font_time, 0);
+    }
+#if LV_FONT_MONTSERRAT_16
+    else {
+        lv_obj_set_style_text_font(label_wash_time, &lv_font_montserrat_16, 0);
+    }
+#endif
     lv_label_set_text_fmt(label_wash_time, "- %02d min -", wash_cycle[item_central].wash_time);
     lv_obj_set_style_text_opa(label_wash_time, LV_OPA_70, 0);
     lv_obj_set_width(label_wash_time, 150);  /*Set smaller width to make the lines wrap*/
@@ -452,6 +554,22 @@ void ui_washing_init(lv_obj_t* parent)
     lv_obj_align(label_wash_time, LV_ALIGN_CENTER, 60, 27);
 
     int16_t x, y;
+    func_stepped = false;
+#if CONFIG_UI_WASHING_ZOOM_STEPS > 1
+    /* The names are always fully recolored, their steps keep the alpha only and take the tint */
+    func_stepped = true;
+    for (size_t i = 0; i < FUNC_NUM && func_stepped; i++) {
+        lvgl_port_delete_img_steps(func_steps[i], CONFIG_UI_WASHING_ZOOM_STEPS);
+        const lv_img_dsc_t* src = (LANGUAGE_CN == param->language) ? wash_cycle[i].wash_funcs_CN : wash_cycle[i].wash_funcs_EN;
+        func_stepped = (ESP_OK == lvgl_port_create_img_steps(src, FUNC_ZOOM_MIN, FUNC_ZOOM_MAX, true,
+                                                             func_steps[i], CONFIG_UI_WASHING_ZOOM_STEPS));
+    }
+    if (!func_stepped) {
+        for (size_t i = 0; i < FUNC_NUM; i++) {
+            lvgl_port_delete_img_steps(func_steps[i], CONFIG_UI_WASHING_ZOOM_STEPS);
+        }
+    }
+#endif
     for (size_t i = 0; i < FUNC_NUM; i++) {
         //arc_path_by_theta(i * 45, &x, &y);
         img_funcs[i] = lv_img_create(page_standby);
@@ -488,8 +606,6 @@ void ui_washing_init(lv_obj_t* parent)
     lv_anim_set_repeat_count(&anmi_bub2, LV_ANIM_REPEAT_INFINITE);
     lv_anim_start(&anmi_bub2);
 
-    img_wave1_x = lv_obj_get_x_aligned(img_wave1);
-    img_wave2_x = lv_obj_get_x_aligned(img_wave2);
     lv_anim_t anmi_wave;
     lv_anim_init(&anmi_wave);
     lv_anim_set_var(&anmi_wave, img_wave1);
@@ -532,8 +648,14 @@ void ui_washing_init(lv_obj_t* parent)
     ui_add_obj_to_encoder_group(page_background);
 
     item_central = 0;
-    wash_mode = WASH_MODE_STANDBY;
-    wash_mode_xor = WASH_MODE_MAX;
+    const washing_cycle_config_t wash_config = {
+        .tick_ms = 1000,
+        .demo_ticks = WASH_DEMO_TICKS,
+        .cb = wash_cycle_cb,
+    };
+    washing_cycle_init(&wash, &wash_config);
+    wash_timer = lv_timer_create(wash_timer_cb, 1000, NULL);
+    lv_timer_pause(wash_timer);
     menu_position_reset();
 }
 
@@ -550,7 +672,11 @@ static bool washing_layer_enter_cb(void* layer)
         lv_obj_set_size(create_layer->lv_obj_layer, LV_HOR_RES, LV_VER_RES);
 
         ui_washing_init(create_layer->lv_obj_layer);
-        set_time_out(&time_1000ms, 500);
+
+        /* The recolored program names, zoomed every frame unless stepped */
+        for (size_t i = 0; i < FUNC_NUM && !func_stepped; i++) {
+            lvgl_port_pin_img(lv_img_get_src(img_funcs[i]), true);
+        }
     }
 
     return ret;
@@ -559,64 +685,17 @@ static bool washing_layer_enter_cb(void* layer)
 static bool washing_layer_exit_cb(void* layer)
 {
     LV_LOG_USER("");
+    /* The images showing the steps are deleted right after, before any redraw */
+#if CONFIG_UI_WASHING_ZOOM_STEPS > 1
+    for (size_t i = 0; i < FUNC_NUM; i++) {
+        lvgl_port_delete_img_steps(func_steps[i], CONFIG_UI_WASHING_ZOOM_STEPS);
+    }
+#endif
+    lvgl_port_delete_img_steps(run_wave_steps, 2);
     return true;
 }
 
 static void washing_layer_timer_cb(lv_timer_t* tmr)
 {
     feed_clock_time();
-    sys_param_t* param = settings_get_parameter();
-
-    if (wash_mode_xor ^ wash_mode) {
-        switch (wash_mode) {
-        case WASH_MODE_STANDBY: {
-            lv_obj_add_flag(page_run, LV_OBJ_FLAG_HIDDEN);
-            lv_obj_clear_flag(page_standby, LV_OBJ_FLAG_HIDDEN);
-        }
-                              break;
-        case WASH_MODE_RUN: {
-            if (WASH_MODE_STANDBY == wash_mode_xor) {
-                wash_demo_left = 8;
-                wash_time_left = 60 * wash_cycle[item_central].wash_time;
-                lv_label_set_text_fmt(label_leftTimeH, "%d", (wash_time_left + 59) / 3600);
-                lv_label_set_text_fmt(label_leftTimeL, "%02d", ((wash_time_left + 59) % 3600) / 60);
-            }
-            lv_obj_clear_flag(page_run, LV_OBJ_FLAG_HIDDEN);
-            lv_obj_add_flag(page_standby, LV_OBJ_FLAG_HIDDEN);
-        }
-                          break;
-        case WASH_MODE_PAUSE: {
-            lv_obj_clear_flag(label_leftTime_unit, LV_OBJ_FLAG_HIDDEN);
-        }
-                            break;
-        case WASH_MODE_EOC: {
-            lv_obj_add_flag(label_leftTime_unit, LV_OBJ_FLAG_HIDDEN);
-            lv_label_set_text(label_leftTimeH, "-");
-            lv_label_set_text(label_leftTimeL, "-");
-            audio_handle_info((LANGUAGE_CN == param->language) ? SOUND_TYPE_WASH_END_CN : SOUND_TYPE_WASH_END_EN);
-        }
-                          break;
-        default:
-            break;
-        }
-        wash_mode_xor = wash_mode;
-    }
-
-    if (is_time_out(&time_1000ms) && (WASH_MODE_RUN == wash_mode)) {
-        if (wash_demo_left) {
-            if (wash_time_left % 2) {
-                lv_obj_add_flag(label_leftTime_unit, LV_OBJ_FLAG_HIDDEN);
-            }
-            else {
-                lv_obj_clear_flag(label_leftTime_unit, LV_OBJ_FLAG_HIDDEN);
-            }
-            lv_label_set_text_fmt(label_leftTimeH, "%d", (wash_time_left + 59) / 3600);
-            lv_label_set_text_fmt(label_leftTimeL, "%02d", ((wash_time_left + 59) % 3600) / 60);
-            wash_time_left--;
-            wash_demo_left--;
-        }
-        else {
-            wash_mode = WASH_MODE_EOC;
-        }
-    }
 }
@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <string.h>
+#include "washing_cycle.h"
+
+static void washing_cycle_notify(const washing_cycle_t *cycle, uint32_t changed)
+{
+    if (changed && cycle->config.cb) {
+        cycle->config.cb(cycle, changed, cycle->config.user_data);
+    }
+}
+
+static void washing_cycle_set_state(washing_cycle_t *cycle, washing_cycle_state_t state, uint32_t changed)
+{
+    cycle->state = state;
+    washing_cycle_notify(cycle, changed | WASHING_CYCLE_CHANGED_STATE);
+}
+
+/* Shown time, as one number */
+static uint32_t washing_cycle_shown(const washing_cycle_t *cycle)
+{
+    uint32_t hours, minutes;
+    washing_cycle_get_time(cycle, &hours, &minutes);
+    return hours * 60 + minutes;
+}
+
+void washing_cycle_init(washing_cycle_t *cycle, const washing_cycle_config_t *config)
+{
+    memset(cycle, 0, sizeof(*cycle));
+    cycle->config = *config;
+    if (cycle->config.tick_ms == 0) {
+        cycle->config.tick_ms = 1000;
+    }
+    cycle->state = WASHING_CYCLE_STANDBY;
+}
+
+bool washing_cycle_start(washing_cycle_t *cycle, uint32_t minutes, uint32_t now_ms)
+{
+    if (cycle->state != WASHING_CYCLE_STANDBY || minutes == 0) {
+        return false;
+    }
+    cycle->seconds_left = minutes * 60;
+    cycle->ticks = 0;
+    cycle->tick_due_ms = now_ms + cycle->config.tick_ms;
+    washing_cycle_set_state(cycle, WASHING_CYCLE_RUN, WASHING_CYCLE_CHANGED_TIME);
+    return true;
+}
+
+bool washing_cycle_pause(washing_cycle_t *cycle, uint32_t now_ms)
+{
+    if (cycle->state != WASHING_CYCLE_RUN) {
+        return false;
+    }
+    const int32_t left = (int32_t)(cycle->tick_due_ms - now_ms);
+    cycle->tick_left_ms = (left > 0) ? (uint32_t)left : 0;
+    washing_cycle_set_state(cycle, WASHING_CYCLE_PAUSE, 0);
+    return true;
+}
+
+bool washing_cycle_resume(washing_cycle_t *cycle, uint32_t now_ms)
+{
+    if (cycle->state != WASHING_CYCLE_PAUSE) {
+        return false;
+    }
+    cycle->tick_due_ms = now_ms + cycle->tick_left_ms;
+    washing_cycle_set_state(cycle, WASHING_CYCLE_RUN, 0);
+    return true;
+}
+
+bool washing_cycle_stop(washing_cycle_t *cycle)
+{
+    if (cycle->state != WASHING_CYCLE_RUN && cycle->state != WASHING_CYCLE_PAUSE) {
+        return false;
+    }
+    washing_cycle_set_state(cycle, WASHING_CYCLE_END, 0);
+    return true;
+}
+
+bool washing_cycle_reset(washing_cycle_t *cycle)
+{
+    if (cycle->state != WASHING_CYCLE_END) {
+        return false;
+    }
+    washing_cycle_set_state(cycle, WASHING_CYCLE_STANDBY, 0);
+    return true;
+}
+
+uint32_t washing_cycle_update(washing_cycle_t *cycle, uint32_t now_ms)
+{
+    if (cycle->state != WASHING_CYCLE_RUN) {
+        return WASHING_CYCLE_IDLE;
+    }
+
+    const uint32_t shown = washing_cycle_shown(cycle);
+    bool ended = false;
+    bool ticked = false;
+    while (!ended && (int32_t)(now_ms - cycle->tick_due_ms) >= 0) {
+        cycle->seconds_left--;
+        cycle->ticks++;
+        cycle->tick_due_ms += cycle->config.tick_ms;
+        ticked = true;
+        ended = (cycle->seconds_left == 0) || (cycle->ticks == cycle->config.demo_ticks);
+    }
+    if (!ticked) {
+        return cycle->tick_due_ms - now_ms;
+    }
+
+    uint32_t changed = WASHING_CYCLE_CHANGED_TICK;
+    if (washing_cycle_shown(cycle) != shown) {
+        changed |= WASHING_CYCLE_CHANGED_TIME;
+    }
+    if (ended) {
+        washing_cycle_set_state(cycle, WASHING_CYCLE_END, changed);
+        return WASHING_CYCLE_IDLE;
+    }
+    washing_cycle_notify(cycle, changed);
+    return cycle->tick_due_ms - now_ms;
+}
+
+void washing_cycle_get_time(const washing_cycle_t *cycle, uint32_t *hours, uint32_t *minutes)
+{
+    const uint32_t seconds = cycle->seconds_left + 59;
+    *hours = seconds / 3600;
+    *minutes = (seconds % 3600) / 60;
+}
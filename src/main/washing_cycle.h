@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/**
+ * @file
+ * @brief State machine of a washing cycle, without any UI
+ *
+ * The cycle counts down its time in ticks of the time passed to washing_cycle_update(), which
+ * returns when the next tick is due, and reports every change to one callback. It depends on
+ * nothing but the C library: the UI drives it with the LVGL tick, the host tests run full cycles
+ * in accelerated time.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* washing_cycle_update() while no tick is due */
+#define WASHING_CYCLE_IDLE          UINT32_MAX
+
+/* Changes reported to the callback */
+#define WASHING_CYCLE_CHANGED_STATE (1 << 0)    /* State */
+#define WASHING_CYCLE_CHANGED_TICK  (1 << 1)    /* Seconds left, once per tick */
+#define WASHING_CYCLE_CHANGED_TIME  (1 << 2)    /* Shown hours or minutes */
+
+typedef enum {
+    WASHING_CYCLE_STANDBY,      /* Program selection */
+    WASHING_CYCLE_RUN,
+    WASHING_CYCLE_PAUSE,
+    WASHING_CYCLE_END,          /* Ended or stopped, until reset */
+} washing_cycle_state_t;
+
+typedef struct washing_cycle washing_cycle_t;
+
+/**
+ * @brief Callback of the changes of a cycle
+ *
+ * Called from the functions of the cycle, in the task calling them.
+ *
+ * @param cycle     Changed cycle
+ * @param changed   WASHING_CYCLE_CHANGED_* flags
+ * @param user_data User data of the configuration
+ */
+typedef void (*washing_cycle_cb_t)(const washing_cycle_t *cycle, uint32_t changed, void *user_data);
+
+typedef struct {
+    uint32_t tick_ms;           /*!< Duration of one second of the countdown, 1000 in real time */
+    uint32_t demo_ticks;        /*!< Ticks before a demo ends the cycle, 0 runs the whole program */
+    washing_cycle_cb_t cb;      /*!< Callback of the changes, may be NULL */
+    void *user_data;            /*!< User data of the callback */
+} washing_cycle_config_t;
+
+struct washing_cycle {
+    washing_cycle_config_t config;
+    washing_cycle_state_t state;
+    uint32_t seconds_left;      /* Of the program */
+    uint32_t ticks;             /* Since the start */
+    uint32_t tick_due_ms;       /* Time of the next tick while running */
+    uint32_t tick_left_ms;      /* Rest of the tick interrupted by a pause */
+};
+
+/**
+ * @brief Initialize a cycle in standby
+ */
+void washing_cycle_init(washing_cycle_t *cycle, const washing_cycle_config_t *config);
+
+/**
+ * @brief Start a program from standby
+ *
+ * @param minutes   Duration of the program
+ * @param now_ms    Current time
+ * @return false when the cycle is not in standby
+ */
+bool washing_cycle_start(washing_cycle_t *cycle, uint32_t minutes, uint32_t now_ms);
+
+/**
+ * @brief Pause a running cycle, keeping the rest of the current tick
+ *
+ * @return false when the cycle is not running
+ */
+bool washing_cycle_pause(washing_cycle_t *cycle, uint32_t now_ms);
+
+/**
+ * @brief Resume a paused cycle
+ *
+ * @return false when the cycle is not paused
+ */
+bool washing_cycle_resume(washing_cycle_t *cycle, uint32_t now_ms);
+
+/**
+ * @brief End a running or paused cycle before its time
+ *
+ * @return false when the cycle is neither running nor paused
+ */
+bool washing_cycle_stop(washing_cycle_t *cycle);
+
+/**
+ * @brief Return from the end of a cycle to standby
+ *
+ * @return false when the cycle has not ended
+ */
+bool washing_cycle_reset(washing_cycle_t *cycle);
+
+/**
+ * @brief Count down the ticks due until now
+ *
+ * Ticks late by more than one period are all counted, a cycle ending on its last one.
+ *
+ * @param now_ms    Current time, wrapping around like a tick counter
+ * @return Milliseconds until the next tick, WASHING_CYCLE_IDLE when not running
+ */
+uint32_t washing_cycle_update(washing_cycle_t *cycle, uint32_t now_ms);
+
+/**
+ * @brief Hours and minutes of the time left, rounded up to the minute as shown
+ */
+void washing_cycle_get_time(const washing_cycle_t *cycle, uint32_t *hours, uint32_t *minutes);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,83 @@
+# Images of main/ui without their C source in the tree
+#
+# Some images are only available as objects of the firmware build. Their descriptor and pixel
+# map are extracted with objcopy and linked into the simulator. Without objcopy or the object
+# an empty image (0x0) is used, so the screen still works but renders without it.
+#
+# sim_firmware_assets(<output.c> <main dir> <firmware object dir>)
+
+function(sim_firmware_assets output main_dir obj_dir)
+    find_program(SIM_OBJCOPY NAMES objcopy llvm-objcopy)
+
+    file(GLOB_RECURSE objects RELATIVE ${obj_dir} ${obj_dir}/ui/*.c.obj)
+    set(content "/* Generated by firmware_assets.cmake, do not edit */\n#include \"lvgl.h\"\n")
+    set(asset_dir ${CMAKE_CURRENT_BINARY_DIR}/firmware_assets)
+    file(MAKE_DIRECTORY ${asset_dir})
+
+    # Sources moved since the firmware was built count as well (frames of sprites)
+    file(GLOB_RECURSE sources ${main_dir}/ui/*.c)
+    set(source_names)
+    foreach(source ${sources})
+        get_filename_component(name ${source} NAME_WE)
+        list(APPEND source_names ${name})
+    endforeach()
+
+    foreach(object ${objects})
+        string(REGEX REPLACE "\\.obj$" "" source ${object})
+        get_filename_component(name ${source} NAME_WE)
+        if(name IN_LIST source_names)
+            continue()
+        endif()
+
+        set(header ${asset_dir}/${name}.header)
+        set(map ${asset_dir}/${name}.map)
+        set(extracted FALSE)
+        if(SIM_OBJCOPY)
+            execute_process(COMMAND ${SIM_OBJCOPY} -I elf32-little -O binary --only-section=.rodata.${name}
+                                    ${obj_dir}/${object} ${header}
+                            RESULT_VARIABLE res_header)
+            execute_process(COMMAND ${SIM_OBJCOPY} -I elf32-little -O binary --only-section=.rodata.${name}_map
+                                    ${obj_dir}/${object} ${map}
+                            RESULT_VARIABLE res_map)
+            if(res_header EQUAL 0 AND res_map EQUAL 0 AND EXISTS ${header})
+                file(SIZE ${header} header_size)
+                if(header_size EQUAL 12)
+                    set(extracted TRUE)
+                endif()
+            endif()
+        endif()
+
+        if(NOT extracted)
+            message(WARNING "Image ${name} has no source and can't be extracted from ${object}, it is left empty")
+            string(APPEND content "const lv_img_dsc_t ${name} = {0};\n")
+            continue()
+        endif()
+
+        # lv_img_header_t (cf:5, always_zero:3, reserved:2, w:11, h:11) and data_size, little-endian
+        file(READ ${header} hex HEX)
+        string(SUBSTRING ${hex} 0 8 word0)
+        string(SUBSTRING ${hex} 8 8 word1)
+        foreach(word word0 word1)
+            string(REGEX REPLACE "(..)(..)(..)(..)" "0x\\4\\3\\2\\1" ${word} ${${word}})
+        endforeach()
+        math(EXPR cf "${word0} & 0x1F")
+        math(EXPR w "(${word0} >> 10) & 0x7FF")
+        math(EXPR h "(${word0} >> 21) & 0x7FF")
+        math(EXPR data_size "${word1}")
+
+        message(STATUS "Image ${name} ${w}x${h} extracted from the firmware build")
+        string(APPEND content
+               "__asm__(\".section .rodata\\n.balign 4\\n${name}_map:\\n.incbin \\\"${map}\\\"\\n.previous\\n\");\n"
+               "extern const uint8_t ${name}_map[] __asm__(\"${name}_map\");\n"
+               "const lv_img_dsc_t ${name} = {\n"
+               "    .header.cf = ${cf},\n"
+               "    .header.w = ${w},\n"
+               "    .header.h = ${h},\n"
+               "    .data_size = ${data_size},\n"
+               "    .data = ${name}_map,\n"
+               "};\n")
+    endforeach()
+
+    file(WRITE ${output}.tmp "${content}")
+    configure_file(${output}.tmp ${output} COPYONLY)
+endfunction()
@@ -0,0 +1,239 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sim_display.h"
+#include "sim_png.h"
+
+#define SIM_FNV_OFFSET      (2166136261u)
+#define SIM_FNV_PRIME       (16777619u)
+
+typedef struct {
+    lv_disp_drv_t disp_drv;
+    lv_disp_draw_buf_t draw_buf;
+    lv_color_t *buf1;
+    lv_color_t *buf2;
+    lv_color_t *fb;
+    sim_frame_t *frames;
+    size_t frames_count;
+    size_t frames_size;
+    sim_frame_t frame;      /* Frame being refreshed */
+    bool refreshed;         /* Set by the refresh, cleared by sim_display_handler_done() */
+    FILE *frame_log;
+} sim_display_ctx_t;
+
+static sim_display_ctx_t sim_disp;
+
+static uint64_t sim_display_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void sim_display_flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    const int32_t w = lv_area_get_width(area);
+
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&sim_disp.fb[y * drv->hor_res + area->x1], color_map, w * sizeof(lv_color_t));
+        color_map += w;
+    }
+    sim_disp.frame.bytes += lv_area_get_size(area) * sizeof(lv_color_t);
+
+    lv_disp_flush_ready(drv);
+}
+
+/* Areas are joined, just before rendering */
+static void sim_display_render_start(lv_disp_drv_t *drv)
+{
+    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+
+    for (uint16_t i = 0; i < disp->inv_p; i++) {
+        if (!disp->inv_area_joined[i]) {
+            sim_disp.frame.areas++;
+            sim_disp.frame.inv_px += lv_area_get_size(&disp->inv_areas[i]);
+        }
+    }
+}
+
+static void sim_display_refr_timer(lv_timer_t *timer)
+{
+    memset(&sim_disp.frame, 0, sizeof(sim_frame_t));
+
+    const uint64_t start = sim_display_now_us();
+    _lv_disp_refr_timer(timer);
+
+    if (sim_disp.frame.bytes > 0) {
+        sim_disp.frame.time_ms = lv_tick_get();
+        sim_disp.frame.render_us = sim_display_now_us() - start;
+        sim_disp.refreshed = true;
+    }
+}
+
+lv_disp_t *sim_display_init(uint16_t hor_res, uint16_t ver_res, uint16_t buf_lines)
+{
+    const size_t buf_px = (size_t)hor_res * buf_lines;
+
+    memset(&sim_disp, 0, sizeof(sim_disp));
+    sim_disp.buf1 = malloc(buf_px * sizeof(lv_color_t));
+    sim_disp.buf2 = malloc(buf_px * sizeof(lv_color_t));
+    sim_disp.fb = calloc((size_t)hor_res * ver_res, sizeof(lv_color_t));
+    if (!sim_disp.buf1 || !sim_disp.buf2 || !sim_disp.fb) {
+        sim_display_deinit();
+        return NULL;
+    }
+
+    lv_disp_draw_buf_init(&sim_disp.draw_buf, sim_disp.buf1, sim_disp.buf2, buf_px);
+
+    lv_disp_drv_init(&sim_disp.disp_drv);
+    sim_disp.disp_drv.hor_res = hor_res;
+    sim_disp.disp_drv.ver_res = ver_res;
+    sim_disp.disp_drv.flush_cb = sim_display_flush;
+    sim_disp.disp_drv.render_start_cb = sim_display_render_start;
+    sim_disp.disp_drv.draw_buf = &sim_disp.draw_buf;
+
+    lv_disp_t *disp = lv_disp_drv_register(&sim_disp.disp_drv);
+    if (disp) {
+        lv_timer_set_cb(disp->refr_timer, sim_display_refr_timer);
+    }
+
+    return disp;
+}
+
+void sim_display_deinit(void)
+{
+    free(sim_disp.buf1);
+    free(sim_disp.buf2);
+    free(sim_disp.fb);
+    free(sim_disp.frames);
+    memset(&sim_disp, 0, sizeof(sim_disp));
+}
+
+void sim_display_set_frame_log(FILE *file)
+{
+    sim_disp.frame_log = file;
+    if (file) {
+        fprintf(file, "frame,time_ms,render_us,handler_us,areas,inv_px,bytes\n");
+    }
+}
+
+bool sim_display_handler_done(uint32_t handler_us)
+{
+    if (!sim_disp.refreshed) {
+        return false;
+    }
+    sim_disp.refreshed = false;
+    sim_disp.frame.handler_us = handler_us;
+
+    if (sim_disp.frames_count == sim_disp.frames_size) {
+        const size_t size = sim_disp.frames_size ? sim_disp.frames_size * 2 : 256;
+        sim_frame_t *frames = realloc(sim_disp.frames, size * sizeof(sim_frame_t));
+        if (!frames) {
+            return true;
+        }
+        sim_disp.frames = frames;
+        sim_disp.frames_size = size;
+    }
+    sim_disp.frames[sim_disp.frames_count++] = sim_disp.frame;
+
+    if (sim_disp.frame_log) {
+        const sim_frame_t *f = &sim_disp.frame;
+        fprintf(sim_disp.frame_log, "%zu,%u,%u,%u,%u,%u,%u\n", sim_disp.frames_count - 1,
+                f->time_ms, f->render_us, f->handler_us, f->areas, f->inv_px, f->bytes);
+    }
+
+    return true;
+}
+
+const sim_frame_t *sim_display_frames(size_t *count)
+{
+    *count = sim_disp.frames_count;
+    return sim_disp.frames;
+}
+
+uint32_t sim_display_checksum(void)
+{
+    const uint8_t *data = (const uint8_t *)sim_disp.fb;
+    const size_t size = (size_t)sim_disp.disp_drv.hor_res * sim_disp.disp_drv.ver_res * sizeof(lv_color_t);
+    uint32_t hash = SIM_FNV_OFFSET;
+
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * SIM_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/* Framebuffer as 8-bit RGB, release with free() */
+static uint8_t *sim_display_rgb(void)
+{
+    const int32_t px = (int32_t)sim_disp.disp_drv.hor_res * sim_disp.disp_drv.ver_res;
+    uint8_t *rgb = malloc((size_t)px * 3);
+
+    for (int32_t i = 0; rgb && i < px; i++) {
+        const uint32_t c = lv_color_to32(sim_disp.fb[i]);
+        rgb[i * 3] = (c >> 16) & 0xFF;
+        rgb[i * 3 + 1] = (c >> 8) & 0xFF;
+        rgb[i * 3 + 2] = c & 0xFF;
+    }
+    return rgb;
+}
+
+bool sim_display_screenshot(const char *path)
+{
+    uint8_t *rgb = sim_display_rgb();
+    FILE *f = rgb ? fopen(path, "wb") : NULL;
+    if (!f) {
+        free(rgb);
+        return false;
+    }
+
+    const lv_coord_t w = sim_disp.disp_drv.hor_res;
+    const lv_coord_t h = sim_disp.disp_drv.ver_res;
+    fprintf(f, "P6\n%d %d\n255\n", w, h);
+    fwrite(rgb, 3, (size_t)w * h, f);
+    free(rgb);
+
+    return fclose(f) == 0;
+}
+
+bool sim_display_save_png(const char *path)
+{
+    uint8_t *rgb = sim_display_rgb();
+    const bool ok = rgb && sim_png_write(path, rgb, sim_disp.disp_drv.hor_res, sim_disp.disp_drv.ver_res);
+    free(rgb);
+    return ok;
+}
+
+int32_t sim_display_compare_png(const char *path)
+{
+    uint8_t *ref = NULL;
+    uint32_t w;
+    uint32_t h;
+
+    if (!sim_png_read(path, &ref, &w, &h)) {
+        return -1;
+    }
+    uint8_t *rgb = sim_display_rgb();
+    if (!rgb || w != (uint32_t)sim_disp.disp_drv.hor_res || h != (uint32_t)sim_disp.disp_drv.ver_res) {
+        free(ref);
+        free(rgb);
+        return -1;
+    }
+
+    int32_t diff = 0;
+    for (uint32_t i = 0; i < w * h; i++) {
+        if (memcmp(&rgb[i * 3], &ref[i * 3], 3) != 0) {
+            diff++;
+        }
+    }
+    free(ref);
+    free(rgb);
+    return diff;
+}
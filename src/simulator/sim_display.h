@@ -0,0 +1,105 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/**
+ * @file
+ * @brief Headless framebuffer display of the simulator
+ *
+ * LVGL renders into draw buffers of the same size as on the target, flushed areas are copied
+ * into a framebuffer in the panel's pixel format. Every refresh is measured and recorded.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief One refreshed frame
+ */
+typedef struct {
+    uint32_t time_ms;       /*!< Virtual time of the refresh */
+    uint32_t render_us;     /*!< Wall time of the refresh (rendering and flushing) */
+    uint32_t areas;         /*!< Refreshed areas after joining */
+    uint32_t inv_px;        /*!< Invalidated pixels of the refreshed areas */
+    uint32_t bytes;         /*!< Flushed bytes */
+    uint32_t handler_us;    /*!< Wall time of the whole lv_timer_handler() call */
+} sim_frame_t;
+
+/**
+ * @brief Create the display and register it in LVGL
+ *
+ * @param hor_res   Horizontal resolution
+ * @param ver_res   Vertical resolution
+ * @param buf_lines Lines of each of the two draw buffers
+ * @return LVGL display, NULL on allocation failure
+ */
+lv_disp_t *sim_display_init(uint16_t hor_res, uint16_t ver_res, uint16_t buf_lines);
+
+/**
+ * @brief Release the framebuffer and draw buffers
+ */
+void sim_display_deinit(void);
+
+/**
+ * @brief Write every refreshed frame as a CSV line (NULL to stop)
+ */
+void sim_display_set_frame_log(FILE *file);
+
+/**
+ * @brief Set, how long the last lv_timer_handler() call took
+ *
+ * Accounted into the frame, if the call refreshed the display.
+ *
+ * @param handler_us    Wall time of lv_timer_handler()
+ * @return true if the call refreshed the display
+ */
+bool sim_display_handler_done(uint32_t handler_us);
+
+/**
+ * @brief All frames refreshed since init
+ *
+ * @param count Output number of frames
+ * @return Frames, oldest first
+ */
+const sim_frame_t *sim_display_frames(size_t *count);
+
+/**
+ * @brief FNV-1a checksum of the framebuffer, as sent to the panel
+ */
+uint32_t sim_display_checksum(void);
+
+/**
+ * @brief Save the framebuffer as a binary PPM image
+ *
+ * @return true on success
+ */
+bool sim_display_screenshot(const char *path);
+
+/**
+ * @brief Save the framebuffer as a PNG image
+ *
+ * @return true on success
+ */
+bool sim_display_save_png(const char *path);
+
+/**
+ * @brief Compare the framebuffer with a PNG image
+ *
+ * @param path  Reference image
+ * @return Number of different pixels, -1 if the image can't be read or has another size
+ */
+int32_t sim_display_compare_png(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
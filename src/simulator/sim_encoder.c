@@ -0,0 +1,106 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <string.h>
+#include "sim_encoder.h"
+
+#define SIM_ENCODER_QUEUE_LEN   (64)
+
+typedef struct {
+    int8_t diff;            /* Knob step, 0 for a press */
+    uint32_t hold_ms;       /* Press time */
+} sim_encoder_step_t;
+
+typedef struct {
+    lv_indev_drv_t indev_drv;
+    sim_encoder_step_t queue[SIM_ENCODER_QUEUE_LEN];
+    uint32_t head;
+    uint32_t count;
+    bool pressed;           /* Button held by the head of the queue */
+    uint32_t press_start;
+} sim_encoder_ctx_t;
+
+static sim_encoder_ctx_t sim_enc;
+
+static bool sim_encoder_push(int8_t diff, uint32_t hold_ms)
+{
+    if (sim_enc.count == SIM_ENCODER_QUEUE_LEN) {
+        return false;
+    }
+    sim_encoder_step_t *step = &sim_enc.queue[(sim_enc.head + sim_enc.count) % SIM_ENCODER_QUEUE_LEN];
+    step->diff = diff;
+    step->hold_ms = hold_ms;
+    sim_enc.count++;
+    return true;
+}
+
+static void sim_encoder_pop(void)
+{
+    sim_enc.head = (sim_enc.head + 1) % SIM_ENCODER_QUEUE_LEN;
+    sim_enc.count--;
+}
+
+static void sim_encoder_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data)
+{
+    data->enc_diff = 0;
+    data->state = LV_INDEV_STATE_RELEASED;
+
+    if (sim_enc.count == 0) {
+        return;
+    }
+
+    const sim_encoder_step_t *step = &sim_enc.queue[sim_enc.head];
+    if (step->diff != 0) {
+        data->enc_diff = step->diff;
+        sim_encoder_pop();
+        return;
+    }
+
+    /* Press is held over the following reads and released by the first read after hold_ms */
+    if (!sim_enc.pressed) {
+        sim_enc.pressed = true;
+        sim_enc.press_start = lv_tick_get();
+    }
+    if (lv_tick_elaps(sim_enc.press_start) < step->hold_ms) {
+        data->state = LV_INDEV_STATE_PRESSED;
+        return;
+    }
+    sim_enc.pressed = false;
+    sim_encoder_pop();
+}
+
+lv_indev_t *sim_encoder_init(void)
+{
+    memset(&sim_enc, 0, sizeof(sim_enc));
+
+    lv_indev_drv_init(&sim_enc.indev_drv);
+    sim_enc.indev_drv.type = LV_INDEV_TYPE_ENCODER;
+    sim_enc.indev_drv.read_cb = sim_encoder_read;
+
+    return lv_indev_drv_register(&sim_enc.indev_drv);
+}
+
+bool sim_encoder_rotate(int32_t steps)
+{
+    const int8_t diff = (steps > 0) ? 1 : -1;
+
+    for (int32_t i = 0; i < steps * diff; i++) {
+        if (!sim_encoder_push(diff, 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sim_encoder_press(uint32_t hold_ms)
+{
+    return sim_encoder_push(0, hold_ms);
+}
+
+bool sim_encoder_idle(void)
+{
+    return (sim_enc.count == 0);
+}
@@ -0,0 +1,57 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/**
+ * @file
+ * @brief Scripted encoder input device of the simulator
+ *
+ * Knob steps and button presses are queued and handed to LVGL one per read of the input device,
+ * like the knob of the panel sends them.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Create the encoder and register it in LVGL
+ *
+ * Must be the first input device, the UI attaches its group to it.
+ *
+ * @return LVGL input device, NULL on failure
+ */
+lv_indev_t *sim_encoder_init(void);
+
+/**
+ * @brief Queue knob steps
+ *
+ * @param steps Positive to the right, negative to the left
+ * @return false if the queue is full
+ */
+bool sim_encoder_rotate(int32_t steps);
+
+/**
+ * @brief Queue a press of the button
+ *
+ * @param hold_ms   Time the button is held, before it is released
+ * @return false if the queue is full
+ */
+bool sim_encoder_press(uint32_t hold_ms);
+
+/**
+ * @brief All queued input was read by LVGL
+ */
+bool sim_encoder_idle(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,278 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Headless simulator of the knob panel UI
+ *
+ *   knob_panel_sim [options] <script>
+ *
+ * Runs the script (see sim_script.h) and reports the refreshed frames, the LVGL memory
+ * high-water mark and the final framebuffer checksum. Exits with 1 when a check failed.
+ * With --ref-dir, the steps of the script are regression tests against reference images and
+ * performance baselines, see tests/.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl.h"
+#include "lvgl_port_stats.h"
+#include "lvgl_port_img.h"
+#include "lvgl_port_font.h"
+#include "lvgl_port_ttf.h"
+#include "sim_display.h"
+#include "sim_encoder.h"
+#include "sim_script.h"
+#include "sim_stubs.h"
+
+#define SIM_HOR_RES         (240)
+#define SIM_VER_RES         (240)
+/* Lines of the two draw buffers, the largest strips of the target (BSP_LCD_DRAW_BUF_MAX_LINES) */
+#define SIM_BUF_LINES       (40)
+/* Render time depends on the host and its load, invalidated pixels only on the UI */
+#define SIM_RENDER_TOLERANCE    (100)
+#define SIM_PX_TOLERANCE        (5)
+/* Decoded rows of compressed images, the default of the BSP (BSP_LVGL_RLE_CACHE_SIZE) */
+#define SIM_RLE_CACHE_SIZE      (8192)
+/* Prepared images, the default of the BSP (BSP_LVGL_IMG_CACHE_SIZE) */
+#define SIM_IMG_CACHE_SIZE      (65536)
+/* Decoded glyphs of compressed fonts, the default of the BSP (BSP_LVGL_FONT_CACHE_SIZE) */
+#define SIM_FONT_CACHE_SIZE     (8192)
+/* Glyph masks, the default of the BSP (BSP_LVGL_GLYPH_CACHE_SIZE) */
+#define SIM_GLYPH_CACHE_SIZE    (12288)
+/* Rasterized glyphs of scalable fonts, the default of the BSP (BSP_LVGL_TTF_CACHE_SIZE) */
+#define SIM_TTF_CACHE_SIZE      (16384)
+
+static void sim_usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [options] <script>\n"
+            "  --frames <file.csv>  write every refreshed frame\n"
+            "  --buf-lines <n>      lines of the draw buffers (default %d)\n"
+            "  --rle-cache <bytes>  cache of decoded image rows (default %d)\n"
+            "  --img-cache <bytes>  cache of prepared images (default %d, 0 for none)\n"
+            "  --font-cache <bytes> cache of decoded glyphs (default %d, 0 for none)\n"
+            "  --glyph-cache <bytes> cache of glyph masks (default %d, 0 for none)\n"
+            "  --ttf-cache <bytes>  cache of rasterized glyphs of scalable fonts (default %d, 0 for none)\n"
+#ifdef SIM_ASSETS_BIN
+            "  --assets <file>      asset table of the images (default " SIM_ASSETS_BIN ")\n"
+#endif
+            "  --log <level>        ESP-IDF log level 0-5 (default 2, warnings)\n"
+            "  --ref-dir <dir>      compare the steps with the references in <dir>\n"
+            "  --update             write the references of the steps instead\n"
+            "  --render-tolerance <pct>  allowed render time increase of a step (default %d)\n"
+            "  --px-tolerance <pct>      allowed invalidated pixels increase of a step (default %d)\n",
+            name, SIM_BUF_LINES, SIM_RLE_CACHE_SIZE, SIM_IMG_CACHE_SIZE, SIM_FONT_CACHE_SIZE, SIM_GLYPH_CACHE_SIZE,
+            SIM_TTF_CACHE_SIZE, SIM_RENDER_TOLERANCE, SIM_PX_TOLERANCE);
+}
+
+/* The asset partition of the firmware, the whole table is in memory */
+static void *sim_assets_load(const char *path, size_t *size)
+{
+    FILE *f = fopen(path, "rb");
+    void *data = NULL;
+    long len;
+
+    if (!f) {
+        return NULL;
+    }
+    if (fseek(f, 0, SEEK_END) == 0 && (len = ftell(f)) > 0 && fseek(f, 0, SEEK_SET) == 0) {
+        data = malloc(len);
+        if (data && fread(data, 1, len, f) != (size_t)len) {
+            free(data);
+            data = NULL;
+        }
+        *size = len;
+    }
+    fclose(f);
+    return data;
+}
+
+static void sim_report_metric(const char *name, const sim_frame_t *frames, size_t count, size_t offset, const char *unit)
+{
+    uint32_t *values = malloc((count ? count : 1) * sizeof(uint32_t));
+    lvgl_port_stats_pct_t pct;
+    uint64_t sum = 0;
+
+    if (!values) {
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        values[i] = *(const uint32_t *)((const uint8_t *)&frames[i] + offset);
+        sum += values[i];
+    }
+    lvgl_port_stats_percentiles(values, count, &pct);
+    printf("%-10s p50 %7u  p95 %7u  p99 %7u  max %7u  total %10llu %s\n",
+           name, pct.p50, pct.p95, pct.p99, pct.max, (unsigned long long)sum, unit);
+    free(values);
+}
+
+static void sim_report(const char *script, const sim_script_result_t *result)
+{
+    size_t count;
+    const sim_frame_t *frames = sim_display_frames(&count);
+    const sim_board_t *board = sim_board();
+    lv_mem_monitor_t mon;
+
+    lv_mem_monitor(&mon);
+
+    printf("session    %s, %u ms virtual time%s\n", script, (unsigned)lv_tick_get(),
+           result->restarted ? ", ended by esp_restart()" : "");
+    printf("frames     %zu\n", count);
+    sim_report_metric("render", frames, count, offsetof(sim_frame_t, render_us), "us");
+    sim_report_metric("handler", frames, count, offsetof(sim_frame_t, handler_us), "us");
+    sim_report_metric("areas", frames, count, offsetof(sim_frame_t, areas), "");
+    sim_report_metric("inv_px", frames, count, offsetof(sim_frame_t, inv_px), "px");
+    sim_report_metric("flushed", frames, count, offsetof(sim_frame_t, bytes), "B");
+    printf("memory     LVGL max used %u B of %u B (%u %%), used at end %u B, frag %u %%\n",
+           (unsigned)result->mem_max_used, (unsigned)mon.total_size, (unsigned)((uint64_t)result->mem_max_used * 100 / mon.total_size),
+           (unsigned)(mon.total_size - mon.free_size), mon.frag_pct);
+    lvgl_port_img_rle_stats_t rle;
+    lvgl_port_img_rle_get_stats(&rle);
+    printf("rle        %u opened, %u lines, %llu px decoded, cache %u hits %u misses of %u B\n",
+           rle.opened, rle.lines, (unsigned long long)rle.px_decoded, rle.cache_hits, rle.cache_misses, rle.cache_size);
+    const char *layer;
+    lvgl_port_cache_layer_t img;
+    for (uint8_t i = 0; lvgl_port_img_cache_get_stats(i, &layer, &img); i++) {
+        const uint32_t draws = img.hits + img.misses;
+        if (draws || img.entries) {
+            printf("img cache  %-18s %6u hits %6u misses (%3u %%), %u evicted, %u images of %u B\n", layer ? layer : "default",
+                   img.hits, img.misses, draws ? (unsigned)((uint64_t)img.hits * 100 / draws) : 0, img.evictions, img.entries, img.bytes);
+        }
+    }
+    lvgl_port_cache_layer_t font;
+    lvgl_port_font_cache_get_stats(&font);
+    if (font.hits + font.misses) {
+        printf("font cache %6u hits %6u misses (%3u %%), %u evicted, %u glyphs of %u B\n", font.hits, font.misses,
+               (unsigned)((uint64_t)font.hits * 100 / (font.hits + font.misses)), font.evictions, font.entries, font.bytes);
+    }
+    lvgl_port_cache_layer_t glyph;
+    lvgl_port_font_glyph_get_stats(&glyph);
+    if (glyph.hits + glyph.misses) {
+        printf("glyph cache %5u hits %6u misses (%3u %%), %u evicted, %u masks of %u B\n", glyph.hits, glyph.misses,
+               (unsigned)((uint64_t)glyph.hits * 100 / (glyph.hits + glyph.misses)), glyph.evictions, glyph.entries, glyph.bytes);
+    }
+    lvgl_port_cache_layer_t ttf;
+    lvgl_port_ttf_get_stats(&ttf);
+    if (ttf.hits + ttf.misses) {
+        printf("ttf cache  %6u hits %6u misses (%3u %%), %u evicted, %u glyphs of %u B\n", ttf.hits, ttf.misses,
+               (unsigned)((uint64_t)ttf.hits * 100 / (ttf.hits + ttf.misses)), ttf.evictions, ttf.entries, ttf.bytes);
+    }
+    printf("board      led %u %u %u (%u sets), last sound %d (%u played), %u tasks\n",
+           board->led[0], board->led[1], board->led[2], board->led_sets,
+           (int)board->last_sound, board->sounds, board->tasks);
+    printf("checks     %u, failed %u\n", result->checks, result->failed);
+    printf("checksum   0x%08x\n", sim_display_checksum());
+}
+
+int main(int argc, char **argv)
+{
+    const char *script = NULL;
+    const char *frames_path = NULL;
+    uint32_t buf_lines = SIM_BUF_LINES;
+    uint32_t rle_cache = SIM_RLE_CACHE_SIZE;
+    uint32_t img_cache = SIM_IMG_CACHE_SIZE;
+    uint32_t font_cache = SIM_FONT_CACHE_SIZE;
+    uint32_t glyph_cache = SIM_GLYPH_CACHE_SIZE;
+    uint32_t ttf_cache = SIM_TTF_CACHE_SIZE;
+#ifdef SIM_ASSETS_BIN
+    const char *assets_path = SIM_ASSETS_BIN;
+#else
+    const char *assets_path = NULL;
+#endif
+    void *assets = NULL;
+    size_t assets_size = 0;
+    FILE *frames_file = NULL;
+    sim_script_config_t config = {
+        .render_tolerance = SIM_RENDER_TOLERANCE,
+        .px_tolerance = SIM_PX_TOLERANCE,
+    };
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--frames") && i + 1 < argc) {
+            frames_path = argv[++i];
+        } else if (!strcmp(argv[i], "--buf-lines") && i + 1 < argc) {
+            buf_lines = strtoul(argv[++i], NULL, 10);
+        } else if (!strcmp(argv[i], "--rle-cache") && i + 1 < argc) {
+            rle_cache = strtoul(argv[++i], NULL, 10);
+        } else if (!strcmp(argv[i], "--img-cache") && i + 1 < argc) {
+            img_cache = strtoul(argv[++i], NULL, 10);
+        } else if (!strcmp(argv[i], "--font-cache") && i + 1 < argc) {
+            font_cache = strtoul(argv[++i], NULL, 10);
+        } else if (!strcmp(argv[i], "--glyph-cache") && i + 1 < argc) {
+            glyph_cache = strtoul(argv[++i], NULL, 10);
+        } else if (!strcmp(argv[i], "--ttf-cache") && i + 1 < argc) {
+            ttf_cache = strtoul(argv[++i], NULL, 10);
+        } else if (!strcmp(argv[i], "--assets") && i + 1 < argc && assets_path) {
+            assets_path = argv[++i];
+        } else if (!strcmp(argv[i], "--log") && i + 1 < argc) {
+            sim_log_level(strtoul(argv[++i], NULL, 10));
+        } else if (!strcmp(argv[i], "--ref-dir") && i + 1 < argc) {
+            config.ref_dir = argv[++i];
+        } else if (!strcmp(argv[i], "--update")) {
+            config.update = true;
+        } else if (!strcmp(argv[i], "--render-tolerance") && i + 1 < argc) {
+            config.render_tolerance = strtoul(argv[++i], NULL, 10);
+        } else if (!strcmp(argv[i], "--px-tolerance") && i + 1 < argc) {
+            config.px_tolerance = strtoul(argv[++i], NULL, 10);
+        } else if (argv[i][0] != '-' && !script) {
+            script = argv[i];
+        } else {
+            sim_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (!script || buf_lines == 0 || buf_lines > SIM_VER_RES || (config.update && !config.ref_dir)) {
+        sim_usage(argv[0]);
+        return 2;
+    }
+
+    lv_init();
+    lv_disp_t *disp = sim_display_init(SIM_HOR_RES, SIM_VER_RES, buf_lines);
+    if (!disp || !sim_encoder_init() || !lvgl_port_img_rle_init(rle_cache) || (img_cache && !lvgl_port_img_cache_init(disp, img_cache)) || (font_cache && !lvgl_port_font_cache_init(font_cache)) ||
+            (glyph_cache && !lvgl_port_font_glyph_init(disp, glyph_cache)) || (ttf_cache && !lvgl_port_ttf_init(ttf_cache))) {
+        fprintf(stderr, "simulator init failed\n");
+        return 2;
+    }
+    if (assets_path) {
+        assets = sim_assets_load(assets_path, &assets_size);
+        if (!assets || !lvgl_port_img_assets_init(assets, assets_size)) {
+            fprintf(stderr, "%s: no valid asset table\n", assets_path);
+            return 2;
+        }
+    }
+    if (frames_path) {
+        frames_file = fopen(frames_path, "w");
+        if (!frames_file) {
+            fprintf(stderr, "%s: can't open\n", frames_path);
+            return 2;
+        }
+        sim_display_set_frame_log(frames_file);
+    }
+
+    sim_script_result_t result;
+    const bool ok = sim_script_run(script, &config, &result);
+    sim_report(script, &result);
+
+    if (frames_file) {
+        sim_display_set_frame_log(NULL);
+        fclose(frames_file);
+    }
+    lvgl_port_ttf_deinit();
+    lvgl_port_img_assets_deinit();
+    free(assets);
+    lvgl_port_img_cache_deinit();
+    lvgl_port_font_cache_deinit();
+    lvgl_port_font_glyph_deinit();
+    lvgl_port_img_rle_deinit();
+    sim_display_deinit();
+
+    if (!ok) {
+        return 2;
+    }
+    return result.failed ? 1 : 0;
+}
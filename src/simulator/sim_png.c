@@ -0,0 +1,83 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "sim_png.h"
+
+/* lodepng of LVGL, with the C heap instead of the LVGL pool and stdio instead of lv_fs */
+#define LV_USE_PNG 1
+#define LODEPNG_NO_COMPILE_ALLOCATORS
+#define LODEPNG_NO_COMPILE_DISK
+#include "extra/libs/png/lodepng.c"
+
+void *lodepng_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+void *lodepng_realloc(void *ptr, size_t new_size)
+{
+    return realloc(ptr, new_size);
+}
+
+void lodepng_free(void *ptr)
+{
+    free(ptr);
+}
+
+bool sim_png_write(const char *path, const uint8_t *rgb, uint32_t w, uint32_t h)
+{
+    unsigned char *png = NULL;
+    size_t size = 0;
+
+    if (lodepng_encode24(&png, &size, rgb, w, h) != 0) {
+        free(png);
+        return false;
+    }
+
+    FILE *f = fopen(path, "wb");
+    bool ok = (f != NULL) && (fwrite(png, 1, size, f) == size);
+    if (f && fclose(f) != 0) {
+        ok = false;
+    }
+    free(png);
+    return ok;
+}
+
+bool sim_png_read(const char *path, uint8_t **rgb, uint32_t *w, uint32_t *h)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return false;
+    }
+
+    unsigned char *png = NULL;
+    long size = -1;
+    if (fseek(f, 0, SEEK_END) == 0) {
+        size = ftell(f);
+    }
+    if (size > 0 && fseek(f, 0, SEEK_SET) == 0) {
+        png = malloc(size);
+    }
+    const bool read = png && (fread(png, 1, size, f) == (size_t)size);
+    fclose(f);
+
+    unsigned width = 0;
+    unsigned height = 0;
+    *rgb = NULL;
+    if (!read || lodepng_decode24(rgb, &width, &height, png, size) != 0) {
+        free(png);
+        free(*rgb);
+        *rgb = NULL;
+        return false;
+    }
+    free(png);
+
+    *w = width;
+    *h = height;
+    return true;
+}
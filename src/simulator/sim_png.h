@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/**
+ * @file
+ * @brief PNG files of the simulator (reference images of the regression tests)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Write an 8-bit RGB image
+ *
+ * @param path  PNG file
+ * @param rgb   Pixels, 3 bytes each, row by row
+ * @param w     Width
+ * @param h     Height
+ * @return true on success
+ */
+bool sim_png_write(const char *path, const uint8_t *rgb, uint32_t w, uint32_t h);
+
+/**
+ * @brief Read an image as 8-bit RGB
+ *
+ * @param path  PNG file
+ * @param rgb   Output pixels, release with free()
+ * @param w     Output width
+ * @param h     Output height
+ * @return true on success
+ */
+bool sim_png_read(const char *path, uint8_t **rgb, uint32_t *w, uint32_t *h);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,471 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lvgl.h"
+#include "settings.h"
+#include "lv_example_pub.h"
+#include "sim_display.h"
+#include "sim_encoder.h"
+#include "sim_stubs.h"
+#include "sim_script.h"
+
+#define SIM_SCRIPT_MAX_LINE     (256)
+#define SIM_SCRIPT_MAX_ARGS     (5)
+#define SIM_PRESS_MS            (100)
+/* LVGL runs this long on the target before app_main() creates the UI (display and panel init) */
+#define SIM_BOOT_MS             (100)
+/* Input not read by LVGL within this time is an error of the script */
+#define SIM_INPUT_TIMEOUT_MS    (10000)
+#define SIM_PATH_MAX            (512)
+#define SIM_STEPS_MAX           (64)
+#define SIM_STEP_NAME_MAX       (32)
+/* Render time a step may grow in any case, short steps are dominated by host jitter */
+#define SIM_RENDER_SLACK_US     (2000)
+
+typedef struct {
+    char name[SIM_STEP_NAME_MAX];
+    uint32_t frames;        /* Frames rendered since the previous step */
+    uint64_t inv_px;        /* Invalidated pixels of these frames */
+    uint64_t render_us;     /* Render time of these frames */
+} sim_step_perf_t;
+
+typedef struct {
+    const char *path;
+    uint32_t line;
+    bool booted;
+    const sim_script_config_t *config;
+    sim_script_result_t *result;
+    char name[SIM_STEP_NAME_MAX];                   /* Script file name without extension */
+    size_t frames_done;                             /* Frames accounted by the previous step */
+    sim_step_perf_t baseline[SIM_STEPS_MAX];
+    uint32_t baseline_count;
+    sim_step_perf_t steps[SIM_STEPS_MAX];
+    uint32_t steps_count;
+} sim_script_ctx_t;
+
+/* lv_mem_monitor_t::max_used of LVGL 8 misses reallocations and block overhead, the pool usage is sampled after every step */
+static uint32_t sim_mem_max_used;
+
+static uint64_t sim_script_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void sim_script_step(void)
+{
+    lv_tick_inc(SIM_TICK_MS);
+
+    const uint64_t start = sim_script_now_us();
+    lv_timer_handler();
+    sim_display_handler_done(sim_script_now_us() - start);
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    if (mon.total_size - mon.free_size > sim_mem_max_used) {
+        sim_mem_max_used = mon.total_size - mon.free_size;
+    }
+}
+
+void sim_script_advance(uint32_t ms)
+{
+    for (uint32_t t = 0; t < ms && !sim_board()->restart; t += SIM_TICK_MS) {
+        sim_script_step();
+    }
+}
+
+static bool sim_script_error(const sim_script_ctx_t *ctx, const char *msg, const char *arg)
+{
+    fprintf(stderr, "%s:%u: %s%s%s\n", ctx->path, ctx->line, msg, arg ? ": " : "", arg ? arg : "");
+    return false;
+}
+
+static bool sim_script_check(sim_script_ctx_t *ctx, bool ok, const char *what)
+{
+    ctx->result->checks++;
+    if (!ok) {
+        ctx->result->failed++;
+        printf("FAIL %s:%u: %s\n", ctx->path, ctx->line, what);
+    }
+    return true;
+}
+
+static bool sim_script_parse_u32(const char *arg, uint32_t *value, int base)
+{
+    char *end;
+    if (!arg) {
+        return false;
+    }
+    const unsigned long v = strtoul(arg, &end, base);
+    if (*end != '\0' || v > UINT32_MAX) {
+        return false;
+    }
+    *value = v;
+    return true;
+}
+
+static bool sim_script_input_wait(sim_script_ctx_t *ctx)
+{
+    uint32_t waited = 0;
+    while (!sim_encoder_idle() && !sim_board()->restart) {
+        if (waited >= SIM_INPUT_TIMEOUT_MS) {
+            return sim_script_error(ctx, "input not read by LVGL", NULL);
+        }
+        sim_script_step();
+        waited += SIM_TICK_MS;
+    }
+    return true;
+}
+
+static void sim_script_boot(void)
+{
+    ESP_ERROR_CHECK(settings_read_parameter_from_nvs());
+    sim_script_advance(SIM_BOOT_MS);
+
+    ui_obj_to_encoder_init();
+    lv_create_home(&boot_Layer);
+    lv_create_clock(&clock_screen_layer, TIME_ENTER_CLOCK_2MIN);
+}
+
+static bool sim_script_settings(sim_script_ctx_t *ctx, char **argv, int argc)
+{
+    if (ctx->booted) {
+        return sim_script_error(ctx, "settings must be changed before boot", NULL);
+    }
+    if (argc != 3) {
+        return sim_script_error(ctx, "usage", "settings hint on|off, settings language en|cn");
+    }
+
+    settings_read_parameter_from_nvs();
+    sys_param_t *param = settings_get_parameter();
+    if (!strcmp(argv[1], "hint")) {
+        param->need_hint = !strcmp(argv[2], "on");
+    } else if (!strcmp(argv[1], "language")) {
+        param->language = !strcmp(argv[2], "cn") ? LANGUAGE_CN : LANGUAGE_EN;
+    } else {
+        return sim_script_error(ctx, "unknown setting", argv[1]);
+    }
+    settings_write_parameter_to_nvs();
+    return true;
+}
+
+static bool sim_script_expect(sim_script_ctx_t *ctx, char **argv, int argc)
+{
+    const sim_board_t *board = sim_board();
+    char what[64];
+    uint32_t v[3];
+
+    if (argc == 5 && !strcmp(argv[1], "led") && sim_script_parse_u32(argv[2], &v[0], 0)
+            && sim_script_parse_u32(argv[3], &v[1], 0) && sim_script_parse_u32(argv[4], &v[2], 0)) {
+        snprintf(what, sizeof(what), "led %u %u %u, is %u %u %u", v[0], v[1], v[2], board->led[0], board->led[1], board->led[2]);
+        return sim_script_check(ctx, board->led[0] == v[0] && board->led[1] == v[1] && board->led[2] == v[2], what);
+    }
+    if (argc == 3 && !strcmp(argv[1], "sound") && sim_script_parse_u32(argv[2], &v[0], 0)) {
+        snprintf(what, sizeof(what), "sound %u, is %d", v[0], (int)board->last_sound);
+        return sim_script_check(ctx, board->last_sound == (int32_t)v[0], what);
+    }
+    return sim_script_error(ctx, "usage", "expect led <r> <g> <b>, expect sound <n>");
+}
+
+static void sim_script_perf_path(const sim_script_ctx_t *ctx, char *path, size_t size)
+{
+    snprintf(path, size, "%s/%s.perf", ctx->config->ref_dir, ctx->name);
+}
+
+/* A missing baseline is not an error here, the steps then fail with "no baseline" */
+static void sim_script_perf_load(sim_script_ctx_t *ctx)
+{
+    char path[SIM_PATH_MAX];
+    char line[SIM_SCRIPT_MAX_LINE];
+
+    sim_script_perf_path(ctx, path, sizeof(path));
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        return;
+    }
+    while (ctx->baseline_count < SIM_STEPS_MAX && fgets(line, sizeof(line), f)) {
+        sim_step_perf_t *perf = &ctx->baseline[ctx->baseline_count];
+        unsigned long long inv_px;
+        unsigned long long render_us;
+        if (line[0] != '#' && sscanf(line, "%31s %u %llu %llu", perf->name, &perf->frames, &inv_px, &render_us) == 4) {
+            perf->inv_px = inv_px;
+            perf->render_us = render_us;
+            ctx->baseline_count++;
+        }
+    }
+    fclose(f);
+}
+
+static bool sim_script_perf_save(const sim_script_ctx_t *ctx)
+{
+    char path[SIM_PATH_MAX];
+
+    sim_script_perf_path(ctx, path, sizeof(path));
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "%s: can't write\n", path);
+        return false;
+    }
+    fprintf(f, "# step frames inv_px render_us\n");
+    for (uint32_t i = 0; i < ctx->steps_count; i++) {
+        const sim_step_perf_t *perf = &ctx->steps[i];
+        fprintf(f, "%s %u %llu %llu\n", perf->name, perf->frames,
+                (unsigned long long)perf->inv_px, (unsigned long long)perf->render_us);
+    }
+    return fclose(f) == 0;
+}
+
+static const sim_step_perf_t *sim_script_perf_find(const sim_script_ctx_t *ctx, const char *name)
+{
+    for (uint32_t i = 0; i < ctx->baseline_count; i++) {
+        if (!strcmp(ctx->baseline[i].name, name)) {
+            return &ctx->baseline[i];
+        }
+    }
+    return NULL;
+}
+
+static bool sim_script_step_fail(const sim_script_ctx_t *ctx, const char *what)
+{
+    printf("FAIL %s:%u: %s\n", ctx->path, ctx->line, what);
+    return false;
+}
+
+/* Compares the step with the references, *passed is cleared by every regression */
+static bool sim_script_step_check(sim_script_ctx_t *ctx, const sim_step_perf_t *perf, bool *passed)
+{
+    const sim_script_config_t *config = ctx->config;
+    char img[SIM_PATH_MAX];
+    char what[SIM_PATH_MAX * 2 + 128];
+
+    snprintf(img, sizeof(img), "%s/%s_%s.png", config->ref_dir, ctx->name, perf->name);
+    if (config->update) {
+        if (!sim_display_save_png(img)) {
+            return sim_script_error(ctx, "can't write", img);
+        }
+        return true;
+    }
+
+    const int32_t diff = sim_display_compare_png(img);
+    if (diff != 0) {
+        char err[SIM_PATH_MAX];
+        snprintf(err, sizeof(err), "%s_%s_err.png", ctx->name, perf->name);
+        sim_display_save_png(err);
+        if (diff < 0) {
+            snprintf(what, sizeof(what), "step %s: no reference image %s, saved %s", perf->name, img, err);
+        } else {
+            snprintf(what, sizeof(what), "step %s: %d pixels differ from %s, saved %s", perf->name, (int)diff, img, err);
+        }
+        *passed = sim_script_step_fail(ctx, what);
+    }
+
+    const sim_step_perf_t *base = sim_script_perf_find(ctx, perf->name);
+    if (!base) {
+        snprintf(what, sizeof(what), "step %s: no baseline, run with --update", perf->name);
+        *passed = sim_script_step_fail(ctx, what);
+        return true;
+    }
+    if (perf->inv_px > base->inv_px * (100 + config->px_tolerance) / 100) {
+        snprintf(what, sizeof(what), "step %s: %llu invalidated pixels, baseline %llu", perf->name,
+                 (unsigned long long)perf->inv_px, (unsigned long long)base->inv_px);
+        *passed = sim_script_step_fail(ctx, what);
+    }
+    if (perf->render_us > base->render_us * (100 + config->render_tolerance) / 100 + SIM_RENDER_SLACK_US) {
+        snprintf(what, sizeof(what), "step %s: %llu us render time, baseline %llu us", perf->name,
+                 (unsigned long long)perf->render_us, (unsigned long long)base->render_us);
+        *passed = sim_script_step_fail(ctx, what);
+    }
+    return true;
+}
+
+static bool sim_script_step_command(sim_script_ctx_t *ctx, char **argv, int argc)
+{
+    if (argc != 2 || strlen(argv[1]) >= SIM_STEP_NAME_MAX) {
+        return sim_script_error(ctx, "usage", "step <name>");
+    }
+    if (ctx->steps_count == SIM_STEPS_MAX) {
+        return sim_script_error(ctx, "too many steps", argv[1]);
+    }
+    for (uint32_t i = 0; i < ctx->steps_count; i++) {
+        if (!strcmp(ctx->steps[i].name, argv[1])) {
+            return sim_script_error(ctx, "step name used twice", argv[1]);
+        }
+    }
+
+    size_t count;
+    const sim_frame_t *frames = sim_display_frames(&count);
+    sim_step_perf_t *perf = &ctx->steps[ctx->steps_count++];
+    memset(perf, 0, sizeof(sim_step_perf_t));
+    strcpy(perf->name, argv[1]);
+    for (size_t i = ctx->frames_done; i < count; i++) {
+        perf->frames++;
+        perf->inv_px += frames[i].inv_px;
+        perf->render_us += frames[i].render_us;
+    }
+    ctx->frames_done = count;
+    printf("step %s:%u %-12s frames %4u  inv_px %9llu  render %8llu us\n", ctx->path, ctx->line, perf->name,
+           perf->frames, (unsigned long long)perf->inv_px, (unsigned long long)perf->render_us);
+
+    if (!ctx->config->ref_dir) {
+        return true;
+    }
+    bool passed = true;
+    if (!sim_script_step_check(ctx, perf, &passed)) {
+        return false;
+    }
+    ctx->result->checks++;
+    ctx->result->failed += passed ? 0 : 1;
+    return true;
+}
+
+static bool sim_script_command(sim_script_ctx_t *ctx, char **argv, int argc)
+{
+    const char *cmd = argv[0];
+    uint32_t value = 0;
+
+    if (!strcmp(cmd, "settings")) {
+        return sim_script_settings(ctx, argv, argc);
+    }
+    if (!strcmp(cmd, "nec")) {
+        sim_nec_set_result(argc > 1 && !strcmp(argv[1], "pass"));
+        return true;
+    }
+    if (!strcmp(cmd, "boot")) {
+        if (ctx->booted) {
+            return sim_script_error(ctx, "already booted", NULL);
+        }
+        sim_script_boot();
+        ctx->booted = true;
+        return true;
+    }
+    if (!ctx->booted) {
+        return sim_script_error(ctx, "boot is missing before", cmd);
+    }
+
+    if (!strcmp(cmd, "wait")) {
+        if (argc != 2 || !sim_script_parse_u32(argv[1], &value, 10)) {
+            return sim_script_error(ctx, "usage", "wait <ms>");
+        }
+        sim_script_advance(value);
+        return true;
+    }
+    if (!strcmp(cmd, "right") || !strcmp(cmd, "left")) {
+        if (argc > 2 || (argc == 2 && !sim_script_parse_u32(argv[1], &value, 10))) {
+            return sim_script_error(ctx, "usage", "right|left [<steps>]");
+        }
+        const int32_t steps = (argc == 2) ? (int32_t)value : 1;
+        if (!sim_encoder_rotate(!strcmp(cmd, "right") ? steps : -steps)) {
+            return sim_script_error(ctx, "too many steps", argv[1]);
+        }
+        return sim_script_input_wait(ctx);
+    }
+    if (!strcmp(cmd, "press")) {
+        value = SIM_PRESS_MS;
+        if (argc > 2 || (argc == 2 && !sim_script_parse_u32(argv[1], &value, 10))) {
+            return sim_script_error(ctx, "usage", "press [<ms>]");
+        }
+        sim_encoder_press(value);
+        return sim_script_input_wait(ctx);
+    }
+    if (!strcmp(cmd, "checksum")) {
+        const uint32_t checksum = sim_display_checksum();
+        printf("checksum %s:%u 0x%08x\n", ctx->path, ctx->line, checksum);
+        if (argc == 2) {
+            char what[48];
+            if (!sim_script_parse_u32(argv[1], &value, 16)) {
+                return sim_script_error(ctx, "invalid checksum", argv[1]);
+            }
+            snprintf(what, sizeof(what), "checksum 0x%08x, is 0x%08x", value, checksum);
+            return sim_script_check(ctx, checksum == value, what);
+        }
+        return true;
+    }
+    if (!strcmp(cmd, "expect")) {
+        return sim_script_expect(ctx, argv, argc);
+    }
+    if (!strcmp(cmd, "screenshot")) {
+        if (argc != 2) {
+            return sim_script_error(ctx, "usage", "screenshot <file.ppm>");
+        }
+        if (!sim_display_screenshot(argv[1])) {
+            return sim_script_error(ctx, "can't write", argv[1]);
+        }
+        return true;
+    }
+    if (!strcmp(cmd, "step")) {
+        return sim_script_step_command(ctx, argv, argc);
+    }
+    if (!strcmp(cmd, "mem")) {
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        printf("mem %s:%u used %u B, max used %u B, frag %u %%\n", ctx->path, ctx->line,
+               (unsigned)(mon.total_size - mon.free_size), (unsigned)sim_mem_max_used, mon.frag_pct);
+        return true;
+    }
+
+    return sim_script_error(ctx, "unknown command", cmd);
+}
+
+bool sim_script_run(const char *path, const sim_script_config_t *config, sim_script_result_t *result)
+{
+    char line[SIM_SCRIPT_MAX_LINE];
+    /* Too big for the stack */
+    static sim_script_ctx_t ctx;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.path = path;
+    ctx.config = config;
+    ctx.result = result;
+
+    const char *base = strrchr(path, '/');
+    snprintf(ctx.name, sizeof(ctx.name), "%s", base ? base + 1 : path);
+    char *ext = strrchr(ctx.name, '.');
+    if (ext) {
+        *ext = '\0';
+    }
+
+    memset(result, 0, sizeof(sim_script_result_t));
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "%s: can't open\n", path);
+        return false;
+    }
+    if (config->ref_dir && !config->update) {
+        sim_script_perf_load(&ctx);
+    }
+
+    bool ok = true;
+    while (ok && !sim_board()->restart && fgets(line, sizeof(line), f)) {
+        char *argv[SIM_SCRIPT_MAX_ARGS];
+        int argc = 0;
+
+        ctx.line++;
+        char *comment = strchr(line, '#');
+        if (comment) {
+            *comment = '\0';
+        }
+        for (char *tok = strtok(line, " \t\r\n"); tok && argc < SIM_SCRIPT_MAX_ARGS; tok = strtok(NULL, " \t\r\n")) {
+            argv[argc++] = tok;
+        }
+        if (argc > 0) {
+            ok = sim_script_command(&ctx, argv, argc);
+        }
+    }
+    fclose(f);
+
+    if (ok && config->ref_dir && config->update) {
+        ok = sim_script_perf_save(&ctx);
+    }
+
+    result->restarted = sim_board()->restart;
+    result->mem_max_used = sim_mem_max_used;
+    return ok;
+}
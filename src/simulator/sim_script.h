@@ -0,0 +1,89 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/**
+ * @file
+ * @brief Scripted sessions of the simulator
+ *
+ * A script is a text file with one command per line, '#' starts a comment:
+ *
+ *   settings hint on|off       Parameters in NVS before boot (language hint screen)
+ *   settings language en|cn
+ *   nec pass|fail              Result of the IR test of the factory screen
+ *   boot                       Start the UI like app_main()
+ *   wait <ms>                  Run LVGL for the given virtual time
+ *   right <steps>              Turn the knob, waits until LVGL read all steps
+ *   left <steps>
+ *   press [<ms>]               Press the button (100 ms by default) and release it
+ *   checksum [<hex>]           Print the framebuffer checksum, fail if it differs from <hex>
+ *   expect led <r> <g> <b>     Fail if the LED has another color
+ *   expect sound <n>           Fail if the last played sound differs
+ *   screenshot <file.ppm>      Save the framebuffer
+ *   mem                        Print the LVGL memory usage
+ *   step <name>                Regression check of the screen state, see below
+ *
+ * Time is virtual: LVGL ticks advance by SIM_TICK_MS per step, so a session renders the same
+ * frames on every run and every host.
+ *
+ * With a reference directory, `step` compares the framebuffer with <ref-dir>/<script>_<name>.png
+ * and the frames rendered since the previous step with the baseline in <ref-dir>/<script>.perf.
+ * The step fails if a pixel differs, or if the invalidated pixels or the render time grew past
+ * the tolerance. A differing frame is saved as <script>_<name>_err.png in the working directory.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* LVGL tick period, as in esp_lvgl_port */
+#define SIM_TICK_MS     (5)
+
+/**
+ * @brief Options of the regression checks
+ */
+typedef struct {
+    const char *ref_dir;        /*!< Reference images and baselines, NULL to only print the steps */
+    bool update;                /*!< Write the references and baselines instead of comparing */
+    uint32_t render_tolerance;  /*!< Allowed render time increase of a step, in percent */
+    uint32_t px_tolerance;      /*!< Allowed invalidated pixels increase of a step, in percent */
+} sim_script_config_t;
+
+/**
+ * @brief Result of a script
+ */
+typedef struct {
+    uint32_t checks;        /*!< Executed checksum, expect and step commands */
+    uint32_t failed;        /*!< Failed checks */
+    bool restarted;         /*!< Session ended by esp_restart() */
+    uint32_t mem_max_used;  /*!< High-water mark of the LVGL memory pool */
+} sim_script_result_t;
+
+/**
+ * @brief Run a script
+ *
+ * The display and the encoder must be registered already.
+ *
+ * @param path      Script file
+ * @param config    Regression checks
+ * @param result    Output result
+ * @return false if the script could not be read, has an invalid command or the references
+ *         could not be written
+ */
+bool sim_script_run(const char *path, const sim_script_config_t *config, sim_script_result_t *result);
+
+/**
+ * @brief Run LVGL for the given virtual time
+ */
+void sim_script_advance(uint32_t ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,410 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Host stubs of ESP-IDF, FreeRTOS, the BSP, audio and IR test used by main/ui.
+ * The simulator is single threaded: LVGL is never locked by anyone else and a created task
+ * runs to completion before xTaskCreate() returns.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_system.h"
+#include "nvs_flash.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+#include "bsp/esp-bsp.h"
+#include "app_audio.h"
+#include "ir_nec_test.h"
+#include "lvgl_port_img.h"
+#include "lvgl_port_sprite_obj.h"
+#include "lvgl_port_clip_obj.h"
+#include "lvgl_port_scroll_obj.h"
+#include "lvgl_port_roller_obj.h"
+#include "lvgl_port_ttf.h"
+#include "sim_stubs.h"
+
+#define SIM_NVS_MAX_KEYS        (8)
+#define SIM_NVS_MAX_BLOB        (64)
+#define SIM_NVS_MAX_NAME        (16)
+
+typedef struct {
+    char name_space[SIM_NVS_MAX_NAME];
+    char key[SIM_NVS_MAX_NAME];
+    uint8_t blob[SIM_NVS_MAX_BLOB];
+    size_t len;
+} sim_nvs_entry_t;
+
+static sim_board_t sim_board_state = {
+    .last_sound = -1,
+};
+static esp_log_level_t sim_log_max = ESP_LOG_WARN;
+static bool sim_nec_ok = true;
+
+static sim_nvs_entry_t sim_nvs[SIM_NVS_MAX_KEYS];
+static size_t sim_nvs_count;
+static char sim_nvs_open_ns[SIM_NVS_MAX_NAME];
+
+sim_board_t *sim_board(void)
+{
+    return &sim_board_state;
+}
+
+/*******************************************************************************
+* ESP-IDF
+*******************************************************************************/
+
+void sim_log_level(esp_log_level_t level)
+{
+    sim_log_max = level;
+}
+
+void esp_log_level_set(const char *tag, esp_log_level_t level)
+{
+    sim_log_max = level;
+}
+
+void sim_log_write(esp_log_level_t level, const char *tag, const char *format, ...)
+{
+    static const char letters[] = "NEWIDV";
+    va_list args;
+
+    if (level > sim_log_max) {
+        return;
+    }
+    fprintf(stderr, "%c (%s) ", letters[level], tag);
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    fputc('\n', stderr);
+}
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+    case ESP_OK:
+        return "ESP_OK";
+    case ESP_FAIL:
+        return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:
+        return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:
+        return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE:
+        return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_NOT_FOUND:
+        return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_NVS_NOT_FOUND:
+        return "ESP_ERR_NVS_NOT_FOUND";
+    default:
+        return "UNKNOWN ERROR";
+    }
+}
+
+void sim_esp_error_check_failed(esp_err_t rc, const char *file, int line, const char *function, const char *expression)
+{
+    fprintf(stderr, "ESP_ERROR_CHECK failed: esp_err_t 0x%x (%s) at %s:%d\n%s: %s\n",
+            rc, esp_err_to_name(rc), file, line, function, expression);
+    abort();
+}
+
+void esp_restart(void)
+{
+    ESP_LOGI("sim", "esp_restart()");
+    sim_board_state.restart = true;
+}
+
+/*******************************************************************************
+* NVS, kept in memory for the session
+*******************************************************************************/
+
+void sim_nvs_erase(void)
+{
+    sim_nvs_count = 0;
+}
+
+esp_err_t nvs_flash_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void)
+{
+    sim_nvs_erase();
+    return ESP_OK;
+}
+
+static sim_nvs_entry_t *sim_nvs_find(const char *key)
+{
+    for (size_t i = 0; i < sim_nvs_count; i++) {
+        if (!strcmp(sim_nvs[i].name_space, sim_nvs_open_ns) && !strcmp(sim_nvs[i].key, key)) {
+            return &sim_nvs[i];
+        }
+    }
+    return NULL;
+}
+
+esp_err_t nvs_open(const char *name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle)
+{
+    bool found = false;
+    for (size_t i = 0; i < sim_nvs_count && !found; i++) {
+        found = !strcmp(sim_nvs[i].name_space, name);
+    }
+    if (!found && open_mode == NVS_READONLY) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+
+    snprintf(sim_nvs_open_ns, sizeof(sim_nvs_open_ns), "%s", name);
+    *out_handle = 1;
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length)
+{
+    const sim_nvs_entry_t *entry = sim_nvs_find(key);
+    if (!entry) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    if (out_value) {
+        if (*length < entry->len) {
+            return ESP_ERR_NVS_INVALID_LENGTH;
+        }
+        memcpy(out_value, entry->blob, entry->len);
+    }
+    *length = entry->len;
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length)
+{
+    sim_nvs_entry_t *entry = sim_nvs_find(key);
+    if (length > SIM_NVS_MAX_BLOB) {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+    if (!entry) {
+        if (sim_nvs_count == SIM_NVS_MAX_KEYS) {
+            return ESP_ERR_NVS_NO_FREE_PAGES;
+        }
+        entry = &sim_nvs[sim_nvs_count++];
+        snprintf(entry->name_space, sizeof(entry->name_space), "%s", sim_nvs_open_ns);
+        snprintf(entry->key, sizeof(entry->key), "%s", key);
+    }
+    memcpy(entry->blob, value, length);
+    entry->len = length;
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle)
+{
+    return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle)
+{
+}
+
+/*******************************************************************************
+* FreeRTOS
+*******************************************************************************/
+
+BaseType_t xTaskCreate(TaskFunction_t task, const char *name, uint32_t stack_depth, void *params,
+                       UBaseType_t priority, TaskHandle_t *created_task)
+{
+    sim_board_state.tasks++;
+    if (created_task) {
+        *created_task = NULL;
+    }
+    task(params);
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+}
+
+EventGroupHandle_t xEventGroupCreate(void)
+{
+    return calloc(1, sizeof(EventBits_t));
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, const EventBits_t bits)
+{
+    *(EventBits_t *)group |= bits;
+    return *(EventBits_t *)group;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, const EventBits_t bits)
+{
+    const EventBits_t old = *(EventBits_t *)group;
+    *(EventBits_t *)group &= ~bits;
+    return old;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, const EventBits_t bits, const BaseType_t clear_on_exit,
+                                const BaseType_t wait_for_all, TickType_t ticks_to_wait)
+{
+    /* Nobody else runs, the bits are final */
+    const EventBits_t value = *(EventBits_t *)group;
+    if (clear_on_exit && (wait_for_all ? (value & bits) == bits : (value & bits) != 0)) {
+        *(EventBits_t *)group &= ~bits;
+    }
+    return value;
+}
+
+void vEventGroupDelete(EventGroupHandle_t group)
+{
+    free(group);
+}
+
+/*******************************************************************************
+* Board
+*******************************************************************************/
+
+esp_err_t bsp_led_rgb_set(uint8_t r, uint8_t g, uint8_t b)
+{
+    sim_board_state.led[0] = r;
+    sim_board_state.led[1] = g;
+    sim_board_state.led[2] = b;
+    sim_board_state.led_sets++;
+    return ESP_OK;
+}
+
+bool bsp_display_lock(uint32_t timeout_ms)
+{
+    return true;
+}
+
+void bsp_display_unlock(void)
+{
+}
+
+esp_err_t bsp_display_backlight_on(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t bsp_display_backlight_off(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_set_img_cache_layer(const char *layer)
+{
+    lvgl_port_img_cache_set_layer(layer);
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_pin_img(const void *src, bool pin)
+{
+    return lvgl_port_img_cache_pin(src, pin) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+esp_err_t lvgl_port_create_img_steps(const void *src, uint16_t zoom_min, uint16_t zoom_max, bool mask, lv_img_dsc_t *steps, uint8_t count)
+{
+    return lvgl_port_img_steps_create(src, zoom_min, zoom_max, mask, steps, count) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+void lvgl_port_delete_img_steps(lv_img_dsc_t *steps, uint8_t count)
+{
+    lvgl_port_img_steps_delete(steps, count);
+}
+
+const lv_font_t *lvgl_port_get_ttf_font(const char *family, uint16_t px)
+{
+    return lvgl_port_ttf_get(family, px);
+}
+
+esp_err_t lvgl_port_prewarm_ttf_font(const lv_font_t *font, const char *text)
+{
+    return lvgl_port_ttf_prewarm(font, text) < 0 ? ESP_ERR_INVALID_ARG : ESP_OK;
+}
+
+lv_obj_t *lvgl_port_create_sprite(lv_obj_t *parent, const lvgl_port_sprite_t *sprite)
+{
+    return lvgl_port_sprite_obj_create(parent, sprite);
+}
+
+esp_err_t lvgl_port_play_sprite(lv_obj_t *sprite, const char *anim)
+{
+    return lvgl_port_sprite_obj_play(sprite, anim) ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t lvgl_port_set_sprite_frame(lv_obj_t *sprite, const char *frame)
+{
+    return lvgl_port_sprite_obj_set_frame(sprite, frame) ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+const char *lvgl_port_get_sprite_frame(lv_obj_t *sprite)
+{
+    return lvgl_port_sprite_obj_get_frame(sprite);
+}
+
+lv_obj_t *lvgl_port_create_scroll(lv_obj_t *parent, const void *src)
+{
+    return lvgl_port_scroll_obj_create(parent, src);
+}
+
+esp_err_t lvgl_port_set_scroll_offset(lv_obj_t *scroll, lv_coord_t x)
+{
+    return lvgl_port_scroll_obj_set_offset(scroll, x) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t lvgl_port_add_clip_radius(lv_obj_t *obj, const lv_obj_t *box, lv_coord_t radius)
+{
+    return lvgl_port_clip_obj_add_radius(obj, box, radius) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+esp_err_t lvgl_port_add_clip_fade(lv_obj_t *obj, lv_coord_t top, lv_coord_t bottom)
+{
+    return lvgl_port_clip_obj_add_fade(obj, top, bottom) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+esp_err_t lvgl_port_add_roller_band(lv_obj_t *roller)
+{
+    return lvgl_port_roller_obj_add_band(roller) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t audio_force_quite(bool ret)
+{
+    return ESP_OK;
+}
+
+esp_err_t audio_handle_info(PDM_SOUND_TYPE voice)
+{
+    sim_board_state.last_sound = voice;
+    sim_board_state.sounds++;
+    return ESP_OK;
+}
+
+esp_err_t audio_play_start()
+{
+    return ESP_OK;
+}
+
+void sim_nec_set_result(bool ok)
+{
+    sim_nec_ok = ok;
+}
+
+esp_err_t nec_test_start()
+{
+    return ESP_OK;
+}
+
+bool nec_test_result()
+{
+    return sim_nec_ok;
+}
@@ -0,0 +1,56 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/**
+ * @file
+ * @brief State of the host stubs of the board, audio, NVS and ESP-IDF
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_log.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Board state seen through the stubs
+ */
+typedef struct {
+    uint8_t led[3];         /*!< Last RGB color of the LED */
+    uint32_t led_sets;      /*!< Calls of bsp_led_rgb_set() */
+    int32_t last_sound;     /*!< Last sound passed to audio_handle_info(), -1 if none */
+    uint32_t sounds;        /*!< Calls of audio_handle_info() */
+    uint32_t tasks;         /*!< Tasks created (run to completion right away) */
+    bool restart;           /*!< esp_restart() was called */
+} sim_board_t;
+
+/**
+ * @brief Board state
+ */
+sim_board_t *sim_board(void);
+
+/**
+ * @brief Maximum level of the printed ESP-IDF logs
+ */
+void sim_log_level(esp_log_level_t level);
+
+/**
+ * @brief Result of the IR test of the factory screen
+ */
+void sim_nec_set_result(bool ok);
+
+/**
+ * @brief Erase all NVS keys
+ */
+void sim_nvs_erase(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/* Host stub of the board support package used by the UI */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "lvgl.h"
+#include "lvgl_port_sprite.h"
+/* Pulled in by the BSP headers (esp_lvgl_port.h, drivers) on the target */
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+
+#define BSP_LCD_H_RES              (240)
+#define BSP_LCD_V_RES              (240)
+
+esp_err_t bsp_led_rgb_set(uint8_t r, uint8_t g, uint8_t b);
+bool bsp_display_lock(uint32_t timeout_ms);
+void bsp_display_unlock(void);
+esp_err_t bsp_display_backlight_on(void);
+esp_err_t bsp_display_backlight_off(void);
+
+/* esp_lvgl_port.h, backed by the image cache, the scalable fonts, the sprite and scroll objects, the clip shapes and the roller bands of the port */
+esp_err_t lvgl_port_set_img_cache_layer(const char *layer);
+esp_err_t lvgl_port_pin_img(const void *src, bool pin);
+esp_err_t lvgl_port_create_img_steps(const void *src, uint16_t zoom_min, uint16_t zoom_max, bool mask, lv_img_dsc_t *steps, uint8_t count);
+void lvgl_port_delete_img_steps(lv_img_dsc_t *steps, uint8_t count);
+const lv_font_t *lvgl_port_get_ttf_font(const char *family, uint16_t px);
+esp_err_t lvgl_port_prewarm_ttf_font(const lv_font_t *font, const char *text);
+lv_obj_t *lvgl_port_create_sprite(lv_obj_t *parent, const lvgl_port_sprite_t *sprite);
+esp_err_t lvgl_port_play_sprite(lv_obj_t *sprite, const char *anim);
+esp_err_t lvgl_port_set_sprite_frame(lv_obj_t *sprite, const char *frame);
+const char *lvgl_port_get_sprite_frame(lv_obj_t *sprite);
+lv_obj_t *lvgl_port_create_scroll(lv_obj_t *parent, const void *src);
+esp_err_t lvgl_port_set_scroll_offset(lv_obj_t *scroll, lv_coord_t x);
+esp_err_t lvgl_port_add_clip_radius(lv_obj_t *obj, const lv_obj_t *box, lv_coord_t radius);
+esp_err_t lvgl_port_add_clip_fade(lv_obj_t *obj, lv_coord_t top, lv_coord_t bottom);
+esp_err_t lvgl_port_add_roller_band(lv_obj_t *roller);
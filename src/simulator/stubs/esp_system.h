@@ -0,0 +1,13 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/* Host stub of esp_system.h, a restart ends the simulated session */
+
+#pragma once
+
+#include "esp_err.h"
+
+void esp_restart(void);